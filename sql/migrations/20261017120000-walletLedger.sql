@@ -0,0 +1,16 @@
+-- Wallet ledger: journal rows keep the ledger sequence number of their entry, wallets the
+-- last one they were written at, and srvStatus the last one whose writes all finished
+
+-- +migrate Up
+alter table jnlCharacters add ledgerSeq bigint unsigned not null default 0, add index ledgerSeq (ledgerSeq);
+alter table jnlCorporations add ledgerSeq bigint unsigned not null default 0, add index ledgerSeq (ledgerSeq);
+alter table chrCharacters add walletSeq bigint unsigned not null default 0;
+alter table crpWalletDivisons add walletSeq bigint unsigned not null default 0;
+alter table srvStatus add walletSeq bigint unsigned not null default 0;
+
+-- +migrate Down
+alter table jnlCharacters drop index ledgerSeq, drop column ledgerSeq;
+alter table jnlCorporations drop index ledgerSeq, drop column ledgerSeq;
+alter table chrCharacters drop column walletSeq;
+alter table crpWalletDivisons drop column walletSeq;
+alter table srvStatus drop column walletSeq;
@@ -110,8 +110,8 @@ namespace Market {
         uint32 duration;
         uint32 memberID;
         int64 issued;
-        float price;
-        float escrow;
+        double price;
+        double escrow;
     };
 
     // used to query sell orders when buy is requested
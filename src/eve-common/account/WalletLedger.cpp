@@ -0,0 +1,117 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "account/WalletLedger.h"
+
+bool WalletLedger::Load(uint32 ownerID, uint16 accountKey, double balance)
+{
+    Wallet wallet = Wallet();
+    wallet.balance = balance;
+    return m_wallets.emplace(Key(ownerID, accountKey), wallet).second;
+}
+
+bool WalletLedger::GetBalance(uint32 ownerID, uint16 accountKey, double& balance) const
+{
+    std::unordered_map<uint64_t, Wallet>::const_iterator itr = m_wallets.find(Key(ownerID, accountKey));
+    if (itr == m_wallets.end()) {
+        balance = 0.0;
+        return false;
+    }
+    balance = itr->second.balance;
+    return true;
+}
+
+bool WalletLedger::Apply(Entry& entry, bool journal/*true*/, double cap/*max*/)
+{
+    const uint64_t key = Key(entry.ownerID, entry.accountKey);
+    std::unordered_map<uint64_t, Wallet>::iterator itr = m_wallets.find(key);
+    if (itr == m_wallets.end())
+        return false;
+
+    Wallet& wallet = itr->second;
+    if ((entry.amount < 0) and (wallet.balance + entry.amount < 0))
+        return false;
+
+    wallet.balance = std::min(wallet.balance + entry.amount, std::max(cap, wallet.balance));
+    wallet.seq = ++m_seq;
+    if (!wallet.dirty) {
+        wallet.dirty = true;
+        m_dirty.push_back(key);
+    }
+
+    entry.seq = wallet.seq;
+    entry.balance = wallet.balance;
+    if (journal)
+        m_journal.push_back(entry);
+    return true;
+}
+
+void WalletLedger::Journal(Entry& entry)
+{
+    entry.seq = ++m_seq;
+    m_journal.push_back(entry);
+}
+
+void WalletLedger::TakePending(std::vector<Entry>& journal, std::vector<Balance>& balances)
+{
+    journal.clear();
+    journal.swap(m_journal);
+
+    // keys sort by owner, then account key
+    std::sort(m_dirty.begin(), m_dirty.end());
+    balances.clear();
+    balances.reserve(m_dirty.size());
+    for (auto cur : m_dirty) {
+        Wallet& wallet = m_wallets[cur];
+        wallet.dirty = false;
+        Balance balance = Balance();
+        balance.ownerID = (uint32)(cur >> 16);
+        balance.accountKey = (uint16)(cur & 0xFFFF);
+        balance.seq = wallet.seq;
+        balance.balance = wallet.balance;
+        balances.push_back(balance);
+    }
+    m_dirty.clear();
+}
+
+bool WalletLedger::Unload(uint32 ownerID, uint16 accountKey)
+{
+    std::unordered_map<uint64_t, Wallet>::iterator itr = m_wallets.find(Key(ownerID, accountKey));
+    if (itr == m_wallets.end())
+        return true;
+    if (itr->second.dirty)
+        return false;
+    m_wallets.erase(itr);
+    return true;
+}
+
+void WalletLedger::Clear()
+{
+    m_wallets.clear();
+    m_dirty.clear();
+    m_journal.clear();
+}
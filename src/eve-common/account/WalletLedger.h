@@ -0,0 +1,120 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __ACCOUNT__WALLET_LEDGER_H__INCL__
+#define __ACCOUNT__WALLET_LEDGER_H__INCL__
+
+/**
+ * @brief Wallet balances, by owner and account key, and the journal rows not yet written.
+ *
+ * The balances here are the real ones; the db catches up when TakePending()
+ * hands over what changed.  Every change gets the next sequence number, kept
+ * on its journal row and on the wallet, so the db can tell which journal rows
+ * its balances already include (see WalletMgr).
+ *
+ * A wallet has to be loaded (with its stored balance) before it can change.
+ * Not thread-safe.
+ */
+class WalletLedger
+{
+public:
+    // one wallet change, as it goes to the journal
+    struct Entry {
+        uint64_t seq = 0;
+        uint32 ownerID = 0;
+        uint32 ownerFromID = 0;
+        uint32 ownerToID = 0;
+        uint32 referenceID = 0;
+        uint16 accountKey = 0;
+        int8 entryTypeID = 0;
+        uint8 currency = 0;
+        double date = 0.0;          // filetime
+        double amount = 0.0;
+        double balance = 0.0;       // after this entry
+        std::string description;
+    };
+
+    // a changed wallet, as of entry 'seq'
+    struct Balance {
+        uint32 ownerID;
+        uint16 accountKey;
+        uint64_t seq;
+        double balance;
+    };
+
+    WalletLedger()
+    : m_seq(0)                                          { }
+
+    /* the last sequence number handed out */
+    uint64_t GetSequence() const                        { return m_seq; }
+    /* at startup, to the highest one the db has seen */
+    void SetSequence(uint64_t seq)                      { m_seq = seq; }
+
+    size_t size() const                                 { return m_wallets.size(); }
+    bool Has(uint32 ownerID, uint16 accountKey) const   { return (m_wallets.find(Key(ownerID, accountKey)) != m_wallets.end()); }
+    /* adds a wallet at its stored balance.  @return false if it's already here; the one here is newer and is kept */
+    bool Load(uint32 ownerID, uint16 accountKey, double balance);
+    /* @return false, with 'balance' 0, if the wallet isn't loaded */
+    bool GetBalance(uint32 ownerID, uint16 accountKey, double& balance) const;
+
+    /**
+     * Moves entry.amount in or out of the wallet of entry.ownerID and entry.accountKey.
+     *
+     * @param entry - gets its seq and the balance after it
+     * @param journal - false to change the balance without a journal row
+     * @param cap - the balance is held to this; the journal row still shows the whole amount
+     * @return false, with nothing changed, if the wallet isn't loaded or the amount would take it below zero.
+     */
+    bool Apply(Entry& entry, bool journal = true, double cap = std::numeric_limits<double>::max());
+    /* journals 'entry' for an owner without a wallet here (npc corps, the system); its balance is left as given */
+    void Journal(Entry& entry);
+
+    /* journal rows and changed wallets not yet handed over */
+    size_t JournalCount() const                         { return m_journal.size(); }
+    size_t DirtyCount() const                           { return m_dirty.size(); }
+    /* hands over what changed since the last call: the journal rows in seq order,
+     * and each changed wallet once, at its latest balance, by owner and account key */
+    void TakePending(std::vector<Entry>& journal, std::vector<Balance>& balances);
+
+    /* drops a wallet, which must have nothing pending.  @return false if it has */
+    bool Unload(uint32 ownerID, uint16 accountKey);
+    void Clear();
+
+private:
+    struct Wallet {
+        double balance;
+        uint64_t seq;               // of the last entry applied, 0 if none since loaded
+        bool dirty;
+    };
+
+    static uint64_t Key(uint32 ownerID, uint16 accountKey)  { return (((uint64_t)ownerID << 16) | accountKey); }
+
+    uint64_t m_seq;
+    std::unordered_map<uint64_t, Wallet> m_wallets;
+    std::vector<uint64_t> m_dirty;      // keys of wallets changed since TakePending(), each once
+    std::vector<Entry> m_journal;
+};
+
+#endif /* !__ACCOUNT__WALLET_LEDGER_H__INCL__ */
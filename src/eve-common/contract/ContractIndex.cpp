@@ -0,0 +1,303 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "contract/ContractIndex.h"
+
+namespace {
+
+void SortUnique(std::vector<uint32>& ids)
+{
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+bool Contains(const std::vector<uint32>& ids, uint32 id)
+{
+    return std::binary_search(ids.begin(), ids.end(), id);
+}
+
+}
+
+bool ContractIndex::Add(const Contract::IndexData& data)
+{
+    if (data.contractID == 0)
+        return false;
+    if (!m_slotOf.emplace(data.contractID, (uint32)m_slots.size()).second)
+        return false;
+
+    uint32 slot = (uint32)m_slots.size();
+    if (m_free.empty()) {
+        m_slots.push_back(data);
+    } else {
+        slot = m_free.back();
+        m_free.pop_back();
+        m_slots[slot] = data;
+        m_slotOf[data.contractID] = slot;
+    }
+
+    Contract::IndexData& cur = m_slots[slot];
+    SortUnique(cur.typeIDs);
+    SortUnique(cur.groupIDs);
+    SortUnique(cur.categoryIDs);
+
+    Post(m_byRegion, cur.startRegionID, slot);
+    Post(m_bySystem, cur.startSystemID, slot);
+    for (uint32 typeID : cur.typeIDs)
+        Post(m_byType, typeID, slot);
+    for (uint32 groupID : cur.groupIDs)
+        Post(m_byGroup, groupID, slot);
+    for (uint32 categoryID : cur.categoryIDs)
+        Post(m_byCategory, categoryID, slot);
+    m_byPrice.emplace(cur.price, slot);
+    m_byReward.emplace(cur.reward, slot);
+    return true;
+}
+
+bool ContractIndex::Remove(uint32 contractID)
+{
+    std::unordered_map<uint32, uint32>::iterator itr = m_slotOf.find(contractID);
+    if (itr == m_slotOf.end())
+        return false;
+
+    const uint32 slot = itr->second;
+    Contract::IndexData& cur = m_slots[slot];
+    Unpost(m_byRegion, cur.startRegionID, slot);
+    Unpost(m_bySystem, cur.startSystemID, slot);
+    for (uint32 typeID : cur.typeIDs)
+        Unpost(m_byType, typeID, slot);
+    for (uint32 groupID : cur.groupIDs)
+        Unpost(m_byGroup, groupID, slot);
+    for (uint32 categoryID : cur.categoryIDs)
+        Unpost(m_byCategory, categoryID, slot);
+    m_byPrice.erase(std::make_pair(cur.price, slot));
+    m_byReward.erase(std::make_pair(cur.reward, slot));
+
+    cur = Contract::IndexData();
+    m_free.push_back(slot);
+    m_slotOf.erase(itr);
+    return true;
+}
+
+void ContractIndex::Clear()
+{
+    m_slots.clear();
+    m_free.clear();
+    m_slotOf.clear();
+    m_byRegion.clear();
+    m_bySystem.clear();
+    m_byType.clear();
+    m_byGroup.clear();
+    m_byCategory.clear();
+    m_byPrice.clear();
+    m_byReward.clear();
+}
+
+const Contract::IndexData* ContractIndex::Find(uint32 contractID) const
+{
+    std::unordered_map<uint32, uint32>::const_iterator itr = m_slotOf.find(contractID);
+    if (itr == m_slotOf.end())
+        return nullptr;
+    return &m_slots[itr->second];
+}
+
+size_t ContractIndex::Search(const Contract::SearchFilter& filter, size_t limit, std::vector<uint32>& into) const
+{
+    into.clear();
+
+    // the shortest list every match has to be in; none walks every slot
+    const Postings* pWalk(nullptr);
+    size_t walkSize = m_slots.size();
+    if (!Narrow(m_bySystem, filter.startSystemID, pWalk, walkSize)
+    or  !Narrow(m_byRegion, filter.startRegionID, pWalk, walkSize)
+    or  !Narrow(m_byGroup, filter.groupID, pWalk, walkSize)
+    or  !Narrow(m_byCategory, filter.categoryID, pWalk, walkSize))
+        return 0;
+
+    // a match has any one of the types; their lists are merged if that's shorter
+    Postings walk;
+    if (!filter.typeIDs.empty()) {
+        size_t count = 0;
+        for (uint32 typeID : filter.typeIDs) {
+            PostingMap::const_iterator itr = m_byType.find(typeID);
+            if (itr != m_byType.end())
+                count += itr->second.size();
+        }
+        if (count == 0)
+            return 0;
+        if (count < walkSize) {
+            walk.reserve(count);
+            for (uint32 typeID : filter.typeIDs) {
+                PostingMap::const_iterator itr = m_byType.find(typeID);
+                if (itr != m_byType.end())
+                    walk.insert(walk.end(), itr->second.begin(), itr->second.end());
+            }
+            SortUnique(walk);
+            pWalk = &walk;
+            walkSize = walk.size();
+        }
+    }
+
+    // and a price or reward range is walked instead when it's shorter still
+    Postings range;
+    if ((filter.minPrice > 0.0) or (filter.maxPrice < std::numeric_limits<double>::max()))
+        if (Collect(m_byPrice, filter.minPrice, filter.maxPrice, walkSize, range)) {
+            std::sort(range.begin(), range.end());
+            walk.swap(range);
+            pWalk = &walk;
+            walkSize = walk.size();
+        }
+    range.clear();
+    if ((filter.minReward > 0.0) or (filter.maxReward < std::numeric_limits<double>::max()))
+        if (Collect(m_byReward, filter.minReward, filter.maxReward, walkSize, range)) {
+            std::sort(range.begin(), range.end());
+            walk.swap(range);
+            pWalk = &walk;
+            walkSize = walk.size();
+        }
+
+    if (pWalk == nullptr) {
+        for (const Contract::IndexData& cur : m_slots)
+            if ((cur.contractID != 0) and Matches(cur, filter))
+                into.push_back(cur.contractID);
+    } else {
+        for (uint32 slot : *pWalk)
+            if (Matches(m_slots[slot], filter))
+                into.push_back(m_slots[slot].contractID);
+    }
+
+    // slots aren't in contractID order once freed ones are reused
+    const size_t found = into.size();
+    if (found > limit) {
+        std::nth_element(into.begin(), into.begin() + limit, into.end(), std::greater<uint32>());
+        into.resize(limit);
+    }
+    std::sort(into.begin(), into.end(), std::greater<uint32>());
+    return found;
+}
+
+bool ContractIndex::Matches(const Contract::IndexData& data, const Contract::SearchFilter& filter)
+{
+    if ((data.type >= 32) or ((filter.typeMask & (1u << data.type)) == 0))
+        return false;
+    if ((data.price < filter.minPrice) or (data.price > filter.maxPrice))
+        return false;
+    if ((data.reward < filter.minReward) or (data.reward > filter.maxReward))
+        return false;
+    if ((filter.startSystemID != 0) and (data.startSystemID != filter.startSystemID))
+        return false;
+    if ((filter.startRegionID != 0) and (data.startRegionID != filter.startRegionID))
+        return false;
+    if ((filter.endSystemID != 0) and (data.endSystemID != filter.endSystemID))
+        return false;
+    if ((filter.endRegionID != 0) and (data.endRegionID != filter.endRegionID))
+        return false;
+
+    if (filter.issuerID != 0) {
+        if (data.forCorp != filter.issuerIsCorp)
+            return false;
+        if ((filter.issuerIsCorp ? data.issuerCorpID : data.issuerID) != filter.issuerID)
+            return false;
+    }
+
+    if (filter.availability == 0) {
+        if (data.isPrivate)
+            return false;
+    } else if (filter.availability > 0) {
+        if (!data.isPrivate or (data.assigneeID != filter.assigneeID))
+            return false;
+    }
+
+    // the item lists last, they're off in the heap
+    if ((filter.groupID != 0) and !Contains(data.groupIDs, filter.groupID))
+        return false;
+    if ((filter.categoryID != 0) and !Contains(data.categoryIDs, filter.categoryID))
+        return false;
+    if (filter.typeIDs.empty())
+        return true;
+    for (uint32 typeID : filter.typeIDs)
+        if (Contains(data.typeIDs, typeID))
+            return true;
+    return false;
+}
+
+void ContractIndex::Post(PostingMap& map, uint32 key, uint32 slot)
+{
+    Postings& list = map[key];
+    // new slots are the highest yet, so this is nearly always an append
+    if (list.empty() or (list.back() < slot)) {
+        list.push_back(slot);
+        return;
+    }
+
+    Postings::iterator itr = std::lower_bound(list.begin(), list.end(), slot);
+    if (*itr != slot)
+        list.insert(itr, slot);
+}
+
+void ContractIndex::Unpost(PostingMap& map, uint32 key, uint32 slot)
+{
+    PostingMap::iterator itr = map.find(key);
+    if (itr == map.end())
+        return;
+
+    Postings& list = itr->second;
+    Postings::iterator pos = std::lower_bound(list.begin(), list.end(), slot);
+    if ((pos != list.end()) and (*pos == slot))
+        list.erase(pos);
+    if (list.empty())
+        map.erase(itr);
+}
+
+bool ContractIndex::Narrow(const PostingMap& map, uint32 key, const Postings*& pWalk, size_t& walkSize)
+{
+    if (key == 0)
+        return true;
+
+    PostingMap::const_iterator itr = map.find(key);
+    if (itr == map.end())
+        return false;
+
+    if (itr->second.size() < walkSize) {
+        pWalk = &itr->second;
+        walkSize = itr->second.size();
+    }
+    return true;
+}
+
+bool ContractIndex::Collect(const RangeMap& map, double min, double max, size_t cap, Postings& into)
+{
+    if (min > max)
+        return true;
+
+    RangeMap::const_iterator end = map.upper_bound(std::make_pair(max, UINT32_MAX));
+    for (RangeMap::const_iterator itr = map.lower_bound(std::make_pair(min, 0u)); itr != end; ++itr) {
+        if (into.size() >= cap)
+            return false;
+        into.push_back(itr->second);
+    }
+    return true;
+}
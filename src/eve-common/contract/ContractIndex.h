@@ -0,0 +1,135 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __CONTRACT__CONTRACT_INDEX_H__INCL__
+#define __CONTRACT__CONTRACT_INDEX_H__INCL__
+
+namespace Contract {
+    // what the search index keeps of an outstanding contract
+    struct IndexData {
+        bool isPrivate :1;
+        bool forCorp :1;
+        uint8 type;
+        uint32 contractID;
+        uint32 issuerID;
+        uint32 issuerCorpID;
+        uint32 assigneeID;
+        uint32 startSystemID;
+        uint32 startRegionID;
+        uint32 endSystemID;
+        uint32 endRegionID;
+        double price;
+        double reward;
+        // of the items on offer, each id once
+        std::vector<uint32> typeIDs;
+        std::vector<uint32> groupIDs;
+        std::vector<uint32> categoryIDs;
+    };
+
+    // a contract search; every field left at its default matches anything
+    struct SearchFilter {
+        uint32 typeMask = UINT32_MAX;       // bit (1 << contractType) for each type wanted
+        std::vector<uint32> typeIDs;        // an item of any of these types
+        uint32 groupID = 0;
+        uint32 categoryID = 0;
+        uint32 startSystemID = 0;
+        uint32 startRegionID = 0;
+        uint32 endSystemID = 0;
+        uint32 endRegionID = 0;
+        uint32 issuerID = 0;                // issuerCorpID instead when issuerIsCorp
+        bool issuerIsCorp = false;
+        int8 availability = -1;             // 0 public, 1 private to assigneeID
+        uint32 assigneeID = 0;
+        double minPrice = 0.0;
+        double maxPrice = std::numeric_limits<double>::max();
+        double minReward = 0.0;
+        double maxReward = std::numeric_limits<double>::max();
+    };
+}
+
+/**
+ * @brief Outstanding contracts, indexed for the contract search.
+ *
+ * Contracts sit in one array, a slot each.  Start region, start system, item
+ * type, group and category each keep a posting list of slots (ascending), and
+ * price and reward are kept ordered.  A search walks the smallest of the lists
+ * (or price/reward range) its filter names, the whole array if it names none,
+ * and checks each contract it finds against the whole filter; walking slots in
+ * order keeps that a forward pass over the array.
+ *
+ * Only outstanding contracts belong here; one is removed once accepted or deleted.
+ */
+class ContractIndex
+{
+public:
+    ContractIndex()                                     { }
+
+    size_t size() const                                 { return m_slotOf.size(); }
+    bool empty() const                                  { return m_slotOf.empty(); }
+
+    /* 'data' is copied; its typeIDs/groupIDs/categoryIDs may repeat.  @return false if it's already here */
+    bool Add(const Contract::IndexData& data);
+    bool Remove(uint32 contractID);
+    void Clear();
+
+    const Contract::IndexData* Find(uint32 contractID) const;
+
+    /**
+     * Finds the contracts matching 'filter'.
+     *
+     * @param into - set to the matches, newest (highest contractID) first, at most 'limit' of them
+     * @return the number of matches, including those past 'limit'.
+     */
+    size_t Search(const Contract::SearchFilter& filter, size_t limit, std::vector<uint32>& into) const;
+
+private:
+    typedef std::vector<uint32> Postings;               // slots, ascending
+    typedef std::unordered_map<uint32, Postings> PostingMap;
+    typedef std::set<std::pair<double, uint32>> RangeMap;   // value, slot
+
+    static bool Matches(const Contract::IndexData& data, const Contract::SearchFilter& filter);
+
+    static void Post(PostingMap& map, uint32 key, uint32 slot);
+    static void Unpost(PostingMap& map, uint32 key, uint32 slot);
+
+    /* keeps the list for 'key' as the walk if it's shorter.  @return false if nothing has 'key' */
+    static bool Narrow(const PostingMap& map, uint32 key, const Postings*& pWalk, size_t& walkSize);
+    /* appends the slots in ['min', 'max'] to 'into', giving up past 'cap' of them.  @return false if it gave up */
+    static bool Collect(const RangeMap& map, double min, double max, size_t cap, Postings& into);
+
+    // a free slot has contractID 0
+    std::vector<Contract::IndexData> m_slots;
+    std::vector<uint32> m_free;
+    std::unordered_map<uint32, uint32> m_slotOf;        // contractID/slot
+    PostingMap m_byRegion;
+    PostingMap m_bySystem;
+    PostingMap m_byType;
+    PostingMap m_byGroup;
+    PostingMap m_byCategory;
+    RangeMap m_byPrice;
+    RangeMap m_byReward;
+};
+
+#endif /* !__CONTRACT__CONTRACT_INDEX_H__INCL__ */
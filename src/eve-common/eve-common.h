@@ -69,6 +69,7 @@
 #include "utils/misc.h"
 #include "utils/Seperator.h"
 #include "utils/timer.h"
+#include "utils/TimerWheel.h"
 #include "utils/utils_hex.h"
 #include "utils/utils_string.h"
 #include "utils/utils_time.h"
@@ -0,0 +1,119 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "market/MarketOrderBook.h"
+
+void MarketOrderBook::Add(const Market::SaveData& data)
+{
+    std::pair<std::unordered_map<uint32, Market::SaveData>::iterator, bool> res = m_orders.emplace(data.orderID, data);
+    if (res.second)
+        Link(&res.first->second);
+}
+
+bool MarketOrderBook::Remove(uint32 orderID)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return false;
+
+    Unlink(&itr->second);
+    m_orders.erase(itr);
+    return true;
+}
+
+const Market::SaveData* MarketOrderBook::Find(uint32 orderID) const
+{
+    std::unordered_map<uint32, Market::SaveData>::const_iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return nullptr;
+    return &itr->second;
+}
+
+bool MarketOrderBook::SetQuantity(uint32 orderID, uint32 volRemaining)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return false;
+
+    itr->second.volRemaining = volRemaining;
+    return true;
+}
+
+bool MarketOrderBook::SetPrice(uint32 orderID, double price)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return false;
+
+    Unlink(&itr->second);
+    itr->second.price = price;
+    Link(&itr->second);
+    return true;
+}
+
+void MarketOrderBook::Link(Market::SaveData* pOrder)
+{
+    if (pOrder->bid) {
+        m_bids[pOrder->price].push_back(pOrder);
+    } else {
+        m_asks[pOrder->price].push_back(pOrder);
+    }
+}
+
+void MarketOrderBook::Unlink(Market::SaveData* pOrder)
+{
+    // the level is keyed by the exact price the order was linked with
+    Level* pLevel(nullptr);
+    AskMap::iterator askItr = m_asks.end();
+    BidMap::iterator bidItr = m_bids.end();
+    if (pOrder->bid) {
+        bidItr = m_bids.find(pOrder->price);
+        if (bidItr != m_bids.end())
+            pLevel = &bidItr->second;
+    } else {
+        askItr = m_asks.find(pOrder->price);
+        if (askItr != m_asks.end())
+            pLevel = &askItr->second;
+    }
+
+    if (pLevel == nullptr)
+        return;
+
+    // keep the rest of the level in time order
+    Level::iterator itr = std::find(pLevel->begin(), pLevel->end(), pOrder);
+    if (itr != pLevel->end())
+        pLevel->erase(itr);
+
+    if (!pLevel->empty())
+        return;
+
+    if (pOrder->bid) {
+        m_bids.erase(bidItr);
+    } else {
+        m_asks.erase(askItr);
+    }
+}
@@ -0,0 +1,121 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __MARKET__MARKET_ORDER_BOOK_H__INCL__
+#define __MARKET__MARKET_ORDER_BOOK_H__INCL__
+
+#include "EVE_Market.h"
+
+/**
+ * @brief Open orders of one type in one region, sorted for matching.
+ *
+ * Sell orders (asks) are kept cheapest first and buy orders (bids) dearest
+ * first, each price level in the order the orders were added, so a search
+ * walks them in price-time priority and stops at the first order it accepts.
+ *
+ * The book only holds the orders; where they may be filled from (order range)
+ * is up to the predicate the caller hands to FindAsk()/FindBid().
+ */
+class MarketOrderBook
+{
+public:
+    MarketOrderBook()                                   { }
+
+    size_t size() const                                 { return m_orders.size(); }
+    bool empty() const                                  { return m_orders.empty(); }
+
+    /* 'data' is copied; data.orderID must be set and not already in the book */
+    void Add(const Market::SaveData& data);
+    bool Remove(uint32 orderID);
+
+    const Market::SaveData* Find(uint32 orderID) const;
+
+    bool SetQuantity(uint32 orderID, uint32 volRemaining);
+    /* the order goes to the back of its new price level */
+    bool SetPrice(uint32 orderID, double price);
+
+    /**
+     * Finds the best sell order priced below 'priceLimit' with at least 'quantity'
+     * remaining that accept(order) agrees to.
+     *
+     * @return the order or nullptr.
+     */
+    template<typename _Pred>
+    const Market::SaveData* FindAsk(double priceLimit, uint32 quantity, _Pred accept) const
+    {
+        for (AskMap::const_iterator itr = m_asks.begin(); itr != m_asks.end(); ++itr) {
+            if (!(itr->first < priceLimit))
+                break;
+            for (const Market::SaveData* cur : itr->second)
+                if ((cur->volRemaining >= quantity) and accept(*cur))
+                    return cur;
+        }
+        return nullptr;
+    }
+
+    /* same as FindAsk(), for the best buy order priced above 'priceLimit' */
+    template<typename _Pred>
+    const Market::SaveData* FindBid(double priceLimit, uint32 quantity, _Pred accept) const
+    {
+        for (BidMap::const_iterator itr = m_bids.begin(); itr != m_bids.end(); ++itr) {
+            if (!(itr->first > priceLimit))
+                break;
+            for (const Market::SaveData* cur : itr->second)
+                if ((cur->volRemaining >= quantity) and accept(*cur))
+                    return cur;
+        }
+        return nullptr;
+    }
+
+    /* calls func(order) for every order on one side, in priority order */
+    template<typename _Func>
+    void ForEach(bool bid, _Func func) const
+    {
+        if (bid) {
+            for (const BidMap::value_type& level : m_bids)
+                for (const Market::SaveData* cur : level.second)
+                    func(*cur);
+        } else {
+            for (const AskMap::value_type& level : m_asks)
+                for (const Market::SaveData* cur : level.second)
+                    func(*cur);
+        }
+    }
+
+private:
+    typedef std::vector<Market::SaveData*> Level;
+    typedef std::map<double, Level> AskMap;
+    typedef std::map<double, Level, std::greater<double>> BidMap;
+
+    void Link(Market::SaveData* pOrder);
+    void Unlink(Market::SaveData* pOrder);
+
+    // node based, so the levels can point into it
+    std::unordered_map<uint32, Market::SaveData> m_orders;
+    AskMap m_asks;
+    BidMap m_bids;
+};
+
+#endif /* !__MARKET__MARKET_ORDER_BOOK_H__INCL__ */
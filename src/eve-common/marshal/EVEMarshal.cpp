@@ -32,6 +32,7 @@
 #include "python/PyRep.h"
 #include "python/PyVisitor.h"
 #include "utils/EVEUtils.h"
+#include "utils/TimeStats.h"
 
 bool Marshal( const PyRep* rep, Buffer& into )
 {
@@ -43,10 +44,19 @@ bool Marshal( const PyRep* rep, Buffer& into )
 
 bool MarshalDeflate( const PyRep* rep, Buffer& into, const uint32 deflationLimit )
 {
+    static TimeStatsKey sMarshalKey("Marshal");
+    static TimeStatsKey sDeflateKey("Deflate");
+
     Buffer* data(new Buffer());
     bool ret(false);
-    if (Marshal(rep, *data)) {
+    bool marshaled(false);
+    {
+        TimeStatsScope timer(sMarshalKey);
+        marshaled = Marshal(rep, *data);
+    }
+    if (marshaled) {
         if ( data->size() >= deflationLimit ) {
+            TimeStatsScope timer(sDeflateKey);
             ret = DeflateData( *data, into );
         } else {
             into.AppendSeq( data->begin<uint8>(), data->end<uint8>() );
@@ -58,23 +68,64 @@ bool MarshalDeflate( const PyRep* rep, Buffer& into, const uint32 deflationLimit
     return ret;
 }
 
+bool MarshalFragment( const PyRep* rep, Buffer& into )
+{
+    MarshalStream* pMS(new MarshalStream());
+    bool ret(pMS->SaveFragment(rep, into));
+    SafeDelete(pMS);
+    return ret;
+}
+
+static std::atomic<size_t> sMarshalWalked( 0 );
+static std::atomic<size_t> sMarshalCopied( 0 );
+
+void GetMarshalStats( size_t& walked, size_t& copied )
+{
+    walked = sMarshalWalked.exchange( 0 );
+    copied = sMarshalCopied.exchange( 0 );
+}
+
 /************************************************************************/
 /* MarshalStream                                                        */
 /************************************************************************/
 MarshalStream::MarshalStream()
-: mBuffer( nullptr )
+: mBuffer( nullptr ),
+  mCopied( 0 )
 {
 }
 
 bool MarshalStream::Save( const PyRep* rep, Buffer& into )
 {
     mBuffer = &into;
+    mCopied = 0;
+    const size_t start(into.size());
     bool res(SaveStream(rep));
+    CountOutput(start);
     mBuffer = nullptr;
 
     return res;
 }
 
+bool MarshalStream::SaveFragment( const PyRep* rep, Buffer& into )
+{
+    mBuffer = &into;
+    mCopied = 0;
+    const size_t start(into.size());
+    bool res(rep->visit(*this));
+    CountOutput(start);
+    mBuffer = nullptr;
+
+    return res;
+}
+
+void MarshalStream::CountOutput( size_t start )
+{
+    // nested streams (sub streams, encoded tuples) count their own walk
+    const size_t total(mBuffer->size() - start);
+    sMarshalWalked += total - mCopied;
+    sMarshalCopied += mCopied;
+}
+
 bool MarshalStream::SaveStream( const PyRep* rep )
 {
     Put<uint8>( MarshalHeaderByte );
@@ -218,6 +269,15 @@ bool MarshalStream::VisitToken( const PyToken* rep )
 
 bool MarshalStream::VisitTuple( const PyTuple* rep )
 {
+    const PyBuffer* encoded(rep->encoded());
+    if (encoded != nullptr) {
+        // marshaled once already, copy it in
+        const Buffer& data = encoded->content();
+        Put( data.begin<uint8>(), data.end<uint8>() );
+        mCopied += data.size();
+        return true;
+    }
+
     uint32 size(rep->size());
     if ( size == 0 ) {
         Put<uint8>( Op_PyEmptyTuple );
@@ -484,6 +544,7 @@ bool MarshalStream::VisitSubStream( const PySubStream* rep )
 
     PutSizeEx( (uint32)data.size() );
     Put( data.begin<uint8>(), data.end<uint8>() );
+    mCopied += data.size();
 
     return true;
 }
@@ -50,6 +50,27 @@ extern bool Marshal( const PyRep* rep, Buffer& into );
  * @retval false Error occured during marshaling.
  */
 extern bool MarshalDeflate( const PyRep* rep, Buffer& into, const uint32 deflationLimit = 0x2000 );
+/*
+ * @brief Marshals object without stream header.
+ *
+ * The output may be spliced into any other marshal stream
+ * (see PyTuple::EncodeOnce()).
+ *
+ * @param[in]  rep  Python object to marshal.
+ * @param[out] into Buffer which receives marshaled object.
+ *
+ * @retval true  Marshaling ran successfully.
+ * @retval false Error occured during marshaling.
+ */
+extern bool MarshalFragment( const PyRep* rep, Buffer& into );
+/*
+ * @brief Obtains marshal output counters and resets them.
+ *
+ * @param[out] walked Bytes produced by walking Python objects.
+ * @param[out] copied Bytes copied from already marshaled data
+ *                    (encoded tuples and sub streams).
+ */
+extern void GetMarshalStats( size_t& walked, size_t& copied );
 
 /**
  * @brief Turns Python objects into marshal bytecode.
@@ -65,10 +86,14 @@ public:
 
     /** saves given rep to given buffer */
     bool Save( const PyRep* rep, Buffer& into );
+    /** saves given rep to given buffer, without stream header */
+    bool SaveFragment( const PyRep* rep, Buffer& into );
 
 protected:
     /** saves new stream with given rep. */
     bool SaveStream( const PyRep* rep );
+    /** updates marshal counters with output of this stream */
+    void CountOutput( size_t start );
 
     /** adds given value to the data stream */
     template<typename T>
@@ -144,6 +169,8 @@ private:
     bool SaveRLE(const Buffer& in );
 
     Buffer* mBuffer;
+    // bytes copied from already marshaled data
+    size_t mCopied;
 };
 
 #endif
@@ -35,7 +35,7 @@
 
 #include "utils/EVEUtils.h"
 
-PyRep* Unmarshal( const Buffer& data )
+PyRep* Unmarshal( const BufferView& data )
 {
     UnmarshalStream* pUMS = new UnmarshalStream();
     PyRep* res = pUMS->Load( data );
@@ -43,7 +43,7 @@ PyRep* Unmarshal( const Buffer& data )
     return res;
 }
 
-PyRep* InflateUnmarshal( const Buffer& data )
+PyRep* InflateUnmarshal( const BufferView& data )
 {
     if (IsDeflated(data)) {
         Buffer inflatedData;
@@ -131,11 +131,12 @@ PyRep* ( UnmarshalStream::* const UnmarshalStream::s_mLoadMap[ PyRepOpcodeMask +
     &UnmarshalStream::LoadError
 };
 
-PyRep* UnmarshalStream::Load( const Buffer& data )
+PyRep* UnmarshalStream::Load( const BufferView& data )
 {
-    mInItr = data.begin<uint8>();
+    mInItr = data.begin();
+    mInEnd = data.end();
     PyRep* res = LoadStream( data.size() );
-    mInItr = Buffer::const_iterator<uint8>();
+    mInItr = mInEnd = nullptr;
 
     return res;
 }
@@ -184,14 +185,14 @@ void UnmarshalStream::CreateObjectStore( size_t streamLength, uint32 saveCount )
 
     if( 0 < saveCount )
     {
-        mStoreIndexItr = ( ( mInItr + streamLength ).As<uint32>() - saveCount );
+        mStoreIndexItr = ( reinterpret_cast< const uint32* >( mInItr + streamLength ) - saveCount );
         mStoredObjects = new PyList( saveCount );
     }
 }
 
 void UnmarshalStream::DestroyObjectStore()
 {
-    mStoreIndexItr = Buffer::const_iterator<uint32>();
+    mStoreIndexItr = nullptr;
     PySafeDecRef( mStoredObjects );
 }
 
@@ -221,19 +222,19 @@ PyRep* UnmarshalStream::LoadIntegerVar()
      */
 
     const uint32 len = ReadSizeEx();
-    const Buffer::const_iterator<uint8> data = Read<uint8>( len );
+    const uint8* data = Read<uint8>( len );
 
     if( sizeof( int32 ) >= len )
     {
         int32 intval(0);
-        memcpy( &intval, &*data, len );
+        memcpy( &intval, data, len );
 
         return new PyInt( intval );
     }
     else if( sizeof( int64 ) >= len )
     {
         int64 intval(0);
-        memcpy( &intval, &*data, len );
+        memcpy( &intval, data, len );
 
         return new PyLong( intval );
     }
@@ -247,7 +248,7 @@ PyRep* UnmarshalStream::LoadIntegerVar()
 
 PyRep* UnmarshalStream::LoadStringChar()
 {
-    const Buffer::const_iterator<char> str = Read<char>( 1 );
+    const char* str = Read<char>( 1 );
 
     return new PyString( str, str + 1 );
 }
@@ -255,7 +256,7 @@ PyRep* UnmarshalStream::LoadStringChar()
 PyRep* UnmarshalStream::LoadStringShort()
 {
     const uint8 len = Read<uint8>();
-    const Buffer::const_iterator<char> str = Read<char>( len );
+    const char* str = Read<char>( len );
 
     return new PyString( str, str + len );
 }
@@ -263,7 +264,7 @@ PyRep* UnmarshalStream::LoadStringShort()
 PyRep* UnmarshalStream::LoadStringLong()
 {
     const uint32 len = ReadSizeEx();
-    const Buffer::const_iterator<char> str = Read<char>( len );
+    const char* str = Read<char>( len );
 
     return new PyString( str, str + len );
 }
@@ -288,7 +289,7 @@ PyRep* UnmarshalStream::LoadStringTable()
 
 PyRep* UnmarshalStream::LoadWStringUCS2Char()
 {
-    const Buffer::const_iterator<uint16> wstr = Read<uint16>( 1 );
+    const uint16* wstr = Read<uint16>( 1 );
 
     // convert to UTF-8
     std::string str;
@@ -300,7 +301,7 @@ PyRep* UnmarshalStream::LoadWStringUCS2Char()
 PyRep* UnmarshalStream::LoadWStringUCS2()
 {
     const uint32 len = ReadSizeEx();
-    const Buffer::const_iterator<uint16> wstr = Read<uint16>( len );
+    const uint16* wstr = Read<uint16>( len );
 
     // convert to UTF-8
     std::string str;
@@ -312,7 +313,7 @@ PyRep* UnmarshalStream::LoadWStringUCS2()
 PyRep* UnmarshalStream::LoadWStringUTF8()
 {
     const uint32 len = ReadSizeEx();
-    const Buffer::const_iterator<char> wstr = Read<char>( len );
+    const char* wstr = Read<char>( len );
 
     return new PyWString( wstr, wstr + len );
 }
@@ -320,7 +321,7 @@ PyRep* UnmarshalStream::LoadWStringUTF8()
 PyRep* UnmarshalStream::LoadToken()
 {
     const uint8 len = Read<uint8>();
-    const Buffer::const_iterator<char> str = Read<char>( len );
+    const char* str = Read<char>( len );
 
     return new PyToken( str, str + len );
 }
@@ -328,7 +329,7 @@ PyRep* UnmarshalStream::LoadToken()
 PyRep* UnmarshalStream::LoadBuffer()
 {
     const uint32 len = ReadSizeEx();
-    const Buffer::const_iterator<uint8> data = Read<uint8>( len );
+    const uint8* data = Read<uint8>( len );
 
     return new PyBuffer( data, data + len );
 }
@@ -476,7 +477,7 @@ PyRep* UnmarshalStream::LoadObjectEx2()
 PyRep* UnmarshalStream::LoadSubStream()
 {
     const uint32 len = ReadSizeEx();
-    const Buffer::const_iterator<uint8> data = Read<uint8>( len );
+    const uint8* data = Read<uint8>( len );
 
     return new PySubStream( new PyBuffer( data, data + len ) );
 }
@@ -761,10 +762,9 @@ bool UnmarshalStream::LoadRLE(Buffer& out)
 {
     const uint32 in_size = ReadSizeEx();
 
-    Buffer::const_iterator<uint8> cur, end;
-    cur = Read<uint8>(in_size );
-    end = cur + in_size;
-    Buffer::const_iterator<uint8> in_ix = cur;
+    const uint8* cur = Read<uint8>( in_size );
+    const uint8* end = cur + in_size;
+    const uint8* in_ix = cur;
     int out_ix = 0;
     int count;
     int run = 0;
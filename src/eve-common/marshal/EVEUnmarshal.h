@@ -27,6 +27,7 @@
 #define EVE_UNMARSHAL_H
 
 #include "python/PyRep.h"
+#include "utils/BufferView.h"
 
 
 /**
@@ -36,7 +37,7 @@
  *
  * @return Ownership of Python object.
  */
-extern PyRep* Unmarshal( const Buffer& data );
+extern PyRep* Unmarshal( const BufferView& data );
 /**
  * @brief Turns possibly inflated marshal stream into Python object.
  *
@@ -44,7 +45,7 @@ extern PyRep* Unmarshal( const Buffer& data );
  *
  * @return Ownership of Python object.
 */
-extern PyRep* InflateUnmarshal( const Buffer& data );
+extern PyRep* InflateUnmarshal( const BufferView& data );
 
 /**
  * @brief Class which turns marshal bytecode into Python object.
@@ -55,7 +56,10 @@ class UnmarshalStream
 {
 public:
     UnmarshalStream()
-    : mStoredObjects( nullptr )
+    : mInItr( nullptr ),
+      mInEnd( nullptr ),
+      mStoreIndexItr( nullptr ),
+      mStoredObjects( nullptr )
     {
     }
 
@@ -64,11 +68,11 @@ public:
     /**
      * @brief Loads Python object from given bytecode.
      *
-     * @param[in] data Buffer containing marshal bytecode.
+     * @param[in] data Marshal bytecode; not copied.
      *
      * @return Loaded Python object.
      */
-    PyRep* Load( const Buffer& data );
+    PyRep* Load( const BufferView& data );
 
 protected:
     /** Peeks element from stream. */
@@ -76,17 +80,22 @@ protected:
     const T& Peek() const { return *Peek<T>( 1 ); }
     /** Peeks elements from stream. */
     template<typename T>
-    Buffer::const_iterator<T> Peek( size_t count ) const { return mInItr.As<T>(); }
+    const T* Peek( size_t count ) const
+    {
+        // make sure we're not going off the bounds
+        assert( count * sizeof( T ) <= (size_t)( mInEnd - mInItr ) );
+        return reinterpret_cast< const T* >( mInItr );
+    }
 
     /** Reads element from stream. */
     template<typename T>
     const T& Read() { return *Read<T>( 1 ); }
     /** Reads elements from stream. */
     template<typename T>
-    Buffer::const_iterator<T> Read( size_t count )
+    const T* Read( size_t count )
     {
-        Buffer::const_iterator<T> res = Peek<T>( count );
-        mInItr = ( res + count ).template As<uint8>();
+        const T* res = Peek<T>( count );
+        mInItr = reinterpret_cast< const uint8* >( res + count );
         return res;
     }
 
@@ -243,11 +252,13 @@ private:
     /** Helper; loads zero-compressed buffer from stream. */
     bool LoadRLE(Buffer& out );
 
-    /** Buffer iterator we are processing. */
-    Buffer::const_iterator<uint8> mInItr;
+    /** Position in the stream we are processing. */
+    const uint8* mInItr;
+    /** End of the stream we are processing. */
+    const uint8* mInEnd;
 
     /** Next store index for referencing in the buffer. */
-    Buffer::const_iterator<uint32> mStoreIndexItr;
+    const uint32* mStoreIndexItr;
     /** Referenced objects within the buffer. */
     PyList* mStoredObjects;
 
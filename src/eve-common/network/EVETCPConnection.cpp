@@ -28,6 +28,7 @@
 #include "marshal/EVEMarshal.h"
 #include "marshal/EVEUnmarshal.h"
 #include "network/EVETCPConnection.h"
+#include "utils/TimeStats.h"
 
 /*************************************************************************/
 /* EVETCPConnection                                                      */
@@ -47,8 +48,19 @@ EVETCPConnection::EVETCPConnection( Socket* sock, uint32 rIP, uint16 rPort )
 {
 }
 
+EVETCPConnection::~EVETCPConnection()
+{
+    // ~TCPConnection would do this too late; reactor could still call
+    // our ProcessReceivedData() with mInQueue and vtable already gone
+    Disconnect();
+    WaitLoop();
+}
+
 void EVETCPConnection::QueueRep( const PyRep* rep, bool compress/*true*/ )
 {
+    static TimeStatsKey sQueueRepKey( "QueueRep" );
+    TimeStatsScope timer( sQueueRepKey );
+
     Buffer* pBuffer = new Buffer();
 
     // make room for length
@@ -86,20 +98,23 @@ PyRep* EVETCPConnection::PopRep()
 {
     PyRep* res(nullptr);
 
-    MutexLock lock( mMInQueue );
-    Buffer* packet = mInQueue.PopPacket();
-
-    if (packet != nullptr) {
-        if ( PACKET_SIZE_LIMIT < packet->size() ) {
-            sLog.Error( "Network", "Packet length %lu exceeds hardcoded packet length limit %u.", packet->size(), PACKET_SIZE_LIMIT );
-        } else {
-           // if (is_log_enabled(DEBUG__DEBUG))
-           //     DumpBuffer( packet, PACKET_INBOUND );
-            res = InflateUnmarshal( *packet );
-        }
+    /* view into packetizer's ring; stays valid until our next PopRep(),
+       so we don't need to hold the queue while unmarshaling */
+    BufferView packet;
+    {
+        MutexLock lock( mMInQueue );
+        if (!mInQueue.PopPacket( packet ))
+            return nullptr;
+    }
+
+    if ( PACKET_SIZE_LIMIT < packet.size() ) {
+        sLog.Error( "Network", "Packet length %lu exceeds hardcoded packet length limit %u.", packet.size(), PACKET_SIZE_LIMIT );
+    } else {
+       // if (is_log_enabled(DEBUG__DEBUG))
+       //     DumpBuffer( packet, PACKET_INBOUND );
+        res = InflateUnmarshal( packet );
     }
 
-    SafeDelete( packet );
     return res;
 }
 
@@ -121,9 +136,33 @@ bool EVETCPConnection::ProcessReceivedData( char* errbuf )
 
 bool EVETCPConnection::RecvData( char* errbuf )
 {
-    if( !TCPConnection::RecvData( errbuf ) )
+    if (errbuf != nullptr)
+        errbuf[0] = 0;
+
+    MutexLock sockLock( mMSock );
+
+    state_t state = GetState();
+    if ((state != STATE_CONNECTED) && (state != STATE_DISCONNECTING))
         return false;
 
+    int status(0);
+    do {
+        MutexLock lock( mMInQueue );
+
+        // receive straight into the packetizer's ring instead of mRecvBuf
+        size_t len(0);
+        uint8* span = mInQueue.GetWriteSpan( len );
+        status = RecvInto( span, len, errbuf );
+        if (status < 0)
+            return false;
+
+        if (status > 0) {
+            mInQueue.CommitWrite( status );
+            mInQueue.Process();
+            mTimeoutTimer.Start();
+        }
+    } while (status > 0);
+
     if( mTimeoutTimer.Check() ) {
         if (errbuf != nullptr)
             snprintf( errbuf, TCPCONN_ERRBUF_SIZE, "Connection timeout" );
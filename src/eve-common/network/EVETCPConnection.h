@@ -49,7 +49,10 @@ public:
      * @brief Creates empty EVE connection.
      */
     EVETCPConnection();
-    virtual ~EVETCPConnection()                         { /* do nothing here */ }
+    /**
+     * @brief Stops processing while ProcessReceivedData() can still be called.
+     */
+    virtual ~EVETCPConnection();
 
     /**
      * @brief Queues given PyRep into send queue.
@@ -618,12 +618,17 @@ bool PyToken::visit( PyVisitor& v ) const
 /************************************************************************/
 /* PyRep Tuple Class                                                    */
 /************************************************************************/
-PyTuple::PyTuple( size_t item_count ) : PyRep( PyRep::PyTypeTuple ), items( item_count, nullptr ) {}
-PyTuple::PyTuple( const PyTuple& oth ) : PyRep( PyRep::PyTypeTuple ), items(oth.items)
+PyTuple::PyTuple( size_t item_count ) : PyRep( PyRep::PyTypeTuple ), items( item_count, nullptr ), mEncoded( nullptr ) {}
+PyTuple::PyTuple( const PyTuple& oth ) : PyRep( PyRep::PyTypeTuple ), items(oth.items), mEncoded( nullptr )
 {
     //sLog.Cyan("PyTuple()", "Copy C'tor.");
 }
 
+PyTuple::~PyTuple()
+{
+    PySafeDecRef( mEncoded );
+}
+
 PyRep* PyTuple::Clone() const
 {
     //sLog.Magenta("PyTuple()", "Clone.");
@@ -637,6 +642,7 @@ bool PyTuple::visit( PyVisitor& v ) const
 
 void PyTuple::clear()
 {
+    DropEncoded();
     iterator cur = items.begin(), end = items.end();
     for (; cur != end; ++cur)
         PySafeDecRef( *cur );
@@ -683,6 +689,22 @@ int32 PyTuple::hash() const
     return (uint32)x;
 }
 
+void PyTuple::EncodeOnce() const
+{
+    if (mEncoded != nullptr)
+        return;
+
+    Buffer* buf = new Buffer();
+    if (!MarshalFragment( this, *buf ) ) {
+        sLog.Error( "Marshal", "Failed to marshal tuple %p.", this );
+        SafeDelete( buf );
+        return;
+    }
+
+    // Move ownership of Buffer to PyBuffer
+    mEncoded = new PyBuffer( &buf );
+}
+
 /************************************************************************/
 /* PyRep List Class                                                     */
 /************************************************************************/
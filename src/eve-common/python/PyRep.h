@@ -625,6 +625,7 @@ public:
      */
     void SetItem( size_t index, PyRep* object )
     {
+        DropEncoded();
         PyRep** rep = &items.at( index );
         PySafeDecRef( *rep );
         if (object == nullptr) {
@@ -640,11 +641,27 @@ public:
 
     int32 hash() const;
 
+    /**
+     * @brief Marshals the tuple once and keeps the bytes.
+     *
+     * Marshaling this tuple afterwards, alone or nested in another object,
+     * copies these bytes instead of walking the items again. Meant for
+     * payloads queued to many clients; neither the tuple nor its items may
+     * be modified once encoded.
+     */
+    void EncodeOnce() const;
+    /** @return Marshaled tuple (without stream header) if EncodeOnce() has been called, NULL otherwise. */
+    const PyBuffer* encoded() const                     { return mEncoded; }
+
     // This needs to be public for now.
     std::vector<PyRep*> items;
 
 protected:
-    virtual ~PyTuple()                                  { /* do nothing here */ }
+    virtual ~PyTuple();
+
+    void DropEncoded()                                  { PySafeDecRef( mEncoded ); mEncoded = nullptr; }
+
+    mutable PyBuffer* mEncoded;
 };
 
 /**
@@ -1186,19 +1203,22 @@ public:
         m_dict = new PyDict();
         m_list = new PyList();
         m_tuple = new PyTuple(0);
+
+        // these are shared by every thread, so their refcounts can't be kept
+        m_none->SetImmortal();
+        m_zero->SetImmortal();
+        m_one->SetImmortal();
+        m_negone->SetImmortal();
+        m_true->SetImmortal();
+        m_false->SetImmortal();
+        m_dict->SetImmortal();
+        m_list->SetImmortal();
+        m_tuple->SetImmortal();
     }
 
    ~pyStatic()
    {
-       PyDecRef(m_none);
-       PyDecRef(m_zero);
-       PyDecRef(m_one);
-       PyDecRef(m_negone);
-       PyDecRef(m_true);
-       PyDecRef(m_false);
-       PyDecRef(m_dict);
-       PyDecRef(m_list);
-       PyDecRef(m_tuple);
+       // immortal; they go with the process
     }
 
     PyRep* NewNone()            { PyIncRef(m_none); return m_none; }
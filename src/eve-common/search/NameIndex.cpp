@@ -0,0 +1,316 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "search/NameIndex.h"
+
+void NameIndex::Set(uint8 kind, uint32 id, const std::string& name, uint32 data)
+{
+    if ((id == 0) or (kind > MAX_KIND))
+        return;
+
+    std::vector<uint32>& sorted = m_sorted[kind];
+    std::unordered_map<uint64_t, uint32>::iterator itr = m_slotOf.find(Key(kind, id));
+    if (itr != m_slotOf.end()) {
+        Slot& cur = m_slots[itr->second];
+        std::string folded(Fold(name));
+        cur.entry.name = name;
+        cur.entry.data = data;
+        if (folded == cur.folded)
+            return;     // same name, or only its case changed
+
+        // a rename moves it in the order and changes its trigrams
+        const uint32 slot = itr->second;
+        Unpost(slot);
+        std::vector<uint32>::iterator pos = std::lower_bound(sorted.begin(), sorted.end(), slot,
+                                                             [this](uint32 left, uint32 right) { return Less(left, right); });
+        if ((pos != sorted.end()) and (*pos == slot))
+            sorted.erase(pos);
+        cur.folded.swap(folded);
+        Post(slot);
+        sorted.insert(std::lower_bound(sorted.begin(), sorted.end(), slot,
+                                       [this](uint32 left, uint32 right) { return Less(left, right); }), slot);
+        return;
+    }
+
+    NameIndex::Entry entry;
+    entry.id = id;
+    entry.data = data;
+    entry.kind = kind;
+    entry.name = name;
+    const uint32 slot = Place(entry);
+    Post(slot);
+    sorted.insert(std::lower_bound(sorted.begin(), sorted.end(), slot,
+                                   [this](uint32 left, uint32 right) { return Less(left, right); }), slot);
+}
+
+bool NameIndex::Remove(uint8 kind, uint32 id)
+{
+    if (kind > MAX_KIND)
+        return false;
+    std::unordered_map<uint64_t, uint32>::iterator itr = m_slotOf.find(Key(kind, id));
+    if (itr == m_slotOf.end())
+        return false;
+
+    const uint32 slot = itr->second;
+    std::vector<uint32>& sorted = m_sorted[kind];
+    std::vector<uint32>::iterator pos = std::lower_bound(sorted.begin(), sorted.end(), slot,
+                                                         [this](uint32 left, uint32 right) { return Less(left, right); });
+    if ((pos != sorted.end()) and (*pos == slot))
+        sorted.erase(pos);
+    Unpost(slot);
+
+    m_slots[slot] = Slot();
+    m_free.push_back(slot);
+    m_slotOf.erase(itr);
+    return true;
+}
+
+void NameIndex::Clear()
+{
+    m_slots.clear();
+    m_free.clear();
+    m_slotOf.clear();
+    for (auto& cur : m_sorted)
+        cur.clear();
+    m_grams.clear();
+}
+
+void NameIndex::Load(const std::vector<NameIndex::Entry>& entries)
+{
+    Clear();
+    m_slots.reserve(entries.size());
+    m_slotOf.reserve(entries.size());
+
+    // slots come in ascending, so every posting is an append; each kind is sorted once at the end
+    for (const auto& cur : entries) {
+        if ((cur.id == 0) or (cur.kind > MAX_KIND))
+            continue;
+        if (m_slotOf.find(Key(cur.kind, cur.id)) != m_slotOf.end())
+            continue;
+        const uint32 slot = Place(cur);
+        Post(slot);
+        m_sorted[cur.kind].push_back(slot);
+    }
+
+    for (auto& cur : m_sorted)
+        std::sort(cur.begin(), cur.end(), [this](uint32 left, uint32 right) { return Less(left, right); });
+}
+
+const NameIndex::Entry* NameIndex::Find(uint8 kind, uint32 id) const
+{
+    if (kind > MAX_KIND)
+        return nullptr;
+    std::unordered_map<uint64_t, uint32>::const_iterator itr = m_slotOf.find(Key(kind, id));
+    if (itr == m_slotOf.end())
+        return nullptr;
+    return &m_slots[itr->second].entry;
+}
+
+size_t NameIndex::Search(const std::string& pattern, uint32 kindMask, size_t limit, std::vector<const NameIndex::Entry*>& into) const
+{
+    const std::string folded(Fold(pattern));
+    size_t found(0);
+    for (uint8 kind = 0; kind <= MAX_KIND; ++kind)
+        if (kindMask & (1U << kind))
+            found += SearchKind(kind, folded, limit, into);
+    return found;
+}
+
+size_t NameIndex::Lookup(const std::string& name, uint32 kindMask, std::vector<const NameIndex::Entry*>& into) const
+{
+    const std::string folded(Fold(name));
+    const size_t first(into.size());
+    for (uint8 kind = 0; kind <= MAX_KIND; ++kind) {
+        if (!(kindMask & (1U << kind)))
+            continue;
+        const std::vector<uint32>& sorted = m_sorted[kind];
+        std::vector<uint32>::const_iterator itr = std::lower_bound(sorted.begin(), sorted.end(), folded,
+                                                                   [this](uint32 slot, const std::string& str) { return m_slots[slot].folded < str; });
+        for (; (itr != sorted.end()) and (m_slots[*itr].folded == folded); ++itr)
+            into.push_back(&m_slots[*itr].entry);
+    }
+    return into.size() - first;
+}
+
+size_t NameIndex::SearchKind(uint8 kind, const std::string& pattern, size_t limit, std::vector<const NameIndex::Entry*>& into) const
+{
+    const std::vector<uint32>& sorted = m_sorted[kind];
+    if (sorted.empty() or (limit == 0))
+        return 0;
+
+    // names starting with the text before the first wildcard are together in the order
+    const std::string prefix(pattern.substr(0, pattern.find_first_of("%_")));
+    std::vector<uint32>::const_iterator begin = sorted.begin(), end = sorted.end();
+    if (!prefix.empty()) {
+        begin = std::lower_bound(sorted.begin(), sorted.end(), prefix,
+                                 [this](uint32 slot, const std::string& str) { return m_slots[slot].folded.compare(0, str.size(), str) < 0; });
+        end = std::upper_bound(begin, sorted.end(), prefix,
+                               [this](const std::string& str, uint32 slot) { return m_slots[slot].folded.compare(0, str.size(), str) > 0; });
+    }
+
+    // a trigram (or bigram) the pattern needs may have fewer names than that
+    const Postings* pWalk(nullptr);
+    size_t walkSize(end - begin);
+    for (size_t start = 0; start < pattern.size(); ) {
+        size_t stop = pattern.find_first_of("%_", start);
+        if (stop == std::string::npos)
+            stop = pattern.size();
+        // each trigram of the run, or its bigram if that's all it is
+        const size_t width = std::min<size_t>(stop - start, 3);
+        for (size_t i = start; (width >= 2) and (i + width <= stop); ++i) {
+            PostingMap::const_iterator itr = m_grams.find(width == 3 ? Gram(kind, &pattern[i]) : Bigram(kind, &pattern[i]));
+            if (itr == m_grams.end())
+                return 0;   // no name has it
+            if (itr->second.size() < walkSize) {
+                pWalk = &itr->second;
+                walkSize = pWalk->size();
+            }
+        }
+        start = stop + 1;
+    }
+
+    const size_t first(into.size());
+    if (pWalk == nullptr) {
+        for (; (begin != end) and (into.size() - first < limit); ++begin)
+            if (Like(m_slots[*begin].folded, pattern))
+                into.push_back(&m_slots[*begin].entry);
+        return into.size() - first;
+    }
+
+    // gram lists are in slot order
+    std::vector<uint32> hits;
+    for (Postings::const_iterator itr = pWalk->begin(); (itr != pWalk->end()) and (hits.size() < limit); ++itr)
+        if (Like(m_slots[*itr].folded, pattern))
+            hits.push_back(*itr);
+    std::sort(hits.begin(), hits.end(), [this](uint32 left, uint32 right) { return Less(left, right); });
+    for (uint32 slot : hits)
+        into.push_back(&m_slots[slot].entry);
+    return hits.size();
+}
+
+bool NameIndex::Like(const std::string& name, const std::string& pattern)
+{
+    // on a mismatch, the last '%' seen takes one more character and the rest is tried again
+    size_t n(0), p(0), starP(std::string::npos), starN(0);
+    while (n < name.size()) {
+        if ((p < pattern.size()) and (pattern[p] == '%')) {
+            starP = p++;
+            starN = n;
+        } else if ((p < pattern.size()) and ((pattern[p] == '_') or (pattern[p] == name[n]))) {
+            ++n;
+            ++p;
+        } else if (starP != std::string::npos) {
+            p = starP + 1;
+            n = ++starN;
+        } else {
+            return false;
+        }
+    }
+    while ((p < pattern.size()) and (pattern[p] == '%'))
+        ++p;
+    return (p == pattern.size());
+}
+
+std::string NameIndex::Fold(const std::string& str)
+{
+    std::string folded(str);
+    for (auto& cur : folded)
+        if ((cur >= 'A') and (cur <= 'Z'))
+            cur += 'a' - 'A';
+    return folded;
+}
+
+void NameIndex::Grams(uint8 kind, const std::string& folded, std::vector<uint32>& into)
+{
+    into.clear();
+    for (size_t i = 0; i + 2 <= folded.size(); ++i) {
+        into.push_back(Bigram(kind, &folded[i]));
+        if (i + 3 <= folded.size())
+            into.push_back(Gram(kind, &folded[i]));
+    }
+    std::sort(into.begin(), into.end());
+    into.erase(std::unique(into.begin(), into.end()), into.end());
+}
+
+bool NameIndex::Less(uint32 left, uint32 right) const
+{
+    const int cmp = m_slots[left].folded.compare(m_slots[right].folded);
+    if (cmp != 0)
+        return (cmp < 0);
+    return (left < right);
+}
+
+uint32 NameIndex::Place(const NameIndex::Entry& entry)
+{
+    uint32 slot = (uint32)m_slots.size();
+    if (m_free.empty()) {
+        m_slots.emplace_back();
+    } else {
+        slot = m_free.back();
+        m_free.pop_back();
+    }
+
+    Slot& cur = m_slots[slot];
+    cur.entry = entry;
+    cur.folded = Fold(entry.name);
+    m_slotOf[Key(entry.kind, entry.id)] = slot;
+    return slot;
+}
+
+void NameIndex::Post(uint32 slot)
+{
+    std::vector<uint32> grams;
+    Grams(m_slots[slot].entry.kind, m_slots[slot].folded, grams);
+    for (uint32 gram : grams) {
+        Postings& list = m_grams[gram];
+        // new slots are the highest yet, so this is nearly always an append
+        if (list.empty() or (list.back() < slot)) {
+            list.push_back(slot);
+            continue;
+        }
+        Postings::iterator itr = std::lower_bound(list.begin(), list.end(), slot);
+        if (*itr != slot)
+            list.insert(itr, slot);
+    }
+}
+
+void NameIndex::Unpost(uint32 slot)
+{
+    std::vector<uint32> grams;
+    Grams(m_slots[slot].entry.kind, m_slots[slot].folded, grams);
+    for (uint32 gram : grams) {
+        PostingMap::iterator itr = m_grams.find(gram);
+        if (itr == m_grams.end())
+            continue;
+        Postings& list = itr->second;
+        Postings::iterator pos = std::lower_bound(list.begin(), list.end(), slot);
+        if ((pos != list.end()) and (*pos == slot))
+            list.erase(pos);
+        if (list.empty())
+            m_grams.erase(itr);
+    }
+}
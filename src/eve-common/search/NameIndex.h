@@ -0,0 +1,118 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __SEARCH__NAME_INDEX_H__INCL__
+#define __SEARCH__NAME_INDEX_H__INCL__
+
+/**
+ * @brief Names of things (characters, corporations, systems...) for LIKE-style searches.
+ *
+ * A name belongs to a kind (below 32) and is known by (kind, id).  Each kind
+ * keeps its names in order, ASCII case folded, so a pattern that starts with
+ * text is a binary search for that prefix; and a posting list of names (slots,
+ * ascending) for each trigram and bigram, so one starting with a wildcard
+ * walks the shortest list of a gram it needs.  Every candidate is then checked
+ * against the whole pattern.  Patterns with no two characters in a row
+ * between wildcards walk the whole kind.
+ *
+ * Case folding is ASCII only; other bytes must match exactly.  Not thread-safe.
+ */
+class NameIndex
+{
+public:
+    struct Entry {
+        uint32 id = 0;
+        uint32 data = 0;    // whatever the owner wants back with the name
+        uint8 kind = 0;
+        std::string name;
+    };
+
+    NameIndex()                                         { }
+
+    size_t size() const                                 { return m_slotOf.size(); }
+    bool empty() const                                  { return m_slotOf.empty(); }
+
+    /* adds the name, or renames (and sets 'data' of) the one already there.  id 0 and kinds past 31 are ignored */
+    void Set(uint8 kind, uint32 id, const std::string& name, uint32 data = 0);
+    bool Remove(uint8 kind, uint32 id);
+    void Clear();
+    /* replaces everything with 'entries', faster than Set() for each */
+    void Load(const std::vector<NameIndex::Entry>& entries);
+
+    const NameIndex::Entry* Find(uint8 kind, uint32 id) const;
+
+    /**
+     * Finds the names matching 'pattern', in LIKE syntax ('%' any run of characters, '_' any one).
+     *
+     * @param kindMask - bit (1 << kind) for each kind wanted
+     * @param limit - most matches wanted per kind; past it, which ones are found is unspecified (as with LIMIT)
+     * @param into - matches are appended, each kind's in name order
+     * @return the number of matches appended
+     */
+    size_t Search(const std::string& pattern, uint32 kindMask, size_t limit, std::vector<const NameIndex::Entry*>& into) const;
+
+    /* like Search() for names equal to 'name' (ignoring case), wildcards and all; no limit */
+    size_t Lookup(const std::string& name, uint32 kindMask, std::vector<const NameIndex::Entry*>& into) const;
+
+    /* whether 'name' matches 'pattern'; both already folded */
+    static bool Like(const std::string& name, const std::string& pattern);
+    static std::string Fold(const std::string& str);
+
+    static const uint8 MAX_KIND = 31;
+
+private:
+    struct Slot {
+        NameIndex::Entry entry;
+        std::string folded;
+    };
+
+    typedef std::vector<uint32> Postings;               // slots, ascending
+    typedef std::unordered_map<uint32, Postings> PostingMap;
+
+    static uint64_t Key(uint8 kind, uint32 id)          { return ((uint64_t)kind << 32) | id; }
+    /* kind and three folded characters */
+    static uint32 Gram(uint8 kind, const char* str)     { return ((uint32)kind << 24) | ((uint8)str[0] << 16) | ((uint8)str[1] << 8) | (uint8)str[2]; }
+    /* kind and two; names have no NUL, so these never collide with a trigram */
+    static uint32 Bigram(uint8 kind, const char* str)   { return ((uint32)kind << 24) | ((uint8)str[0] << 8) | (uint8)str[1]; }
+    /* the distinct bigrams and trigrams of 'folded', sorted */
+    static void Grams(uint8 kind, const std::string& folded, std::vector<uint32>& into);
+
+    /* orders a kind's slots by folded name, then slot */
+    bool Less(uint32 left, uint32 right) const;
+    uint32 Place(const NameIndex::Entry& entry);
+    void Post(uint32 slot);
+    void Unpost(uint32 slot);
+
+    size_t SearchKind(uint8 kind, const std::string& pattern, size_t limit, std::vector<const NameIndex::Entry*>& into) const;
+
+    // a free slot has id 0
+    std::vector<Slot> m_slots;
+    std::vector<uint32> m_free;
+    std::unordered_map<uint64_t, uint32> m_slotOf;      // kind|id/slot
+    std::vector<uint32> m_sorted[MAX_KIND + 1];         // slots of each kind, see Less()
+    PostingMap m_grams;
+};
+
+#endif /* !__SEARCH__NAME_INDEX_H__INCL__ */
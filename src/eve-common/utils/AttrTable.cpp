@@ -0,0 +1,224 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "utils/AttrTable.h"
+
+namespace {
+
+/* same value and type; ints and floats go to the client as different objects */
+bool IsSame(EvilNumber a, EvilNumber b)
+{
+    return ((a.get_type() == b.get_type()) and (a == b));
+}
+
+}
+
+AttrTable::const_iterator::const_iterator(const AttrTable* pTable, size_t idx, size_t baseIdx)
+: mTable(pTable),
+mIdx(idx),
+mBaseIdx(baseIdx)
+{
+    Settle();
+}
+
+bool AttrTable::const_iterator::Own() const
+{
+    if (mIdx >= mTable->mIDs.size())
+        return false;
+    if ((mTable->mBase == nullptr) or (mBaseIdx >= mTable->mBase->mIDs.size()))
+        return true;
+    return ((mTable->mIDs[mIdx] & ~ERASED) < mTable->mBase->mIDs[mBaseIdx]);
+}
+
+uint16 AttrTable::const_iterator::Id() const
+{
+    if (Own())
+        return mTable->mIDs[mIdx] & ~ERASED;
+    return mTable->mBase->mIDs[mBaseIdx];
+}
+
+const EvilNumber& AttrTable::const_iterator::Value() const
+{
+    if (Own())
+        return mTable->mValues[mIdx];
+    return mTable->mBase->mValues[mBaseIdx];
+}
+
+void AttrTable::const_iterator::Settle()
+{
+    const size_t ownSize = mTable->mIDs.size();
+    const size_t baseSize = (mTable->mBase == nullptr ? 0 : mTable->mBase->mIDs.size());
+    while (mIdx < ownSize) {
+        const uint16 id = mTable->mIDs[mIdx] & ~ERASED;
+        if (mBaseIdx < baseSize) {
+            const uint16 baseID = mTable->mBase->mIDs[mBaseIdx];
+            if (baseID < id)
+                return;
+            if (baseID == id)
+                ++mBaseIdx;
+        }
+        if ((mTable->mIDs[mIdx] & ERASED) == 0)
+            return;
+        ++mIdx;
+    }
+}
+
+AttrTable::const_iterator& AttrTable::const_iterator::operator++()
+{
+    if (Own()) {
+        ++mIdx;
+    } else {
+        ++mBaseIdx;
+    }
+    Settle();
+    return *this;
+}
+
+size_t AttrTable::Lower(uint16 attrID) const
+{
+    return std::lower_bound(mIDs.begin(), mIDs.end(), attrID,
+                            [](uint16 id, uint16 value) { return ((id & ~ERASED) < value); }) - mIDs.begin();
+}
+
+const EvilNumber* AttrTable::FindInBase(uint16 attrID) const
+{
+    if (mBase == nullptr)
+        return nullptr;
+    const size_t idx = mBase->Lower(attrID);
+    if (mBase->Here(idx, attrID))
+        return &mBase->mValues[idx];
+    return nullptr;
+}
+
+const EvilNumber* AttrTable::Find(uint16 attrID) const
+{
+    const size_t idx = Lower(attrID);
+    if (Here(idx, attrID)) {
+        if (mIDs[idx] & ERASED)
+            return nullptr;
+        return &mValues[idx];
+    }
+    return FindInBase(attrID);
+}
+
+void AttrTable::Set(uint16 attrID, const EvilNumber& value)
+{
+    assert(attrID < ERASED);
+    const size_t idx = Lower(attrID);
+    const bool here = Here(idx, attrID);
+
+    // the base's value needs no entry
+    const EvilNumber* pBase = FindInBase(attrID);
+    if ((pBase != nullptr) and IsSame(*pBase, value)) {
+        if (here) {
+            mIDs.erase(mIDs.begin() + idx);
+            mValues.erase(mValues.begin() + idx);
+        }
+        return;
+    }
+
+    if (here) {
+        mIDs[idx] = attrID;
+        mValues[idx] = value;
+        return;
+    }
+    mIDs.insert(mIDs.begin() + idx, attrID);
+    mValues.insert(mValues.begin() + idx, value);
+}
+
+bool AttrTable::Erase(uint16 attrID)
+{
+    const size_t idx = Lower(attrID);
+    const bool inBase = (FindInBase(attrID) != nullptr);
+    if (Here(idx, attrID)) {
+        if (mIDs[idx] & ERASED)
+            return false;
+        if (inBase) {
+            mIDs[idx] |= ERASED;
+            mValues[idx] = EvilZero;
+        } else {
+            mIDs.erase(mIDs.begin() + idx);
+            mValues.erase(mValues.begin() + idx);
+        }
+        return true;
+    }
+    if (!inBase)
+        return false;
+
+    mIDs.insert(mIDs.begin() + idx, attrID | ERASED);
+    mValues.insert(mValues.begin() + idx, EvilZero);
+    return true;
+}
+
+void AttrTable::Clear()
+{
+    mIDs.clear();
+    mValues.clear();
+}
+
+void AttrTable::Revert()
+{
+    size_t to = 0;
+    for (size_t from = 0; from < mIDs.size(); ++from) {
+        if (FindInBase(mIDs[from] & ~ERASED) != nullptr)
+            continue;
+        mIDs[to] = mIDs[from];
+        mValues[to] = mValues[from];
+        ++to;
+    }
+    mIDs.resize(to);
+    mValues.resize(to);
+}
+
+void AttrTable::Compact()
+{
+    mIDs.shrink_to_fit();
+    mValues.shrink_to_fit();
+}
+
+size_t AttrTable::Count() const
+{
+    size_t count = 0;
+    for (const_iterator itr = begin(), last = end(); itr != last; ++itr)
+        ++count;
+    return count;
+}
+
+size_t AttrTable::MemoryUsed() const
+{
+    return (mIDs.capacity() * sizeof(uint16)) + (mValues.capacity() * sizeof(EvilNumber));
+}
+
+AttrTable::const_iterator AttrTable::begin() const
+{
+    return const_iterator(this, 0, 0);
+}
+
+AttrTable::const_iterator AttrTable::end() const
+{
+    return const_iterator(this, mIDs.size(), (mBase == nullptr ? 0 : mBase->mIDs.size()));
+}
@@ -0,0 +1,117 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __UTILS__ATTR_TABLE_H__INCL__
+#define __UTILS__ATTR_TABLE_H__INCL__
+
+#include "utils/EvilNumber.h"
+
+/**
+ * @brief Attribute values by attributeID, in two sorted arrays.
+ *
+ * An item's table sits over its type's table (the base) and only holds what
+ * differs from it; a value set equal to the base's is dropped again, and
+ * Erase() of a base attribute leaves a marker that hides it.  Lookups are a
+ * binary search of the ids (a few cache lines for a whole type), then one of
+ * the base.  Iterating walks both tables merged, in attributeID order.
+ *
+ * attributeIDs must be below 0x8000; the top bit marks erased ones.
+ * A base is one level deep (its own base isn't looked at), and must not
+ * change or go away while tables use it.  Not thread-safe.
+ */
+class AttrTable
+{
+public:
+    typedef std::pair<uint16, EvilNumber> value_type;
+
+    class const_iterator
+    {
+    public:
+        /* value_type by value; 'second' may be changed, the table won't be */
+        value_type operator*() const                    { return value_type(Id(), Value()); }
+        const_iterator& operator++();
+        bool operator==(const const_iterator& oth) const    { return ((mIdx == oth.mIdx) and (mBaseIdx == oth.mBaseIdx)); }
+        bool operator!=(const const_iterator& oth) const    { return !(*this == oth); }
+
+    private:
+        friend class AttrTable;
+        const_iterator(const AttrTable* pTable, size_t idx, size_t baseIdx);
+
+        /* whether the current entry comes from our own table */
+        bool Own() const;
+        uint16 Id() const;
+        const EvilNumber& Value() const;
+        /* moves past erased entries and base entries we override */
+        void Settle();
+
+        const AttrTable* mTable;
+        size_t mIdx;
+        size_t mBaseIdx;
+    };
+
+    AttrTable()
+    : mBase(nullptr)                                    { }
+
+    void SetBase(const AttrTable* pBase)                { mBase = pBase; }
+    const AttrTable* GetBase() const                    { return mBase; }
+
+    /* @return value of 'attrID', here or in base; nullptr if neither has it (or it's erased) */
+    const EvilNumber* Find(uint16 attrID) const;
+    bool Has(uint16 attrID) const                       { return (Find(attrID) != nullptr); }
+
+    void Set(uint16 attrID, const EvilNumber& value);
+    /* @return true if 'attrID' was there */
+    bool Erase(uint16 attrID);
+    /* drops everything set here, back to base */
+    void Clear();
+    /* drops what is set here for attributes the base has */
+    void Revert();
+    void Compact();
+
+    /* attributes seen thru this table, base included */
+    size_t Count() const;
+    /* entries held here, not counting base */
+    size_t OwnCount() const                             { return mIDs.size(); }
+    /* heap bytes held here, not counting base */
+    size_t MemoryUsed() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    static const uint16 ERASED = 0x8000;
+
+    /* @return position of 'attrID' in mIDs, or where it would go */
+    size_t Lower(uint16 attrID) const;
+    /* whether mIDs[idx] is 'attrID', erased or not */
+    bool Here(size_t idx, uint16 attrID) const          { return ((idx < mIDs.size()) and ((mIDs[idx] & ~ERASED) == attrID)); }
+    const EvilNumber* FindInBase(uint16 attrID) const;
+
+    const AttrTable* mBase;
+    std::vector<uint16> mIDs;           // sorted on id, ERASED bit set for erased base attribs
+    std::vector<EvilNumber> mValues;
+};
+
+#endif /* !__UTILS__ATTR_TABLE_H__INCL__ */
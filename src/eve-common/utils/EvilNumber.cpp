@@ -46,61 +46,51 @@ const EvilNumber EvilTime_Year = EvilTime_Month * 12 + 5;
 EvilNumber::EvilNumber() : mType(evil_number_int)
 {
     iVal = 0;
-    fVal = 0.0;
 }
 
 EvilNumber::EvilNumber( int8 val ) : mType(evil_number_int)
 {
     iVal = val;
-    fVal = 0.0;
 }
 
 EvilNumber::EvilNumber( uint8 val ) : mType(evil_number_int)
 {
     iVal = val;
-    fVal = 0.0;
 }
 
 EvilNumber::EvilNumber( int16 val ) : mType(evil_number_int)
 {
     iVal = val;
-    fVal = 0.0;
 }
 
 EvilNumber::EvilNumber( uint16 val ) : mType(evil_number_int)
 {
     iVal = val;
-    fVal = 0.0;
 }
 
 EvilNumber::EvilNumber( int32 val ) : mType(evil_number_int)
 {
     iVal = val;
-    fVal = 0.0;
 }
 
 EvilNumber::EvilNumber( uint32 val ) : mType(evil_number_int)
 {
     iVal = val;
-    fVal = 0.0;
 }
 
 EvilNumber::EvilNumber( int64 val ) : mType(evil_number_int)
 {
     iVal = val;
-    fVal = 0.0;
 }
 
 EvilNumber::EvilNumber( float val ) : mType(evil_number_float)
 {
     fVal = val;
-    iVal = 0;
 }
 
 EvilNumber::EvilNumber( double val ) : mType(evil_number_float)
 {
     fVal = val;
-    iVal = 0;
 }
 
 
@@ -131,7 +121,6 @@ inline void EvilNumber::CheckIntegrity()
     int64 cmp_val = (int64)fVal;
     if (double(cmp_val) == fVal) {
         iVal = cmp_val;
-        fVal = 0;
         mType = evil_number_int;
     }
 }
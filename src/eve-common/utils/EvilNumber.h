@@ -59,8 +59,11 @@ class PyRep;
 class EvilNumber
 {
 private:
-    double fVal;
-    int64 iVal;
+    // only the one mType names is set.  16 bytes in all, as every item attribute is one of these
+    union {
+        double fVal;
+        int64 iVal;
+    };
     EVIL_NUMBER_TYPE mType;
 
 public:
@@ -30,22 +30,86 @@
 #include "log/LogNew.h"
 #include "log/logsys.h"
 #include "utils/misc.h"
+#include "utils/TimeStats.h"
 #include "utils/utils_time.h"
-//#include "../eve-server/Profiler.h"
 
 #define COLUMN_BOUNDS_CHECKING
 
-// this is to enable profile tracking for db
-#define sProfiler ( Profiler::get() )
+namespace {
 
-class Profiler
-: public Singleton<Profiler>
+/* the query with its values taken out, so every call site gets one key:
+ * "DB: SELECT itemName FROM entity WHERE itemID = ?".  lists of values become one '?' */
+std::string QueryShape(const char* query)
 {
-public:
-    void AddTime(uint8 key, double value);
-};
+    std::string shape("DB: ");
+    char prev(' ');
+    for (const char* p = query; (*p != '\0') and (shape.size() < 100); ) {
+        const char c = *p;
+        bool value(false);
+        if ((c == '\'') or (c == '"')) {
+            for (++p; (*p != '\0') and (*p != c); ++p)
+                if ((*p == '\\') and (p[1] != '\0'))
+                    ++p;
+            if (*p != '\0')
+                ++p;
+            value = true;
+        } else if (isdigit(c) and !isalnum(prev) and (prev != '_') and (prev != '.')) {
+            while (isalnum(*p) or (*p == '.'))
+                ++p;
+            value = true;
+        } else if (isspace(c)) {
+            while (isspace(*p))
+                ++p;
+            if (prev != ' ')
+                shape += ' ';
+            prev = ' ';
+            continue;
+        } else {
+            shape += c;
+            prev = c;
+            ++p;
+            continue;
+        }
+
+        if (value) {
+            // "?, ?" -> "?"
+            size_t end = shape.find_last_not_of(", ");
+            if ((end != std::string::npos) and (shape[end] == '?') and (end + 1 < shape.size()) and (shape.find(',', end) != std::string::npos)) {
+                shape.resize(end + 1);
+            } else {
+                shape += '?';
+            }
+            prev = '?';
+        }
+    }
+    return shape;
+}
+
+/* adds a query's time to "DB" and to the key of its call site */
+void ProfileQuery(const char* query, double profileStartTime)
+{
+    if (!TimeStats::IsEnabled())
+        return;
+
+    static TimeStatsKey dbKey("DB");
+    // shapes are looked up once per thread, not on every query
+    static thread_local std::unordered_map<std::string, uint32> siteKeys;
+
+    const double time(GetTimeUSeconds() - profileStartTime);
+    const std::string shape(QueryShape(query));
+    auto itr = siteKeys.find(shape);
+    if (itr == siteKeys.end())
+        itr = siteKeys.emplace(shape, sTimeStats.GetKey(shape)).first;
+
+    sTimeStats.Record(dbKey.Get(), time);
+    sTimeStats.Record(itr->second, time);
+}
+
+}
 
 
+thread_local DBcore::ThreadConnection* DBcore::mThreadConn(nullptr);
+
 DBcore::DBcore()
 : mysql(nullptr),
 pSocket(false),
@@ -54,7 +118,8 @@ pReconnect(false),
 pProfile(false),
 pCompress(false),
 pSSL(false),
-pPort(3306)
+pPort(3306),
+mNextReader(0)
 {
     mysql_thread_init();    // this is for each thread used for db connections
     mysql = mysql_init(nullptr);
@@ -86,12 +151,7 @@ void DBcore::Connect(uint* errnum, char* errbuf)
             sLog.Error("        DB Server", " TCP Connection Option Failed");
     }
 
-    int32 flags = CLIENT_FOUND_ROWS; //2
-    if (pCompress)
-        flags |= CLIENT_COMPRESS; //32
-    // sql-ssl  needs more info/settings to properly use....however, not needed when using socket under linux
-    if (pSSL and !pSocket)
-        flags |= CLIENT_SSL;
+    int32 flags = GetConnectFlags();
     sLog.Cyan("    Connect Flags", " %x", flags);
     /*
      *    unsigned int conn_timeout = 2;
@@ -137,6 +197,17 @@ void DBcore::Connect(uint* errnum, char* errbuf)
         sLog.Cyan(" DataBase Manager", "DataBase Character set: %s", mysql_character_set_name(mysql));
 }
 
+int32 DBcore::GetConnectFlags()
+{
+    int32 flags = CLIENT_FOUND_ROWS; //2
+    if (pCompress)
+        flags |= CLIENT_COMPRESS; //32
+    // sql-ssl  needs more info/settings to properly use....however, not needed when using socket under linux
+    if (pSSL and !pSocket)
+        flags |= CLIENT_SSL;
+    return flags;
+}
+
 bool DBcore::Reconnect()
 {
     _log(DATABASE__MESSAGE, "DBCore attempting to recover...");
@@ -193,6 +264,7 @@ void DBcore::Initialize(std::string host, std::string user, std::string password
 }
 
 void DBcore::Close() {
+    CloseStatements_locked();
     pStatus = Closed;
     mysql_close(mysql);
     mysql_server_end();
@@ -223,7 +295,7 @@ void DBcore::ping()
 
 //query which returns a result (error is stored in the result if it occurs)
 bool DBcore::RunQuery(DBQueryResult &into, const char *query_fmt, ...) {
-    MutexLock lock(MDatabase);
+    MutexLock lock(MDatabase, (mThreadConn == nullptr));
 
     char query[4096];
     va_list vlist;
@@ -234,7 +306,7 @@ bool DBcore::RunQuery(DBQueryResult &into, const char *query_fmt, ...) {
     if (!DoQuery_locked(into.error, query, querylen))
         return false;
 
-    uint col_count = mysql_field_count(mysql);
+    uint col_count = mysql_field_count(Conn());
     if (col_count == 0) {
         into.error.SetError(0xFFFF, "DBcore::RunQuery: No Result");
         codelog(DATABASE__ERROR, "DBCore::RunQuery: %s failed because it did not return a result", query);
@@ -242,14 +314,14 @@ bool DBcore::RunQuery(DBQueryResult &into, const char *query_fmt, ...) {
         return false;
     }
 
-    into.SetResult(mysql_store_result(mysql), col_count);
+    into.SetResult(mysql_store_result(Conn()), col_count);
 
     return true;
 }
 
 //query which returns only error status
 bool DBcore::RunQuery(DBerror &err, const char *query_fmt, ...) {
-    MutexLock lock(MDatabase);
+    MutexLock lock(MDatabase, (mThreadConn == nullptr));
 
     va_list args;
     va_start(args, query_fmt);
@@ -268,7 +340,7 @@ bool DBcore::RunQuery(DBerror &err, const char *query_fmt, ...) {
 
 //query which returns affected rows:  (not used)
 bool DBcore::RunQuery(DBerror &err, uint32 &affected_rows, const char *query_fmt, ...) {
-    MutexLock lock(MDatabase);
+    MutexLock lock(MDatabase, (mThreadConn == nullptr));
 
     va_list args;
     va_start(args, query_fmt);
@@ -282,14 +354,14 @@ bool DBcore::RunQuery(DBerror &err, uint32 &affected_rows, const char *query_fmt
     }
     free(query);
 
-    affected_rows = (uint32)mysql_affected_rows(mysql);
+    affected_rows = (uint32)mysql_affected_rows(Conn());
 
     return true;
 }
 
 //query which returns last insert ID:
 bool DBcore::RunQueryLID(DBerror &err, uint32 &last_insert_id, const char *query_fmt, ...) {
-    MutexLock lock(MDatabase);
+    MutexLock lock(MDatabase, (mThreadConn == nullptr));
 
     va_list args;
     va_start(args, query_fmt);
@@ -303,7 +375,7 @@ bool DBcore::RunQueryLID(DBerror &err, uint32 &last_insert_id, const char *query
     }
     free(query);
 
-    last_insert_id = (uint32)mysql_insert_id(mysql);
+    last_insert_id = (uint32)mysql_insert_id(Conn());
 
     return true;
 }
@@ -312,6 +384,21 @@ bool DBcore::DoQuery_locked(DBerror &err, const char *query, int querylen, bool
 {
     double profileStartTime = GetTimeUSeconds();
 
+    if (mThreadConn != nullptr) {
+        // no recovery on a thread connection; its owner sees the error and gives up
+        if (is_log_enabled(DATABASE__QUERIES))
+            _log(DATABASE__QUERIES, "DBcore Thread Query - %s", query);
+        if (mysql_real_query(mThreadConn->mysql, query, querylen)) {
+            err.SetError(mysql_errno(mThreadConn->mysql), mysql_error(mThreadConn->mysql));
+            codelog(DATABASE__ERROR, "DBCore Thread Query - #%u in '%s': %s", err.GetErrNo(), query, err.c_str());
+            return false;
+        }
+        err.ClearError();
+        if (pProfile)
+            ProfileQuery(query, profileStartTime);
+        return true;
+    }
+
     if (mysql == nullptr) {
         pStatus = Error;
         codelog(DATABASE__ERROR, "DBCore - mysql = null");
@@ -352,15 +439,504 @@ bool DBcore::DoQuery_locked(DBerror &err, const char *query, int querylen, bool
     err.ClearError();
 
     if (pProfile)
-        sProfiler.AddTime(9, GetTimeUSeconds() - profileStartTime);
+        ProfileQuery(query, profileStartTime);
+
+    return true;
+}
+
+
+/************************************************************************/
+/* async query pool                                                     */
+/************************************************************************/
+// opens another connection with the settings of the main one
+MYSQL* DBcore::OpenPoolConnection()
+{
+    MYSQL* conn = mysql_init(nullptr);
+    if (conn == nullptr)
+        return nullptr;
 
+    enum mysql_protocol_type prot_type = (pSocket ? MYSQL_PROTOCOL_SOCKET : MYSQL_PROTOCOL_TCP);
+    mysql_options(conn, MYSQL_OPT_PROTOCOL, (void*)&prot_type);
+    if (pReconnect) {
+        my_bool reconnect = true;
+        mysql_options(conn, MYSQL_OPT_RECONNECT, (void*)&reconnect);
+    }
+
+    if (mysql_real_connect(conn, pHost.c_str(), pUser.c_str(), pPassword.c_str(), pDatabase.c_str(), pPort, 0, GetConnectFlags()) == nullptr) {
+        _log(DATABASE__ERROR, "DBCore pool connection failed - #%u: %s", mysql_errno(conn), mysql_error(conn));
+        mysql_close(conn);
+        return nullptr;
+    }
+
+    mysql_set_character_set(conn, "utf8");
+    return conn;
+}
+
+bool DBcore::OpenThreadConnection()
+{
+    if (mThreadConn != nullptr)
+        return true;
+
+    mysql_thread_init();
+    MYSQL* conn = OpenPoolConnection();
+    if (conn == nullptr) {
+        mysql_thread_end();
+        return false;
+    }
+
+    mThreadConn = new ThreadConnection();
+    mThreadConn->mysql = conn;
     return true;
 }
 
+void DBcore::CloseThreadConnection()
+{
+    if (mThreadConn == nullptr)
+        return;
+
+    for (auto cur : mThreadConn->statements)
+        mysql_stmt_close(cur.second);
+    mysql_close(mThreadConn->mysql);
+    SafeDelete(mThreadConn);
+    mysql_thread_end();
+}
+
+void DBcore::StartPool(uint8 size)
+{
+    if ((pStatus != Connected) or !mPool.empty())
+        return;
+
+    for (uint8 i = 0; i < size; ++i) {
+        MYSQL* conn = OpenPoolConnection();
+        if (conn == nullptr)
+            break;
+        PoolConnection* pc = new PoolConnection();
+            pc->mysql = conn;
+            pc->running = true;
+            pc->thread = new std::thread(&DBcore::PoolThread, this, pc);
+        mPool.push_back(pc);
+    }
+
+    if (mPool.size() < size)
+        sLog.Error(" DataBase Manager", "Opened %u of %u pool connections", (uint32)mPool.size(), size);
+    else
+        sLog.Blue(" DataBase Manager", "Opened %u pool connections for async queries", (uint32)mPool.size());
+}
+
+void DBcore::StopPool()
+{
+    // the threads drain their queues before they exit
+    for (auto cur : mPool) {
+        {
+            std::lock_guard<std::mutex> lock(cur->lock);
+            cur->running = false;
+        }
+        cur->cond.notify_one();
+    }
+    for (auto cur : mPool) {
+        cur->thread->join();
+        SafeDelete(cur->thread);
+        mysql_close(cur->mysql);
+        SafeDelete(cur);
+    }
+    mPool.clear();
+
+    // nobody is left to run these
+    std::lock_guard<std::mutex> lock(mCompletedLock);
+    for (auto cur : mCompleted)
+        SafeDelete(cur);
+    mCompleted.clear();
+}
+
+size_t DBcore::GetPendingCount()
+{
+    size_t count(0);
+    for (auto cur : mPool) {
+        std::lock_guard<std::mutex> lock(cur->lock);
+        count += cur->jobs.size();
+    }
+    return count;
+}
+
+void DBcore::RunQueryAsync(const char* query_fmt, ...)
+{
+    PoolJob* job = new PoolJob();
+
+    va_list args;
+    va_start(args, query_fmt);
+    char* query(nullptr);
+    int querylen = vasprintf(&query, query_fmt, args);
+    va_end(args);
+
+    job->query.assign(query, querylen);
+    free(query);
+
+    QueueJob(job);
+}
+
+void DBcore::RunQueryAsync(DBQueryCallback callback, const char* query_fmt, ...)
+{
+    PoolJob* job = new PoolJob();
+    job->callback = callback;
+
+    va_list args;
+    va_start(args, query_fmt);
+    char* query(nullptr);
+    int querylen = vasprintf(&query, query_fmt, args);
+    va_end(args);
+
+    job->query.assign(query, querylen);
+    free(query);
+
+    QueueJob(job);
+}
+
+void DBcore::RunWriteAsync(DBQueryCallback callback, const char* query_fmt, ...)
+{
+    PoolJob* job = new PoolJob();
+    job->callback = callback;
+    job->write = true;
+
+    va_list args;
+    va_start(args, query_fmt);
+    char* query(nullptr);
+    int querylen = vasprintf(&query, query_fmt, args);
+    va_end(args);
+
+    job->query.assign(query, querylen);
+    free(query);
+
+    QueueJob(job);
+}
+
+void DBcore::QueueJob(PoolJob* job)
+{
+    if (mPool.empty()) {
+        // no pool; run it here.
+        MutexLock lock(MDatabase, (mThreadConn == nullptr));
+        if (DoQuery_locked(job->result.error, job->query.c_str(), (int)job->query.size())) {
+            uint col_count = mysql_field_count(Conn());
+            if (col_count > 0)
+                job->result.SetResult(mysql_store_result(Conn()), col_count);
+        }
+        if (job->callback) {
+            std::lock_guard<std::mutex> cLock(mCompletedLock);
+            mCompleted.push_back(job);
+        } else {
+            SafeDelete(job);
+        }
+        return;
+    }
+
+    PoolConnection* conn = mPool[0];
+    if (job->callback and !job->write and (mPool.size() > 1)) {
+        conn = mPool[1 + mNextReader];
+        mNextReader = (mNextReader + 1) % (mPool.size() - 1);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(conn->lock);
+        conn->jobs.push_back(job);
+    }
+    conn->cond.notify_one();
+}
+
+void DBcore::PoolThread(PoolConnection* conn)
+{
+    mysql_thread_init();    // this is for each thread used for db connections
+
+    std::unique_lock<std::mutex> lock(conn->lock);
+    while (true) {
+        conn->cond.wait(lock, [conn] { return !conn->running or !conn->jobs.empty(); });
+        if (conn->jobs.empty())
+            break;  // stopped and drained
+
+        PoolJob* job = conn->jobs.front();
+        conn->jobs.pop_front();
+        lock.unlock();
+
+        DoPoolQuery(conn, job);
+        if (job->callback) {
+            std::lock_guard<std::mutex> cLock(mCompletedLock);
+            mCompleted.push_back(job);
+        } else {
+            SafeDelete(job);
+        }
+
+        lock.lock();
+    }
+
+    mysql_thread_end();
+}
+
+bool DBcore::DoPoolQuery(PoolConnection* conn, PoolJob* job)
+{
+    if (is_log_enabled(DATABASE__QUERIES))
+        _log(DATABASE__QUERIES, "DBcore Async Query - %s", job->query.c_str());
+
+    double profileStartTime = GetTimeUSeconds();
+    DBerror& err = job->result.error;
+    // one retry on a fresh connection if the server went away
+    for (uint8 attempt = 0; attempt < 2; ++attempt) {
+        if (conn->mysql == nullptr)
+            conn->mysql = OpenPoolConnection();
+        if (conn->mysql == nullptr) {
+            err.SetError(CR_SERVER_LOST, "DBcore: pool connection lost");
+            break;
+        }
+
+        if (mysql_real_query(conn->mysql, job->query.c_str(), job->query.size()) == 0) {
+            err.ClearError();
+            uint col_count = mysql_field_count(conn->mysql);
+            if (col_count > 0)
+                job->result.SetResult(mysql_store_result(conn->mysql), col_count);
+            if (pProfile)
+                ProfileQuery(job->query.c_str(), profileStartTime);
+            return true;
+        }
+
+        uint num = mysql_errno(conn->mysql);
+        err.SetError(num, mysql_error(conn->mysql));
+        if ((num != CR_SERVER_LOST) and (num != CR_SERVER_GONE_ERROR))
+            break;
+
+        _log(DATABASE__ERROR, "DBCore error - pool connection lost.");
+        mysql_close(conn->mysql);
+        conn->mysql = nullptr;
+    }
+
+    codelog(DATABASE__ERROR, "DBCore Async Query - #%u in '%s': %s", err.GetErrNo(), job->query.c_str(), err.c_str());
+    return false;
+}
+
+void DBcore::ProcessCompletions()
+{
+    std::vector<PoolJob*> done;
+    {
+        std::lock_guard<std::mutex> lock(mCompletedLock);
+        if (mCompleted.empty())
+            return;
+        done.swap(mCompleted);
+    }
+
+    for (auto cur : done) {
+        cur->callback(cur->result);
+        SafeDelete(cur);
+    }
+}
+
+/************************************************************************/
+/* prepared statements                                                  */
+/************************************************************************/
+void DBParam::Bind( MYSQL_BIND& bind ) const
+{
+    bind.buffer_type = mType;
+    bind.is_unsigned = mUnsigned;
+    if (mType == MYSQL_TYPE_STRING) {
+        bind.buffer = (void*)mText;
+        bind.buffer_length = mLength;
+        bind.length = (ulong*)&mLength;
+    } else {
+        bind.buffer = (void*)&mInt;
+    }
+}
+
+MYSQL_STMT* DBcore::GetStatement_locked(DBerror &err, const char *query)
+{
+    std::unordered_map<std::string, MYSQL_STMT*>& statements = (mThreadConn != nullptr ? mThreadConn->statements : mStatements);
+    std::unordered_map<std::string, MYSQL_STMT*>::iterator itr = statements.find(query);
+    if (itr != statements.end())
+        return itr->second;
+
+    MYSQL_STMT* stmt = mysql_stmt_init(Conn());
+    if (stmt == nullptr) {
+        err.SetError(mysql_errno(Conn()), mysql_error(Conn()));
+        return nullptr;
+    }
+    if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0) {
+        err.SetError(mysql_stmt_errno(stmt), mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+    // lets FetchPrepared() size text buffers for the longest value
+    my_bool updateMax = true;
+    mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, (void*)&updateMax);
+
+    statements[query] = stmt;
+    return stmt;
+}
+
+void DBcore::CloseStatements_locked()
+{
+    // statements die with their connection
+    for (auto cur : mStatements)
+        mysql_stmt_close(cur.second);
+    mStatements.clear();
+}
+
+bool DBcore::DoPrepared(DBPreparedResult* into, DBerror& err, const char* query, const DBParam* params, size_t count)
+{
+    MutexLock lock(MDatabase, (mThreadConn == nullptr));
+
+    double profileStartTime = GetTimeUSeconds();
+
+    if (is_log_enabled(DATABASE__QUERIES))
+        _log(DATABASE__QUERIES, "DBcore Prepared - %s", query);
+
+    if (into != nullptr)
+        into->Clear();
+
+    std::vector<MYSQL_BIND> binds(count);
+    memset(binds.data(), 0, count * sizeof(MYSQL_BIND));
+    for (size_t i = 0; i < count; ++i)
+        params[i].Bind(binds[i]);
+
+    // one retry if the server went away
+    for (uint8 attempt = 0; attempt < 2; ++attempt) {
+        if ((mThreadConn == nullptr) and (pStatus != Connected)) {
+            _log(DATABASE__MESSAGE, "DBCore error detected.  Look for error msgs in logs prior to this point.");
+            if (!Reconnect()) {
+                err.SetError(CR_SERVER_LOST, "DBcore: not connected");
+                return false;
+            }
+        }
+
+        MYSQL_STMT* stmt = GetStatement_locked(err, query);
+        if (stmt != nullptr) {
+            if (mysql_stmt_param_count(stmt) != count) {
+                err.SetError(0xFFFF, "DBcore::RunPrepared: Wrong number of arguments");
+                codelog(DATABASE__ERROR, "DBCore Prepared - '%s' takes %lu arguments, %lu given", query, mysql_stmt_param_count(stmt), count);
+                return false;
+            }
+            if ((mysql_stmt_bind_param(stmt, binds.data()) == 0) and (mysql_stmt_execute(stmt) == 0)) {
+                err.ClearError();
+                if ((into != nullptr) and !FetchPrepared(stmt, *into)) {
+                    err.SetError(mysql_stmt_errno(stmt), mysql_stmt_error(stmt));
+                    codelog(DATABASE__ERROR, "DBCore Prepared - #%u fetching '%s': %s", err.GetErrNo(), query, err.c_str());
+                    return false;
+                }
+                if (pProfile)
+                    ProfileQuery(query, profileStartTime);
+                return true;
+            }
+            err.SetError(mysql_stmt_errno(stmt), mysql_stmt_error(stmt));
+        }
+
+        if ((mThreadConn != nullptr) or ((err.GetErrNo() != CR_SERVER_LOST) and (err.GetErrNo() != CR_SERVER_GONE_ERROR)))
+            break;
+        _log(DATABASE__ERROR, "DBCore error - server lost or gone.");
+        pStatus = Error;
+    }
+
+    codelog(DATABASE__ERROR, "DBCore Prepared - #%u in '%s': %s", err.GetErrNo(), query, err.c_str());
+    return false;
+}
+
+bool DBcore::FetchPrepared(MYSQL_STMT* stmt, DBPreparedResult& into)
+{
+    MYSQL_RES* meta = mysql_stmt_result_metadata(stmt);
+    if (meta == nullptr)
+        return true;    // no result set
+
+    if (mysql_stmt_store_result(stmt) != 0) {
+        mysql_free_result(meta);
+        return false;
+    }
+
+    const uint32 cols = mysql_num_fields(meta);
+    const MYSQL_FIELD* fields = mysql_fetch_fields(meta);
+    into.mColumnCount = cols;
+    into.mKinds.resize(cols);
+
+    std::vector<MYSQL_BIND> binds(cols);
+    memset(binds.data(), 0, cols * sizeof(MYSQL_BIND));
+    std::vector<DBPreparedResult::Value> row(cols);
+    std::vector<ulong> lengths(cols, 0);
+    std::vector<my_bool> nulls(cols, 0);
+    std::vector<std::string> text(cols);
+    for (uint32 i = 0; i < cols; ++i) {
+        MYSQL_BIND& bind = binds[i];
+        bind.length = &lengths[i];
+        bind.is_null = &nulls[i];
+        switch (fields[i].type) {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONGLONG:
+            case MYSQL_TYPE_YEAR:
+                into.mKinds[i] = DBPreparedResult::Integer;
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.buffer = &row[i].i;
+                bind.is_unsigned = ((fields[i].flags & UNSIGNED_FLAG) != 0);
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+            case MYSQL_TYPE_DECIMAL:
+            case MYSQL_TYPE_NEWDECIMAL:
+                into.mKinds[i] = DBPreparedResult::Real;
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &row[i].d;
+                break;
+            default:
+                // strings, blobs, dates and bits come as bytes
+                into.mKinds[i] = (fields[i].type == MYSQL_TYPE_BIT ? DBPreparedResult::Integer : DBPreparedResult::Text);
+                text[i].resize(fields[i].max_length + 1);
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer = &text[i][0];
+                bind.buffer_length = text[i].size();
+                break;
+        }
+    }
+
+    bool ok = (mysql_stmt_bind_result(stmt, binds.data()) == 0);
+    if (ok) {
+        into.mValues.reserve((size_t)mysql_stmt_num_rows(stmt) * cols);
+        int status(0);
+        while (((status = mysql_stmt_fetch(stmt)) == 0) or (status == MYSQL_DATA_TRUNCATED)) {
+            for (uint32 i = 0; i < cols; ++i) {
+                DBPreparedResult::Value value = row[i];
+                value.null = (nulls[i] != 0);
+                value.offset = 0;
+                value.length = 0;
+                if (value.null or text[i].empty()) {
+                    // numeric values are already in place
+                } else if (fields[i].type == MYSQL_TYPE_BIT) {
+                    // big endian bits; read them as a number
+                    value.i = 0;
+                    for (ulong b = 0; (b < lengths[i]) and (b < text[i].size()); ++b)
+                        value.i = (value.i << 8) | (uint8)text[i][b];
+                } else {
+                    value.offset = (uint32)into.mText.size();
+                    value.length = (uint32)lengths[i];
+                    if (lengths[i] >= text[i].size()) {
+                        // longer than max_length said; fetch this one again in full
+                        std::string full(lengths[i], '\0');
+                        MYSQL_BIND col = binds[i];
+                        col.buffer = &full[0];
+                        col.buffer_length = full.size();
+                        mysql_stmt_fetch_column(stmt, &col, i, 0);
+                        into.mText.append(full);
+                    } else {
+                        into.mText.append(text[i].data(), lengths[i]);
+                    }
+                    into.mText.push_back('\0');
+                }
+                into.mValues.push_back(value);
+            }
+            ++into.mRowCount;
+        }
+        ok = (status == MYSQL_NO_DATA);
+    }
+
+    mysql_free_result(meta);
+    mysql_stmt_free_result(stmt);
+    return ok;
+}
 
 int32 DBcore::DoEscapeString(char* tobuf, const char* frombuf, int32 fromlen)
 {
-    return mysql_real_escape_string(mysql, tobuf, frombuf, fromlen);
+    return mysql_real_escape_string(Conn(), tobuf, frombuf, fromlen);
 }
 
 void DBcore::DoEscapeString(std::string &to, const std::string &from)
@@ -368,7 +944,7 @@ void DBcore::DoEscapeString(std::string &to, const std::string &from)
     assert(mysql);
     uint32 len = (uint32)from.length();
     to.resize(len * 2);   // make enough room
-    uint32 esc_len = mysql_real_escape_string(mysql, &to[0], from.c_str(), len);
+    uint32 esc_len = mysql_real_escape_string(Conn(), &to[0], from.c_str(), len);
     to.resize(esc_len + 1); // optional.
 }
 
@@ -703,3 +1279,96 @@ double DBResultRow::GetDouble( uint32 index ) const
 
     return strtod( mRow[index], nullptr );
 }
+
+/************************************************************************/
+/* DBPreparedResult                                                     */
+/************************************************************************/
+DBPreparedResult::DBPreparedResult()
+: mColumnCount(0),
+mRowCount(0),
+mRowIndex(0)
+{
+}
+
+void DBPreparedResult::Clear()
+{
+    mColumnCount = 0;
+    mRowCount = 0;
+    mRowIndex = 0;
+    mKinds.clear();
+    mValues.clear();
+    mText.clear();
+}
+
+bool DBPreparedResult::GetRow( DBPreparedRow& into )
+{
+    if (mRowIndex >= mRowCount)
+        return false;
+
+    into.mResult = this;
+    into.mValues = &mValues[ mRowIndex * mColumnCount ];
+    ++mRowIndex;
+    return true;
+}
+
+const char* DBPreparedRow::GetText( uint32 index ) const
+{
+    if (index >= mResult->ColumnCount()) {
+        _log(DATABASE__ERROR,  "   DBCore::GetText: Column index %u exceeds number of columns in row (%u)", index, mResult->ColumnCount() );
+        EvE::traceStack();
+        return "";
+    }
+    if (mValues[ index ].null)
+        return nullptr;
+    if (mResult->mKinds[ index ] != DBPreparedResult::Text) {
+        _log(DATABASE__ERROR,  "   DBCore::GetText: Column %u is numeric", index );
+        EvE::traceStack();
+        return "";
+    }
+
+    return &mResult->mText[ mValues[ index ].offset ];
+}
+
+int64 DBPreparedRow::GetInt64( uint32 index ) const
+{
+    if (index >= mResult->ColumnCount()) {
+        _log(DATABASE__ERROR,  "   DBCore::GetInt64: Column index %u exceeds number of columns in row (%u)", index, mResult->ColumnCount() );
+        EvE::traceStack();
+        return 0;
+    }
+
+    const DBPreparedResult::Value& value = mValues[ index ];
+    if (value.null)
+        return 0;
+    switch (mResult->mKinds[ index ]) {
+        case DBPreparedResult::Integer:
+            return value.i;
+        case DBPreparedResult::Real:
+            return (int64)value.d;
+        default:
+            break;
+    }
+    return strtoll( &mResult->mText[ value.offset ], nullptr, 0 );
+}
+
+double DBPreparedRow::GetDouble( uint32 index ) const
+{
+    if (index >= mResult->ColumnCount()) {
+        _log(DATABASE__ERROR,  "   DBCore::GetDouble: Column index %u exceeds number of columns in row (%u)", index, mResult->ColumnCount() );
+        EvE::traceStack();
+        return 0.0;
+    }
+
+    const DBPreparedResult::Value& value = mValues[ index ];
+    if (value.null)
+        return 0.0;
+    switch (mResult->mKinds[ index ]) {
+        case DBPreparedResult::Integer:
+            return (double)value.i;
+        case DBPreparedResult::Real:
+            return value.d;
+        default:
+            break;
+    }
+    return strtod( &mResult->mText[ value.offset ], nullptr );
+}
@@ -26,6 +26,11 @@
 #ifndef __DATABASE__DBCORE_H__INCL__
 #define __DATABASE__DBCORE_H__INCL__
 
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
+
 // MySQL headers
 #include <mysql.h>
 #include <mysqld_error.h>
@@ -134,6 +139,119 @@ protected:
     DBQueryResult* mResult;
 };
 
+/**
+ * @brief Argument of a prepared statement, see DBcore::RunPrepared().
+ *
+ * Integers, floating point numbers and strings are bound as they are;
+ * enums have to be cast to an integer first. Strings are not copied.
+ */
+class DBParam
+{
+public:
+    template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    DBParam( T value ) : mType( MYSQL_TYPE_LONGLONG ), mUnsigned( std::is_unsigned<T>::value ), mInt( (int64)value ), mText( nullptr ), mLength( 0 ) {}
+    template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    DBParam( T value ) : mType( MYSQL_TYPE_DOUBLE ), mUnsigned( false ), mDouble( (double)value ), mText( nullptr ), mLength( 0 ) {}
+    DBParam( const char* value ) : mType( MYSQL_TYPE_STRING ), mUnsigned( false ), mInt( 0 ), mText( value ), mLength( strlen( value ) ) {}
+    DBParam( const std::string& value ) : mType( MYSQL_TYPE_STRING ), mUnsigned( false ), mInt( 0 ), mText( value.c_str() ), mLength( value.size() ) {}
+
+    // points bind at this parameter's value
+    void Bind( MYSQL_BIND& bind ) const;
+
+protected:
+    enum_field_types mType;
+    bool mUnsigned;
+    union {
+        int64 mInt;
+        double mDouble;
+    };
+    const char* mText;
+    ulong mLength;
+};
+
+class DBPreparedRow;
+/**
+ * @brief Binary result of a prepared statement.
+ *
+ * All rows are fetched when the statement runs, so the result does not
+ * depend on the (cached) statement afterwards.
+ */
+class DBPreparedResult
+{
+public:
+    DBPreparedResult();
+
+    /* error during the query, if RunPrepared returned false. */
+    DBerror error;
+
+    bool GetRow( DBPreparedRow& into );
+    size_t GetRowCount() const { return mRowCount; }
+    // rewinds to the first row
+    void Reset() { mRowIndex = 0; }
+
+    uint32 ColumnCount() const { return mColumnCount; }
+
+protected:
+    //for DBcore and DBPreparedRow:
+    friend class DBcore;
+    friend class DBPreparedRow;
+
+    enum ColumnKind : uint8 { Integer, Real, Text };
+    struct Value {
+        union {
+            int64 i;
+            double d;
+        };
+        uint32 offset;  // Text: into mText
+        uint32 length;  // Text: without terminating zero
+        bool null;
+    };
+
+    void Clear();
+
+    uint32 mColumnCount;
+    size_t mRowCount;
+    size_t mRowIndex;
+    std::vector<ColumnKind> mKinds;
+    std::vector<Value> mValues;     // mRowCount * mColumnCount, row by row
+    std::string mText;              // zero terminated text values
+};
+
+/**
+ * @brief Row of a DBPreparedResult; same accessors as DBResultRow.
+ *
+ * Numeric columns are read without parsing. GetText() works on text
+ * columns only, numeric getters convert text columns.
+ */
+class DBPreparedRow
+{
+public:
+    DBPreparedRow() : mResult( nullptr ), mValues( nullptr ) { }
+
+    bool IsNull( uint32 index ) const { return mValues[ index ].null; }
+
+    const char* GetText( uint32 index ) const;
+    int32 GetInt( uint32 index ) const { return (int32)GetInt64( index ); }
+    bool GetBool( uint32 index ) const { return ( GetInt64( index ) != 0 ); }
+    uint32 GetUInt( uint32 index ) const { return (uint32)GetInt64( index ); }
+    int64 GetInt64( uint32 index ) const;
+    float GetFloat( uint32 index ) const { return (float)GetDouble( index ); }
+    double GetDouble( uint32 index ) const;
+
+    uint32 ColumnCount() const { return mResult->ColumnCount(); }
+    uint32 ColumnLength( uint32 index ) const { return mValues[ index ].length; }
+
+protected:
+    //for DBPreparedResult
+    friend class DBPreparedResult;
+
+    const DBPreparedResult* mResult;
+    const DBPreparedResult::Value* mValues;
+};
+
+// run on the main thread with the result of a RunQueryAsync() query
+typedef std::function<void(DBQueryResult& res)> DBQueryCallback;
+
 class DBcore
 : public Singleton<DBcore>
 {
@@ -161,6 +279,49 @@ public:
     // NOTE:  result is cleared before populating with most recent data for multiple statements using same DBQueryResult object.
     bool    RunQueryLID(DBerror& err, uint32& last_insert_id, const char* query_fmt, ...);
 
+    /* prepared statements: '?' placeholders in query are bound to args in order, without formatting or escaping.
+     * statements are prepared once per connection and cached by query text, so query should be a constant. */
+    //statement which returns a result (error is stored in the result if it occurs)
+    template<typename... Args>
+    bool    RunPrepared(DBPreparedResult& into, const char* query, const Args&... args)
+    {
+        const std::array<DBParam, sizeof...(Args)> params = {{ DBParam( args )... }};
+        return DoPrepared(&into, into.error, query, params.data(), params.size());
+    }
+    //statement which returns no information except error status
+    template<typename... Args>
+    bool    RunPrepared(DBerror& err, const char* query, const Args&... args)
+    {
+        const std::array<DBParam, sizeof...(Args)> params = {{ DBParam( args )... }};
+        return DoPrepared(nullptr, err, query, params.data(), params.size());
+    }
+
+    /* async queries run on a pool of extra connections (see StartPool()).
+     * without a pool they run synchronously, but callbacks are still deferred to ProcessCompletions().
+     * NOTE:  async queries are not ordered against queries run on the main connection. */
+    //write which returns nothing.  errors are logged.  writes run on one connection, in the order they are queued.
+    void    RunQueryAsync(const char* query_fmt, ...);
+    //query whose result is passed to callback from ProcessCompletions().  check res.error on failure.
+    void    RunQueryAsync(DBQueryCallback callback, const char* query_fmt, ...);
+    //write run in order with the other writes, whose result is passed to callback from ProcessCompletions().
+    // the callback runs once every write queued before it has run too.
+    void    RunWriteAsync(DBQueryCallback callback, const char* query_fmt, ...);
+    //runs callbacks of finished async queries.  call from the main loop.
+    void    ProcessCompletions();
+
+    //opens 'size' pool connections for async queries.  call after Initialize().
+    void    StartPool(uint8 size);
+    //runs all queued async writes, then closes the pool.  call before Close().
+    void    StopPool();
+    //async queries not yet run
+    size_t  GetPendingCount();
+
+    /* gives the calling thread a connection of its own.  until CloseThreadConnection(), that thread's
+     * RunQuery*() and RunPrepared() calls use it, and don't wait on the main connection.
+     * for threads doing a lot of reads at once, like startup loaders.  call after Initialize(). */
+    bool    OpenThreadConnection();
+    void    CloseThreadConnection();
+
     int32   DoEscapeString(char* tobuf, const char* frombuf, int32 fromlen);
     void    DoEscapeString(std::string &to, const std::string &from);
     static bool IsSafeString(const char *str);
@@ -182,11 +343,58 @@ protected:
 private:
     //MDatabase must be locked before these calls:
     bool    DoQuery_locked(DBerror &err, const char *query, int querylen, bool retry = true);
+    MYSQL_STMT* GetStatement_locked(DBerror &err, const char *query);
+    void    CloseStatements_locked();
+
+    bool    DoPrepared(DBPreparedResult* into, DBerror& err, const char* query, const DBParam* params, size_t count);
+    bool    FetchPrepared(MYSQL_STMT* stmt, DBPreparedResult& into);
+
+    struct PoolJob {
+        std::string query;
+        DBQueryCallback callback;
+        DBQueryResult result;
+        bool write = false; // runs on the write connection even with a callback
+    };
+    struct PoolConnection {
+        MYSQL* mysql;
+        std::thread* thread;
+        bool running;
+        std::mutex lock;
+        std::condition_variable cond;
+        std::deque<PoolJob*> jobs;
+    };
+
+    // a connection owned by one thread (see OpenThreadConnection())
+    struct ThreadConnection {
+        MYSQL* mysql;
+        std::unordered_map<std::string, MYSQL_STMT*> statements;
+    };
+
+    //connection the calling thread's queries use
+    MYSQL*  Conn()                  { return (mThreadConn != nullptr ? mThreadConn->mysql : mysql); }
+
+    int32   GetConnectFlags();
+    MYSQL*  OpenPoolConnection();
+    void    QueueJob(PoolJob* job);
+    void    PoolThread(PoolConnection* conn);
+    bool    DoPoolQuery(PoolConnection* conn, PoolJob* job);
 
     MYSQL*  mysql;
     Mutex   MDatabase;
     eStatus pStatus;
 
+    // prepared statements of the main connection, by query text
+    std::unordered_map<std::string, MYSQL_STMT*> mStatements;
+
+    // the calling thread's own connection, if it opened one
+    static thread_local ThreadConnection* mThreadConn;
+
+    // pool connection 0 runs writes; the rest (if any) run callback queries round-robin
+    std::vector<PoolConnection*> mPool;
+    uint8   mNextReader;
+    std::mutex mCompletedLock;
+    std::vector<PoolJob*> mCompleted;
+
     bool    pCompress;
     bool    pProfile;
     bool    pReconnect;
@@ -73,6 +73,7 @@
 
 // Standard Template Library includes
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <list>
 #include <map>
@@ -26,6 +26,7 @@
 #include "eve-core.h"
 
 #include "log/LogNew.h"
+#include "log/LogQueue.h"
 #include "log/logtypes.h"
 #include "log/logsys.h"
 
@@ -247,9 +248,37 @@ void NewLog::PrintMsg( Color color, char pfx, const char* source, const char* fm
     if( !m_initialized )
         return;
 
+    if( LogQueue::IsRunning() )
+    {
+        sLogQueue.Push( &NewLog::PrintQueued, -1, color, pfx, source, fmt, ap );
+        return;
+    }
+
     MutexLock l( mMutex );
 
-    PrintTime();
+    PrintHeader( color, pfx, source, time( NULL ) );
+
+    PrintVa( fmt, ap );
+    Print( "\n" );
+
+    SetColor( COLOR_DEFAULT );
+}
+
+void NewLog::PrintQueued( const LogRecord& rec )
+{
+    NewLog& log = sLog;
+    MutexLock l( log.mMutex );
+
+    log.PrintHeader( (Color)rec.color, rec.prefix, rec.Source(), (time_t)( rec.time / 1000000 ) );
+
+    log.Print( "%s\n", rec.Message() );
+
+    log.SetColor( COLOR_DEFAULT );
+}
+
+void NewLog::PrintHeader( Color color, char pfx, const char* source, time_t time )
+{
+    PrintTime( time );
 
     SetColor( color );
     Print( " %c ", pfx );
@@ -261,19 +290,13 @@ void NewLog::PrintMsg( Color color, char pfx, const char* source, const char* fm
 
         SetColor( color );
     }
-
-    PrintVa( fmt, ap );
-    Print( "\n" );
-
-    SetColor( COLOR_DEFAULT );
 }
 
-void NewLog::PrintTime()
+void NewLog::PrintTime( time_t time )
 {
     MutexLock l( mMutex );
 
-    // this will be replaced my a timing thread somehow
-    SetTime( time( NULL ) );
+    SetTime( time );
 
     tm t;
     localtime_r( &mTime, &t );
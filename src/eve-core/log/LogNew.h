@@ -29,6 +29,8 @@
 #include "utils/Singleton.h"
 #include "threading/Mutex.h"
 
+struct LogRecord;
+
 /**
  * @brief a small and simple logging system.
  *
@@ -187,9 +189,26 @@ protected:
      */
     void PrintMsg( Color color, char pfx, const char* source, const char* fmt, va_list ap );
     /**
-     * @brief Prints current time.
+     * @brief Prints a message queued by PrintMsg on sLogQueue.
+     *
+     * Called on the log writer thread.
+     *
+     * @param[in] rec The queued message.
+     */
+    static void PrintQueued( const LogRecord& rec );
+    /**
+     * @brief Prints the time, prefix and source of a message.
+     *
+     * @param[in] color  Color of the message.
+     * @param[in] pfx    Single-character prefix/identificator.
+     * @param[in] source Origin of message.
+     * @param[in] time   When the message was logged.
+     */
+    void PrintHeader( Color color, char pfx, const char* source, time_t time );
+    /**
+     * @brief Prints the given time.
      */
-    void PrintTime();
+    void PrintTime( time_t time );
 
     /**
      * @brief Prints a raw message.
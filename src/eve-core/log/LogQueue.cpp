@@ -0,0 +1,310 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "log/LogQueue.h"
+
+/*
+ * single producer (the thread owning it), single consumer (the writer) byte ring.
+ * head and tail only grow; the position in data is the counter modulo RING_SIZE.
+ */
+struct LogQueue::Ring
+{
+    Ring() : head( 0 ), tail( 0 ), dropped( 0 ), closed( false ), reported( 0 ) { }
+
+    alignas( 64 ) std::atomic<uint64_t> head;       // written by the owning thread
+    alignas( 64 ) std::atomic<uint64_t> tail;       // written by the writer
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> closed;                       // the owning thread is gone
+    uint64_t reported;                              // drops the writer already reported
+    char data[ RING_SIZE ];
+};
+
+namespace {
+
+inline uint32 AlignRecord( size_t size )
+{
+    return (uint32)( ( size + 7 ) & ~(size_t)7 );
+}
+
+}
+
+std::atomic<bool> LogQueue::sRunning( false );
+
+LogQueue::LogQueue()
+: mThread( NULL ),
+  mDropped( 0 )
+{
+}
+
+LogQueue::~LogQueue()
+{
+    Stop();
+
+    // rings of threads still alive are left alone, their exit still touches them
+    for( auto cur : mRings )
+        if( cur->closed.load( std::memory_order_acquire ) )
+            SafeDelete( cur );
+}
+
+bool LogQueue::Start()
+{
+    if( NULL != mThread )
+        return false;
+
+    sRunning.store( true, std::memory_order_release );
+    mThread = new std::thread( &LogQueue::WriterThread, this );
+    return true;
+}
+
+void LogQueue::Stop()
+{
+    if( NULL == mThread )
+        return;
+
+    sRunning.store( false, std::memory_order_release );
+    mWake.notify_one();
+    mThread->join();
+    SafeDelete( mThread );
+
+    // lines pushed while the writer was finishing
+    Drain();
+}
+
+bool LogQueue::Push( LogRecord::WriteFn write, int16 type, uint8 color, char prefix, const char* source, const char* fmt, va_list ap )
+{
+    char text[ MAX_MESSAGE ];
+    int len = vsnprintf( text, sizeof( text ), fmt, ap );
+    if( len < 0 )
+        len = 0;
+    else if( len >= (int)sizeof( text ) )
+        len = sizeof( text ) - 1;
+
+    if( NULL == source )
+        source = "";
+    const size_t sourceLen = strlen( source ) + 1;
+    const uint32 size = AlignRecord( sizeof( LogRecord ) + sourceLen + len + 1 );
+
+    Ring* ring = GetRing();
+    uint64_t head = ring->head.load( std::memory_order_relaxed );
+    const uint64_t tail = ring->tail.load( std::memory_order_acquire );
+
+    // a record never wraps; if it doesn't fit before the end, the rest is skipped
+    uint32 offset = head & ( RING_SIZE - 1 );
+    const uint32 contig = RING_SIZE - offset;
+    const uint64_t need = ( contig < size ? contig + size : size );
+    if( RING_SIZE - ( head - tail ) < need )
+    {
+        ring->dropped.fetch_add( 1, std::memory_order_relaxed );
+        mWake.notify_one();
+        return false;
+    }
+
+    if( contig < size )
+    {
+        // too small for a header, the writer skips it by itself
+        if( contig >= sizeof( LogRecord ) )
+        {
+            LogRecord* pad = (LogRecord*)&ring->data[ offset ];
+            pad->size = contig;
+            pad->write = NULL;
+        }
+        head += contig;
+        offset = 0;
+    }
+
+    LogRecord* rec = (LogRecord*)&ring->data[ offset ];
+    rec->size = size;
+    rec->sourceLen = (uint16)sourceLen;
+    rec->color = color;
+    rec->prefix = prefix;
+    rec->type = type;
+    rec->time = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::system_clock::now().time_since_epoch() ).count();
+    rec->write = write;
+    char* pText = (char*)( rec + 1 );
+    memcpy( pText, source, sourceLen );
+    memcpy( pText + sourceLen, text, len );
+    pText[ sourceLen + len ] = '\0';
+
+    head += size;
+    ring->head.store( head, std::memory_order_release );
+
+    // don't wait for the writer's next round when filling up
+    if( head - tail > RING_SIZE / 2 )
+        mWake.notify_one();
+
+    return true;
+}
+
+uint64_t LogQueue::GetDropped()
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+    uint64_t dropped = mDropped;
+    for( auto cur : mRings )
+        dropped += cur->dropped.load( std::memory_order_relaxed );
+    return dropped;
+}
+
+LogQueue::Ring* LogQueue::GetRing()
+{
+    // marks the ring closed when its thread exits; the writer frees it once empty
+    struct Owner
+    {
+        Ring* ring = NULL;
+        ~Owner() { if( NULL != ring ) ring->closed.store( true, std::memory_order_release ); }
+    };
+    static thread_local Owner owner;
+
+    if( NULL == owner.ring )
+    {
+        owner.ring = new Ring();
+        std::lock_guard<std::mutex> lock( mMutex );
+        mRings.push_back( owner.ring );
+    }
+
+    return owner.ring;
+}
+
+void LogQueue::WriterThread()
+{
+    while( sRunning.load( std::memory_order_acquire ) )
+    {
+        if( Drain() > 0 )
+            continue;
+
+        std::unique_lock<std::mutex> lock( mMutex );
+        mWake.wait_for( lock, std::chrono::milliseconds( 5 ) );
+    }
+
+    Drain();
+}
+
+size_t LogQueue::Drain()
+{
+    struct Cursor
+    {
+        Ring* ring;
+        uint64_t tail;
+        uint64_t head;
+    };
+
+    std::vector<Cursor> cursors;
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+        for( auto cur : mRings )
+        {
+            Cursor c = { cur, cur->tail.load( std::memory_order_relaxed ), cur->head.load( std::memory_order_acquire ) };
+            if( c.tail != c.head )
+                cursors.push_back( c );
+        }
+    }
+
+    // next line of a ring, skipping the padding at its end
+    auto peek = []( Cursor& c ) -> const LogRecord* {
+        while( c.tail != c.head )
+        {
+            const uint32 offset = c.tail & ( RING_SIZE - 1 );
+            const uint32 contig = RING_SIZE - offset;
+            if( contig < sizeof( LogRecord ) )
+            {
+                c.tail += contig;
+                continue;
+            }
+
+            const LogRecord* rec = (const LogRecord*)&c.ring->data[ offset ];
+            if( NULL != rec->write )
+                return rec;
+            c.tail += rec->size;
+        }
+        c.ring->tail.store( c.tail, std::memory_order_release );
+        return NULL;
+    };
+
+    // merge the rings by time, so lines of different threads come out in order
+    size_t count = 0;
+    while( !cursors.empty() )
+    {
+        size_t next = 0;
+        const LogRecord* rec = NULL;
+        for( size_t i = 0; i < cursors.size(); )
+        {
+            const LogRecord* cur = peek( cursors[ i ] );
+            if( NULL == cur )
+            {
+                cursors[ i ] = cursors.back();
+                cursors.pop_back();
+                continue;
+            }
+            if( NULL == rec || cur->time < rec->time )
+            {
+                rec = cur;
+                next = i;
+            }
+            ++i;
+        }
+        if( NULL == rec )
+            break;
+
+        rec->write( *rec );
+        ++count;
+
+        Cursor& c = cursors[ next ];
+        c.tail += rec->size;
+        c.ring->tail.store( c.tail, std::memory_order_release );
+    }
+
+    // the writers leave flushing to us, once per round instead of per line
+    if( count > 0 )
+        fflush( NULL );
+
+    uint64_t lost = 0;
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+        for( size_t i = 0; i < mRings.size(); )
+        {
+            Ring* ring = mRings[ i ];
+            const uint64_t dropped = ring->dropped.load( std::memory_order_relaxed );
+            lost += dropped - ring->reported;
+            ring->reported = dropped;
+
+            if( ring->closed.load( std::memory_order_acquire )
+                && ring->tail.load( std::memory_order_relaxed ) == ring->head.load( std::memory_order_acquire ) )
+            {
+                mDropped += ring->reported;
+                SafeDelete( ring );
+                mRings[ i ] = mRings.back();
+                mRings.pop_back();
+                continue;
+            }
+            ++i;
+        }
+    }
+
+    if( lost > 0 )
+        sLog.Warning( "        Log Queue", "%" PRIu64 " log lines dropped, a thread logged faster than they could be written.", lost );
+
+    return count;
+}
@@ -0,0 +1,133 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __LOG__LOG_QUEUE_H__INCL__
+#define __LOG__LOG_QUEUE_H__INCL__
+
+#include <condition_variable>
+#include <mutex>
+
+#include "utils/Singleton.h"
+
+/**
+ * @brief One queued log line, as it sits in a LogQueue ring.
+ *
+ * The source and message text follow the header, each nul terminated.
+ */
+struct LogRecord
+{
+    typedef void (*WriteFn)( const LogRecord& rec );
+
+    uint32 size;        ///< bytes taken in the ring, header included
+    uint16 sourceLen;   ///< length of the source text, nul included
+    uint8 color;
+    char prefix;
+    int16 type;         ///< LogType, or -1
+    int64 time;         ///< microseconds since the epoch
+    WriteFn write;      ///< prints the record; nullptr for the padding at the end of a ring
+
+    const char* Source() const  { return (const char*)( this + 1 ); }
+    const char* Message() const { return Source() + sourceLen; }
+};
+
+/**
+ * @brief Moves the formatting and writing of log lines off the threads logging them.
+ *
+ * Every thread logging gets its own ring buffer, which only it writes and only
+ * the writer thread reads, so Push() takes no lock.  It formats the message
+ * into the ring with the time, the type and how to print it; the writer thread
+ * takes the lines out of all rings in time order and prints them to console and
+ * logfile.  When a ring is full the line is dropped and counted, and the writer
+ * reports how many were lost.
+ *
+ * The message is formatted on the calling thread, as %s arguments often point
+ * to strings that are gone by the time the writer gets to them.
+ *
+ * @note Until Start() is called, NewLog and _log print on the calling thread as before.
+ */
+class LogQueue
+: public Singleton< LogQueue >
+{
+public:
+    LogQueue();
+    ~LogQueue();
+
+    bool Start();
+    /// Stops the writer thread, after it wrote everything queued.
+    void Stop();
+
+    /// Checked on every log line; static so it doesn't construct the instance.
+    static bool IsRunning() { return sRunning.load( std::memory_order_relaxed ); }
+
+    /**
+     * @brief Queues a log line.
+     *
+     * @param[in] write  Prints the record on the writer thread.
+     * @param[in] type   Log type, or -1.
+     * @param[in] color  Passed through to @a write.
+     * @param[in] prefix Passed through to @a write.
+     * @param[in] source Origin of the message, may be NULL.
+     * @param[in] fmt    The format string.
+     * @param[in] ap     The arguments.
+     *
+     * @retval true  The line was queued.
+     * @retval false The ring of this thread was full, the line was dropped.
+     */
+    bool Push( LogRecord::WriteFn write, int16 type, uint8 color, char prefix, const char* source, const char* fmt, va_list ap );
+
+    /// Lines dropped so far on full rings.
+    uint64_t GetDropped();
+
+    /// Size of a ring, one per thread logging.
+    static const uint32 RING_SIZE = 0x10000;
+    /// Longest message, anything longer is cut.
+    static const uint32 MAX_MESSAGE = 0x1000;
+
+protected:
+    struct Ring;
+
+    Ring* GetRing();
+    void WriterThread();
+    /**
+     * @brief Writes out what is in the rings right now.
+     *
+     * @return the number of lines written.
+     */
+    size_t Drain();
+
+    std::vector<Ring*> mRings;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::thread* mThread;
+    static std::atomic<bool> sRunning;
+    /// Drops of rings already gone.
+    uint64_t mDropped;
+};
+
+/// Evaluates to a LogQueue instance.
+#define sLogQueue \
+    ( LogQueue::get() )
+
+#endif /* !__LOG__LOG_QUEUE_H__INCL__ */
@@ -26,6 +26,7 @@
 #include "eve-core.h"
 
 #include "log/logsys.h"
+#include "log/LogQueue.h"
 #include "utils/utils_hex.h"
 #include "threading/Mutex.h"
 
@@ -81,8 +82,48 @@ void log_messageVA(LogType type, const char *fmt, va_list args) {
     log_messageVA(type, 0, fmt, args);
 }
 
+/* prints a line queued by log_messageVA, on the log writer thread */
+static void log_write_queued( const LogRecord& rec )
+{
+    /* only ever called by the one thread writing, the time can be kept from line to line */
+    static time_t lastTime(0);
+    static char timeText[0x10] = "";
+    time_t tTime = (time_t)(rec.time / 1000000);
+    if (tTime != lastTime) {
+        tm t;
+        localtime_r( &tTime, &t );
+        snprintf(timeText, sizeof(timeText), "%02u:%02u:%02u", t.tm_hour, t.tm_min, t.tm_sec);
+        lastTime = tTime;
+    }
+
+    char prefix[0x80];
+    snprintf(prefix, sizeof(prefix), "%s [%s] ", timeText, log_type_info[rec.type].display_name );
+
+    MutexLock lock(mLogSys);
+
+    /* the indent is queued as the source */
+    fputs(prefix, stdout);
+    fputs(rec.Source(), stdout);
+    fputs(rec.Message(), stdout);
+    fputc('\n', stdout);
+
+    //print into the logfile (if any).  LogQueue flushes it after each round
+    if (logsys_log_file != nullptr) {
+        fputs(prefix, logsys_log_file);
+        fputs(rec.Source(), logsys_log_file);
+        fputs(rec.Message(), logsys_log_file);
+        fputc('\n', logsys_log_file);
+    }
+}
+
 extern void log_messageVA( LogType type, uint32 iden, const char *fmt, va_list args )
 {
+    if (LogQueue::IsRunning()) {
+        std::string indent(iden, ' ');
+        sLogQueue.Push(&log_write_queued, type, 0, 0, indent.c_str(), fmt, args);
+        return;
+    }
+
     /* allocate enough room for a med message  (changed from 4k to 1k) */
     size_t log_msg_size = 0x400;
     size_t log_msg_index = 0;
@@ -162,7 +203,9 @@ bool log_close_logfile()
     MutexLock lock(mLogSys);
     if (!logsys_log_file)
         return true;
-    return ( 0 == fclose( logsys_log_file ) );
+    FILE* file = logsys_log_file;
+    logsys_log_file = nullptr;
+    return ( 0 == fclose( file ) );
 }
 
 bool load_log_settings(const char *filename) {
@@ -374,6 +374,7 @@ LOG_TYPE( ITEM, DEBUG, DISABLED, "ItemDebug" )
 LOG_TYPE( ITEM, TRACE, DISABLED, "ItemTrace" )
 LOG_TYPE( ITEM, RELOCATE, DISABLED, "ItemRelocate" )
 LOG_TYPE( ITEM, CHANGE, DISABLED, "ItemChange" )
+LOG_TYPE( ITEM, SAVE, DISABLED, "ItemSave" )
 
 LOG_CATEGORY( LOOT )
 LOG_TYPE( LOOT, ERROR, ENABLED, "LootError" )
@@ -453,6 +454,7 @@ LOG_TYPE( NET, PRES_REP_OUT, DISABLED, "PresOut" )
 LOG_TYPE( NET, PRES_RAW_OUT, DISABLED, "RawOut" )
 LOG_TYPE( NET, MARSHAL_ERROR, ENABLED, "MarshalError" )
 LOG_TYPE( NET, MARSHAL_TRACE, DISABLED, "MarshalTrace" )
+LOG_TYPE( NET, MARSHAL_STATS, DISABLED, "MarshalStats" )
 LOG_TYPE( NET, UNMARSHAL_TRACE, DISABLED, "UnmarshalTrace" )
 LOG_TYPE( NET, UNMARSHAL_BUFHEX, DISABLED, "UnmarshalHex" )
 LOG_TYPE( NET, UNMARSHAL_ERROR, ENABLED, "UnmarshalError" )
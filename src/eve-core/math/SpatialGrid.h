@@ -0,0 +1,138 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __MATH__SPATIAL_GRID_H__INCL__
+#define __MATH__SPATIAL_GRID_H__INCL__
+
+#include "math/gpoint.h"
+
+/**
+ * @brief Uniform hash grid of values placed at points in space.
+ *
+ * Each value is kept in the cube of edge 'cellSize' holding its point and
+ * only occupied cells are stored, so a search only probes the few cells its
+ * reach overlaps.  A cell size near the usual search distance works best.
+ *
+ * Cell coordinates wrap at 2^21 per axis to fit one 64-bit key; cells that
+ * far apart may share a bucket, which only yields extra candidates.  Callers
+ * must test the real distance of whatever Visit() hands them.
+ */
+template<typename _Ty>
+class SpatialGrid
+{
+public:
+    SpatialGrid(double cellSize) : m_cellSize(cellSize), m_count(0) { }
+
+    double cellSize() const                             { return m_cellSize; }
+    size_t size() const                                 { return m_count; }
+    bool empty() const                                  { return m_count == 0; }
+
+    void clear()
+    {
+        m_cells.clear();
+        m_count = 0;
+    }
+
+    void Insert(const GPoint& pos, const _Ty& value)
+    {
+        m_cells[Key(pos)].push_back(value);
+        ++m_count;
+    }
+
+    /* 'pos' must be the point 'value' was inserted at */
+    bool Erase(const GPoint& pos, const _Ty& value)
+    {
+        typename CellMap::iterator itr = m_cells.find(Key(pos));
+        if (itr == m_cells.end())
+            return false;
+
+        std::vector<_Ty>& cell = itr->second;
+        for (size_t i = 0; i < cell.size(); ++i) {
+            if (cell[i] != value)
+                continue;
+            cell[i] = cell.back();
+            cell.pop_back();
+            if (cell.empty())
+                m_cells.erase(itr);
+            --m_count;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Calls func(value) for every value in the cells within 'reach' of 'pos' on each axis,
+     * stopping at the first call that returns true.
+     *
+     * @return true if func did.
+     */
+    template<typename _Func>
+    bool Visit(const GPoint& pos, double reach, _Func func) const
+    {
+        if (m_cells.empty())
+            return false;
+
+        const int64 x0(Coord(pos.x - reach)), x1(Coord(pos.x + reach));
+        const int64 y0(Coord(pos.y - reach)), y1(Coord(pos.y + reach));
+        const int64 z0(Coord(pos.z - reach)), z1(Coord(pos.z + reach));
+        for (int64 x = x0; x <= x1; ++x)
+            for (int64 y = y0; y <= y1; ++y)
+                for (int64 z = z0; z <= z1; ++z) {
+                    typename CellMap::const_iterator itr = m_cells.find(Pack(x, y, z));
+                    if (itr == m_cells.end())
+                        continue;
+                    for (const _Ty& cur : itr->second)
+                        if (func(cur))
+                            return true;
+                }
+
+        return false;
+    }
+
+private:
+    typedef std::unordered_map<uint64_t, std::vector<_Ty>> CellMap;
+
+    int64 Coord(double v) const
+    {
+        const double cell(std::floor(v / m_cellSize));
+        // NaN and absurd positions all land in cell 0 rather than overflowing the cast
+        if (!(cell > -1e15 and cell < 1e15))
+            return 0;
+        return (int64)cell;
+    }
+
+    static uint64_t Pack(int64 x, int64 y, int64 z)
+    {
+        return ((uint64_t)x & 0x1FFFFF) | (((uint64_t)y & 0x1FFFFF) << 21) | (((uint64_t)z & 0x1FFFFF) << 42);
+    }
+
+    uint64_t Key(const GPoint& pos) const                 { return Pack(Coord(pos.x), Coord(pos.y), Coord(pos.z)); }
+
+    double m_cellSize;
+    size_t m_count;
+    CellMap m_cells;
+};
+
+#endif /* !__MATH__SPATIAL_GRID_H__INCL__ */
@@ -81,12 +81,23 @@ public:
     uint16 GetCount()           { return mRefCount; }
     bool IsDeleted()            { return mDeleted; }
 
+    /**
+     * @brief Stops counting references; the object is never deleted thru DecRef().
+     *
+     * For shared constants that are handed out from more than one thread,
+     * whose count would otherwise be changed by all of them at once.
+     */
+    void SetImmortal() const    { mRefCount = IMMORTAL; }
+    bool IsImmortal() const     { return (mRefCount == IMMORTAL); }
+
 protected:
     /**
      * @brief Increments reference count of object by one.
      */
     void IncRef() const
     {
+        if (IsImmortal())
+            return;
         // ---modulefix; issue with installing and uninstalling modules caused a soft freeze and unable to make changes to modules in fit screen.
         if (mDeleted) {
             _log(REFPTR__ERROR, "IncRef() - Attempted to increase ref count on deleted object! Current Count: %u", mRefCount);
@@ -107,6 +118,8 @@ protected:
      */
     void DecRef() const
     {
+        if (IsImmortal())
+            return;
         if (mDeleted) {
             // ---modulefix; issue with installing and uninstalling modules caused a soft freeze and unable to make changes to modules in fit screen.
             _log(REFPTR__ERROR, "IncRef() - Attempted to increase ref count on deleted object! Current Count: %u", mRefCount);
@@ -124,6 +137,9 @@ protected:
     }
 
 private:
+    /// Reference count of immortal objects.
+    static const uint16 IMMORTAL = 0xFFFF;
+
     /// Reference count of instance.
     mutable uint16 mRefCount;
     mutable bool mDeleted;
@@ -52,6 +52,9 @@ public:
     int setopt( int level, int optname, const void* optval, unsigned int optlen );
     int setblocking( bool blocking );
 
+    /** @return Underlying descriptor; used to register the socket with TCPReactor. */
+    SOCKET fd() const                                   { return mSock; }
+
 protected:
     Socket( SOCKET sock );
 
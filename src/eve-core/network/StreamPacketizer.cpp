@@ -27,51 +27,157 @@
 
 #include "network/StreamPacketizer.h"
 
+const uint32 STREAMPACKETIZER_RING_SIZE = 0x10000;  /* 64k */
+
+StreamPacketizer::StreamPacketizer()
+: mRing( STREAMPACKETIZER_RING_SIZE ),
+  mRead( 0 ),
+  mFramed( 0 ),
+  mUsed( 0 ),
+  mUnframed( 0 ),
+  mRelease( 0 ),
+  mWrapped( 0 )
+{
+}
+
 StreamPacketizer::~StreamPacketizer()
 {
     ClearBuffers();
 }
 
+uint8* StreamPacketizer::GetWriteSpan( size_t& len )
+{
+    if( mUsed == mRing.size() )
+        Reallocate( mRing.size() << 1 );
+
+    // free space runs either up to the ring's end or up to mRead
+    const size_t write = ( mRead + mUsed ) & ( mRing.size() - 1 );
+    len = ( write < mRead ? mRead - write : mRing.size() - write );
+    return &mRing[ write ];
+}
+
+void StreamPacketizer::CommitWrite( size_t len )
+{
+    assert( mUsed + len <= mRing.size() );
+    mUsed += len;
+    mUnframed += len;
+}
+
 void StreamPacketizer::InputData( const Buffer& data )
 {
-    mBuffer.AppendSeq( data.begin<uint8>(), data.end<uint8>() );
+    size_t done( 0 ), len( 0 );
+    while( done < data.size() ) {
+        uint8* span = GetWriteSpan( len );
+        len = std::min( len, data.size() - done );
+        memcpy( span, &data[ done ], len );
+        CommitWrite( len );
+        done += len;
+    }
 }
 
 void StreamPacketizer::Process()
 {
-    Buffer::const_iterator<uint8> cur = mBuffer.begin<uint8>(), end = mBuffer.end<uint8>();
-    while( true ) {
-        if (sizeof(uint32) > (end - cur))
+    const size_t mask = mRing.size() - 1;
+    uint32 len( 0 );
+    while( sizeof( uint32 ) <= mUnframed ) {
+        Peek( mFramed, (uint8*)&len, sizeof( len ) );
+        if( len > mUnframed - sizeof( uint32 ) )
             break;
 
-        const Buffer::const_iterator<uint32> len = cur.As<uint32>();
-        const Buffer::const_iterator<uint8> start = ( len + 1 ).As<uint8>();
+        Packet packet;
+        packet.offset = ( mFramed + sizeof( uint32 ) ) & mask;
+        packet.length = len;
+        mPackets.push_back( packet );
 
-        if (*len > (uint32)(end - start))
-            break;
+        mFramed = ( packet.offset + len ) & mask;
+        mUnframed -= sizeof( uint32 ) + len;
+    }
+}
+
+bool StreamPacketizer::PopPacket( BufferView& packet )
+{
+    Release();
 
-        mPackets.push( new Buffer(start, start + *len));
-        cur = (start + *len);
+    if( mPackets.empty() ) {
+        packet = BufferView();
+        return false;
     }
 
-    if( cur != mBuffer.begin<uint8>() )
-        mBuffer.AssignSeq( cur, end );
+    const Packet cur = mPackets.front();
+    mPackets.pop_front();
+    // length prefix and body are released on next pop
+    mRelease = ( ( cur.offset - mRead ) & ( mRing.size() - 1 ) ) + cur.length;
+
+    if( cur.offset + cur.length <= mRing.size() ) {
+        packet = BufferView( &mRing[ 0 ] + cur.offset, cur.length );
+        return true;
+    }
+
+    // split by the wrap point; this one has to be copied
+    ++mWrapped;
+    mWrapBuf.Resize<uint8>( cur.length );
+    Peek( cur.offset, &mWrapBuf[ 0 ], cur.length );
+    packet = BufferView( mWrapBuf );
+    return true;
+}
+
+void StreamPacketizer::ClearBuffers()
+{
+    // popped packet may still be in use; keep it until next pop releases it
+    mPackets.clear();
+    mUsed = mRelease;
+    mUnframed = 0;
+    mFramed = ( mRead + mRelease ) & ( mRing.size() - 1 );
+}
+
+void StreamPacketizer::Peek( size_t offset, uint8* out, size_t len ) const
+{
+    const size_t first = std::min( len, mRing.size() - offset );
+    memcpy( out, &mRing[ offset ], first );
+    if( len > first )
+        memcpy( out + first, &mRing[ 0 ], len - first );
 }
 
-Buffer* StreamPacketizer::PopPacket()
+void StreamPacketizer::Release()
 {
-    Buffer* buf(nullptr);
-    if (!mPackets.empty()) {
-        buf = mPackets.front();
-        mPackets.pop();
+    if( 0 == mRelease )
+        return;
+
+    mRead = ( mRead + mRelease ) & ( mRing.size() - 1 );
+    mUsed -= mRelease;
+    mRelease = 0;
+    // nothing points into these anymore
+    mRetired.Resize<uint8>( 0 );
+    if( STREAMPACKETIZER_RING_SIZE < mWrapBuf.size() )
+        mWrapBuf.Resize<uint8>( 0 );
+
+    if( 0 == mUsed ) {
+        // empty; restart at 0 so next receives have the whole ring contiguous
+        mRead = mFramed = 0;
     }
 
-    return buf;
+    // give back the memory of a big packet once it's gone
+    if( ( STREAMPACKETIZER_RING_SIZE < mRing.size() ) and ( mUsed <= STREAMPACKETIZER_RING_SIZE / 2 ) )
+        Reallocate( STREAMPACKETIZER_RING_SIZE );
 }
 
-void StreamPacketizer::ClearBuffers()
+void StreamPacketizer::Reallocate( size_t size )
 {
-    Buffer* buf(nullptr);
-    while ((buf = PopPacket()))
-        SafeDelete( buf );
+    assert( mUsed <= size );
+
+    Buffer ring( size );
+    if( 0 < mUsed )
+        Peek( mRead, &ring[ 0 ], mUsed );
+
+    const size_t mask = mRing.size() - 1;
+    for( auto& cur : mPackets )
+        cur.offset = ( cur.offset - mRead ) & mask;
+    mFramed = mUsed - mUnframed;
+    mRead = 0;
+
+    // popped packet may still point into the current ring; if it's already
+    // in mRetired (or mWrapBuf), nothing points here
+    if( ( 0 < mRelease ) and ( 0 == mRetired.size() ) )
+        mRetired.swap( mRing );
+    mRing.swap( ring );
 }
@@ -27,25 +27,121 @@
 #define __STREAM_PACKETIZER_H__INCL__
 
 #include "utils/Buffer.h"
+#include "utils/BufferView.h"
 
+/** Initial size of StreamPacketizer's ring; it grows (power of 2) for bigger packets and shrinks back afterwards. */
+extern const uint32 STREAMPACKETIZER_RING_SIZE;
+
+/**
+ * @brief Splits stream of length-prefixed packets into packets.
+ *
+ * Received data is kept in a ring buffer the socket can recv() into
+ * directly (GetWriteSpan()/CommitWrite()).  Packets are handed out as
+ * views into the ring, so the only packets which get copied are those
+ * split by the ring's wrap point.
+ *
+ * The popped packet stays valid until the next PopPacket();
+ * receiving more data meanwhile doesn't touch it, so the packet may be used
+ * outside of the lock protecting the packetizer.
+ */
 class StreamPacketizer
 {
 public:
+    StreamPacketizer();
     ~StreamPacketizer();
 
+    /**
+     * @brief Obtains free space at the end of received data.
+     *
+     * Grows the ring if it's full.  The span is valid until CommitWrite()
+     * or any other non-const call.
+     *
+     * @param[out] len Length of the span, in bytes; never 0.
+     *
+     * @return Pointer to the span.
+     */
+    uint8* GetWriteSpan( size_t& len );
+    /**
+     * @brief Marks bytes written into span from GetWriteSpan() as received.
+     *
+     * @param[in] len Number of bytes written.
+     */
+    void CommitWrite( size_t len );
+    /**
+     * @brief Copies received data into the ring.
+     */
     void InputData( const Buffer& data );
+    /**
+     * @brief Frames all complete packets in the ring.
+     */
     void Process();
 
-    Buffer* PopPacket();
+    /**
+     * @brief Pops next framed packet.
+     *
+     * Previously popped packet is released back to the ring.
+     *
+     * @param[out] packet View of the packet.
+     *
+     * @return True if a packet was popped, false if there is none.
+     */
+    bool PopPacket( BufferView& packet );
 
+    /**
+     * @brief Drops all received data and packets.
+     *
+     * Popped packet stays valid until next PopPacket().
+     */
     void ClearBuffers();
 
+    /** @return Number of packets which had to be copied since they wrapped around the ring. */
+    uint32 GetWrappedCount() const                      { return mWrapped; }
+
 protected:
-    Buffer mBuffer;
+    /** Location of a framed packet within the ring. */
+    struct Packet
+    {
+        /** Offset of packet body (after length) in the ring. */
+        size_t offset;
+        /** Length of packet body. */
+        uint32 length;
+    };
 
-    std::queue<Buffer*> mPackets;
-};
+    /**
+     * @brief Copies bytes out of the ring, handling the wrap point.
+     */
+    void Peek( size_t offset, uint8* out, size_t len ) const;
+    /**
+     * @brief Releases previously popped packet; shrinks the ring if it's mostly unused.
+     */
+    void Release();
+    /**
+     * @brief Moves used bytes into new ring of given size (power of 2), starting at 0.
+     */
+    void Reallocate( size_t size );
 
-#endif /* !__STREAM_PACKETIZER_H__INCL__ */
+    /** Ring buffer; size is always power of 2. */
+    Buffer mRing;
+    /** Previous ring, kept after Reallocate() while popped packet still points into it. */
+    Buffer mRetired;
+    /** Offset of first byte still in use (popped packet's length). */
+    size_t mRead;
+    /** Offset of first byte not yet framed. */
+    size_t mFramed;
+    /** Number of bytes in use, counted from mRead. */
+    size_t mUsed;
+    /** Number of bytes not yet framed, counted from mFramed. */
+    size_t mUnframed;
+    /** Bytes of popped packet to release from mRead on next pop. */
+    size_t mRelease;
 
+    /** Copy of popped packet which wrapped around the ring. */
+    Buffer mWrapBuf;
+    /** Number of wrapped packets. */
+    uint32 mWrapped;
 
+    /** Framed packets, oldest first. */
+    std::deque<Packet> mPackets;
+};
+
+#endif /* !__STREAM_PACKETIZER_H__INCL__ */
@@ -30,6 +30,7 @@
 #include "log/LogNew.h"
 #include "network/TCPConnection.h"
 #include "network/NetUtils.h"
+#include "network/TCPReactor.h"
 #include "threading/Threading.h"
 #include "utils/timer.h"
 
@@ -41,7 +42,10 @@ TCPConnection::TCPConnection()
   mSockState(STATE_DISCONNECTED),
   mrIP(0),
   mrPort(0),
-  mRecvBuf(nullptr)
+  mRecvBuf(nullptr),
+  mThread(nullptr),
+  mReactorLoop(nullptr),
+  mReactorAttached(false)
 {
 }
 
@@ -50,7 +54,10 @@ TCPConnection::TCPConnection(Socket* socket, uint32 mrIP, uint16 mrPort)
   mSockState(STATE_CONNECTED),
   mrIP(mrIP),
   mrPort(mrPort),
-  mRecvBuf(nullptr)
+  mRecvBuf(nullptr),
+  mThread(nullptr),
+  mReactorLoop(nullptr),
+  mReactorAttached(false)
 {
     // Start worker thread
     StartLoop();
@@ -164,6 +171,8 @@ void TCPConnection::Disconnect()
 
     // Change state
     mSockState = STATE_DISCONNECTING;
+    // reactor only runs us on socket events; flush and close now
+    sTCPReactor.Wake(this);
 }
 
 bool TCPConnection::Send(Buffer** data)
@@ -186,11 +195,17 @@ bool TCPConnection::Send(Buffer** data)
     mSendQueue.push_back(buf);
     buf = nullptr;
 
+    // reactor only runs us on socket events; send now
+    sTCPReactor.Wake(this);
     return true;
 }
 
 void TCPConnection::StartLoop()
 {
+    // let the reactor own the socket if it's running; outbound async connects have no socket yet
+    if (sTCPReactor.IsRunning() and sTCPReactor.Attach(this))
+        return;
+
     /** @note  update this to use thread pool instead of creating new threads.
      * check with sThread.XXXX() for avalible thread from current thread pool.
      * if one is avalible, it will be used, and if not, sThread will create a new one
@@ -206,6 +221,11 @@ void TCPConnection::StartLoop()
 
 void TCPConnection::WaitLoop()
 {
+    // Block calling thread until reactor releases us
+    {
+        std::unique_lock<std::mutex> lock(mMReactor);
+        mReactorCond.wait(lock, [this] { return !mReactorAttached; });
+    }
     // Block calling thread until work thread terminates
     mMLoopRunning.Lock();
     mMLoopRunning.Unlock();
@@ -241,6 +261,12 @@ bool TCPConnection::Process() {
                 _log(TCP_CLIENT__TRACE, "Process() - Disconnecting SendData() Failed at %s: %s", GetAddress().c_str(), errbuf);
                 return false;
             }
+            {
+                // SendData() stops on a full socket buffer; keep going until everything is out
+                MutexLock queueLock(mMSendQueue);
+                if (!mSendQueue.empty())
+                    return true;
+            }
             DoDisconnect();
             return true;
         }
@@ -298,6 +324,8 @@ bool TCPConnection::SendData(char* errbuf)
             MutexLock queueLock(mMSendQueue);
             mSendQueue.push_front(buf);
             buf = nullptr;
+            // socket buffer is full.  try again next loop (or on EPOLLOUT) instead of spinning here
+            return true;
         } else {
             SafeDelete(buf);
         }
@@ -326,37 +354,47 @@ bool TCPConnection::RecvData(char* errbuf)
             mRecvBuf->Resize<uint8>(TCPCONN_RECVBUF_SIZE);
         }
 
-        status = mSock->recv(&(*mRecvBuf)[ 0 ], (uint)mRecvBuf->size(), MSG_DONTWAIT);
-        if (status == SOCKET_ERROR) {
-#ifdef HAVE_WINSOCK2_H
-            int errcode = WSAGetLastError();
-            if (errcode == WSAEWOULDBLOCK)
-                return true;
-#else
-            if (errno == EWOULDBLOCK)
-                return true;
-#endif
-            if (errbuf)
-                snprintf(errbuf, TCPCONN_ERRBUF_SIZE, "%s", strerror(errno));
+        status = RecvInto(&(*mRecvBuf)[ 0 ], mRecvBuf->size(), errbuf);
+        if (status < 0)
             return false;
-        } else if (status == 0) {
-            if (errbuf)
-                snprintf(errbuf, TCPCONN_ERRBUF_SIZE, "No Data Received.");
-            return false;
-        } else if (status) {
-            mRecvBuf->Resize<uint8>(status);
-            if (!ProcessReceivedData(errbuf))
-                return false;
-        } else {
-            if (errbuf)
-                snprintf(errbuf, TCPCONN_ERRBUF_SIZE, "recv() returned unknown status");
-            _log(TCP_CLIENT__ERROR, "TCPConnection::RecvData(): Error: recv() returned unknown status");
+        if (status == 0)
+            return true;
+
+        mRecvBuf->Resize<uint8>(status);
+        if (!ProcessReceivedData(errbuf))
             return false;
-        }
     }
     return true;
 }
 
+int TCPConnection::RecvInto(uint8* buf, size_t len, char* errbuf)
+{
+    int status = mSock->recv(buf, (uint)len, MSG_DONTWAIT);
+    if (status == SOCKET_ERROR) {
+#ifdef HAVE_WINSOCK2_H
+        int errcode = WSAGetLastError();
+        if (errcode == WSAEWOULDBLOCK)
+            return 0;
+#else
+        if (errno == EWOULDBLOCK)
+            return 0;
+#endif
+        if (errbuf)
+            snprintf(errbuf, TCPCONN_ERRBUF_SIZE, "%s", strerror(errno));
+        return -1;
+    } else if (status == 0) {
+        if (errbuf)
+            snprintf(errbuf, TCPCONN_ERRBUF_SIZE, "No Data Received.");
+        return -1;
+    } else if (status < 0) {
+        if (errbuf)
+            snprintf(errbuf, TCPCONN_ERRBUF_SIZE, "recv() returned unknown status");
+        _log(TCP_CLIENT__ERROR, "TCPConnection::RecvInto(): Error: recv() returned unknown status");
+        return -1;
+    }
+    return status;
+}
+
 void TCPConnection::DoDisconnect()
 {
     MutexLock lock(mMSock);
@@ -390,8 +428,8 @@ void* TCPConnection::TCPConnectionLoop(void* arg)
     TCPConnection* tcpc = reinterpret_cast< TCPConnection* >(arg);
     assert(tcpc != nullptr);
 
+    // tcpc may already be deleted once its loop returns
     tcpc->TCPConnectionLoop();
-    sThread.RemoveThread(tcpc->mThread);
 
     return nullptr;
 }
@@ -408,5 +446,6 @@ void TCPConnection::TCPConnectionLoop()
         start = GetTickCount();
     }
     DoDisconnect();
+    sThread.RemoveThread(mThread);
     mMLoopRunning.Unlock();
 }
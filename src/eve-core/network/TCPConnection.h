@@ -26,6 +26,9 @@
 #ifndef __NETWORK__TCP_CONNECTION_H__INCL__
 #define __NETWORK__TCP_CONNECTION_H__INCL__
 
+#include <condition_variable>
+#include <mutex>
+
 #include "network/Socket.h"
 #include "threading/Mutex.h"
 #include "utils/Buffer.h"
@@ -37,6 +40,8 @@ extern const uint32 TCPCONN_RECVBUF_SIZE;
 /** Time (in milliseconds) between periodical process for incoming/outgoing data. */
 extern const uint32 TCPCONN_LOOP_GRANULARITY;
 
+struct TCPReactorLoop;
+
 /**
  * @brief Generic class for TCP connections.
  *
@@ -44,6 +49,7 @@ extern const uint32 TCPCONN_LOOP_GRANULARITY;
  */
 class TCPConnection
 {
+    friend class TCPReactor;
 public:
     /** Describes all states this object may be in. */
     enum state_t
@@ -134,10 +140,12 @@ protected:
      *
      * This function just starts a thread, does not check
      * whether there is already one running!
+     * If TCPReactor is running, connection is attached to it instead.
      */
     void StartLoop();
     /**
-     * @brief Blocks calling thread until working thread terminates.
+     * @brief Blocks calling thread until working thread terminates
+     *  (or until reactor releases the connection).
      */
     void WaitLoop();
 
@@ -176,6 +184,19 @@ protected:
      * @return True if receive was OK, false if not.
      */
     virtual bool RecvData( char* errbuf = 0 );
+    /**
+     * @brief Receives data into given memory without blocking.
+     *
+     * Caller must hold mMSock.
+     *
+     * @param[in]  buf    Destination.
+     * @param[in]  len    Size of destination, in bytes.
+     * @param[out] errbuf Buffer which receives description of error.
+     *
+     * @return Number of bytes received, 0 if there is nothing to receive,
+     *         -1 on error or if remote side closed the connection.
+     */
+    int RecvInto( uint8* buf, size_t len, char* errbuf = 0 );
     /**
      * @brief Disconnects socket.
      */
@@ -224,6 +245,15 @@ protected:
 
     /** Thread */
     std::thread* mThread;
+
+    /** Reactor loop owning this connection; nullptr when running own thread. */
+    TCPReactorLoop* mReactorLoop;
+    /** Protects mReactorLoop and mReactorAttached. */
+    std::mutex mMReactor;
+    /** Signalled when reactor releases the connection. */
+    std::condition_variable mReactorCond;
+    /** True while attached to reactor; WaitLoop() blocks on it. */
+    bool mReactorAttached;
 };
 
 #endif /* !__NETWORK__TCP_CONNECTION_H__INCL__ */
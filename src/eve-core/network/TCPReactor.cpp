@@ -0,0 +1,340 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "network/TCPConnection.h"
+#include "network/TCPReactor.h"
+#include "threading/Threading.h"
+
+#ifdef HAVE_SYS_EPOLL_H
+#   include <sys/epoll.h>
+#   include <sys/eventfd.h>
+#endif /* HAVE_SYS_EPOLL_H */
+
+const uint32 TCPREACTOR_MAX_EVENTS = 256;
+const uint32 TCPREACTOR_SWEEP_INTERVAL = 1000;  /* 1s */
+
+/**
+ * @brief One epoll set with the thread running it.
+ */
+struct TCPReactorLoop
+{
+    TCPReactorLoop()
+    : epfd(-1),
+      wakefd(-1),
+      thread(nullptr),
+      running(false),
+      signaled(false)
+    {
+    }
+
+    /** epoll descriptor. */
+    int epfd;
+    /** eventfd used to interrupt epoll_wait(). */
+    int wakefd;
+    /** Thread running this loop. */
+    std::thread* thread;
+    /** Loop keeps running while set. */
+    std::atomic<bool> running;
+
+    /** Protects pending and signaled. */
+    Mutex mPending;
+    /** Connections which requested processing from other threads. */
+    std::vector<TCPConnection*> pending;
+    /** True if wakefd has been written since pending was last drained. */
+    bool signaled;
+
+    /** Protects conns; only the loop thread erases from it. */
+    Mutex mConns;
+    /** Attached connections. */
+    std::unordered_set<TCPConnection*> conns;
+};
+
+TCPReactor::TCPReactor()
+: mNextLoop(0),
+  mRunning(false)
+{
+}
+
+TCPReactor::~TCPReactor()
+{
+    Stop();
+}
+
+bool TCPReactor::Start(uint8 threads)
+{
+#ifdef HAVE_SYS_EPOLL_H
+    MutexLock lock(mMLoops);
+    if (mRunning)
+        return true;
+
+    if (threads < 1)
+        threads = 1;
+
+    for (uint8 i = 0; i < threads; ++i) {
+        TCPReactorLoop* loop = new TCPReactorLoop();
+        loop->epfd = ::epoll_create1(EPOLL_CLOEXEC);
+        loop->wakefd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        epoll_event ev = epoll_event();
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;  // nullptr marks wakefd
+        if ((loop->epfd == -1) or (loop->wakefd == -1)
+        or (::epoll_ctl(loop->epfd, EPOLL_CTL_ADD, loop->wakefd, &ev) == -1)) {
+            _log(TCP_SERVER__ERROR, "Start() - Failed to create reactor loop: %s", strerror(errno));
+            if (loop->epfd != -1)
+                ::close(loop->epfd);
+            if (loop->wakefd != -1)
+                ::close(loop->wakefd);
+            SafeDelete(loop);
+            Stop();
+            return false;
+        }
+
+        loop->running = true;
+        loop->thread = new std::thread(ReactorThread, loop);
+        sThread.AddThread(loop->thread);
+        mLoops.push_back(loop);
+    }
+
+    mNextLoop = 0;
+    mRunning = true;
+    _log(TCP_SERVER__MESSAGE, "Start() - Started %u reactor threads.", mLoops.size());
+    return true;
+#else /* !HAVE_SYS_EPOLL_H */
+    _log(TCP_SERVER__WARNING, "Start() - epoll is not available; using thread per connection.");
+    return false;
+#endif /* !HAVE_SYS_EPOLL_H */
+}
+
+void TCPReactor::Stop()
+{
+    MutexLock lock(mMLoops);
+    mRunning = false;
+
+    for (auto loop : mLoops) {
+        loop->running = false;
+        Signal(loop);
+        if (loop->thread != nullptr) {
+            loop->thread->join();
+            sThread.RemoveThread(loop->thread);
+            SafeDelete(loop->thread);
+        }
+
+        // thread is gone; release whatever is still attached
+        Release(loop);
+
+        ::close(loop->wakefd);
+        ::close(loop->epfd);
+        SafeDelete(loop);
+    }
+    mLoops.clear();
+}
+
+bool TCPReactor::Attach(TCPConnection* conn)
+{
+#ifdef HAVE_SYS_EPOLL_H
+    MutexLock lock(mMLoops);
+    if (!mRunning or mLoops.empty())
+        return false;
+
+    // hold the socket until registered so the loop cannot process a half attached connection
+    MutexLock sockLock(conn->mMSock);
+    if (conn->mSock == nullptr)
+        return false;
+
+    TCPReactorLoop* loop = mLoops[mNextLoop++ % mLoops.size()];
+    // loop died on epoll error; let the caller run its own thread
+    if (!loop->running)
+        return false;
+
+    conn->mSock->setblocking(false);
+
+    {
+        std::lock_guard<std::mutex> attachLock(conn->mMReactor);
+        conn->mReactorLoop = loop;
+        conn->mReactorAttached = true;
+    }
+    {
+        MutexLock connsLock(loop->mConns);
+        loop->conns.insert(conn);
+    }
+
+    // edge triggered; RecvData()/SendData() always run until EWOULDBLOCK
+    epoll_event ev = epoll_event();
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.ptr = conn;
+    if (::epoll_ctl(loop->epfd, EPOLL_CTL_ADD, conn->mSock->fd(), &ev) == -1) {
+        _log(TCP_SERVER__ERROR, "Attach() - epoll_ctl() failed for %s: %s", conn->GetAddress().c_str(), strerror(errno));
+        {
+            MutexLock connsLock(loop->mConns);
+            loop->conns.erase(conn);
+        }
+        std::lock_guard<std::mutex> attachLock(conn->mMReactor);
+        conn->mReactorLoop = nullptr;
+        conn->mReactorAttached = false;
+        return false;
+    }
+
+    return true;
+#else /* !HAVE_SYS_EPOLL_H */
+    return false;
+#endif /* !HAVE_SYS_EPOLL_H */
+}
+
+void TCPReactor::Wake(TCPConnection* conn)
+{
+    std::lock_guard<std::mutex> attachLock(conn->mMReactor);
+    TCPReactorLoop* loop = conn->mReactorLoop;
+    if (loop == nullptr)
+        return;
+
+    MutexLock lock(loop->mPending);
+    loop->pending.push_back(conn);
+    // one wakeup per drain is enough
+    if (!loop->signaled) {
+        loop->signaled = true;
+        Signal(loop);
+    }
+}
+
+void* TCPReactor::ReactorThread(void* arg)
+{
+    TCPReactorLoop* loop = reinterpret_cast< TCPReactorLoop* >(arg);
+    assert(loop != nullptr);
+
+    Run(loop);
+
+    return nullptr;
+}
+
+void TCPReactor::Run(TCPReactorLoop* loop)
+{
+#ifdef HAVE_SYS_EPOLL_H
+    std::vector<epoll_event> events(TCPREACTOR_MAX_EVENTS);
+    std::vector<TCPConnection*> pending, sweep;
+    uint32 lastSweep = GetTickCount();
+    eventfd_t count(0);
+    while (loop->running) {
+        int ready = ::epoll_wait(loop->epfd, events.data(), TCPREACTOR_MAX_EVENTS, TCPREACTOR_SWEEP_INTERVAL);
+        if (ready == -1) {
+            if (errno == EINTR)
+                continue;
+            _log(TCP_SERVER__ERROR, "Run() - epoll_wait() failed: %s", strerror(errno));
+            // nobody would process our connections anymore; don't leave their owners waiting
+            loop->running = false;
+            Release(loop);
+            break;
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            if (events[i].data.ptr == nullptr) {
+                // drain wakefd; pending list is handled below
+                ::eventfd_read(loop->wakefd, &count);
+                continue;
+            }
+            Dispatch(loop, reinterpret_cast< TCPConnection* >(events[i].data.ptr));
+        }
+
+        {
+            MutexLock lock(loop->mPending);
+            pending.swap(loop->pending);
+            loop->signaled = false;
+        }
+        if (!pending.empty()) {
+            // connections may have queued several sends since last pass
+            std::sort(pending.begin(), pending.end());
+            pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+            for (auto conn : pending)
+                Dispatch(loop, conn);
+            pending.clear();
+        }
+
+        // timeouts are checked in Process(), so every connection still needs an occasional pass
+        if (GetTickCount() - lastSweep >= TCPREACTOR_SWEEP_INTERVAL) {
+            {
+                MutexLock lock(loop->mConns);
+                sweep.assign(loop->conns.begin(), loop->conns.end());
+            }
+            for (auto conn : sweep)
+                Dispatch(loop, conn);
+            sweep.clear();
+            lastSweep = GetTickCount();
+        }
+    }
+#endif /* HAVE_SYS_EPOLL_H */
+}
+
+void TCPReactor::Dispatch(TCPReactorLoop* loop, TCPConnection* conn)
+{
+    {
+        MutexLock lock(loop->mConns);
+        if (loop->conns.find(conn) == loop->conns.end())
+            return;
+    }
+
+    if (conn->Process() and (conn->GetState() != TCPConnection::STATE_DISCONNECTED))
+        return;
+
+    // closing the socket also removes it from the epoll set
+    conn->DoDisconnect();
+    Detach(loop, conn);
+}
+
+void TCPReactor::Detach(TCPReactorLoop* loop, TCPConnection* conn)
+{
+    {
+        MutexLock lock(loop->mConns);
+        if (loop->conns.erase(conn) == 0)
+            return;
+    }
+    // notify under the lock; once it's released, WaitLoop() may return and conn may be deleted
+    std::lock_guard<std::mutex> attachLock(conn->mMReactor);
+    conn->mReactorLoop = nullptr;
+    conn->mReactorAttached = false;
+    conn->mReactorCond.notify_all();
+}
+
+void TCPReactor::Release(TCPReactorLoop* loop)
+{
+    std::vector<TCPConnection*> conns;
+    {
+        MutexLock lock(loop->mConns);
+        conns.assign(loop->conns.begin(), loop->conns.end());
+    }
+    for (auto conn : conns) {
+        conn->DoDisconnect();
+        Detach(loop, conn);
+    }
+}
+
+void TCPReactor::Signal(TCPReactorLoop* loop)
+{
+#ifdef HAVE_SYS_EPOLL_H
+    if (::eventfd_write(loop->wakefd, 1) < 0)
+        _log(TCP_SERVER__ERROR, "Signal() - write() failed: %s", strerror(errno));
+#endif /* HAVE_SYS_EPOLL_H */
+}
@@ -0,0 +1,140 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __NETWORK__TCP_REACTOR_H__INCL__
+#define __NETWORK__TCP_REACTOR_H__INCL__
+
+#include <atomic>
+
+#include "threading/Mutex.h"
+#include "utils/Singleton.h"
+
+class TCPConnection;
+struct TCPReactorLoop;
+
+/** Max number of events TCPReactor handles per epoll_wait() call. */
+extern const uint32 TCPREACTOR_MAX_EVENTS;
+/** Time (in milliseconds) between periodical sweeps of all connections (timeouts, missed wakeups). */
+extern const uint32 TCPREACTOR_SWEEP_INTERVAL;
+
+/**
+ * @brief Readiness based I/O loop for TCP connections.
+ *
+ * Instead of every TCPConnection spinning its own thread every TCPCONN_LOOP_GRANULARITY,
+ * a fixed number of reactor threads each own an epoll set and only wake up when one
+ * of their sockets becomes readable/writable, when a connection queues data to send
+ * or when it requests disconnect.  The TCPConnection interface (Send(), ProcessReceivedData())
+ * is unchanged; connections are attached to the reactor by TCPConnection::StartLoop()
+ * when it is running, otherwise they fall back to the old thread-per-connection model.
+ *
+ * Only available where sys/epoll.h is; Start() fails everywhere else.
+ */
+class TCPReactor
+: public Singleton< TCPReactor >
+{
+public:
+    TCPReactor();
+    ~TCPReactor();
+
+    /**
+     * @brief Starts reactor threads.
+     *
+     * @param[in] threads Number of reactor threads (and epoll sets) to run.
+     *
+     * @return True if the reactor is running, false if not supported or failed.
+     */
+    bool Start( uint8 threads );
+    /**
+     * @brief Stops reactor threads.
+     *
+     * All connections still attached are disconnected and released.
+     */
+    void Stop();
+
+    /** @return True if the reactor accepts new connections. */
+    bool IsRunning() const                              { return mRunning; }
+
+    /**
+     * @brief Hands given connection over to the reactor.
+     *
+     * Connection must have a socket.  It stays attached until its Process() fails
+     * or it reaches STATE_DISCONNECTED; TCPConnection::WaitLoop() blocks until then.
+     *
+     * @param[in] conn Connection to attach.
+     *
+     * @return True if attached, false if the caller should run its own thread.
+     */
+    bool Attach( TCPConnection* conn );
+    /**
+     * @brief Schedules given connection for processing on its reactor thread.
+     *
+     * Used by TCPConnection::Send() and TCPConnection::Disconnect() to flush
+     * queued data without waiting for socket readiness.
+     *
+     * @param[in] conn Attached connection.
+     */
+    void Wake( TCPConnection* conn );
+
+protected:
+    /**
+     * @brief Thread entry point; casts arg to TCPReactorLoop and runs it.
+     */
+    static void* ReactorThread( void* arg );
+    /**
+     * @brief Waits for events and dispatches them until loop is stopped.
+     */
+    static void Run( TCPReactorLoop* loop );
+    /**
+     * @brief Runs one Process() pass of the connection; detaches it when done.
+     */
+    static void Dispatch( TCPReactorLoop* loop, TCPConnection* conn );
+    /**
+     * @brief Removes connection from loop and releases its waiters.
+     */
+    static void Detach( TCPReactorLoop* loop, TCPConnection* conn );
+    /**
+     * @brief Disconnects and detaches all connections of given loop.
+     */
+    static void Release( TCPReactorLoop* loop );
+    /**
+     * @brief Interrupts epoll_wait() of given loop.
+     */
+    static void Signal( TCPReactorLoop* loop );
+
+    /** Protects loop list and round-robin index. */
+    mutable Mutex mMLoops;
+    /** Loops connections are distributed over. */
+    std::vector<TCPReactorLoop*> mLoops;
+    /** Index of loop receiving the next connection. */
+    uint32 mNextLoop;
+    /** True between successful Start() and Stop(); read by accepting threads. */
+    std::atomic<bool> mRunning;
+};
+
+//Singleton
+#define sTCPReactor \
+    ( TCPReactor::get() )
+
+#endif /* !__NETWORK__TCP_REACTOR_H__INCL__ */
@@ -0,0 +1,134 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+
+#include "eve-core.h"
+
+#include "threading/TaskGraph.h"
+#include "utils/utils_time.h"
+
+uint32 TaskGraph::Add(const std::string& name, Job job, const std::vector<uint32>& after)
+{
+    const uint32 id = (uint32)m_tasks.size();
+
+    Task task;
+    task.name = name;
+    task.job = job;
+    task.needs = 0;
+    task.waiting = 0;
+    task.state = Waiting;
+    task.start = 0.0;
+    task.end = 0.0;
+    for (auto cur : after) {
+        assert(cur < id);
+        m_tasks[cur].dependents.push_back(id);
+        ++task.needs;
+    }
+
+    m_tasks.push_back(task);
+    return id;
+}
+
+bool TaskGraph::Run(uint8 threads, std::function<bool()> threadStart, std::function<void()> threadEnd)
+{
+    m_ready.clear();
+    m_finished = 0;
+    m_begin = GetTimeMSeconds();
+    for (uint32 id = 0; id < m_tasks.size(); ++id) {
+        Task& task = m_tasks[id];
+        task.waiting = task.needs;
+        task.start = task.end = 0.0;
+        task.state = (task.waiting == 0 ? Ready : Waiting);
+        if (task.state == Ready)
+            m_ready.push_back(id);
+    }
+
+    std::vector<std::thread*> workers;
+    for (uint8 i = 1; i < std::min<size_t>(threads, m_tasks.size()); ++i)
+        workers.push_back(new std::thread([this, threadStart, threadEnd]() {
+            if (threadStart and !threadStart())
+                return;
+            Work();
+            if (threadEnd)
+                threadEnd();
+        }));
+
+    Work();
+
+    for (auto cur : workers) {
+        cur->join();
+        SafeDelete(cur);
+    }
+
+    for (auto& cur : m_tasks)
+        if (cur.state != Done)
+            return false;
+    return true;
+}
+
+void TaskGraph::Work()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (m_finished < m_tasks.size()) {
+        if (m_ready.empty()) {
+            m_cond.wait(lock);
+            continue;
+        }
+
+        const uint32 id = m_ready.front();
+        m_ready.pop_front();
+        Task& task = m_tasks[id];
+        task.state = Running;
+        task.start = GetTimeMSeconds() - m_begin;
+
+        lock.unlock();
+        const bool ok = task.job();
+        lock.lock();
+
+        task.end = GetTimeMSeconds() - m_begin;
+        task.state = (ok ? Done : Failed);
+        ++m_finished;
+        for (auto cur : task.dependents) {
+            if (!ok) {
+                Skip(cur);
+            } else if ((m_tasks[cur].state == Waiting) and (--m_tasks[cur].waiting == 0)) {
+                m_tasks[cur].state = Ready;
+                m_ready.push_back(cur);
+            }
+        }
+        m_cond.notify_all();
+    }
+}
+
+void TaskGraph::Skip(uint32 id)
+{
+    if (m_tasks[id].state == Skipped)
+        return;
+
+    m_tasks[id].state = Skipped;
+    ++m_finished;
+    for (auto cur : m_tasks[id].dependents)
+        Skip(cur);
+}
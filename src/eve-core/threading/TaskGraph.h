@@ -0,0 +1,105 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+
+#ifndef __THREADING__TASK_GRAPH_H__INCL__
+#define __THREADING__TASK_GRAPH_H__INCL__
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * @brief Runs named jobs once each, every job as soon as the jobs it needs are done.
+ *
+ * A job names the jobs it depends on when it's added; those must have been
+ * added before it, so there can't be a cycle.  Run() works on up to 'threads'
+ * threads, the calling thread being one of them, and returns when all jobs
+ * have run.  A job that fails (returns false) has all jobs depending on it,
+ * directly or not, skipped.
+ *
+ * Extra threads can be set up for their jobs with a start and end call, e.g.
+ * to give each its own database connection; a thread whose start call fails
+ * runs nothing, and the others (at least the calling thread) do its share.
+ */
+class TaskGraph
+{
+public:
+    typedef std::function<bool()> Job;
+
+    TaskGraph()                                         { }
+
+    /* @param after  ids of the jobs this one needs, from earlier Add() calls
+     * @return id of the new job */
+    uint32 Add(const std::string& name, Job job, const std::vector<uint32>& after = std::vector<uint32>());
+
+    /* @return true if every job ran and succeeded */
+    bool Run(uint8 threads, std::function<bool()> threadStart = nullptr, std::function<void()> threadEnd = nullptr);
+
+    size_t size() const                                 { return m_tasks.size(); }
+    const std::string& GetName(uint32 id) const         { return m_tasks[id].name; }
+    bool IsFailed(uint32 id) const                      { return (m_tasks[id].state == Failed); }
+    bool IsSkipped(uint32 id) const                     { return (m_tasks[id].state == Skipped); }
+    /* ms after Run() started that the job started and was done */
+    double GetStart(uint32 id) const                    { return m_tasks[id].start; }
+    double GetEnd(uint32 id) const                      { return m_tasks[id].end; }
+
+private:
+    enum State {
+        Waiting,
+        Ready,
+        Running,
+        Done,
+        Failed,
+        Skipped
+    };
+
+    struct Task
+    {
+        std::string name;
+        Job job;
+        std::vector<uint32> dependents;
+        uint32 needs;       // deps given to Add()
+        uint32 waiting;     // deps not done yet, while running
+        State state;
+        double start;
+        double end;
+    };
+
+    /* runs ready jobs until all are finished */
+    void Work();
+    /* marks 'id' and everything depending on it skipped.  m_lock held */
+    void Skip(uint32 id);
+
+    std::vector<Task> m_tasks;
+
+    std::mutex m_lock;
+    std::condition_variable m_cond;
+    std::deque<uint32> m_ready;
+    size_t m_finished;
+    double m_begin;
+};
+
+#endif /* !__THREADING__TASK_GRAPH_H__INCL__ */
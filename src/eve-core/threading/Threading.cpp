@@ -95,11 +95,13 @@ std::thread* Threading::CreateThread(void *(*start_routine) (void *), void *args
 }
 
 void Threading::AddThread(std::thread* thread) {
+    std::lock_guard<std::mutex> lock(m_mThreads);
     m_threads.push_back(thread);
     _log(THREAD__INFO, "AddThread() - Added thread ID 0x%X", thread);
 }
 
 void Threading::RemoveThread(std::thread* thread) {
+    std::lock_guard<std::mutex> lock(m_mThreads);
     for (std::vector<std::thread*>::iterator cur = m_threads.begin(); cur != m_threads.end(); ++cur) {
         if ((*cur) == thread) {
             _log(THREAD__INFO, "RemoveThread() called for thread ID 0x%X", thread);
@@ -111,11 +113,13 @@ void Threading::RemoveThread(std::thread* thread) {
 }
 
 void Threading::ListThreads() {
+    std::lock_guard<std::mutex> lock(m_mThreads);
     for (auto cur : m_threads)
         sLog.Warning( "                 ", "ThreadID 0x%X", cur );
 }
 
 void Threading::EndThreads() {
+    std::lock_guard<std::mutex> lock(m_mThreads);
     if (!m_threads.size()) {
         _log(THREAD__MESSAGE, "EndThreads() - There are no active threads.");
         return;
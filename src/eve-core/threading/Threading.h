@@ -10,6 +10,7 @@
 #ifndef EVE_THREADING_H
 #define EVE_THREADING_H
 
+#include <mutex>
 #include <thread>
 
 #include "../eve-core.h"
@@ -45,6 +46,8 @@ protected:
     uint32 bufferLen;
 
 private:
+    // connection threads add/remove themselves concurrently
+    std::mutex m_mThreads;
     std::vector<std::thread*> m_threads;
 };
 
@@ -0,0 +1,220 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "threading/WorkerPool.h"
+
+thread_local int32 WorkerPool::s_worker = -1;
+thread_local int64 WorkerPool::s_job = -1;
+
+WorkerPool::WorkerPool()
+: m_job(nullptr),
+m_generation(0),
+m_busy(0),
+m_remaining(0),
+m_stop(false)
+{
+    m_queues.push_back(new Queue());
+}
+
+WorkerPool::~WorkerPool()
+{
+    Stop();
+    for (auto cur : m_queues)
+        SafeDelete(cur);
+}
+
+bool WorkerPool::Start(uint8 workers)
+{
+    if (!m_threads.empty())
+        return false;
+
+    m_stop = false;
+    for (size_t i = m_queues.size(); i < workers; ++i)
+        m_queues.push_back(new Queue());
+    for (size_t i = 1; i < m_queues.size(); ++i)
+        m_threads.push_back(new std::thread(&WorkerPool::WorkerThread, this, i));
+
+    return true;
+}
+
+void WorkerPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (auto cur : m_threads) {
+        cur->join();
+        SafeDelete(cur);
+    }
+    m_threads.clear();
+
+    while (m_queues.size() > 1) {
+        SafeDelete(m_queues.back());
+        m_queues.pop_back();
+    }
+}
+
+void WorkerPool::Run(size_t count, const std::function<void(size_t)>& job)
+{
+    if (count == 0)
+        return;
+
+    if (m_threads.empty()) {
+        s_worker = 0;
+        for (size_t i = 0; i < count; ++i) {
+            s_job = i;
+            job(i);
+        }
+        s_worker = -1;
+        s_job = -1;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_job = &job;
+        m_remaining = count;
+    }
+
+    // deal out contiguous blocks.  a worker still waking up from the last Run() may already pop these
+    const size_t workers = m_queues.size();
+    for (size_t w = 0; w < workers; ++w) {
+        std::lock_guard<std::mutex> lock(m_queues[w]->lock);
+        for (size_t i = w * count / workers, end = (w + 1) * count / workers; i < end; ++i)
+            m_queues[w]->jobs.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    Work(0);
+
+    // wait for the workers to leave Work() too, they still hold m_job
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_done.wait(lock, [this]() { return (m_remaining == 0) and (m_busy == 0); });
+    m_job = nullptr;
+}
+
+bool WorkerPool::Pop(size_t worker, size_t& job)
+{
+    {
+        Queue* pQueue = m_queues[worker];
+        std::lock_guard<std::mutex> lock(pQueue->lock);
+        if (!pQueue->jobs.empty()) {
+            job = pQueue->jobs.front();
+            pQueue->jobs.pop_front();
+            return true;
+        }
+    }
+
+    // steal from the far end of someone else's block
+    for (size_t i = 1; i < m_queues.size(); ++i) {
+        Queue* pQueue = m_queues[(worker + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(pQueue->lock);
+        if (!pQueue->jobs.empty()) {
+            job = pQueue->jobs.back();
+            pQueue->jobs.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkerPool::Work(size_t worker)
+{
+    s_worker = (int32)worker;
+    size_t job(0);
+    while (Pop(worker, job)) {
+        s_job = (int64)job;
+        (*m_job)(job);
+        if (--m_remaining == 0) {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_done.notify_all();
+        }
+    }
+    s_worker = -1;
+    s_job = -1;
+}
+
+void WorkerPool::WorkerThread(size_t worker)
+{
+    uint32 generation(0);
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true) {
+        m_wake.wait(lock, [&]() { return m_stop or (m_generation != generation); });
+        if (m_stop)
+            return;
+
+        generation = m_generation;
+        ++m_busy;
+        lock.unlock();
+        Work(worker);
+        lock.lock();
+        if (--m_busy == 0)
+            m_done.notify_all();
+    }
+}
+
+void StagedCalls::Reset(size_t workers)
+{
+    m_calls.resize(workers);
+    for (auto& cur : m_calls)
+        cur.clear();
+}
+
+void StagedCalls::Add(std::function<void()> call)
+{
+    const int32 worker = WorkerPool::CurrentWorker();
+    if ((worker < 0) or ((size_t)worker >= m_calls.size())) {
+        call();
+        return;
+    }
+
+    m_calls[worker].push_back(Call(WorkerPool::CurrentJob(), std::move(call)));
+}
+
+void StagedCalls::Commit()
+{
+    std::vector<Call> calls;
+    for (auto& cur : m_calls) {
+        for (auto& call : cur)
+            calls.push_back(std::move(call));
+        cur.clear();
+    }
+
+    // a job runs on one worker only, so this keeps each job's calls in the order it added them
+    std::stable_sort(calls.begin(), calls.end(), [](const Call& a, const Call& b) { return a.first < b.first; });
+    for (auto& cur : calls)
+        cur.second();
+}
@@ -0,0 +1,114 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __THREADING__WORKER_POOL_H__INCL__
+#define __THREADING__WORKER_POOL_H__INCL__
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * @brief Runs a batch of independent jobs on a fixed set of threads.
+ *
+ * Run(count, job) calls job(0) .. job(count - 1) and returns when all of them
+ * are done.  The jobs are dealt out to the workers in contiguous blocks; a
+ * worker that runs out takes jobs off the back of another worker's block, so
+ * a few heavy jobs don't leave the other threads idle.  The calling thread is
+ * worker 0 and works along; Start(n) adds n - 1 threads.
+ *
+ * Until Start() is called (or with Start(1)) Run() simply calls the jobs in
+ * order on the calling thread.
+ */
+class WorkerPool
+{
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    /* @param workers  total number of workers, counting the thread calling Run() */
+    bool Start(uint8 workers);
+    void Stop();
+
+    size_t size() const                                 { return m_queues.size(); }
+
+    void Run(size_t count, const std::function<void(size_t)>& job);
+
+    /* worker and job the calling thread is running; both -1 outside of Run() */
+    static int32 CurrentWorker()                        { return s_worker; }
+    static int64 CurrentJob()                           { return s_job; }
+
+private:
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<size_t> jobs;
+    };
+
+    bool Pop(size_t worker, size_t& job);
+    void Work(size_t worker);
+    void WorkerThread(size_t worker);
+
+    std::vector<Queue*> m_queues;
+    std::vector<std::thread*> m_threads;
+
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(size_t)>* m_job;
+    uint32 m_generation;    // bumped for every Run(), wakes the workers
+    size_t m_busy;          // workers inside Work()
+    std::atomic<size_t> m_remaining;
+    bool m_stop;
+
+    static thread_local int32 s_worker;
+    static thread_local int64 s_job;
+};
+
+/**
+ * @brief Calls queued by the jobs of a WorkerPool::Run(), made afterwards on one thread.
+ *
+ * Jobs running in parallel hand whatever must not happen concurrently to Add().
+ * Commit() then makes the calls ordered by job, and in the order each job added
+ * them, so the outcome doesn't depend on how the jobs were spread over threads.
+ */
+class StagedCalls
+{
+public:
+    StagedCalls()                                       { }
+
+    /* call before WorkerPool::Run() */
+    void Reset(size_t workers);
+    /* from inside a job; anywhere else the call is made at once */
+    void Add(std::function<void()> call);
+    void Commit();
+
+private:
+    typedef std::pair<int64, std::function<void()>> Call;
+    // one list per worker, so Add() needs no lock
+    std::vector<std::vector<Call>> m_calls;
+};
+
+#endif /* !__THREADING__WORKER_POOL_H__INCL__ */
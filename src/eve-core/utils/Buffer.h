@@ -592,6 +592,20 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Exchanges content with another buffer.
+     *
+     * Only pointers are exchanged, no data is copied.
+     *
+     * @param[in,out] oth Buffer to exchange content with.
+     */
+    void swap( Buffer& oth )
+    {
+        std::swap( mBuffer, oth.mBuffer );
+        std::swap( mSize, oth.mSize );
+        std::swap( mCapacity, oth.mCapacity );
+    }
+
     /********************************************************************/
     /* Size methods                                                     */
     /********************************************************************/
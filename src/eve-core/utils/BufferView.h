@@ -0,0 +1,85 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __UTILS__BUFFER_VIEW_H__INCL__
+#define __UTILS__BUFFER_VIEW_H__INCL__
+
+#include "utils/Buffer.h"
+
+/**
+ * @brief Read-only view of bytes owned by someone else.
+ *
+ * Unlike Buffer, it never owns nor modifies the memory; the owner
+ * must keep it alive and unchanged while the view is in use.
+ * Implicitly constructible from Buffer, so functions taking
+ * a BufferView accept Buffers as well.
+ */
+class BufferView
+{
+public:
+    BufferView()
+    : mData( nullptr ),
+      mSize( 0 )
+    {
+    }
+    BufferView( const uint8* data, size_t size )
+    : mData( data ),
+      mSize( size )
+    {
+    }
+    BufferView( const Buffer& buf )
+    : mData( 0 < buf.size() ? &buf[ 0 ] : nullptr ),
+      mSize( buf.size() )
+    {
+    }
+
+    /// @return Pointer to first byte.
+    const uint8* data() const                           { return mData; }
+    /// @return Size of the view, in bytes.
+    size_t size() const                                 { return mSize; }
+    /// @return True if the view is empty.
+    bool empty() const                                  { return ( 0 == mSize ); }
+
+    /// @return Pointer to first byte.
+    const uint8* begin() const                          { return mData; }
+    /// @return Pointer past the last byte.
+    const uint8* end() const                            { return mData + mSize; }
+
+    /// @return Byte at given index.
+    const uint8& operator[]( size_t index ) const
+    {
+        // make sure we're not going off the bounds
+        assert( index < mSize );
+        return mData[ index ];
+    }
+
+protected:
+    /// Viewed memory.
+    const uint8* mData;
+    /// Length of viewed memory, in bytes.
+    size_t mSize;
+};
+
+#endif /* !__UTILS__BUFFER_VIEW_H__INCL__ */
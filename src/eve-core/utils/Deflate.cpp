@@ -32,7 +32,7 @@
 
 const uint8 DeflateHeaderByte = 0x78; //'x'
 
-bool IsDeflated( const Buffer& data )
+bool IsDeflated( const BufferView& data )
 {
     return ( DeflateHeaderByte == data[0] );
 }
@@ -78,7 +78,7 @@ bool InflateData( Buffer& data )
     return true;
 }
 
-bool InflateData( const Buffer& input, Buffer& output )
+bool InflateData( const BufferView& input, Buffer& output )
 {
     const Buffer::iterator<uint8> out = output.end<uint8>();
 
@@ -91,7 +91,7 @@ bool InflateData( const Buffer& input, Buffer& output )
         outputSize = ( input.size() << ++sizeMultiplier );
         output.ResizeAt( out, outputSize );
 
-        res = uncompress( &*out, (uLongf*)&outputSize, &input[0], input.size() );
+        res = uncompress( &*out, (uLongf*)&outputSize, input.data(), input.size() );
     } while( Z_BUF_ERROR == res );
 
     if( Z_OK == res )
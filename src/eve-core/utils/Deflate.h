@@ -27,6 +27,7 @@
 #define PACKET_FUNCTIONS_H
 
 #include "utils/Buffer.h"
+#include "utils/BufferView.h"
 
 extern const uint8 DeflateHeaderByte;
 
@@ -38,7 +39,7 @@ extern const uint8 DeflateHeaderByte;
  * @retval true  Data is deflated.
  * @retval false Data is not deflated.
  */
-bool IsDeflated( const Buffer& data );
+bool IsDeflated( const BufferView& data );
 
 /**
  * @brief Deflates given data.
@@ -95,6 +96,6 @@ bool InflateData( Buffer& data );
  * @retval true  Inflation ran successfully.
  * @retval false Failed to inflate data.
  */
-bool InflateData( const Buffer& input, Buffer& output );
+bool InflateData( const BufferView& input, Buffer& output );
 
 #endif
@@ -0,0 +1,273 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __UTILS__FLAT_MAP_H__INCL__
+#define __UTILS__FLAT_MAP_H__INCL__
+
+/**
+ * @brief Read-only view of 'size' T's owned by someone else.
+ *
+ * Like BufferView, for arrays of any type; the owner must keep them
+ * alive and unchanged while the span is in use.
+ */
+template<typename T>
+class Span
+{
+public:
+    Span()
+    : mData( nullptr ),
+      mSize( 0 )
+    {
+    }
+    Span( const T* data, size_t size )
+    : mData( data ),
+      mSize( size )
+    {
+    }
+
+    const T* data() const                               { return mData; }
+    size_t size() const                                 { return mSize; }
+    bool empty() const                                  { return ( 0 == mSize ); }
+
+    const T* begin() const                              { return mData; }
+    const T* end() const                                { return mData + mSize; }
+
+    const T& operator[]( size_t index ) const
+    {
+        assert( index < mSize );
+        return mData[ index ];
+    }
+
+protected:
+    const T* mData;
+    size_t mSize;
+};
+
+/**
+ * @brief A sorted, contiguous, read-mostly map; a std::multimap for data that is built once.
+ *
+ * Keys and values are kept in two arrays, sorted on key, so a lookup is a
+ * binary search of the keys alone (a 20k-entry uint16 table is 40k in a
+ * few dozen cache lines) and then one read of the value.  All values of a
+ * key are adjacent, so Range() hands them out as a Span, without copying.
+ *
+ * Built with Add() in any order then Seal(), which sorts (stably, so values
+ * of a key keep their order and Find() gets the first one added), or with
+ * View() straight over sorted arrays somebody else owns, e.g. a mapped
+ * SnapshotFile, in which case nothing is copied at all.  Insert() is for
+ * the odd change after that; it is linear, and makes a viewed table its own.
+ *
+ * Lookups before Seal() see nothing.  Not thread-safe for writes; any
+ * number of threads may read a sealed table.
+ */
+template<typename K, typename V>
+class FlatMap
+{
+public:
+    /* value_type by value, as the key and value aren't stored together */
+    typedef std::pair<K, const V&> value_type;
+
+    class const_iterator
+    {
+    public:
+        value_type operator*() const                    { return value_type(mMap->mKeys[mIdx], mMap->mValues[mIdx]); }
+        const_iterator& operator++()                    { ++mIdx; return *this; }
+        bool operator==(const const_iterator& oth) const    { return (mIdx == oth.mIdx); }
+        bool operator!=(const const_iterator& oth) const    { return (mIdx != oth.mIdx); }
+
+    private:
+        friend class FlatMap;
+        const_iterator(const FlatMap* pMap, size_t idx)
+        : mMap(pMap),
+        mIdx(idx)                                       { }
+
+        const FlatMap* mMap;
+        size_t mIdx;
+    };
+
+    FlatMap()
+    : mKeys(nullptr),
+    mValues(nullptr),
+    mSize(0),
+    mSorted(true),
+    mView(false)                                        { }
+
+    /* adds an entry; not seen by lookups until Seal() */
+    void Add(K key, const V& value)
+    {
+        Own();
+        if (!mOwnKeys.empty() and (key < mOwnKeys.back()))
+            mSorted = false;
+        mOwnKeys.push_back(key);
+        mOwnValues.push_back(value);
+        // the arrays may have moved
+        mKeys = nullptr;
+        mValues = nullptr;
+        mSize = 0;
+    }
+    /* sorts what Add() gave us and makes it visible */
+    void Seal()
+    {
+        if (mView)
+            return;
+        if (!mSorted) {
+            std::vector<size_t> order(mOwnKeys.size());
+            for (size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return (mOwnKeys[a] < mOwnKeys[b]); });
+
+            std::vector<K> keys;
+            std::vector<V> values;
+            keys.reserve(order.size());
+            values.reserve(order.size());
+            for (auto cur : order) {
+                keys.push_back(mOwnKeys[cur]);
+                values.push_back(mOwnValues[cur]);
+            }
+            mOwnKeys.swap(keys);
+            mOwnValues.swap(values);
+            mSorted = true;
+        }
+        mOwnKeys.shrink_to_fit();
+        mOwnValues.shrink_to_fit();
+        Point();
+    }
+    /* adds an entry after any others of 'key', keeping it sorted */
+    void Insert(K key, const V& value)
+    {
+        Own();
+        Seal();
+        const size_t idx = Upper(key);
+        mOwnKeys.insert(mOwnKeys.begin() + idx, key);
+        mOwnValues.insert(mOwnValues.begin() + idx, value);
+        Point();
+    }
+    /* uses 'count' keys, sorted, and their values in place; they must outlive this table (or the next Insert()) */
+    void View(const K* keys, const V* values, size_t count)
+    {
+        // plain structs of numbers; a type that owns memory can't live in a file
+        static_assert(std::is_standard_layout<V>::value and std::is_trivially_destructible<V>::value, "only plain values can be viewed in place");
+        clear();
+        mKeys = keys;
+        mValues = values;
+        mSize = count;
+        mView = true;
+    }
+    void clear()
+    {
+        mOwnKeys.clear();
+        mOwnValues.clear();
+        mKeys = nullptr;
+        mValues = nullptr;
+        mSize = 0;
+        mSorted = true;
+        mView = false;
+    }
+
+    /* @return the first value of 'key', nullptr if there's none */
+    const V* Find(K key) const
+    {
+        const size_t idx = Lower(key);
+        if ((idx < mSize) and (mKeys[idx] == key))
+            return &mValues[idx];
+        return nullptr;
+    }
+    bool Has(K key) const                               { return (Find(key) != nullptr); }
+    /* @return all values of 'key', in the order they were added */
+    Span<V> Range(K key) const
+    {
+        const size_t first = Lower(key);
+        return Span<V>(mValues + first, Upper(key) - first);
+    }
+
+    size_t size() const                                 { return mSize; }
+    bool empty() const                                  { return (mSize == 0); }
+    bool IsView() const                                 { return mView; }
+    Span<K> Keys() const                                { return Span<K>(mKeys, mSize); }
+    Span<V> Values() const                              { return Span<V>(mValues, mSize); }
+
+    const_iterator begin() const                        { return const_iterator(this, 0); }
+    const_iterator end() const                          { return const_iterator(this, mSize); }
+
+private:
+    FlatMap(const FlatMap&) = delete;
+    FlatMap& operator=(const FlatMap&) = delete;
+
+    /* @return index of the first key not below 'key'; branch-free, so the search doesn't stall on mispredicts */
+    size_t Lower(K key) const
+    {
+        if (mSize == 0)
+            return 0;
+        const K* base = mKeys;
+        size_t n = mSize;
+        while (n > 1) {
+            const size_t half = n / 2;
+            base = ((base[half] < key) ? base + half : base);
+            n -= half;
+        }
+        return (base - mKeys) + (*base < key);
+    }
+    /* @return index of the first key above 'key' */
+    size_t Upper(K key) const
+    {
+        if (mSize == 0)
+            return 0;
+        const K* base = mKeys;
+        size_t n = mSize;
+        while (n > 1) {
+            const size_t half = n / 2;
+            base = ((key < base[half]) ? base : base + half);
+            n -= half;
+        }
+        return (base - mKeys) + !(key < *base);
+    }
+    /* copies a viewed table into our own arrays */
+    void Own()
+    {
+        if (!mView)
+            return;
+        mOwnKeys.assign(mKeys, mKeys + mSize);
+        mOwnValues.assign(mValues, mValues + mSize);
+        mView = false;
+        Point();
+    }
+    void Point()
+    {
+        mKeys = mOwnKeys.data();
+        mValues = mOwnValues.data();
+        mSize = mOwnKeys.size();
+    }
+
+    const K* mKeys;
+    const V* mValues;
+    size_t mSize;
+    bool mSorted;
+    bool mView;
+
+    std::vector<K> mOwnKeys;
+    std::vector<V> mOwnValues;
+};
+
+#endif /* !__UTILS__FLAT_MAP_H__INCL__ */
@@ -0,0 +1,140 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "utils/Histogram.h"
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+namespace {
+
+/* position of the highest set bit, value > 0 */
+inline uint32 HighBit(uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+inline void Bump(std::atomic<uint64_t>& counter, uint64_t by)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+}
+
+void Histogram::Record(uint64_t value)
+{
+    Bump(m_counts[Index(value)], 1);
+    Bump(m_count, 1);
+    Bump(m_sum, value);
+    if (value > m_max.load(std::memory_order_relaxed))
+        m_max.store(value, std::memory_order_relaxed);
+}
+
+void Histogram::Add(const Histogram& other)
+{
+    for (uint32 i = 0; i < BUCKETS; ++i) {
+        const uint64_t count = other.m_counts[i].load(std::memory_order_relaxed);
+        if (count > 0)
+            Bump(m_counts[i], count);
+    }
+    Bump(m_count, other.m_count.load(std::memory_order_relaxed));
+    Bump(m_sum, other.m_sum.load(std::memory_order_relaxed));
+    if (other.Max() > Max())
+        m_max.store(other.Max(), std::memory_order_relaxed);
+}
+
+void Histogram::Clear()
+{
+    for (uint32 i = 0; i < BUCKETS; ++i)
+        m_counts[i].store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+double Histogram::Mean() const
+{
+    const uint64_t count = Count();
+    if (count == 0)
+        return 0.0;
+    return (double)m_sum.load(std::memory_order_relaxed) / count;
+}
+
+uint64_t Histogram::Percentile(double pct) const
+{
+    // the buckets may be a little ahead of m_count while being written, so count them
+    uint64_t total = 0;
+    for (uint32 i = 0; i < BUCKETS; ++i)
+        total += m_counts[i].load(std::memory_order_relaxed);
+    if (total == 0)
+        return 0;
+
+    uint64_t rank = (uint64_t)(pct / 100.0 * total + 0.5);
+    if (rank < 1)
+        rank = 1;
+    if (rank > total)
+        rank = total;
+
+    uint64_t seen = 0;
+    for (uint32 i = 0; i < BUCKETS; ++i) {
+        seen += m_counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(Upper(i), Max());
+    }
+    return Max();
+}
+
+uint32 Histogram::Index(uint64_t value)
+{
+    if (value < 64)
+        return (uint32)value;
+
+    const uint32 bit = HighBit(value);
+    if (bit > 41)
+        return BUCKETS - 1;
+
+    // the top 6 bits of the value pick the bucket within its power of two
+    const uint32 shift = bit - 5;
+    return 64 + (bit - 6) * 32 + (uint32)((value >> shift) - 32);
+}
+
+uint64_t Histogram::Upper(uint32 index)
+{
+    if (index < 64)
+        return index;
+
+    const uint32 bit = 6 + (index - 64) / 32;
+    const uint64_t top = 32 + (index - 64) % 32;
+    return ((top + 1) << (bit - 5)) - 1;
+}
@@ -0,0 +1,74 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __UTILS__HISTOGRAM_H__INCL__
+#define __UTILS__HISTOGRAM_H__INCL__
+
+/**
+ * @brief Counts values in log-linear buckets, in fixed memory.
+ *
+ * Values below 64 get a bucket each; above that every power of two is split
+ * in 32 buckets, so a percentile is off by at most 1/32 (3%) of its value.
+ * Values up to 2^42 (73 minutes in ns) are told apart, anything larger lands
+ * in the last bucket.  Count, sum and max are exact.
+ *
+ * Record() is for one thread at a time.  Other threads may read (Add() it
+ * into their own copy) while it records; the counters are atomics that the
+ * writer only loads and stores, so recording costs no locked instructions.
+ */
+class Histogram
+{
+public:
+    Histogram()                                         { Clear(); }
+
+    void Record(uint64_t value);
+
+    /* adds the counts of 'other' to this one */
+    void Add(const Histogram& other);
+    void Clear();
+
+    uint64_t Count() const                              { return m_count.load(std::memory_order_relaxed); }
+    uint64_t Max() const                                { return m_max.load(std::memory_order_relaxed); }
+    double Mean() const;
+    /* the value 'pct' percent of the values are at or below, 0 if empty */
+    uint64_t Percentile(double pct) const;
+
+    static const uint32 BUCKETS = 1216;
+
+private:
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    static uint32 Index(uint64_t value);
+    /* largest value counted in bucket 'index' */
+    static uint64_t Upper(uint32 index);
+
+    std::atomic<uint64_t> m_counts[BUCKETS];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+
+#endif /* !__UTILS__HISTOGRAM_H__INCL__ */
@@ -0,0 +1,246 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+
+#include "eve-core.h"
+
+#include "utils/crc32.h"
+#include "utils/SnapshotFile.h"
+
+#ifndef _WIN32
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+struct SnapshotFile::Header
+{
+    uint32 magic;
+    uint32 format;
+    uint32 version;
+    uint32 count;       // sections
+    uint64_t hash;
+    uint32 crc;         // of this header (crc 0) and the section table
+    uint32 pad;
+};
+
+struct SnapshotFile::Section
+{
+    uint32 id;
+    uint32 pad;
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+namespace {
+
+const uint32 SNAPSHOT_MAGIC = 0x4E535645;   // "EVSN"
+const uint32 SNAPSHOT_FORMAT = 1;
+const size_t SNAPSHOT_ALIGN = 16;
+
+size_t Align(size_t offset)
+{
+    return (offset + SNAPSHOT_ALIGN - 1) & ~(SNAPSHOT_ALIGN - 1);
+}
+
+}
+
+SnapshotFile::SnapshotFile()
+: m_data(nullptr),
+m_size(0)
+{
+}
+
+bool SnapshotFile::Open(const std::string& path, uint32 version, uint64_t hash)
+{
+    Close();
+
+#ifdef _WIN32
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+    fseek(file, 0, SEEK_END);
+    m_buffer.resize(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    const bool read = (fread(m_buffer.data(), 1, m_buffer.size(), file) == m_buffer.size());
+    fclose(file);
+    if (!read or m_buffer.empty()) {
+        m_buffer.clear();
+        return false;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if ((fstat(fd, &st) != 0) or (st.st_size == 0)) {
+        close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+    m_data = (const uint8*)map;
+    m_size = st.st_size;
+#endif
+
+    const Header* pHeader = (const Header*)m_data;
+    if ((m_size < sizeof(Header)) or (pHeader->magic != SNAPSHOT_MAGIC) or (pHeader->format != SNAPSHOT_FORMAT)
+    or (m_size < sizeof(Header) + pHeader->count * sizeof(Section))) {
+        _log(DATA__WARNING, "SnapshotFile: %s is not a snapshot, or is damaged.", path.c_str());
+        Close();
+        return false;
+    }
+
+    Header check(*pHeader);
+    check.crc = 0;
+    uint32 crc = CRC32::Update((const uint8*)&check, sizeof(Header));
+    crc = CRC32::Finish(CRC32::Update(m_data + sizeof(Header), pHeader->count * sizeof(Section), crc));
+    if (crc != pHeader->crc) {
+        _log(DATA__WARNING, "SnapshotFile: %s is damaged.", path.c_str());
+        Close();
+        return false;
+    }
+
+    const Section* pSection = (const Section*)(m_data + sizeof(Header));
+    for (uint32 i = 0; i < pHeader->count; ++i)
+        if ((pSection[i].offset > m_size) or (pSection[i].bytes > m_size - pSection[i].offset)) {
+            _log(DATA__WARNING, "SnapshotFile: %s is cut short.", path.c_str());
+            Close();
+            return false;
+        }
+
+    if ((pHeader->version != version) or (pHeader->hash != hash)) {
+        _log(DATA__MESSAGE, "SnapshotFile: %s is out of date.", path.c_str());
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void SnapshotFile::Close()
+{
+    if (m_data == nullptr)
+        return;
+
+#ifdef _WIN32
+    m_buffer.clear();
+#else
+    munmap((void*)m_data, m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+const void* SnapshotFile::Get(uint32 id, size_t& bytes) const
+{
+    bytes = 0;
+    if (m_data == nullptr)
+        return nullptr;
+
+    const Header* pHeader = (const Header*)m_data;
+    const Section* pSection = (const Section*)(m_data + sizeof(Header));
+    for (uint32 i = 0; i < pHeader->count; ++i)
+        if (pSection[i].id == id) {
+            bytes = pSection[i].bytes;
+            return m_data + pSection[i].offset;
+        }
+
+    return nullptr;
+}
+
+uint64_t SnapshotFile::Hash(const void* data, size_t bytes, uint64_t seed)
+{
+    const uint8* pByte = (const uint8*)data;
+    for (size_t i = 0; i < bytes; ++i) {
+        seed ^= pByte[i];
+        seed *= 0x100000001b3ULL;
+    }
+    return seed;
+}
+
+void SnapshotFile::Writer::Add(uint32 id, const void* data, size_t bytes)
+{
+    m_sections.emplace_back(id, std::string((const char*)data, bytes));
+}
+
+bool SnapshotFile::Writer::Write(const std::string& path, uint32 version, uint64_t hash) const
+{
+    Header header = Header();
+    header.magic = SNAPSHOT_MAGIC;
+    header.format = SNAPSHOT_FORMAT;
+    header.version = version;
+    header.count = (uint32)m_sections.size();
+    header.hash = hash;
+
+    std::vector<Section> table(m_sections.size());
+    size_t offset = Align(sizeof(Header) + table.size() * sizeof(Section));
+    for (size_t i = 0; i < m_sections.size(); ++i) {
+        table[i] = Section();
+        table[i].id = m_sections[i].first;
+        table[i].offset = offset;
+        table[i].bytes = m_sections[i].second.size();
+        offset = Align(offset + table[i].bytes);
+    }
+
+    uint32 crc = CRC32::Update((const uint8*)&header, sizeof(Header));
+    header.crc = CRC32::Finish(CRC32::Update((const uint8*)table.data(), table.size() * sizeof(Section), crc));
+
+    const std::string temp(path + ".tmp");
+    FILE* file = fopen(temp.c_str(), "wb");
+    if (file == nullptr) {
+        _log(DATA__ERROR, "SnapshotFile: unable to create %s.", temp.c_str());
+        return false;
+    }
+
+    static const char zeros[SNAPSHOT_ALIGN] = { 0 };
+    bool ok = (fwrite(&header, sizeof(Header), 1, file) == 1);
+    if (!table.empty())
+        ok = ok and (fwrite(table.data(), sizeof(Section), table.size(), file) == table.size());
+    size_t written = sizeof(Header) + table.size() * sizeof(Section);
+    for (size_t i = 0; ok and (i < m_sections.size()); ++i) {
+        ok = (fwrite(zeros, 1, table[i].offset - written, file) == table[i].offset - written);
+        ok = ok and (fwrite(m_sections[i].second.data(), 1, table[i].bytes, file) == table[i].bytes);
+        written = table[i].offset + table[i].bytes;
+    }
+    ok = (fclose(file) == 0) and ok;
+
+#ifdef _WIN32
+    // rename() won't replace an existing file here
+    remove(path.c_str());
+#endif
+    if (!ok or (rename(temp.c_str(), path.c_str()) != 0)) {
+        _log(DATA__ERROR, "SnapshotFile: unable to write %s.", path.c_str());
+        remove(temp.c_str());
+        return false;
+    }
+
+    return true;
+}
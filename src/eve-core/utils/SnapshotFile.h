@@ -0,0 +1,105 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+
+#ifndef __UTILS__SNAPSHOT_FILE_H__INCL__
+#define __UTILS__SNAPSHOT_FILE_H__INCL__
+
+/**
+ * @brief A file of numbered binary sections, read in place thru mmap.
+ *
+ * The header carries a version (the layout of what the caller puts in the
+ * sections) and a hash (of what the data was made from, e.g. its tables'
+ * checksums); Open() refuses a file if either differs from what the caller
+ * expects, so a stale file is simply rebuilt.  Sections start 16-byte aligned
+ * and are meant to be arrays of plain structs, used straight from the map.
+ *
+ * The header and section table are CRC'd and the sections must lie within
+ * the file; the section data itself isn't checked.  Files are written to a
+ * temporary name and renamed, so a reader never sees half a file.
+ */
+class SnapshotFile
+{
+public:
+    SnapshotFile();
+    ~SnapshotFile()                                     { Close(); }
+
+    /* @return false (with nothing open) if 'path' is missing, damaged, or doesn't match 'version' and 'hash' */
+    bool Open(const std::string& path, uint32 version, uint64_t hash);
+    void Close();
+    bool IsOpen() const                                 { return (m_data != nullptr); }
+
+    /* @return section 'id' and its size in bytes, or nullptr if there's no such section */
+    const void* Get(uint32 id, size_t& bytes) const;
+    /* @return section 'id' as 'count' T's, or nullptr if there's no such section */
+    template<typename T>
+    const T* GetArray(uint32 id, size_t& count) const
+    {
+        size_t bytes(0);
+        const T* data = (const T*)Get(id, bytes);
+        count = bytes / sizeof(T);
+        return data;
+    }
+
+    size_t GetSize() const                              { return m_size; }
+
+    /* FNV-1a; chain calls with the last result as 'seed' to build a hash for Open() */
+    static uint64_t Hash(const void* data, size_t bytes, uint64_t seed = 0xcbf29ce484222325ULL);
+    static uint64_t Hash(const std::string& str, uint64_t seed = 0xcbf29ce484222325ULL)   { return Hash(str.data(), str.size(), seed); }
+
+    /**
+     * @brief Gathers sections, then writes them out as a SnapshotFile.
+     */
+    class Writer
+    {
+    public:
+        Writer()                                        { }
+
+        /* copies 'bytes' of 'data' as section 'id' */
+        void Add(uint32 id, const void* data, size_t bytes);
+        template<typename T>
+        void AddArray(uint32 id, const std::vector<T>& data)    { Add(id, data.data(), data.size() * sizeof(T)); }
+
+        bool Write(const std::string& path, uint32 version, uint64_t hash) const;
+
+    private:
+        std::vector<std::pair<uint32, std::string>> m_sections;
+    };
+
+private:
+    struct Header;
+    struct Section;
+
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    const uint8* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    std::vector<uint8> m_buffer;
+#endif
+};
+
+#endif /* !__UTILS__SNAPSHOT_FILE_H__INCL__ */
@@ -0,0 +1,154 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __UTILS__TIC_LIST_H__INCL__
+#define __UTILS__TIC_LIST_H__INCL__
+
+/**
+ * @brief Dense list of pointers to process once per tic, safe to change while it runs.
+ *
+ * Tic() walks a flat array.  Whatever is added while it runs waits until the
+ * tic is over; whatever is removed has its slot cleared at once, so it is never
+ * called after removal, and the holes are closed when the tic is over.  Every
+ * value present for the whole tic is called exactly once.
+ *
+ * Values must be pointers; nullptr marks a removed slot.
+ */
+template<typename _Key, typename _Ty>
+class TicList
+{
+public:
+    TicList() : m_ticking(false), m_holes(false) { }
+
+    size_t size() const                                 { return m_index.size() + m_pending.size(); }
+    bool empty() const                                  { return size() == 0; }
+
+    void clear()
+    {
+        m_pending.clear();
+        m_index.clear();
+        if (m_ticking) {
+            // keep the slots for the running tic, just empty them
+            for (Slot& cur : m_slots)
+                cur.value = nullptr;
+            m_holes = true;
+        } else {
+            m_slots.clear();
+            m_holes = false;
+        }
+    }
+
+    /* 'key' must not be in the list already */
+    void Add(const _Key& key, _Ty value)
+    {
+        if (m_ticking) {
+            m_pending.push_back(Slot(key, value));
+        } else {
+            m_index[key] = m_slots.size();
+            m_slots.push_back(Slot(key, value));
+        }
+    }
+
+    bool Remove(const _Key& key)
+    {
+        typename std::unordered_map<_Key, size_t>::iterator itr = m_index.find(key);
+        if (itr == m_index.end()) {
+            for (size_t i = 0; i < m_pending.size(); ++i)
+                if (m_pending[i].key == key) {
+                    m_pending.erase(m_pending.begin() + i);
+                    return true;
+                }
+            return false;
+        }
+
+        const size_t idx = itr->second;
+        m_index.erase(itr);
+        if (m_ticking) {
+            m_slots[idx].value = nullptr;
+            m_holes = true;
+        } else {
+            if (idx != m_slots.size() - 1) {
+                m_slots[idx] = m_slots.back();
+                m_index[m_slots[idx].key] = idx;
+            }
+            m_slots.pop_back();
+        }
+        return true;
+    }
+
+    /* calls func(value) once for each value, then applies the changes made meanwhile */
+    template<typename _Func>
+    void Tic(_Func func)
+    {
+        m_ticking = true;
+        // adds are held back, so the size can't change under us
+        for (size_t i = 0, count = m_slots.size(); i < count; ++i)
+            if (m_slots[i].value != nullptr)
+                func(m_slots[i].value);
+        m_ticking = false;
+
+        Flush();
+    }
+
+private:
+    struct Slot
+    {
+        Slot(const _Key& k, _Ty v) : key(k), value(v) { }
+        _Key key;
+        _Ty value;
+    };
+
+    void Flush()
+    {
+        if (m_holes) {
+            size_t count = 0;
+            for (size_t i = 0; i < m_slots.size(); ++i) {
+                if (m_slots[i].value == nullptr)
+                    continue;
+                if (count != i) {
+                    m_slots[count] = m_slots[i];
+                    m_index[m_slots[count].key] = count;
+                }
+                ++count;
+            }
+            m_slots.resize(count, Slot(_Key(), nullptr));
+            m_holes = false;
+        }
+
+        for (const Slot& cur : m_pending) {
+            m_index[cur.key] = m_slots.size();
+            m_slots.push_back(cur);
+        }
+        m_pending.clear();
+    }
+
+    bool m_ticking;
+    bool m_holes;
+    std::vector<Slot> m_slots;
+    std::vector<Slot> m_pending;
+    std::unordered_map<_Key, size_t> m_index;   // key/slot, for what is in m_slots
+};
+
+#endif /* !__UTILS__TIC_LIST_H__INCL__ */
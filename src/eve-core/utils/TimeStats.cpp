@@ -0,0 +1,195 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "utils/TimeStats.h"
+
+std::atomic<bool> TimeStats::s_enabled(false);
+
+TimeStats::Table::Table()
+{
+    for (auto& cur : chunks)
+        cur.store(nullptr, std::memory_order_relaxed);
+}
+
+TimeStats::Table::~Table()
+{
+    for (auto& cur : chunks) {
+        std::atomic<Histogram*>* chunk = cur.load(std::memory_order_relaxed);
+        if (chunk == nullptr)
+            continue;
+        for (uint32 i = 0; i < CHUNK; ++i)
+            delete chunk[i].load(std::memory_order_relaxed);
+        delete[] chunk;
+    }
+}
+
+Histogram* TimeStats::Table::Find(uint32 key) const
+{
+    std::atomic<Histogram*>* chunk = chunks[key / CHUNK].load(std::memory_order_acquire);
+    if (chunk == nullptr)
+        return nullptr;
+    return chunk[key % CHUNK].load(std::memory_order_acquire);
+}
+
+Histogram* TimeStats::Table::Get(uint32 key)
+{
+    std::atomic<Histogram*>* chunk = chunks[key / CHUNK].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        chunk = new std::atomic<Histogram*>[CHUNK];
+        for (uint32 i = 0; i < CHUNK; ++i)
+            chunk[i].store(nullptr, std::memory_order_relaxed);
+        chunks[key / CHUNK].store(chunk, std::memory_order_release);
+    }
+
+    Histogram* pHist = chunk[key % CHUNK].load(std::memory_order_relaxed);
+    if (pHist == nullptr) {
+        pHist = new Histogram();
+        chunk[key % CHUNK].store(pHist, std::memory_order_release);
+    }
+    return pHist;
+}
+
+TimeStats::TimeStats()
+{
+    m_names.push_back("Other");
+    m_keys["Other"] = OTHER_KEY;
+}
+
+TimeStats::~TimeStats()
+{
+    // tables of threads still running stay; their exit still hands them to Retire()
+    for (auto cur : m_retired)
+        SafeDelete(cur);
+}
+
+uint32 TimeStats::GetKey(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto itr = m_keys.find(name);
+    if (itr != m_keys.end())
+        return itr->second;
+
+    if (m_names.size() >= MAX_KEYS)
+        return OTHER_KEY;
+
+    const uint32 key = (uint32)m_names.size();
+    m_names.push_back(name);
+    m_keys[name] = key;
+    return key;
+}
+
+std::string TimeStats::GetName(uint32 key)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (key < m_names.size())
+        return m_names[key];
+    return "";
+}
+
+size_t TimeStats::GetKeyCount()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_names.size();
+}
+
+void TimeStats::Record(uint32 key, double us)
+{
+    if (key >= MAX_KEYS)
+        key = OTHER_KEY;
+    if (us < 0.0)
+        us = 0.0;
+
+    GetTable()->Get(key)->Record((uint64_t)(us * 1000.0));
+}
+
+void TimeStats::Get(uint32 key, Histogram& into)
+{
+    into.Clear();
+    if (key >= MAX_KEYS)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if ((key < m_retired.size()) and (m_retired[key] != nullptr))
+        into.Add(*m_retired[key]);
+    for (auto cur : m_tables) {
+        Histogram* pHist = cur->Find(key);
+        if (pHist != nullptr)
+            into.Add(*pHist);
+    }
+}
+
+void TimeStats::Clear()
+{
+    // a thread recording right now may keep a count or two from before
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (auto cur : m_retired)
+        if (cur != nullptr)
+            cur->Clear();
+    for (auto cur : m_tables)
+        for (uint32 key = 0; key < m_names.size(); ++key) {
+            Histogram* pHist = cur->Find(key);
+            if (pHist != nullptr)
+                pHist->Clear();
+        }
+}
+
+TimeStats::Table* TimeStats::GetTable()
+{
+    // hands the thread's histograms to Retire() when it exits
+    struct Owner
+    {
+        Table* pTable = nullptr;
+        ~Owner() { if (pTable != nullptr) sTimeStats.Retire(pTable); }
+    };
+    static thread_local Owner owner;
+
+    if (owner.pTable == nullptr) {
+        owner.pTable = new Table();
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_tables.push_back(owner.pTable);
+    }
+    return owner.pTable;
+}
+
+void TimeStats::Retire(Table* pTable)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_retired.size() < m_names.size())
+        m_retired.resize(m_names.size(), nullptr);
+
+    for (uint32 key = 0; key < m_names.size(); ++key) {
+        Histogram* pHist = pTable->Find(key);
+        if (pHist == nullptr)
+            continue;
+        if (m_retired[key] == nullptr)
+            m_retired[key] = new Histogram();
+        m_retired[key]->Add(*pHist);
+    }
+
+    m_tables.erase(std::remove(m_tables.begin(), m_tables.end(), pTable), m_tables.end());
+    SafeDelete(pTable);
+}
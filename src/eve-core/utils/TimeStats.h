@@ -0,0 +1,152 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __UTILS__TIME_STATS_H__INCL__
+#define __UTILS__TIME_STATS_H__INCL__
+
+#include <mutex>
+
+#include "utils/Histogram.h"
+#include "utils/Singleton.h"
+#include "utils/utils_time.h"
+
+/**
+ * @brief Named timing histograms, recorded per thread and merged when read.
+ *
+ * A key is a name ("DB", "Service::Method") turned into a number once by
+ * GetKey(); call sites keep the number.  Record() adds to the calling thread's
+ * own Histogram for the key, so threads never share a counter.  Get() merges
+ * all threads' histograms for a key; the histograms of threads that exit are
+ * merged into a per-key total first, so memory stays bounded by threads alive
+ * times keys they used.
+ *
+ * Times are in microseconds, kept at ns resolution.
+ */
+class TimeStats
+: public Singleton<TimeStats>
+{
+public:
+    TimeStats();
+    ~TimeStats();
+
+    /* whether anything should be recorded at all; set by the server's Profiler */
+    static bool IsEnabled()                             { return s_enabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool enabled)                { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+    /* @return the key for 'name', added if new.  past MAX_KEYS names all share OTHER_KEY */
+    uint32 GetKey(const std::string& name);
+    std::string GetName(uint32 key);
+    size_t GetKeyCount();
+
+    void Record(uint32 key, double us);
+
+    /* sets 'into' to the merged histogram of 'key', values in ns */
+    void Get(uint32 key, Histogram& into);
+    void Clear();
+
+    static const uint32 MAX_KEYS = 4096;
+    static const uint32 OTHER_KEY = 0;
+
+private:
+    static const uint32 CHUNK = 64;
+
+    /* one thread's histograms, by key; only the owning thread adds to it */
+    struct Table
+    {
+        Table();
+        ~Table();
+
+        Histogram* Find(uint32 key) const;
+        Histogram* Get(uint32 key);
+
+        std::atomic<std::atomic<Histogram*>*> chunks[MAX_KEYS / CHUNK];
+    };
+
+    Table* GetTable();
+    void Retire(Table* pTable);
+
+    std::mutex m_lock;
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, uint32> m_keys;
+    std::vector<Table*> m_tables;
+    /* merged histograms of threads that exited, by key */
+    std::vector<Histogram*> m_retired;
+
+    static std::atomic<bool> s_enabled;
+};
+
+//Singleton
+#define sTimeStats \
+    ( TimeStats::get() )
+
+/**
+ * @brief A fixed TimeStats key for a static at a call site, registered on first use.
+ *
+ * Keeps call sites from touching sTimeStats before profiling is turned on.
+ */
+class TimeStatsKey
+{
+public:
+    TimeStatsKey(const char* name)
+    : m_name(name),
+    m_key(UINT32_MAX)                                   { }
+
+    uint32 Get()
+    {
+        uint32 key = m_key.load(std::memory_order_relaxed);
+        if (key == UINT32_MAX) {
+            key = sTimeStats.GetKey(m_name);
+            m_key.store(key, std::memory_order_relaxed);
+        }
+        return key;
+    }
+
+private:
+    const char* m_name;
+    std::atomic<uint32> m_key;
+};
+
+/**
+ * @brief Records the time from construction to destruction (a scope) under a TimeStats key.
+ *
+ * Does nothing while TimeStats is disabled.
+ */
+class TimeStatsScope
+{
+public:
+    TimeStatsScope(uint32 key)
+    : m_key(key),
+    m_start(TimeStats::IsEnabled() ? GetTimeUSeconds() : 0.0)   { }
+    TimeStatsScope(TimeStatsKey& key)
+    : m_key(TimeStats::IsEnabled() ? key.Get() : TimeStats::OTHER_KEY),
+    m_start(TimeStats::IsEnabled() ? GetTimeUSeconds() : 0.0)   { }
+    ~TimeStatsScope()                                   { if (m_start > 0.0) sTimeStats.Record(m_key, GetTimeUSeconds() - m_start); }
+
+private:
+    uint32 m_key;
+    double m_start;
+};
+
+#endif /* !__UTILS__TIME_STATS_H__INCL__ */
@@ -0,0 +1,211 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "utils/TimerWheel.h"
+
+TimerWheel::TimerWheel()
+: m_time(0),
+m_count(0),
+m_free(sNone)
+{
+    for (uint8 level = 0; level < sLevels; ++level)
+        for (uint32 slot = 0; slot < sSlots; ++slot)
+            m_slots[level][slot] = sNone;
+}
+
+TimerWheel::TimerID TimerWheel::Schedule(uint32 delay, std::function<void()> callback)
+{
+    // keep clear of the wrap of the 32 bit clock
+    if (delay > 0x7FFFFFFF)
+        delay = 0x7FFFFFFF;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    int32 index(m_free);
+    if (index == sNone) {
+        index = (int32)m_nodes.size();
+        m_nodes.push_back(Node());
+        m_nodes.back().generation = 1;
+    } else {
+        m_free = m_nodes[index].next;
+    }
+
+    Node& node = m_nodes[index];
+    node.expires = m_time + delay + 1;
+    node.callback = std::move(callback);
+    Insert(index);
+    ++m_count;
+
+    return ((TimerID)node.generation << 32) | (uint32)index;
+}
+
+bool TimerWheel::Cancel(TimerID id)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    Node* pNode = Lookup(id);
+    if (pNode == nullptr)
+        return false;
+
+    const int32 index = (int32)(id & 0xFFFFFFFF);
+    Unlink(index);
+    Free(index);
+    return true;
+}
+
+bool TimerWheel::Pending(TimerID id)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return (Lookup(id) != nullptr);
+}
+
+uint32 TimerWheel::GetRemainingTime(TimerID id)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    Node* pNode = Lookup(id);
+    if (pNode == nullptr)
+        return 0;
+    return pNode->expires - m_time;
+}
+
+void TimerWheel::Advance(uint32 now)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    while ((int32)(now - m_time) > 0) {
+        if (m_count == 0) {
+            // nothing to wait for, skip ahead
+            m_time = now;
+            break;
+        }
+
+        ++m_time;
+        // entering a new block of a level; move its timers down.  higher levels only when the lower wraps
+        for (uint8 level = 1; level < sLevels; ++level) {
+            if ((m_time >> (8 * (level - 1))) & 0xFF)
+                break;
+            Cascade(level);
+        }
+
+        // one at a time, as a callback may cancel the next one
+        int32& head = m_slots[0][m_time & 0xFF];
+        while (head != sNone) {
+            const int32 index = head;
+            Unlink(index);
+            std::function<void()> callback(std::move(m_nodes[index].callback));
+            Free(index);
+
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+}
+
+TimerWheel::Node* TimerWheel::Lookup(TimerID id)
+{
+    const uint32 index = (uint32)(id & 0xFFFFFFFF);
+    if (index >= m_nodes.size())
+        return nullptr;
+
+    Node& node = m_nodes[index];
+    if ((node.generation != (uint32)(id >> 32)) or (node.pHead == nullptr))
+        return nullptr;
+    return &node;
+}
+
+void TimerWheel::Insert(int32 index)
+{
+    Node& node = m_nodes[index];
+    const uint32 delta = node.expires - m_time;
+
+    uint8 level(0);
+    if (delta >= (1u << 24)) {
+        level = 3;
+    } else if (delta >= (1u << 16)) {
+        level = 2;
+    } else if (delta >= (1u << 8)) {
+        level = 1;
+    }
+
+    int32& head = m_slots[level][(node.expires >> (8 * level)) & 0xFF];
+    node.prev = sNone;
+    node.next = head;
+    node.pHead = &head;
+    if (head != sNone)
+        m_nodes[head].prev = index;
+    head = index;
+}
+
+void TimerWheel::Unlink(int32 index)
+{
+    Node& node = m_nodes[index];
+    if (node.prev == sNone) {
+        *node.pHead = node.next;
+    } else {
+        m_nodes[node.prev].next = node.next;
+    }
+    if (node.next != sNone)
+        m_nodes[node.next].prev = node.prev;
+
+    node.prev = node.next = sNone;
+    node.pHead = nullptr;
+}
+
+void TimerWheel::Free(int32 index)
+{
+    Node& node = m_nodes[index];
+    node.callback = nullptr;
+    ++node.generation;
+    if (node.generation == 0)
+        node.generation = 1;
+    node.next = m_free;
+    m_free = index;
+    --m_count;
+}
+
+void TimerWheel::Cascade(uint8 level)
+{
+    int32& head = m_slots[level][(m_time >> (8 * level)) & 0xFF];
+    int32 index = head;
+    head = sNone;
+    while (index != sNone) {
+        const int32 next = m_nodes[index].next;
+        Insert(index);
+        index = next;
+    }
+}
+
+void WheelTimer::Start(uint32 delay, std::function<void()> callback)
+{
+    Cancel();
+    m_id = sTimerWheel.Schedule(delay, std::move(callback));
+}
+
+void WheelTimer::Cancel()
+{
+    if (m_id != 0)
+        sTimerWheel.Cancel(m_id);
+    m_id = 0;
+}
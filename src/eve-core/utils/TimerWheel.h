@@ -0,0 +1,129 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __UTILS__TIMER_WHEEL_H__INCL__
+#define __UTILS__TIMER_WHEEL_H__INCL__
+
+#include <mutex>
+
+#include "utils/Singleton.h"
+
+/**
+ * @brief Calls a function once a delay has passed, without polling.
+ *
+ * Timers sit in a hierarchical wheel: four levels of 256 slots at 1ms,
+ * 256ms, 65s and 4.6h resolution.  Schedule() and Cancel() are O(1).
+ * Advance() only looks at the slots the clock passes and moves a coarse
+ * slot's timers down a level when the clock reaches it, so a timer that is
+ * hours away costs nothing until it is close.
+ *
+ * Time is in ms, on the same clock as Timer (Timer::Now()).  A timer started
+ * with 'delay' fires at the first Advance() at least delay + 1ms later, the
+ * same point Timer::Check() would first return true.
+ *
+ * Callbacks run from Advance(), with no lock held, and may schedule or cancel
+ * timers (their own included).
+ */
+class TimerWheel
+: public Singleton<TimerWheel>
+{
+public:
+    typedef uint64_t TimerID;   // 0 is never a valid id
+
+    TimerWheel();
+    ~TimerWheel()                                       { /* do nothing here */ }
+
+    TimerID Schedule(uint32 delay, std::function<void()> callback);
+    /* @return false if the timer already fired or was cancelled */
+    bool Cancel(TimerID id);
+
+    bool Pending(TimerID id);
+    /* ms until the timer fires, 0 if it isn't pending */
+    uint32 GetRemainingTime(TimerID id);
+
+    /* fires every timer due up to 'now' */
+    void Advance(uint32 now);
+
+    size_t size() const                                 { return m_count; }
+
+private:
+    static const uint8 sLevels = 4;
+    static const uint32 sSlots = 256;
+    static const int32 sNone = -1;
+
+    struct Node
+    {
+        uint32 generation;  // bumped when the node is freed, so stale ids miss
+        uint32 expires;
+        int32 prev;
+        int32 next;
+        int32* pHead;       // list the node is in, nullptr when free
+        std::function<void()> callback;
+    };
+
+    Node* Lookup(TimerID id);
+    void Insert(int32 index);
+    void Unlink(int32 index);
+    void Free(int32 index);
+    void Cascade(uint8 level);
+
+    std::mutex m_lock;
+    uint32 m_time;          // last ms processed
+    size_t m_count;
+    int32 m_free;           // free list, chained through Node::next
+    std::vector<Node> m_nodes;
+    int32 m_slots[sLevels][sSlots];
+};
+
+//Singleton
+#define sTimerWheel \
+    ( TimerWheel::get() )
+
+/**
+ * @brief One callback on sTimerWheel, owned by the object it calls into.
+ *
+ * Cancels whatever is pending when it is restarted or destroyed, so the
+ * callback never runs on an object that is gone.
+ */
+class WheelTimer
+{
+public:
+    WheelTimer() : m_id(0)                              { }
+    ~WheelTimer()                                       { Cancel(); }
+
+    void Start(uint32 delay, std::function<void()> callback);
+    void Cancel();
+
+    bool Enabled() const                                { return (m_id != 0) and sTimerWheel.Pending(m_id); }
+    uint32 GetRemainingTime() const                     { return (m_id == 0 ? 0 : sTimerWheel.GetRemainingTime(m_id)); }
+
+private:
+    WheelTimer(const WheelTimer&) = delete;
+    WheelTimer& operator=(const WheelTimer&) = delete;
+
+    TimerWheel::TimerID m_id;
+};
+
+#endif /* !__UTILS__TIMER_WHEEL_H__INCL__ */
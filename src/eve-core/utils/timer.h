@@ -51,6 +51,8 @@ public:
     bool Check(bool reset = true);
 
     static const void SetCurrentTime();
+    // the clock all timers run on, in ms
+    static uint32 Now();
     // return remaining time in ms
     uint32 GetRemainingTime() const;
     uint32 GetCurrentTime();
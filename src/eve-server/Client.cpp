@@ -121,7 +121,6 @@ Client::Client(EVEServiceManager& services, EVETCPConnection** con)
     //m_toGate = 0;
     m_locationID = 0;
     m_moveSystemID = 0;
-    m_skillTimer = 0;
     m_dockStationID = 0;
 
     m_lpMap.clear();
@@ -352,6 +351,25 @@ bool Client::SelectCharacter(int32 charID/*0*/)
     return (m_loaded = true);
 }
 
+void Client::SetTrainingEndTime(int64 endTime)
+{
+    if (endTime <= 0) {
+        m_skillTimer.Cancel();
+        return;
+    }
+
+    // round up to the next ms, so the skill is done when this hits
+    int64 delay = (int64)((endTime - GetFileTimeNow()) *1000 / Win32Time_Second) + 1;
+    if (delay < 0)
+        delay = 0;
+    if (delay > 0x7FFFFFFF)
+        delay = 0x7FFFFFFF;
+    m_skillTimer.Start((uint32)delay, [this]() {
+        if (m_char.get() != nullptr)
+            m_char->SkillQueueLoop();
+    });
+}
+
 void Client::ProcessClient() {
     if (m_charCreation)
         return;
@@ -364,10 +382,6 @@ void Client::ProcessClient() {
         m_char->SetLogonMinutes();
     }
 
-    if (m_skillTimer > 0)
-        if (m_skillTimer < GetFileTimeNow())
-            m_char->SkillQueueLoop();
-
     if (m_sessionTimer.Check(false)) {
         _log(CLIENT__TIMER, "Client::ProcessClient():  SetSessionChange to false for %s(%u)", m_char->name(), m_char->itemID());
         m_sessionTimer.Disable();
@@ -337,7 +337,8 @@ public:
     void InitSession( int32 characterID  );
 
     // skill training timer shit
-    void SetTrainingEndTime(int64 endTime)              { m_skillTimer = endTime; }
+    // calls SkillQueueLoop() once 'endTime' (filetime) is reached.  0 stops the timer
+    void SetTrainingEndTime(int64 endTime);
 
 protected:
     ServiceDB m_sDB;
@@ -413,7 +414,7 @@ protected:
     std::set<LSCChannel*>   m_channels;    //we do not own these.
     std::map<uint32, bool>  m_hangarLoaded;
 
-    int64                   m_skillTimer;
+    WheelTimer              m_skillTimer;
 
     int8                    m_clientState;
 
@@ -235,6 +235,9 @@ bool ConsoleCommand::HandleCommand(const char* buf)
         sLog.Warning("    Server UpTime", " %s", uptime.c_str());
         //  loaded items
         sLog.Warning("     Loaded Items", " %u", sItemFactory.Count());
+        //  item write-behind
+        sLog.Warning("    Changed Items", " %u  (%u rows saved, last pass %.3fms)", \
+            sItemFactory.DirtyCount(), sItemFactory.SavedRows(), sItemFactory.LastSaveTime());
         //  loaded NPCs
         sLog.Warning("      Loaded NPCs", " %u", sEntityList.GetNPCCount());
         //  loaded systems
@@ -73,6 +73,9 @@ EVEServerConfig::EVEServerConfig()
     world.loginMsg = false;//N
     world.saveOnMove = false;
     world.saveOnUpdate = false;
+    world.saveInterval = 60 /*s*/;
+    world.saveBatch = 500;
+    world.walletInterval = 2 /*s*/;
     world.shootRoids = false;
     world.shootWrecks = false;
     world.mailDelay = 5;//N
@@ -224,6 +227,7 @@ EVEServerConfig::EVEServerConfig()
     // testing
     testing.EnableDrones = false;
     testing.ShipHeat = false;
+    testing.StackingPenalty = false;
 
     // debug
     debug.BeanCount = false;
@@ -250,6 +254,8 @@ EVEServerConfig::EVEServerConfig()
     database.autoReconnect = false;
     database.dbTimeout = 2/*s*/;
     database.pingTime = 10/*m*/;
+    database.poolSize = 2;
+    database.loaderThreads = 4;
 
     // files
     files.logDir = "../log/";
@@ -257,9 +263,11 @@ EVEServerConfig::EVEServerConfig()
     files.cacheDir = "../server_cache/";
     files.imageDir = "../image_cache/";
     files.marketBotSettings = "../etc/MarketBot.xml";
+    files.staticSnapshot = "";
 
     // net
     net.port = 26000;
+    net.useReactor = true;
     net.imageServer = "localhost";
     net.imageServerPort = 26001;
 
@@ -267,8 +275,9 @@ EVEServerConfig::EVEServerConfig()
     threads.ConsoleThreads = 1;//P
     threads.DatabaseThreads = 2;//N
     threads.ImageServerThreads = 1;//N
-    threads.NetworkThreads = 2;//N
-    threads.WorldThreads = 2;//N
+    threads.NetworkThreads = 2;//P  (TCPReactor)
+    threads.WorldThreads = 1;//P  (system tics, EntityList)
+    threads.LogThreads = 0;//P  (LogQueue)
 }
 
 bool EVEServerConfig::ProcessEveServer( const TiXmlElement* ele )
@@ -378,6 +387,9 @@ bool EVEServerConfig::ProcessWorld( const TiXmlElement* ele )
     AddValueParser( "loginMsg",          world.loginMsg );
     AddValueParser( "saveOnMove",        world.saveOnMove );
     AddValueParser( "saveOnUpdate",      world.saveOnUpdate );
+    AddValueParser( "saveInterval",      world.saveInterval );
+    AddValueParser( "saveBatch",         world.saveBatch );
+    AddValueParser( "walletInterval",    world.walletInterval );
     AddValueParser( "highSecCyno",       world.highSecCyno );
     AddValueParser( "mailDelay",         world.mailDelay );
     AddValueParser( "shootRoids",        world.shootRoids );
@@ -396,6 +408,9 @@ bool EVEServerConfig::ProcessWorld( const TiXmlElement* ele )
     RemoveParser( "loginMsg" );
     RemoveParser( "saveOnMove" );
     RemoveParser( "saveOnUpdate" );
+    RemoveParser( "saveInterval" );
+    RemoveParser( "saveBatch" );
+    RemoveParser( "walletInterval" );
     RemoveParser( "highSecCyno" );
     RemoveParser( "mailDelay" );
     RemoveParser( "shootRoids" );
@@ -620,6 +635,8 @@ bool EVEServerConfig::ProcessDatabase( const TiXmlElement* ele )
     AddValueParser( "autoReconnect",    database.autoReconnect );
     AddValueParser( "dbTimeout",        database.dbTimeout );
     AddValueParser( "pingTime",         database.pingTime );
+    AddValueParser( "poolSize",         database.poolSize );
+    AddValueParser( "loaderThreads",    database.loaderThreads );
 
     const bool result = ParseElementChildren( ele );
 
@@ -634,6 +651,8 @@ bool EVEServerConfig::ProcessDatabase( const TiXmlElement* ele )
     RemoveParser( "autoReconnect" );
     RemoveParser( "dbTimeout" );
     RemoveParser( "pingTime" );
+    RemoveParser( "poolSize" );
+    RemoveParser( "loaderThreads" );
 
     return result;
 }
@@ -644,6 +663,7 @@ bool EVEServerConfig::ProcessFiles( const TiXmlElement* ele )
     AddValueParser( "logSettings",      files.logSettings );
     AddValueParser( "cacheDir",         files.cacheDir );
     AddValueParser( "imageDir",         files.imageDir );
+    AddValueParser( "staticSnapshot",   files.staticSnapshot );
 
     const bool result = ParseElementChildren( ele );
 
@@ -651,6 +671,7 @@ bool EVEServerConfig::ProcessFiles( const TiXmlElement* ele )
     RemoveParser( "logSettings" );
     RemoveParser( "cacheDir" );
     RemoveParser( "imageDir" );
+    RemoveParser( "staticSnapshot" );
 
     return result;
 }
@@ -658,12 +679,14 @@ bool EVEServerConfig::ProcessFiles( const TiXmlElement* ele )
 bool EVEServerConfig::ProcessNet( const TiXmlElement* ele )
 {
     AddValueParser( "port",             net.port );
+    AddValueParser( "useReactor",       net.useReactor );
     AddValueParser( "imageServerPort",  net.imageServerPort);
     AddValueParser( "imageServer",      net.imageServer);
 
     const bool result = ParseElementChildren( ele );
 
     RemoveParser( "port" );
+    RemoveParser( "useReactor" );
     RemoveParser( "imageServerPort" );
     RemoveParser( "imageServer" );
 
@@ -677,6 +700,7 @@ bool EVEServerConfig::ProcessThreads( const TiXmlElement* ele )
     AddValueParser( "ImageServerThreads",   threads.ImageServerThreads);
     AddValueParser( "NetworkThreads",       threads.NetworkThreads );
     AddValueParser( "WorldThreads",         threads.WorldThreads);
+    AddValueParser( "LogThreads",           threads.LogThreads);
 
     const bool result = ParseElementChildren( ele );
 
@@ -685,6 +709,7 @@ bool EVEServerConfig::ProcessThreads( const TiXmlElement* ele )
     RemoveParser( "ImageServerThreads" );
     RemoveParser( "NetworkThreads" );
     RemoveParser( "WorldThreads" );
+    RemoveParser( "LogThreads" );
 
     return result;
 }
@@ -852,11 +877,13 @@ bool EVEServerConfig::ProcessTesting(const TiXmlElement* ele)
 {
     AddValueParser( "ShipHeat",             testing.ShipHeat );
     AddValueParser( "EnableDrones",         testing.EnableDrones);
+    AddValueParser( "StackingPenalty",      testing.StackingPenalty );
 
     const bool result = ParseElementChildren( ele );
 
     RemoveParser( "ShipHeat" );
     RemoveParser( "EnableDrones" );
+    RemoveParser( "StackingPenalty" );
 
     return result;
 }
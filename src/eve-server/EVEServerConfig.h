@@ -85,6 +85,9 @@ public:
         uint16 shipBoardDistance;
         uint16 gridUnloadTime;
         uint16 apWarptoDistance;
+        uint16 saveInterval;
+        uint16 saveBatch;
+        uint16 walletInterval;
     } world;
 
     // From <rates>
@@ -215,6 +218,10 @@ public:
         bool autoReconnect;
         uint dbTimeout;
         uint8 pingTime;
+        /// Extra connections for async queries; 0 runs them on the main connection.
+        uint8 poolSize;
+        /// Threads (each with its own connection) loading static data at startup; 0 or 1 loads it on the main thread.
+        uint8 loaderThreads;
         /// A port at which the database server listens.
         uint16 port;
         /// Hostname of database server.
@@ -239,12 +246,16 @@ public:
         std::string imageDir;
         // used as the path for the MarketBot.xml settings file
         std::string marketBotSettings;
+        /// A file to keep a snapshot of the static data in, for faster startup.  empty to not use one.
+        std::string staticSnapshot;
     } files;
 
     // From <net>
     struct {
         /// Port at which the server should listen.
         uint16 port;
+        /// Use epoll reactor threads (threads.NetworkThreads) for client sockets instead of a thread per connection.
+        bool useReactor;
         /// Port at which the imageServer should listen.
         uint16 imageServerPort;
         /// the imageServer for char images. should be the evemu server external ip/host
@@ -256,6 +267,8 @@ public:
         uint8 NetworkThreads;
         uint8 DatabaseThreads;
         uint8 WorldThreads;
+        /// 1: print log lines on a background thread (LogQueue), 0: on the thread logging them.
+        uint8 LogThreads;
         uint8 ImageServerThreads;
         uint8 ConsoleThreads;
     } threads;
@@ -326,6 +339,7 @@ public:
     struct {
         bool ShipHeat;
         bool EnableDrones;
+        bool StackingPenalty;
     } testing;
 
     // From <debug>
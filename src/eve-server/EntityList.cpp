@@ -33,6 +33,7 @@
 #include "EntityList.h"
 #include "EVEServerConfig.h"
 #include "ServiceDB.h"
+#include "account/WalletMgr.h"
 #include "agents/Agent.h"
 #include "exploration/Probes.h"
 #include "map/MapDB.h"
@@ -66,7 +67,6 @@ m_clientSeedID(0)
     m_players.clear();
     m_systems.clear();
     m_stations.clear();
-    m_targMgrs.clear();
     m_corpMembers.clear();
 
     m_shipTracking = sConfig.debug.UseShipTracking;
@@ -80,7 +80,7 @@ void EntityList::Initialize() {
     m_startTime = GetFileTimeNow();
 
     /* start the timers */
-    m_targTimer.Start(250);     // testing targeting and scan probes at 4/sec
+    m_targTimer.Start(250);     // scan probes at 4/sec
     m_stampTimer.Start(1000);   // 1hz tic timer
     m_minuteTimer.Start(60000); // does this need to be accurate?
 
@@ -90,6 +90,11 @@ void EntityList::Initialize() {
     if (is_log_enabled(SERVER__STACKTRACE))
         sConfig.debug.StackTrace = true;
 
+    if (sConfig.threads.WorldThreads > 1) {
+        m_ticPool.Start(sConfig.threads.WorldThreads);
+        sLog.Warning("       EntityList", "System tics running on %u threads.", sConfig.threads.WorldThreads);
+    }
+
     sLog.Blue("       EntityList", "Entity Manager Initialized.");
 }
 
@@ -103,6 +108,7 @@ void EntityList::Shutdown() {
         SafeDelete(cur);
 
     m_clients.clear();
+    m_ticPool.Stop();
 }
 
 void EntityList::Close()
@@ -186,6 +192,9 @@ void EntityList::RemovePlayer(Client* pClient)
 
 
 void EntityList::Process() {
+    // results of async db queries
+    sDatabase.ProcessCompletions();
+
     Client* pClient(nullptr);
     std::vector<Client*>::iterator citr = m_clients.begin();
     while (citr != m_clients.end()) {
@@ -199,14 +208,6 @@ void EntityList::Process() {
     }
 
     if (m_targTimer.Check()) {
-        std::unordered_map<SystemEntity*, TargetManager*>::iterator titr = m_targMgrs.begin();
-        while (titr != m_targMgrs.end()) {
-            if (titr->second->Process()) {
-                ++titr;
-            } else {
-                titr = m_targMgrs.erase(titr);
-            }
-        }
         std::map<uint32, ProbeSE*>::iterator pitr = m_probes.begin();
         while (pitr != m_probes.end()) {
             if (pitr->second->ProcessTic()) {
@@ -221,34 +222,53 @@ void EntityList::Process() {
     if (m_stampTimer.Check()) {
         double profileStartTime(GetTimeUSeconds());
 
+        // marshal output since last tic; counters are reset on every read
+        size_t walked(0), copied(0);
+        GetMarshalStats(walked, copied);
+        _log(NET__MARSHAL_STATS, "Stamp %u: %u bytes marshaled, %u bytes copied from encoded data.", m_stamp, (uint32)walked, (uint32)copied);
+
         ++m_stamp;
 
         for (auto cur : m_players)
             if (cur.second->IsValidSession())   // verify client is constructed before calling ProcessClient() on it
                 cur.second->ProcessClient();
 
-    /** @todo test for adding OpenMP here to enable MP per system. */
-    // this wont work....possibility of removing systems, therefore invalidating the iterator.
-    // bad things can happen if this is running parallel on MP
-    //#pragma omp parallel  // starts a new team
+        /* systems tic independently, so they may run in parallel (threads.WorldThreads).
+         *  whatever a system does outside itself goes through Stage() and is run after all systems are done,
+         *  and systems are only unloaded after that, so m_systems doesn't change while they run.
+         */
+        std::vector<SystemManager*> systems;
+        systems.reserve(m_systems.size());
         std::map<uint32, SystemManager*>::iterator itr = m_systems.begin();
         while (itr != m_systems.end()) {
             if (itr->second == nullptr) { /* this shouldnt happen.  log error to make note */
                 sLog.Error(" EntityList::Proc", "Deleting System %u", itr->first);
                 itr = m_systems.erase(itr);
                 continue;
-            } else if (!itr->second->ProcessTic()) {    /* Process each loaded system */
-                itr->second->UnloadSystem();
-                SafeDelete(itr->second);
-                itr = m_systems.erase(itr);
-                continue;
             }
+            systems.push_back(itr->second);
             ++itr;
         }
 
+        std::vector<uint8> keep(systems.size(), 1);     // not vector<bool>, workers write neighbouring entries
+        m_staged.Reset(m_ticPool.size());
+        m_ticPool.Run(systems.size(), [&](size_t i) { keep[i] = systems[i]->ProcessTic(); });
+        m_staged.Commit();
+
+        for (size_t i = 0; i < systems.size(); ++i) {
+            if (keep[i])
+                continue;
+            SystemManager* pSM = systems[i];
+            m_systems.erase(pSM->GetID());
+            pSM->UnloadSystem();
+            SafeDelete(pSM);
+        }
+
         // these need 1Hz tics
         sCivMgr.Process();
         sBubbleMgr.Process();
+        sItemFactory.Process();     // item write-behind
+        sWalletMgr.Process();       // wallet write-behind
 
         // these minute tics do not need to be precise
         if (m_minuteTimer.Check()) {
@@ -34,8 +34,7 @@
 
 #include "inventory/ItemRef.h"
 
-// this is not used.  was supposed to be for eventual MT work
-//#include "threading/Mutex.h"
+#include "threading/WorkerPool.h"
 
 class Agent;
 class Client;
@@ -46,7 +45,6 @@ class ProbeSE;
 class PyTuple;
 class EVEServiceManager;
 class SystemEntity;
-class TargetManager;
 
 typedef enum {
     NOTIF_DEST__LOCATION,
@@ -152,18 +150,17 @@ public:
     void Multicast(const character_set &cset, const char* notifyType, const char* idType, PyTuple** payload, bool seq=true) const;
     void Unicast(uint32 charID, const char* notifyType, const char* idType, PyTuple** payload, bool seq=true);
 
-    //testing target tics in <1hz
-    // add SE* and targMgr* to map
-    void AddTargMgr(SystemEntity* pSE, TargetManager* pTM)
-                                                        { m_targMgrs.emplace(pSE, pTM); }
-    // remove SE* and targMgr* from map
-    void DeleteTargMgr(SystemEntity* pSE)               { m_targMgrs.erase(pSE); }
-
     // add ProbeSE* to map
     void AddProbe(uint32 probeID, ProbeSE* pSE)         { m_probes[probeID] = pSE; }
     // remove ProbeSE* from map
     void RemoveProbe(uint32 probeID)                    { m_probes.erase(probeID); }
 
+    /* for anything a system tic does outside its own system (other systems, items, db, other clients).
+     *  called during a parallel system tic, 'call' is held until all systems are done and then
+     *  run on the main thread, ordered by system.  anywhere else it is run at once.
+     */
+    void Stage(std::function<void()> call)              { m_staged.Add(std::move(call)); }
+
 
 protected:
     EVEServiceManager* m_services;    //we do not own this, only used for booting systems.
@@ -183,13 +180,14 @@ private:
     std::map<uint32, Client*> m_players;
     std::set<int64> m_sessions;
     std::map<uint32, SystemManager*> m_systems;
+    // system tics, threads.WorldThreads wide
+    WorkerPool m_ticPool;
+    StagedCalls m_staged;
     std::map<uint32, StationItemRef> m_stations;
     std::vector<std::string> m_anomIDs;
     std::map<uint32, Agent*> m_agents;
 
-    //testing target tics in <1hz
-    std::unordered_map<SystemEntity*, TargetManager*> m_targMgrs;
-    // also running scan probes at sub-hz tics
+    // running scan probes at sub-hz tics
     std::map<uint32, ProbeSE*> m_probes;
 
     // make list for corp members and their roles for easy access of notifications etc.
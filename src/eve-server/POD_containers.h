@@ -332,8 +332,16 @@ struct StaticData {
     GPoint position;
 };
 
+/* POD structure for where a station is. */
+struct StationLocation {
+    uint32 systemID;
+    uint32 constellationID;
+    uint32 regionID;
+};
+
 /* POD structure for attribute type data. */
 struct AttrTypeData {
+    bool stackable;
     uint8 categoryID;
     uint8 attributeCategory;
     uint16 attributeID;
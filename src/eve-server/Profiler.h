@@ -7,11 +7,13 @@
  */
 
 /**   Allan's EvEmu Profiler
- * simple singleton profiler using std::vector<double> being simple mem object storage.
- * vector object denotes call type, (db, client, map, etc.)
- * double precision float holds elapsed time for that particular call
- * output functions use size() to count calls, and give readouts as
- *     CALL_TYPE: called N times, hi: Xus, lo: Yus, avg: Zus
+ * simple singleton profiler over the per-thread timing histograms of TimeStats.
+ * key denotes call type, (db, client, map, etc.); each gets a fixed-size histogram,
+ *  so long runs cost no more memory than short ones.
+ * besides the keys below, TimeStats also has a key per called service method,
+ *  per db query and for marshal/deflate of outgoing packets.
+ * output functions give readouts as
+ *     CALL_TYPE: called N times, p50: Aus, p90: Bus, p99: Cus, max: Dus, avg: Eus
  *  Times are measured in microseconds via GetTimeUSeconds() from core/utils/utils_time.cpp
  *
  */
@@ -55,11 +57,22 @@ namespace Profile {
     };
 }
 
+/* one key's readout, times in us */
+struct ProfileStats {
+    std::string name;
+    uint64_t count;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+    double avg;
+};
+
 class Profiler
 : public Singleton<Profiler>
 {
 public:
-    Profiler() {};
+    Profiler();
     ~Profiler() {};
 
     int Initialize();
@@ -71,39 +84,19 @@ public:
 
     void GetSize(size_t cSize, std::string& ret);
 
-    void GetRunTimes(std::vector< double >& container, float& h, float& l, float& a);
+    /* every key called since the last ClearAll(), slowest p99 first */
+    void GetStats(std::vector<ProfileStats>& into);
 
 protected:
     std::string GetKeyName(uint8& key);
 
 private:
-    std::vector<double> m_server;
-    std::vector<double> m_functions;
-    std::vector<double> m_db;
-    std::vector<double> m_client;
-    std::vector<double> m_map;
-    std::vector<double> m_destiny;
-    std::vector<double> m_system;
-    std::vector<double> m_entityS;
-    std::vector<double> m_npc;
-    std::vector<double> m_drone;
-    std::vector<double> m_bubbles;
-    std::vector<double> m_items;
-    std::vector<double> m_itemload;
-    std::vector<double> m_modules;
-    std::vector<double> m_ship;
-    std::vector<double> m_targets;
-    std::vector<double> m_ontarget;
-    std::vector<double> m_missile;
-    std::vector<double> m_loot;
-    std::vector<double> m_salvage;
-    std::vector<double> m_spawn;
-    std::vector<double> m_collision;
-    std::vector<double> m_concord;
-    std::vector<double> m_colony;
-    std::vector<double> m_damage;
-    std::vector<double> m_effects1;
-    std::vector<double> m_effects2;
+    void GetStats(uint32 timeKey, ProfileStats& into);
+    void PrintLine(const char* label, uint8 key);
+    void PrintSlowest(size_t count);
+
+    // TimeStats key of each Profile:: key
+    uint32 m_keys[Profile::onTarg + 1];
 };
 
 #define sProfiler \
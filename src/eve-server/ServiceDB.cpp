@@ -362,135 +362,6 @@ PyRep* ServiceDB::LookupChars(const char *match, bool exact) {
 }
 
 
-PyRep* ServiceDB::LookupOwners(const char *match, bool exact) {
-    DBQueryResult res;
-
-    std::string matchEsc;
-    sDatabase.DoEscapeString(matchEsc, match);
-
-    // so each row needs "ownerID", "ownerName", and "groupID"
-    // ownerID      =  itemID
-    // ownerName    =  name
-    // groupID      = 1 for character, 2 for corporation, 32 for alliance
-
-    sDatabase.RunQuery(res,
-        "SELECT"
-        "  characterID AS ownerID,"
-        "  characterName AS ownerName,"
-        "  1 AS groupID"
-        " FROM chrCharacters"
-        " WHERE characterName %s '%s'", (exact?"=":"LIKE"), matchEsc.c_str());
-
-    sDatabase.RunQuery(res,
-        "SELECT"
-        "  corporationID AS ownerID,"
-        "  corporationName AS ownerName,"
-        "  2 AS groupID"
-        " FROM crpCorporation"
-        " WHERE corporationName %s '%s'", (exact?"=":"LIKE"), matchEsc.c_str());
-
-    sDatabase.RunQuery(res,
-        "SELECT"
-        "  corporationID AS ownerID,"
-        "  corporationName AS ownerName,"
-        "  2 AS groupID"
-        " FROM crpCorporation"
-        " WHERE tickerName %s '%s'", (exact?"=":"LIKE"), matchEsc.c_str());
-
-    sDatabase.RunQuery(res,
-        "SELECT"
-        "  allianceID AS ownerID,"
-        "  allianceName AS ownerName,"
-        "  32 AS groupID"
-        " FROM alnAlliance"
-        " WHERE allianceName %s '%s'", (exact?"=":"LIKE"), matchEsc.c_str());
-
-    sDatabase.RunQuery(res,
-        "SELECT"
-        "  allianceID AS ownerID,"
-        "  shortName AS ownerName,"
-        "  32 AS groupID"
-        " FROM alnAlliance"
-        " WHERE shortName %s '%s'", (exact?"=":"LIKE"), matchEsc.c_str());
-
-    return DBResultToRowset(res);
-}
-
-PyRep* ServiceDB::LookupCorporations(const std::string & search) {
-    DBQueryResult res;
-    std::string secure;
-    sDatabase.DoEscapeString(secure, search);
-
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        "   corporationID, corporationName, corporationType "
-        " FROM crpCorporation "
-        " WHERE corporationName LIKE '%s'", secure.c_str()))
-    {
-        _log(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
-    }
-
-    return DBResultToRowset(res);
-}
-
-
-PyRep* ServiceDB::LookupFactions(const std::string & search) {
-    DBQueryResult res;
-    std::string secure;
-    sDatabase.DoEscapeString(secure, search);
-
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        "   factionID, factionName "
-        " FROM facFactions "
-        " WHERE factionName LIKE '%s'", secure.c_str()))
-    {
-        _log(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
-    }
-
-    return DBResultToRowset(res);
-}
-
-
-PyRep* ServiceDB::LookupCorporationTickers(const std::string & search) {
-    DBQueryResult res;
-    std::string secure;
-    sDatabase.DoEscapeString(secure, search);
-
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        "   corporationID, corporationName, tickerName "
-        " FROM crpCorporation "
-        " WHERE tickerName LIKE '%s'", secure.c_str()))
-    {
-        _log(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
-    }
-
-    return DBResultToRowset(res);
-}
-
-
-PyRep* ServiceDB::LookupStations(const std::string & search) {
-    DBQueryResult res;
-    std::string secure;
-    sDatabase.DoEscapeString(secure, search);
-
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        "   stationID, stationName, stationTypeID "
-        " FROM staStations "
-        " WHERE stationName LIKE '%s'", secure.c_str()))
-    {
-        _log(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
-    }
-
-    return DBResultToRowset(res);
-}
-
 //  wtf is this shit?
 PyRep* ServiceDB::LookupKnownLocationsByGroup(const std::string & search, uint32 typeID) {
     DBQueryResult res;
@@ -59,11 +59,6 @@ public:
     static uint32 SetClientSeed();
 
     static PyRep* LookupChars(const char *match, bool exact=false);
-    static PyRep* LookupOwners(const char *match, bool exact=false);
-    static PyRep* LookupCorporations(const std::string &);
-    static PyRep* LookupFactions(const std::string &);
-    static PyRep* LookupCorporationTickers(const std::string &);
-    static PyRep* LookupStations(const std::string &);
     static PyRep* LookupKnownLocationsByGroup(const std::string &, uint32);
 
     static PyRep* PrimeOwners(std::vector<int32>& itemIDs);
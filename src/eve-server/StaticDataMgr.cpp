@@ -23,6 +23,7 @@
 #include "station/StationDB.h"
 #include "system/SystemManager.h"
 #include "system/cosmicMgrs/ManagerDB.h"
+#include "utils/SnapshotFile.h"
 #include <random> // ---marketbot changes
 
 /*
@@ -32,6 +33,81 @@
  * DATA__INFO           # data loading msgs (container and amount) (mt)
  */
 
+namespace {
+
+/* snapshot sections; bump SNAPSHOT_VERSION when any of these change.
+ * static entities and stations are kept as the key and value arrays of their
+ * FlatMaps, so they are used straight from the mapped file */
+const uint32 SNAPSHOT_VERSION = 2;
+
+enum SnapshotSection : uint32 {
+    SnapTypes = 1,
+    SnapSystems,
+    SnapStaticIDs,
+    SnapStaticEntities,
+    SnapStationIDs,
+    SnapStations,
+    SnapTypeAttributes,
+    SnapStrings
+};
+
+/* text is kept in SnapStrings, as offset and length */
+struct SnapString {
+    uint32 offset;
+    uint32 length;
+};
+
+struct SnapType {
+    uint16 id;
+    uint16 groupID;
+    uint16 portionSize;
+    uint8 race;
+    uint8 metaLvl;
+    uint8 published;
+    uint8 isRefinable;
+    uint8 isRecyclable;
+    uint8 pad;
+    uint32 marketGroupID;
+    float chanceOfDuplicating;
+    float radius;
+    float mass;
+    float volume;
+    float capacity;
+    double basePrice;
+    SnapString name;
+    SnapString description;
+};
+
+struct SnapSystem {
+    uint32 systemID;
+    uint32 constellationID;
+    uint32 regionID;
+    uint32 factionID;
+    int64 radius;
+    float securityRating;
+    SnapString name;
+    SnapString securityClass;
+};
+
+struct SnapTypeAttribute {
+    uint16 typeID;
+    uint16 attributeID;
+    uint32 isInt;
+    int64 iVal;
+    double fVal;
+};
+
+SnapString AddString(std::string& pool, const std::string& str)
+{
+    SnapString res;
+    res.offset = (uint32)pool.size();
+    res.length = (uint32)str.size();
+    pool += str;
+    return res;
+}
+
+}
+
 StaticDataMgr::StaticDataMgr()
 : m_keyMap(nullptr),
 m_agents(nullptr),
@@ -57,10 +133,8 @@ m_npcDivisions(nullptr)
     m_corpFaction.clear();
     m_typeAttrMap.clear();
     m_LootGroupMap.clear();
-    m_stationCount.clear();
-    m_stationConst.clear();
-    m_stationRegion.clear();
-    m_stationSystem.clear();
+    m_stations.clear();
+    m_stationList.clear();
     m_oreBySecClass.clear();
     m_LootGroupTypeMap.clear();
     m_WrecksToTypesMap.clear();
@@ -115,10 +189,8 @@ void StaticDataMgr::Clear()
     m_corpFaction.clear();
     m_typeAttrMap.clear();
     m_LootGroupMap.clear();
-    m_stationCount.clear();
-    m_stationConst.clear();
-    m_stationRegion.clear();
-    m_stationSystem.clear();
+    m_stations.clear();
+    m_stationList.clear();
     m_oreBySecClass.clear();
     m_LootGroupTypeMap.clear();
     m_WrecksToTypesMap.clear();
@@ -134,6 +206,9 @@ void StaticDataMgr::Clear()
     for (auto cur : m_bpMatlData)
         PySafeDecRef(cur.second);
     m_bpMatlData.clear();
+
+    // after the tables viewing it
+    m_snapshot.Close();
 }
 
 void StaticDataMgr::Populate()
@@ -191,8 +266,9 @@ void StaticDataMgr::Populate()
     ManagerDB::LoadNPCCorpFactionData(*res);
     while (res->GetRow(row)) {
         //SELECT corporationID, factionID FROM crpNPCCorporations
-        m_corpFaction.emplace(row.GetUInt(0), row.GetUInt(1));
+        m_corpFaction.Add(row.GetUInt(0), row.GetUInt(1));
     }
+    m_corpFaction.Seal();
     sLog.Cyan("    StaticDataMgr", "%lu Corps in NPC Corp Faction map loaded in %.3fms.", m_corpFaction.size(), (GetTimeMSeconds() - startTime));
 
     startTime = GetTimeMSeconds();
@@ -204,8 +280,9 @@ void StaticDataMgr::Populate()
             data.name           = row.GetText(1);
             data.description    = row.GetText(2);
             data.published      = (sConfig.server.AllowNonPublished ? true : row.GetBool(3));
-        m_catData.emplace(row.GetUInt(0), data);
+        m_catData.Add(row.GetUInt(0), data);
     }
+    m_catData.Seal();
     sLog.Cyan("    StaticDataMgr", "%lu Inventory Categories loaded in %.3fms.", m_catData.size(), (GetTimeMSeconds() - startTime));
 
     startTime = GetTimeMSeconds();
@@ -225,65 +302,45 @@ void StaticDataMgr::Populate()
             data.anchorable             = row.GetBool(8);
             data.fittableNonSingleton   = row.GetBool(9);
             data.published              = (sConfig.server.AllowNonPublished ? true : row.GetBool(10));
-        m_grpData.emplace(row.GetUInt(0), data);
+        m_grpData.Add(row.GetUInt(0), data);
     }
+    m_grpData.Seal();
     sLog.Cyan("    StaticDataMgr", "%lu Inventory Groups loaded in %.3fms.", m_grpData.size(), (GetTimeMSeconds() - startTime));
 
+    // the bulk of the static data; from the snapshot if it's up to date, else from the db (and a new snapshot made)
     startTime = GetTimeMSeconds();
-    ManagerDB::GetTypeData(*res);
-    while (res->GetRow(row)) {
-        Inv::TypeData data              = Inv::TypeData();
-            data.id                     = row.GetUInt(0);
-            data.groupID                = row.GetUInt(1);
-            data.name                   = row.GetText(2);
-            data.description            = row.GetText(3);
-            data.radius                 = row.GetFloat(4);
-            data.mass                   = row.GetFloat(5);
-            data.volume                 = row.GetFloat(6);
-            data.capacity               = row.GetFloat(7);
-            data.portionSize            = row.GetUInt(8);
-            data.race                   = row.GetUInt(9);
-            data.basePrice              = row.GetDouble(10);
-            data.published              = (sConfig.server.AllowNonPublished ? true : row.GetBool(11));
-            data.marketGroupID          = (row.IsNull(11) ? 0 : row.GetUInt(12));
-            data.chanceOfDuplicating    = row.GetFloat(13);
-            data.metaLvl                = (row.IsNull(14) ? 0 : row.GetUInt(14));
-            // these will take a bit of work, but will eliminate multiple db hits on inventory/menu loading ingame
-            data.isRecyclable           = FactoryDB::IsRecyclable(data.id);   // +5s to startup
-            data.isRefinable            = FactoryDB::IsRefinable(data.id);     // +3s to startup
-        m_typeData.emplace(row.GetUInt(0), data);
+    const std::string& snapshot = sConfig.files.staticSnapshot;
+    uint64_t snapshotHash(0);
+    if (!snapshot.empty() and GetSnapshotHash(snapshotHash) and LoadSnapshot(snapshot, snapshotHash)) {
+        sLog.Cyan("    StaticDataMgr", "%lu Types, %lu Systems, %lu Static Entities, %lu Stations and %lu Type Attributes loaded from snapshot in %.3fms.",
+                  m_typeData.size(), m_systemData.size(), m_staticData.size(), m_stations.size(), m_typeAttrMap.size(), (GetTimeMSeconds() - startTime));
+    } else {
+        PopulateTables(*res);
+        if (snapshotHash != 0)
+            SaveSnapshot(snapshot, snapshotHash);
     }
-    sLog.Cyan("    StaticDataMgr", "%lu Inventory Types loaded in %.3fms.", m_typeData.size(), (GetTimeMSeconds() - startTime));
+
+    // stations by system, whichever way they were loaded
+    for (auto cur : m_stations)
+        m_stationList.Add(cur.second.systemID, cur.first);
+    m_stationList.Seal();
 
     startTime = GetTimeMSeconds();
     ManagerDB::GetAttributeTypes(*res);
     while (res->GetRow(row)) {
-        //SELECT attributeID, attributeName, attributeCategory, displayName, categoryID FROM dgmAttribute
+        //SELECT attributeID, attributeName, attributeCategory, displayName, categoryID, stackable FROM dgmAttribute
         AttrTypeData typeData               = AttrTypeData();
         typeData.attributeID            = row.GetInt(0);
         typeData.attributeName          = (row.IsNull(1) ? "*none*" : row.GetText(1));
         typeData.attributeCategory      = (row.IsNull(2) ? 0        : row.GetInt(2));
         typeData.displayName            = (row.IsNull(3) ? "*none*" : row.GetText(3));
         typeData.categoryID             = (row.IsNull(4) ? 0        : row.GetInt(4));
-        m_attrTypeData.emplace(row.GetInt(0), typeData);
+        typeData.stackable              = (row.IsNull(5) ? true     : row.GetBool(5));
+        m_attrTypeData.Add(row.GetInt(0), typeData);
     }
+    m_attrTypeData.Seal();
     sLog.Cyan("    StaticDataMgr", "%lu Attribute data sets loaded in %.3fms.", m_attrTypeData.size(), (GetTimeMSeconds() - startTime));
 
-    startTime = GetTimeMSeconds();
-    ManagerDB::GetSystemData(*res);
-    while (res->GetRow(row)) {
-        //SELECT solarSystemID, solarSystemName, constellationID, regionID, securityClass, security FROM mapSolarSystems
-        SystemData sysData        = SystemData();
-        sysData.systemID          = row.GetInt(0);
-        sysData.name              = row.GetText(1);
-        sysData.constellationID   = row.GetInt(2);
-        sysData.regionID          = row.GetInt(3);
-        sysData.securityClass     = (row.IsNull(4) ? "0" : row.GetText(4));
-        sysData.securityRating    = row.GetFloat(5);    // this gives system trueSec
-        sysData.factionID         = (row.IsNull(6) ? 0 : row.GetUInt(6));
-        m_systemData.emplace(row.GetInt(0), sysData);
-    }
-    sLog.Cyan("    StaticDataMgr", "%lu Static System data sets loaded in %.3fms.", m_systemData.size(), (GetTimeMSeconds() - startTime));
 /*
     startTime = GetTimeMSeconds();
     ManagerDB::GetSolarSystemData(*res);
@@ -312,102 +369,31 @@ void StaticDataMgr::Populate()
 
     // Load wormhole destination classes into static memory object
     startTime = GetTimeMSeconds();
-    int size = 0;
     for (int i = 1; i < 10; i++) {
         ManagerDB::GetWHClassDestinations(i, *res);
         DBResultRow row;
-        m_whClassDestinations[i];
         while (res->GetRow(row)) {
-            m_whClassDestinations[i].push_back(row.GetUInt(0));
+            m_whClassDestinations.Add(i, row.GetUInt(0));
         }
-        size += m_whClassDestinations[i].size();
     }
+    m_whClassDestinations.Seal();
 
     sLog.Cyan("    StaticDataMgr", "%lu WH Destination Classes loaded in %.3fms.",
-              size, (GetTimeMSeconds() - startTime));
+              m_whClassDestinations.size(), (GetTimeMSeconds() - startTime));
 
     // Load wormhole system classes into static memory object
     startTime = GetTimeMSeconds();
-    size = 0;
     for (int i = 1; i < 10; i++) {
         ManagerDB::GetWHClassSystems(i, *res);
         DBResultRow row;
-        m_whClassSystems[i];
         while (res->GetRow(row)) {
-            m_whClassSystems[i].push_back(row.GetUInt(0));
+            m_whClassSystems.Add(i, row.GetUInt(0));
         }
-        size += m_whClassSystems[i].size();
     }
+    m_whClassSystems.Seal();
 
     sLog.Cyan("    StaticDataMgr", "%lu WH Class Systems loaded in %.3fms.",
-              size, (GetTimeMSeconds() - startTime));
-
-    startTime = GetTimeMSeconds();
-    ManagerDB::GetStaticData(*res);
-    while (res->GetRow(row)) {
-        //SELECT itemID, regionID, constellationID, solarSystemID, typeID, radius, x, y, z FROM mapDenormalize
-        StaticData data         = StaticData();
-        data.itemID             = row.GetInt(0);
-        data.regionID           = row.GetInt(1);
-        data.constellationID    = row.GetInt(2);
-        data.systemID           = row.GetInt(3);
-        data.typeID             = row.GetInt(4);
-        data.radius             = row.GetFloat(5);
-        data.position           = GPoint(row.GetDouble(6),row.GetDouble(7),row.GetDouble(8));
-        m_staticData.emplace(row.GetInt(0), data);
-    }
-    sLog.Cyan("    StaticDataMgr", "%lu Static Entity data sets loaded in %.3fms.", m_staticData.size(), (GetTimeMSeconds() - startTime));
-
-    startTime = GetTimeMSeconds();
-    MapDB::GetStationCount(*res);
-    while (res->GetRow(row)) {
-        //SELECT map.solarSystemID, count(sta.stationID) FROM staStations sta
-        m_stationCount.emplace(row.GetInt(0), row.GetInt(1));
-    }
-    StationDB::GetStationRegion(*res);
-    while (res->GetRow(row)) {
-        //SELECT stationID, regionID FROM staStations
-        m_stationRegion.emplace(row.GetInt(0), row.GetInt(1));
-    }
-    StationDB::GetStationConstellation(*res);
-    while (res->GetRow(row)) {
-        //SELECT stationID, constellationID FROM staStations
-        m_stationConst.emplace(row.GetInt(0), row.GetInt(1));
-    }
-    StationDB::GetStationSystem(*res);
-    while (res->GetRow(row)) {
-        //SELECT stationID, solarSystemID FROM staStations
-        m_stationSystem.emplace(row.GetInt(0), row.GetInt(1));
-    }
-
-    std::map<uint32, std::vector<uint32>>::iterator itr = m_stationList.begin();
-    for (auto cur : m_stationSystem) {
-        itr = m_stationList.find(cur.second);
-        if (itr != m_stationList.end()) {
-            itr->second.push_back(cur.first);
-        } else {
-            std::vector<uint32> sVec;
-            sVec.push_back(cur.first);
-            m_stationList.emplace(std::pair<uint32, std::vector<uint32>>(cur.second, sVec));
-        }
-    }
-    sLog.Cyan("    StaticDataMgr", "%lu Static Station query sets loaded in %.3fms.", (m_stationConst.size() + m_stationRegion.size() + m_stationSystem.size() + m_stationList.size()), (GetTimeMSeconds() - startTime));
-
-    startTime = GetTimeMSeconds();
-    ManagerDB::GetTypeAttributes(*res);
-    while (res->GetRow(row)) {
-        //SELECT typeID, attributeID, valueInt, valueFloat FROM dgmTypeAttributes
-        DmgTypeAttribute typeAttr = DmgTypeAttribute();
-        typeAttr.attributeID = row.GetInt(1);
-        if (row.IsNull(2)) {
-            typeAttr.value = row.GetDouble(3);
-        } else {
-            typeAttr.value = row.GetInt(2); // highest value seen is 2,000,000,000 (struct HP)
-        }
-
-        m_typeAttrMap.emplace(row.GetInt(0), typeAttr);
-    }
-    sLog.Cyan("    StaticDataMgr", "%lu Type Attribute Sets loaded in %.3fms", m_typeAttrMap.size(), (GetTimeMSeconds() - startTime));
+              m_whClassSystems.size(), (GetTimeMSeconds() - startTime));
 
     startTime = GetTimeMSeconds();
     ManagerDB::GetSkillList(*res);
@@ -459,8 +445,9 @@ void StaticDataMgr::Populate()
         EvERam::RamMaterials ramMatls = EvERam::RamMaterials();
         ramMatls.quantity       = row.GetInt(2);
         ramMatls.materialTypeID = row.GetInt(1);
-        m_ramMatl.emplace(row.GetInt(0), ramMatls);
+        m_ramMatl.Add(row.GetInt(0), ramMatls);
     }
+    m_ramMatl.Seal();
     FactoryDB::GetRAMRequirements(*res);
     while (res->GetRow(row)) {
         //SELECT typeID, activityID, requiredTypeID, quantity, damagePerJob, extra FROM ramTypeRequirements
@@ -470,8 +457,9 @@ void StaticDataMgr::Populate()
         ramReq.quantity         = row.GetInt(3);
         ramReq.damagePerJob     = row.GetFloat(4);
         ramReq.extra            = row.GetBool(5);
-        m_ramReq.emplace(row.GetInt(0), ramReq);
+        m_ramReq.Add(row.GetInt(0), ramReq);
     }
+    m_ramReq.Seal();
     sLog.Cyan("    StaticDataMgr", "%lu R.A.M. defs loaded in %.3fms.", (m_ramMatl.size() + m_ramReq.size()), (GetTimeMSeconds() - startTime));
 
     startTime = GetTimeMSeconds();
@@ -531,14 +519,16 @@ void StaticDataMgr::Populate()
     ManagerDB::GetRegionFaction(*res);
     while (res->GetRow(row)) {
         //SELECT regionID, factionID FROM mapRegions
-        m_regions.emplace(row.GetInt(0), row.GetInt(1));
+        m_regions.Add(row.GetInt(0), row.GetInt(1));
     }
+    m_regions.Seal();
 
     ManagerDB::GetRegionRatFaction(*res);
     while (res->GetRow(row)) {
         //SELECT regionID, ratFactionID FROM mapRegions WHERE ratFactionID != 0
-        m_ratRegions.emplace(row.GetInt(0), row.GetInt(1));
+        m_ratRegions.Add(row.GetInt(0), row.GetInt(1));
     }
+    m_ratRegions.Seal();
     sLog.Cyan("    StaticDataMgr", "%lu Region Faction Data Sets loaded in %.3fms.", (m_regions.size() + m_ratRegions.size()), (GetTimeMSeconds() - startTime));
 
     startTime = GetTimeMSeconds();
@@ -648,6 +638,284 @@ void StaticDataMgr::Populate()
     sLog.Cyan("    StaticDataMgr", "Static Data loaded in %.3fms.", (GetTimeMSeconds() - beginTime));
 }
 
+void StaticDataMgr::PopulateTables(DBQueryResult& res)
+{
+    double startTime(GetTimeMSeconds());
+    DBResultRow row;
+
+    ManagerDB::GetTypeData(res);
+    while (res.GetRow(row)) {
+        Inv::TypeData data              = Inv::TypeData();
+            data.id                     = row.GetUInt(0);
+            data.groupID                = row.GetUInt(1);
+            data.name                   = row.GetText(2);
+            data.description            = row.GetText(3);
+            data.radius                 = row.GetFloat(4);
+            data.mass                   = row.GetFloat(5);
+            data.volume                 = row.GetFloat(6);
+            data.capacity               = row.GetFloat(7);
+            data.portionSize            = row.GetUInt(8);
+            data.race                   = row.GetUInt(9);
+            data.basePrice              = row.GetDouble(10);
+            data.published              = (sConfig.server.AllowNonPublished ? true : row.GetBool(11));
+            data.marketGroupID          = (row.IsNull(11) ? 0 : row.GetUInt(12));
+            data.chanceOfDuplicating    = row.GetFloat(13);
+            data.metaLvl                = (row.IsNull(14) ? 0 : row.GetUInt(14));
+            // these will take a bit of work, but will eliminate multiple db hits on inventory/menu loading ingame
+            data.isRecyclable           = FactoryDB::IsRecyclable(data.id);   // +5s to startup
+            data.isRefinable            = FactoryDB::IsRefinable(data.id);     // +3s to startup
+        m_typeData.Add(row.GetUInt(0), data);
+    }
+    m_typeData.Seal();
+    sLog.Cyan("    StaticDataMgr", "%lu Inventory Types loaded in %.3fms.", m_typeData.size(), (GetTimeMSeconds() - startTime));
+
+    startTime = GetTimeMSeconds();
+    ManagerDB::GetSystemData(res);
+    while (res.GetRow(row)) {
+        //SELECT solarSystemID, solarSystemName, constellationID, regionID, securityClass, security FROM mapSolarSystems
+        SystemData sysData        = SystemData();
+        sysData.systemID          = row.GetInt(0);
+        sysData.name              = row.GetText(1);
+        sysData.constellationID   = row.GetInt(2);
+        sysData.regionID          = row.GetInt(3);
+        sysData.securityClass     = (row.IsNull(4) ? "0" : row.GetText(4));
+        sysData.securityRating    = row.GetFloat(5);    // this gives system trueSec
+        sysData.factionID         = (row.IsNull(6) ? 0 : row.GetUInt(6));
+        m_systemData.Add(row.GetInt(0), sysData);
+    }
+    m_systemData.Seal();
+    sLog.Cyan("    StaticDataMgr", "%lu Static System data sets loaded in %.3fms.", m_systemData.size(), (GetTimeMSeconds() - startTime));
+
+    startTime = GetTimeMSeconds();
+    ManagerDB::GetStaticData(res);
+    while (res.GetRow(row)) {
+        //SELECT itemID, regionID, constellationID, solarSystemID, typeID, radius, x, y, z FROM mapDenormalize
+        StaticData data         = StaticData();
+        data.itemID             = row.GetInt(0);
+        data.regionID           = row.GetInt(1);
+        data.constellationID    = row.GetInt(2);
+        data.systemID           = row.GetInt(3);
+        data.typeID             = row.GetInt(4);
+        data.radius             = row.GetFloat(5);
+        data.position           = GPoint(row.GetDouble(6),row.GetDouble(7),row.GetDouble(8));
+        m_staticData.Add(row.GetInt(0), data);
+    }
+    m_staticData.Seal();
+    sLog.Cyan("    StaticDataMgr", "%lu Static Entity data sets loaded in %.3fms.", m_staticData.size(), (GetTimeMSeconds() - startTime));
+
+    startTime = GetTimeMSeconds();
+    std::map<uint32, StationLocation> stations;
+    StationDB::GetStationRegion(res);
+    while (res.GetRow(row)) {
+        //SELECT stationID, regionID FROM staStations
+        stations[row.GetInt(0)].regionID = row.GetInt(1);
+    }
+    StationDB::GetStationConstellation(res);
+    while (res.GetRow(row)) {
+        //SELECT stationID, constellationID FROM staStations
+        stations[row.GetInt(0)].constellationID = row.GetInt(1);
+    }
+    StationDB::GetStationSystem(res);
+    while (res.GetRow(row)) {
+        //SELECT stationID, solarSystemID FROM staStations
+        stations[row.GetInt(0)].systemID = row.GetInt(1);
+    }
+    for (auto& cur : stations)
+        m_stations.Add(cur.first, cur.second);
+    m_stations.Seal();
+
+    sLog.Cyan("    StaticDataMgr", "%lu Static Stations loaded in %.3fms.", m_stations.size(), (GetTimeMSeconds() - startTime));
+
+    startTime = GetTimeMSeconds();
+    ManagerDB::GetTypeAttributes(res);
+    while (res.GetRow(row)) {
+        //SELECT typeID, attributeID, valueInt, valueFloat FROM dgmTypeAttributes
+        DmgTypeAttribute typeAttr = DmgTypeAttribute();
+        typeAttr.attributeID = row.GetInt(1);
+        if (row.IsNull(2)) {
+            typeAttr.value = row.GetDouble(3);
+        } else {
+            typeAttr.value = row.GetInt(2); // highest value seen is 2,000,000,000 (struct HP)
+        }
+
+        m_typeAttrMap.Add(row.GetInt(0), typeAttr);
+    }
+    m_typeAttrMap.Seal();
+    sLog.Cyan("    StaticDataMgr", "%lu Type Attribute Sets loaded in %.3fms", m_typeAttrMap.size(), (GetTimeMSeconds() - startTime));
+}
+
+bool StaticDataMgr::GetSnapshotHash(uint64_t& hash)
+{
+    std::string checksum;
+    if (!ManagerDB::GetSnapshotChecksum(checksum))
+        return false;
+
+    // what the rows turn into depends on these too
+    checksum += (sConfig.server.AllowNonPublished ? "published:all;" : "published:db;");
+    checksum += "sizes:" + std::to_string(sizeof(SnapType)) + "," + std::to_string(sizeof(SnapSystem)) + "," + std::to_string(sizeof(StaticData))
+              + "," + std::to_string(sizeof(StationLocation)) + "," + std::to_string(sizeof(SnapTypeAttribute)) + ";";
+    hash = SnapshotFile::Hash(checksum);
+    return true;
+}
+
+bool StaticDataMgr::LoadSnapshot(const std::string& path, uint64_t hash)
+{
+    if (!m_snapshot.Open(path, SNAPSHOT_VERSION, hash))
+        return false;
+
+    size_t typeCount(0), systemCount(0), staticIDCount(0), staticCount(0), stationIDCount(0), stationCount(0), attribCount(0), poolSize(0);
+    const SnapType* pType = m_snapshot.GetArray<SnapType>(SnapTypes, typeCount);
+    const SnapSystem* pSystem = m_snapshot.GetArray<SnapSystem>(SnapSystems, systemCount);
+    const uint32* pStaticID = m_snapshot.GetArray<uint32>(SnapStaticIDs, staticIDCount);
+    const StaticData* pStatic = m_snapshot.GetArray<StaticData>(SnapStaticEntities, staticCount);
+    const uint32* pStationID = m_snapshot.GetArray<uint32>(SnapStationIDs, stationIDCount);
+    const StationLocation* pStation = m_snapshot.GetArray<StationLocation>(SnapStations, stationCount);
+    const SnapTypeAttribute* pAttrib = m_snapshot.GetArray<SnapTypeAttribute>(SnapTypeAttributes, attribCount);
+    const char* pPool = (const char*)m_snapshot.Get(SnapStrings, poolSize);
+    if ((pType == nullptr) or (pSystem == nullptr) or (pStaticID == nullptr) or (pStatic == nullptr) or (pStationID == nullptr)
+    or (pStation == nullptr) or (pAttrib == nullptr) or (pPool == nullptr)
+    or (staticIDCount != staticCount) or (stationIDCount != stationCount)) {
+        _log(DATA__WARNING, "LoadSnapshot() - %s is missing sections.", path.c_str());
+        m_snapshot.Close();
+        return false;
+    }
+
+    auto text = [pPool, poolSize](const SnapString& str) {
+        if ((str.offset > poolSize) or (str.length > poolSize - str.offset))
+            return std::string();
+        return std::string(pPool + str.offset, str.length);
+    };
+
+    // the plain tables are used in place
+    m_staticData.View(pStaticID, pStatic, staticCount);
+    m_stations.View(pStationID, pStation, stationCount);
+
+    // the rest hold strings or EvilNumbers, so are copied out; they were written in key order, so Seal() has nothing to sort
+    for (size_t i = 0; i < typeCount; ++i, ++pType) {
+        Inv::TypeData data              = Inv::TypeData();
+            data.id                     = pType->id;
+            data.groupID                = pType->groupID;
+            data.name                   = text(pType->name);
+            data.description            = text(pType->description);
+            data.radius                 = pType->radius;
+            data.mass                   = pType->mass;
+            data.volume                 = pType->volume;
+            data.capacity               = pType->capacity;
+            data.portionSize            = pType->portionSize;
+            data.race                   = pType->race;
+            data.basePrice              = pType->basePrice;
+            data.published              = pType->published;
+            data.marketGroupID          = pType->marketGroupID;
+            data.chanceOfDuplicating    = pType->chanceOfDuplicating;
+            data.metaLvl                = pType->metaLvl;
+            data.isRecyclable           = pType->isRecyclable;
+            data.isRefinable            = pType->isRefinable;
+        m_typeData.Add(data.id, data);
+    }
+    m_typeData.Seal();
+
+    for (size_t i = 0; i < systemCount; ++i, ++pSystem) {
+        SystemData sysData        = SystemData();
+        sysData.systemID          = pSystem->systemID;
+        sysData.name              = text(pSystem->name);
+        sysData.constellationID   = pSystem->constellationID;
+        sysData.regionID          = pSystem->regionID;
+        sysData.securityClass     = text(pSystem->securityClass);
+        sysData.securityRating    = pSystem->securityRating;
+        sysData.factionID         = pSystem->factionID;
+        sysData.radius            = pSystem->radius;
+        m_systemData.Add(sysData.systemID, sysData);
+    }
+    m_systemData.Seal();
+
+    for (size_t i = 0; i < attribCount; ++i, ++pAttrib) {
+        DmgTypeAttribute typeAttr = DmgTypeAttribute();
+        typeAttr.attributeID = pAttrib->attributeID;
+        if (pAttrib->isInt) {
+            typeAttr.value = pAttrib->iVal;
+        } else {
+            typeAttr.value = pAttrib->fVal;
+        }
+        m_typeAttrMap.Add(pAttrib->typeID, typeAttr);
+    }
+    m_typeAttrMap.Seal();
+
+    return true;
+}
+
+void StaticDataMgr::SaveSnapshot(const std::string& path, uint64_t hash)
+{
+    double startTime(GetTimeMSeconds());
+    std::string pool;
+
+    std::vector<SnapType> types;
+    types.reserve(m_typeData.size());
+    for (auto cur : m_typeData) {
+        SnapType rec = SnapType();
+        rec.id                  = cur.second.id;
+        rec.groupID             = cur.second.groupID;
+        rec.portionSize         = cur.second.portionSize;
+        rec.race                = cur.second.race;
+        rec.metaLvl             = cur.second.metaLvl;
+        rec.published           = cur.second.published;
+        rec.isRefinable         = cur.second.isRefinable;
+        rec.isRecyclable        = cur.second.isRecyclable;
+        rec.marketGroupID       = cur.second.marketGroupID;
+        rec.chanceOfDuplicating = cur.second.chanceOfDuplicating;
+        rec.radius              = cur.second.radius;
+        rec.mass                = cur.second.mass;
+        rec.volume              = cur.second.volume;
+        rec.capacity            = cur.second.capacity;
+        rec.basePrice           = cur.second.basePrice;
+        rec.name                = AddString(pool, cur.second.name);
+        rec.description         = AddString(pool, cur.second.description);
+        types.push_back(rec);
+    }
+
+    std::vector<SnapSystem> systems;
+    systems.reserve(m_systemData.size());
+    for (auto cur : m_systemData) {
+        SnapSystem rec = SnapSystem();
+        rec.systemID            = cur.second.systemID;
+        rec.constellationID     = cur.second.constellationID;
+        rec.regionID            = cur.second.regionID;
+        rec.factionID           = cur.second.factionID;
+        rec.radius              = cur.second.radius;
+        rec.securityRating      = cur.second.securityRating;
+        rec.name                = AddString(pool, cur.second.name);
+        rec.securityClass       = AddString(pool, cur.second.securityClass);
+        systems.push_back(rec);
+    }
+
+    std::vector<SnapTypeAttribute> attribs;
+    attribs.reserve(m_typeAttrMap.size());
+    for (auto cur : m_typeAttrMap) {
+        SnapTypeAttribute rec = SnapTypeAttribute();
+        rec.typeID              = cur.first;
+        rec.attributeID         = cur.second.attributeID;
+        EvilNumber value(cur.second.value);
+        rec.isInt               = value.isInt();
+        if (rec.isInt) {
+            rec.iVal            = value.get_int();
+        } else {
+            rec.fVal            = value.get_double();
+        }
+        attribs.push_back(rec);
+    }
+
+    SnapshotFile::Writer writer;
+    writer.AddArray(SnapTypes, types);
+    writer.AddArray(SnapSystems, systems);
+    writer.Add(SnapStaticIDs, m_staticData.Keys().data(), m_staticData.size() * sizeof(uint32));
+    writer.Add(SnapStaticEntities, m_staticData.Values().data(), m_staticData.size() * sizeof(StaticData));
+    writer.Add(SnapStationIDs, m_stations.Keys().data(), m_stations.size() * sizeof(uint32));
+    writer.Add(SnapStations, m_stations.Values().data(), m_stations.size() * sizeof(StationLocation));
+    writer.AddArray(SnapTypeAttributes, attribs);
+    writer.Add(SnapStrings, pool.data(), pool.size());
+    if (writer.Write(path, SNAPSHOT_VERSION, hash))
+        sLog.Cyan("    StaticDataMgr", "Snapshot saved to %s in %.3fms.", path.c_str(), (GetTimeMSeconds() - startTime));
+}
+
 void StaticDataMgr::GetInfo()
 {
     /* return info about loaded items? */
@@ -660,16 +928,16 @@ void StaticDataMgr::GetInfo()
 
 void StaticDataMgr::GetCategory(uint8 catID, Inv::CatData& into)
 {
-    std::map<uint16, Inv::CatData>::const_iterator itr = m_catData.find(catID);
-    if (itr != m_catData.end())
-        into = itr->second;
+    const Inv::CatData* pData = m_catData.Find(catID);
+    if (pData != nullptr)
+        into = *pData;
 }
 
 const char* StaticDataMgr::GetCategoryName(uint8 catID)
 {
-    std::map<uint16, Inv::CatData>::const_iterator itr = m_catData.find(catID);
-    if (itr != m_catData.end())
-        return itr->second.name.c_str();
+    const Inv::CatData* pData = m_catData.Find(catID);
+    if (pData != nullptr)
+        return pData->name.c_str();
 
     _log(DATA__ERROR, "GetCategoryName() - Category %u not found in map", catID);
     return "None";
@@ -677,16 +945,16 @@ const char* StaticDataMgr::GetCategoryName(uint8 catID)
 
 void StaticDataMgr::GetGroup(uint16 grpID, Inv::GrpData& into)
 {
-    std::map<uint16, Inv::GrpData>::const_iterator itr = m_grpData.find(grpID);
-    if (itr != m_grpData.end())
-        into = itr->second;
+    const Inv::GrpData* pData = m_grpData.Find(grpID);
+    if (pData != nullptr)
+        into = *pData;
 }
 
 const char* StaticDataMgr::GetGroupName(uint16 grpID)
 {
-    std::map<uint16, Inv::GrpData>::const_iterator itr = m_grpData.find(grpID);
-    if (itr != m_grpData.end())
-        return itr->second.name.c_str();
+    const Inv::GrpData* pData = m_grpData.Find(grpID);
+    if (pData != nullptr)
+        return pData->name.c_str();
 
     _log(DATA__ERROR, "GetGroupName() - Group %u not found in map", grpID);
     return "None";
@@ -694,16 +962,16 @@ const char* StaticDataMgr::GetGroupName(uint16 grpID)
 
 void StaticDataMgr::GetType(uint16 typeID, Inv::TypeData& into)
 {
-    std::map<uint16, Inv::TypeData>::const_iterator itr = m_typeData.find(typeID);
-    if (itr != m_typeData.end())
-        into = itr->second;
+    const Inv::TypeData* pData = m_typeData.Find(typeID);
+    if (pData != nullptr)
+        into = *pData;
 }
 
 const char* StaticDataMgr::GetTypeName(uint16 typeID)
 {
-    std::map<uint16, Inv::TypeData>::const_iterator itr = m_typeData.find(typeID);
-    if (itr != m_typeData.end())
-        return itr->second.name.c_str();
+    const Inv::TypeData* pData = m_typeData.Find(typeID);
+    if (pData != nullptr)
+        return pData->name.c_str();
 
     _log(DATA__ERROR, "GetGroupName() - Group %u not found in map", typeID);
     return "None";
@@ -711,20 +979,29 @@ const char* StaticDataMgr::GetTypeName(uint16 typeID)
 
 void StaticDataMgr::GetTypes(std::map< uint16, Inv::TypeData >& into)
 {
-    into = m_typeData;
+    for (auto cur : m_typeData)
+        into.emplace_hint(into.end(), cur.first, cur.second);
 }
 
 const char* StaticDataMgr::GetAttrName(uint16 attrID)
 {
-    std::map<uint16, AttrTypeData>::const_iterator itr = m_attrTypeData.find(attrID);
-    if (itr != m_attrTypeData.end())
-        return itr->second.attributeName.c_str();
+    const AttrTypeData* pData = m_attrTypeData.Find(attrID);
+    if (pData != nullptr)
+        return pData->attributeName.c_str();
         //return itr->second.displayName.c_str();
 
     _log(DATA__ERROR, "GetAttrName() - Attribute %u not found in map", attrID);
     return "None";
 }
 
+bool StaticDataMgr::IsStackable(uint16 attrID)
+{
+    const AttrTypeData* pData = m_attrTypeData.Find(attrID);
+    if (pData != nullptr)
+        return pData->stackable;
+    return true;
+}
+
 PyInt* StaticDataMgr::GetAgentSystemID(int32 agentID)
 {
     std::map<uint32, uint32>::iterator itr = m_agentSystem.find(agentID);
@@ -753,9 +1030,8 @@ bool StaticDataMgr::GetRoidDist(const char* secClass, std::unordered_multimap<fl
 
 void StaticDataMgr::GetDgmTypeAttrVec(uint16 typeID, std::vector< DmgTypeAttribute >& typeAttrVec)
 {
-    auto itr = m_typeAttrMap.equal_range(typeID);
-    for (auto it = itr.first; it != itr.second; ++it)
-        typeAttrVec.push_back(it->second);
+    Span<DmgTypeAttribute> attrs = m_typeAttrMap.Range(typeID);
+    typeAttrVec.insert(typeAttrVec.end(), attrs.begin(), attrs.end());
 }
 
 bool StaticDataMgr::IsSkillTypeID(uint16 typeID)
@@ -1008,47 +1284,44 @@ bool StaticDataMgr::GetBpDataForItem(uint16 typeID, EvERam::bpTypeData& tData)
 
 bool StaticDataMgr::IsRecyclable(uint16 typeID)
 {
-    std::map<uint16, Inv::TypeData>::iterator itr = m_typeData.find(typeID);
-    if (itr != m_typeData.end())
-        return itr->second.isRecyclable;
+    const Inv::TypeData* pData = m_typeData.Find(typeID);
+    if (pData != nullptr)
+        return pData->isRecyclable;
     return false;
 }
 
 bool StaticDataMgr::IsRefinable(uint16 typeID)
 {
-    std::map<uint16, Inv::TypeData>::iterator itr = m_typeData.find(typeID);
-    if (itr != m_typeData.end())
-        return itr->second.isRefinable;
+    const Inv::TypeData* pData = m_typeData.Find(typeID);
+    if (pData != nullptr)
+        return pData->isRefinable;
     return false;
 }
 
 void StaticDataMgr::GetRamReturns(uint16 typeID, int8 activityID, std::vector< EvERam::RequiredItem >& ramReqs)
 {
-    auto itr = m_ramReq.equal_range(typeID);
-    for (auto it = itr.first; it != itr.second; ++it)
-        if ((it->second.activityID == activityID) and (it->second.extra) and !(IsSkillTypeID(it->second.requiredTypeID))) {
+    for (auto& cur : m_ramReq.Range(typeID))
+        if ((cur.activityID == activityID) and (cur.extra) and !(IsSkillTypeID(cur.requiredTypeID))) {
             EvERam::RequiredItem data = EvERam::RequiredItem();
-            data.typeID = it->second.requiredTypeID;
-            data.quantity = it->second.quantity;
-            data.damagePerJob = it->second.damagePerJob;
-            data.isSkill = IsSkillTypeID(it->second.requiredTypeID);
-            data.extra = it->second.extra;
+            data.typeID = cur.requiredTypeID;
+            data.quantity = cur.quantity;
+            data.damagePerJob = cur.damagePerJob;
+            data.isSkill = IsSkillTypeID(cur.requiredTypeID);
+            data.extra = cur.extra;
             ramReqs.push_back(data);
         }
 }
 
 void StaticDataMgr::GetRamMaterials(uint16 typeID, std::vector< EvERam::RamMaterials >& ramMatls)
 {
-    auto itr = m_ramMatl.equal_range(typeID);
-    for (auto it = itr.first; it != itr.second; ++it)
-        ramMatls.push_back(it->second);
+    Span<EvERam::RamMaterials> matls = m_ramMatl.Range(typeID);
+    ramMatls.insert(ramMatls.end(), matls.begin(), matls.end());
 }
 
 void StaticDataMgr::GetRamRequirements(uint16 typeID, std::vector< EvERam::RamRequirements >& ramReqs)
 {
-    auto itr = m_ramReq.equal_range(typeID);
-    for (auto it = itr.first; it != itr.second; ++it)
-        ramReqs.push_back(it->second);
+    Span<EvERam::RamRequirements> reqs = m_ramReq.Range(typeID);
+    ramReqs.insert(ramReqs.end(), reqs.begin(), reqs.end());
 }
 
 void StaticDataMgr::GetRamRequiredItems(const uint32 typeID, const int8 activity, std::vector< EvERam::RequiredItem >& into)
@@ -1056,48 +1329,47 @@ void StaticDataMgr::GetRamRequiredItems(const uint32 typeID, const int8 activity
     if (activity == EvERam::Activity::Manufacturing) {
         std::map<uint16, EvERam::bpTypeData>::iterator itr = m_bpTypeData.find(typeID);
         if (itr != m_bpTypeData.end()) {
-            auto range = m_ramMatl.equal_range(itr->second.productTypeID);
-            for (auto it = range.first; it != range.second; ++it) {
+            for (auto& cur : m_ramMatl.Range(itr->second.productTypeID)) {
                 EvERam::RequiredItem data = EvERam::RequiredItem();
-                data.typeID = it->second.materialTypeID;
-                data.quantity = it->second.quantity;
+                data.typeID = cur.materialTypeID;
+                data.quantity = cur.quantity;
                 into.push_back(data);
             }
         }
     }
 
-    auto itr = m_ramReq.equal_range(typeID);
-    for (auto it = itr.first; it != itr.second; ++it)
-        if (it->second.activityID == activity) {
+    for (auto& cur : m_ramReq.Range(typeID))
+        if (cur.activityID == activity) {
             EvERam::RequiredItem data = EvERam::RequiredItem();
-            data.typeID = it->second.requiredTypeID;
-            data.quantity = it->second.quantity;
-            data.damagePerJob = it->second.damagePerJob;
-            data.isSkill = IsSkillTypeID(it->second.requiredTypeID);
-            data.extra = it->second.extra;
+            data.typeID = cur.requiredTypeID;
+            data.quantity = cur.quantity;
+            data.damagePerJob = cur.damagePerJob;
+            data.isSkill = IsSkillTypeID(cur.requiredTypeID);
+            data.extra = cur.extra;
             into.push_back(data);
         }
 }
 
 PyRep* StaticDataMgr::GetStationCount()
 {
+    // m_stationList holds each system's stations together
     PyList* list = new PyList();
-    std::map<uint32, uint8>::iterator itr = m_stationCount.begin(), end = m_stationCount.end();
-    while (itr != end) {
+    Span<uint32> systems = m_stationList.Keys();
+    for (size_t i = 0, count = 0; i < systems.size(); i += count) {
+        count = m_stationList.Range(systems[i]).size();
         PyTuple* tuple = new PyTuple(2);
-        tuple->SetItem(0, new PyInt(itr->first));
-        tuple->SetItem(1, new PyInt(itr->second));
+        tuple->SetItem(0, new PyInt(systems[i]));
+        tuple->SetItem(1, new PyInt(count));
         list->AddItem(tuple);
-        ++itr;
     }
     return list;
 }
 
 uint8 StaticDataMgr::GetStationCount(uint32 systemID)
 {
-    std::map<uint32, uint8>::iterator itr = m_stationCount.find(systemID);
-    if (itr != m_stationCount.end())
-        return itr->second;
+    const size_t count = m_stationList.Range(systemID).size();
+    if (count > 0)
+        return count;
 
     _log(DATA__MESSAGE, "Failed to query station count for system %u: System not found.", systemID);
     return 0;
@@ -1105,19 +1377,16 @@ uint8 StaticDataMgr::GetStationCount(uint32 systemID)
 
 bool StaticDataMgr::GetStationList(uint32 systemID, std::vector< uint32 >& data)
 {
-    std::map<uint32, std::vector<uint32>>::iterator itr = m_stationList.find(systemID);
-    if (itr != m_stationList.end()) {
-        data = itr->second;
-        return true;
-    }
-    return false;
+    Span<uint32> stations = m_stationList.Range(systemID);
+    data.assign(stations.begin(), stations.end());
+    return !stations.empty();
 }
 
 uint32 StaticDataMgr::GetStationRegion(uint32 stationID)
 {
-    std::map<uint32, uint32>::iterator itr = m_stationRegion.find(stationID);
-    if (itr != m_stationRegion.end())
-        return itr->second;
+    const StationLocation* pData = m_stations.Find(stationID);
+    if (pData != nullptr)
+        return pData->regionID;
 
     _log(DATA__MESSAGE, "Failed to query region info for station %u: Station not found.", stationID);
     return 0;
@@ -1125,9 +1394,9 @@ uint32 StaticDataMgr::GetStationRegion(uint32 stationID)
 
 uint32 StaticDataMgr::GetStationConstellation(uint32 stationID)
 {
-    std::map<uint32, uint32>::iterator itr = m_stationConst.find(stationID);
-    if (itr != m_stationConst.end())
-        return itr->second;
+    const StationLocation* pData = m_stations.Find(stationID);
+    if (pData != nullptr)
+        return pData->constellationID;
 
     _log(DATA__MESSAGE, "Failed to query constellation info for station %u: Station not found.", stationID);
     return 0;
@@ -1135,9 +1404,9 @@ uint32 StaticDataMgr::GetStationConstellation(uint32 stationID)
 
 uint32 StaticDataMgr::GetStationSystem(uint32 stationID)
 {
-    std::map<uint32, uint32>::iterator itr = m_stationSystem.find(stationID);
-    if (itr != m_stationSystem.end())
-        return itr->second;
+    const StationLocation* pData = m_stations.Find(stationID);
+    if (pData != nullptr)
+        return pData->systemID;
 
     _log(DATA__MESSAGE, "Failed to query system info for station %u: Station not found.", stationID);
     return 0;
@@ -1177,9 +1446,9 @@ bool StaticDataMgr::GetSystemData(uint32 locationID, SystemData& data)
         return false;
     }
 
-    std::map<uint32, SystemData>::iterator itr = m_systemData.find(locationID);
-    if (itr != m_systemData.end()) {
-        data = itr->second;
+    const SystemData* pData = m_systemData.Find(locationID);
+    if (pData != nullptr) {
+        data = *pData;
         return true;
     }
 
@@ -1197,9 +1466,9 @@ const char* StaticDataMgr::GetSystemName(uint32 locationID)
         return "Error";
     }
 
-    std::map<uint32, SystemData>::iterator itr = m_systemData.find(locationID);
-    if (itr != m_systemData.end())
-        return itr->second.name.c_str();
+    const SystemData* pData = m_systemData.Find(locationID);
+    if (pData != nullptr)
+        return pData->name.c_str();
 
     _log(DATA__MESSAGE, "Failed to query info for system %u: System not found.", locationID);
     return "Invalid";
@@ -1217,9 +1486,9 @@ bool StaticDataMgr::GetSolarSystemData(uint32 sysID, SolarSystemData& into)
 
 bool StaticDataMgr::GetStaticInfo(uint32 itemID, StaticData& data)
 {
-    std::map<uint32, StaticData>::iterator itr = m_staticData.find(itemID);
-    if (itr != m_staticData.end()) {
-        data = itr->second;
+    const StaticData* pData = m_staticData.Find(itemID);
+    if (pData != nullptr) {
+        data = *pData;
         return true;
     }
 
@@ -1229,17 +1498,17 @@ bool StaticDataMgr::GetStaticInfo(uint32 itemID, StaticData& data)
 
 uint16 StaticDataMgr::GetStaticType(uint32 itemID)
 {
-    std::map<uint32, StaticData>::iterator itr = m_staticData.find(itemID);
-    if (itr != m_staticData.end())
-        return itr->second.typeID;
+    const StaticData* pData = m_staticData.Find(itemID);
+    if (pData != nullptr)
+        return pData->typeID;
     return 0;
 }
 
 uint32 StaticDataMgr::GetRegionFaction(uint32 regionID)
 {
-    std::map<uint32, uint32>::iterator itr = m_regions.find(regionID);
-    if (itr != m_regions.end())
-        return itr->second;
+    const uint32* pFaction = m_regions.Find(regionID);
+    if (pFaction != nullptr)
+        return *pFaction;
 
     _log(DATA__MESSAGE, "Failed to query faction for region %u: region not found.", regionID);
     return 0;
@@ -1247,9 +1516,9 @@ uint32 StaticDataMgr::GetRegionFaction(uint32 regionID)
 
 uint32 StaticDataMgr::GetRegionRatFaction(uint32 regionID)
 {
-    std::map<uint32, uint32>::iterator itr = m_ratRegions.find(regionID);
-    if (itr != m_ratRegions.end())
-        return itr->second;
+    const uint32* pFaction = m_ratRegions.Find(regionID);
+    if (pFaction != nullptr)
+        return *pFaction;
 
     _log(DATA__MESSAGE, "Failed to query rat faction for region %u: region not found.", regionID);
     return 0;
@@ -1317,15 +1586,13 @@ return {10000001: (500019,),
 bool StaticDataMgr::IsSolarSystem(uint32 systemID/*0*/)
 {
     // if systemID has entry here, it is valid
-    std::map<uint32, SystemData>::iterator itr = m_systemData.find(systemID);
-    return (itr != m_systemData.end());
+    return m_systemData.Has(systemID);
 }
 
 bool StaticDataMgr::IsStation(uint32 stationID/*0*/)
 {
     // if stationID has entry here, it is valid
-    std::map<uint32, uint32>::iterator itr = m_stationRegion.find(stationID);
-    return (itr != m_stationRegion.end());
+    return m_stations.Has(stationID);
 }
 
 DBRowDescriptor* StaticDataMgr::CreateHeader() {
@@ -1609,9 +1876,9 @@ std::string StaticDataMgr::GetOwnerName(int32 ownerID)
 uint8 StaticDataMgr::GetRegionQuarter(uint32 regionID)
 {
     uint32 factionID = 0;
-    std::map<uint32, uint32>::iterator itr = m_regions.find(regionID);
-    if (itr != m_regions.end())
-        factionID = (*itr).second;
+    const uint32* pFaction = m_regions.Find(regionID);
+    if (pFaction != nullptr)
+        factionID = *pFaction;
 
     // caldari=1, minmatar=2, amarr=3, gallente=4, none=5
     switch (factionID) {
@@ -1701,9 +1968,9 @@ std::string StaticDataMgr::GetCorpName(uint32 corpID)
 
 uint32 StaticDataMgr::GetCorpFaction(uint32 corpID)
 {
-    std::map<uint32, uint32>::iterator itr = m_corpFaction.find(corpID);
-    if (itr != m_corpFaction.end())
-        return itr->second;
+    const uint32* pFaction = m_corpFaction.Find(corpID);
+    if (pFaction != nullptr)
+        return *pFaction;
 
     if (IsNPCCorp(corpID))
         _log(DATA__ERROR, "Faction not found for NPC corp %s", GetCorpName(corpID).c_str());
@@ -2189,38 +2456,23 @@ uint32 StaticDataMgr::GetWreckFaction(uint32 typeID)
 // Add a new outpost to the staticDataMgr
 void StaticDataMgr::AddOutpost(StationData &stData)
 {
-    // Update m_stationCount
-    std::map<uint32, uint8>::iterator itr = m_stationCount.lower_bound(stData.systemID);
-    if (itr != m_stationCount.end() && !(m_stationCount.key_comp()(stData.systemID, itr->first)))
-    {
-        itr->second = itr->second + 1;
-    }
-    else
-    {
-        m_stationCount.emplace(stData.systemID, 1);
-    }
-
-    // Update m_stationRegion
-    if (m_stationRegion.find(stData.stationID) == m_stationRegion.end()) {
-        m_stationRegion.emplace(stData.stationID, stData.regionID);
-    }
+    // a rare change, so the tables' linear Insert() is fine here
+    if (m_stations.Has(stData.stationID))
+        return;
 
-    // Update m_stationConstellation
-    if (m_stationConst.find(stData.stationID) == m_stationConst.end()) {
-        m_stationConst.emplace(stData.stationID, stData.constellationID);
-    }
-
-    // Update m_stationSystem
-    if (m_stationSystem.find(stData.stationID) == m_stationSystem.end()) {
-        m_stationSystem.emplace(stData.stationID, stData.systemID);
-    }
+    StationLocation data = StationLocation();
+    data.systemID           = stData.systemID;
+    data.constellationID    = stData.constellationID;
+    data.regionID           = stData.regionID;
+    m_stations.Insert(stData.stationID, data);
+    m_stationList.Insert(stData.systemID, stData.stationID);
 }
 
 // ---marketbot changes
 bool StaticDataMgr::GetStationListForSystem(uint32 systemID, std::vector<uint32>& stations) const {
-    auto itr = m_stationList.find(systemID);
-    if (itr != m_stationList.end() && !itr->second.empty()) {
-        stations = itr->second;
+    Span<uint32> list = m_stationList.Range(systemID);
+    if (!list.empty()) {
+        stations.assign(list.begin(), list.end());
         return true;
     }
     return false;
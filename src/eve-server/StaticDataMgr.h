@@ -22,6 +22,9 @@
 #include "../eve-common/EVE_RAM.h"
 #include "../eve-common/EVE_Market.h"
 
+#include "utils/FlatMap.h"
+#include "utils/SnapshotFile.h"
+
 
 //struct CelestialObjectData;
 struct SolarSystemData;
@@ -51,8 +54,12 @@ public:
     void                GetCategory(uint8 catID, Inv::CatData &into);
     void                GetGroup(uint16 grpID, Inv::GrpData &into);
     void                GetType(uint16 typeID, Inv::TypeData &into);
+    // nullptr if there's no such type; good for as long as the manager
+    const Inv::TypeData* FindType(uint16 typeID)        { return m_typeData.Find(typeID); }
+    const Inv::GrpData* FindGroup(uint16 grpID)         { return m_grpData.Find(grpID); }
     void                GetTypes(std::map<uint16, Inv::TypeData> &into);
     const char*         GetAttrName(uint16 attrID);
+    bool                IsStackable(uint16 attrID);     // false for attribs whose like module modifiers are stacking penalized
     const char*         GetTypeName(uint16 typeID);     // not sure if this will be needed
     const char*         GetGroupName(uint16 grpID);
     const char*         GetCategoryName(uint8 catID);
@@ -81,6 +88,8 @@ public:
     void                GetRamReturns(uint16 typeID, int8 activityID, std::vector< EvERam::RequiredItem >& ramReqs); // bp typeID/data
     void                GetRamMaterials(uint16 typeID, std::vector<EvERam::RamMaterials>& ramMatls);    // bp productTypeID/data{typeID/qty}
     void                GetRamRequirements(uint16 typeID, std::vector< EvERam::RamRequirements >& ramReqs); // bp typeID/data
+    Span<EvERam::RamMaterials> GetRamMaterials(uint16 typeID)   { return m_ramMatl.Range(typeID); }
+    Span<EvERam::RamRequirements> GetRamRequirements(uint16 typeID) { return m_ramReq.Range(typeID); }
     // this is for ALL needed materials for RAM activity from BP.  these are NOT modified.
     void                GetRamRequiredItems(const uint32 typeID, const int8 activity, std::vector<EvERam::RequiredItem> &into);
 
@@ -107,6 +116,7 @@ public:
 
     uint8               GetStationCount(uint32 systemID);
     bool                GetStationList(uint32 systemID, std::vector< uint32 >& data);
+    Span<uint32>        GetStationList(uint32 systemID) { return m_stationList.Range(systemID); }
 
     bool                GetRoidDist(const char* secClass, std::unordered_multimap<float, uint16>& roids);
     uint8               GetRegionQuarter(uint32 regionID);
@@ -114,10 +124,11 @@ public:
     uint32              GetRegionRatFaction(uint32 regionID);
 
     uint8               GetWHSystemClass(uint32 systemID);
-    std::vector<uint32> GetWHDestinationTypes(uint32 classID) { return m_whClassDestinations[classID]; }
-    std::vector<uint32> GetWHClassSystems(uint8 classID) { return m_whClassSystems[classID]; }
+    Span<uint32>        GetWHDestinationTypes(uint32 classID) { return m_whClassDestinations.Range(classID); }
+    Span<uint32>        GetWHClassSystems(uint8 classID) { return m_whClassSystems.Range(classID); }
 
     void                GetDgmTypeAttrVec(uint16 typeID, std::vector< DmgTypeAttribute >& typeAttrVec);
+    Span<DmgTypeAttribute> GetDgmTypeAttrs(uint16 typeID) { return m_typeAttrMap.Range(typeID); }
 
     PyDict*             SetBPMatlType(int8 catID, uint16 typeID, uint16 prodID);
     PyDict*             GetBPMatlData(uint16 typeID);   //this is called on EVERY "show info" of a blueprint
@@ -163,6 +174,13 @@ public:
     // ---
 protected:
     void                Populate();
+    // types, systems, static entities, stations and type attributes, from the db
+    void                PopulateTables(DBQueryResult& res);
+
+    /* the PopulateTables() data, from/to a SnapshotFile.  the hash covers the tables it came from (see ManagerDB::GetSnapshotChecksum()) */
+    bool                GetSnapshotHash(uint64_t& hash);
+    bool                LoadSnapshot(const std::string& path, uint64_t hash);
+    void                SaveSnapshot(const std::string& path, uint64_t hash);
 
 private:
     PyTuple*                                            m_factionInfo;
@@ -173,38 +191,38 @@ private:
     PyObjectEx*                                         m_agents;
     PyObjectEx*                                         m_operands;
 
-    std::map<uint16, Inv::CatData>                      m_catData;
-    std::map<uint16, Inv::GrpData>                      m_grpData;
-    std::map<uint16, Inv::TypeData>                     m_typeData;
+    // the plain tables of a warm start are used in place from here
+    SnapshotFile                                        m_snapshot;
+
+    /* the hot tables are FlatMaps: built once at startup, then sorted arrays.  they may be multimaps */
+    FlatMap<uint16, Inv::CatData>                       m_catData;
+    FlatMap<uint16, Inv::GrpData>                       m_grpData;
+    FlatMap<uint16, Inv::TypeData>                      m_typeData;
+    FlatMap<uint16, AttrTypeData>                       m_attrTypeData;     // attrID/data
+    FlatMap<uint32, SystemData>                         m_systemData;       // systemID/data
+    FlatMap<uint32, StaticData>                         m_staticData;       // itemID/data
+    FlatMap<uint32, StationLocation>                    m_stations;         // stationID/data
+    FlatMap<uint32, uint32>                             m_stationList;      // systemID/stationIDs
+    FlatMap<uint16, DmgTypeAttribute>                   m_typeAttrMap;      // typeID/data<attrID, value>
+    FlatMap<uint16, EvERam::RamMaterials>               m_ramMatl;          // itemTypeID/data
+    FlatMap<uint16, EvERam::RamRequirements>            m_ramReq;           // bpTypeID/data
+    FlatMap<uint32, uint32>                             m_whClassDestinations; //classID/typeIDs
+    FlatMap<uint32, uint32>                             m_whClassSystems;   //classID/systemIDs
+    FlatMap<uint32, uint32>                             m_regions;          // regionID/ownerFactionID
+    FlatMap<uint32, uint32>                             m_ratRegions;       // regionID/ratFactionID
+    FlatMap<uint32, uint32>                             m_corpFaction;      // corpID/factionID
 
     std::map<uint16, PyDict*>                           m_bpMatlData;       // typeID/dict*
     std::map<uint32, uint8>                             m_whRegions;        // regionID/classID
-    std::map<uint32, std::vector<uint32>>               m_whClassDestinations; //classID/typeID
-    std::map<uint32, std::vector<uint32>>               m_whClassSystems;   //classID/systemID
-    std::map<uint32, uint32>                            m_regions;          // regionID/ownerFactionID
-    std::map<uint32, uint32>                            m_ratRegions;       // regionID/ratFactionID
-    std::map<uint32, SystemData>                        m_systemData;       // systemID/data
     std::map<uint32, uint32>                            m_agentSystem;      // agentID/systemID
-    std::map<uint32, uint32>                            m_corpFaction;      // corpID/factionID
-    std::map<uint32, uint8>                             m_stationCount;     // systemID/count
-    std::map<uint32, std::vector<uint32>>               m_stationList;      // systemID/data<stationID>
-    std::map<uint32, uint32>                            m_stationRegion;    // stationID/regionID
-    std::map<uint32, uint32>                            m_stationConst;     // stationID/systemID
-    std::map<uint32, uint32>                            m_stationSystem;    // stationID/systemID
     std::map<uint32, SolarSystemData>                   m_solSysData;       // systemID/data
     std::map<uint32, uint8>                             m_factionRaces;     // factionID/raceID
     std::map<uint16, EvERam::bpTypeData>                m_bpTypeData;       // typeID/data
     std::map<uint16, uint8>                             m_moonGoo;          // typeID/rarity
     std::map<uint16, std::string>                       m_skills;           // typeID/name
-    std::map<uint32, StaticData>                        m_staticData;       // itemID/data
-    std::map<uint16, AttrTypeData>                      m_attrTypeData;     // attrID/data
 
-    std::multimap<uint16, EvERam::RamMaterials>         m_ramMatl;          // itemTypeID/data
-    std::multimap<uint16, EvERam::RamRequirements>      m_ramReq;           // bpTypeID/data
     std::multimap<std::string, OreTypeChance>           m_oreBySecClass;    // systemSecClass/data
 
-    std::multimap<uint16, DmgTypeAttribute>             m_typeAttrMap;      // typeID/data<attrID, value>
-
     /* spawn data */
     // roid rats
     typedef std::vector<uint16>                         rt_typeIDs;
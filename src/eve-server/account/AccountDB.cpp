@@ -43,93 +43,53 @@
  * ACCOUNT__DB_MESSAGE
  */
 
-double AccountDB::OfflineFundXfer(uint32 charID, double amount, uint8 type)
+const char* AccountDB::GetBalanceColumn(uint32 ownerID, uint16 accountKey)
 {
-    std::string from = "";
-    switch (type) {
-        case Account::CreditType::ISK:      from = "balance";    break;
-        case Account::CreditType::AURUM:    from = "aurBalance"; break;
-        case Account::CreditType::MPLEX:    return 0; //make error..this isnt used yet
+    static const char* corpColumns[] = { "balance1", "balance2", "balance3", "balance4", "balance5", "balance6", "balance7" };
+    if (IsCharacterID(ownerID)) {
+        if (accountKey == Account::KeyType::Cash)
+            return "balance";
+        if (accountKey == Account::KeyType::AUR)
+            return "aurBalance";
+    } else if (IsPlayerCorp(ownerID)) {
+        if ((accountKey >= Account::KeyType::Cash) and (accountKey <= Account::KeyType::Cash7))
+            return corpColumns[accountKey - Account::KeyType::Cash];
     }
-
-    double balance = 0;
-    DBQueryResult res;
-    sDatabase.RunQuery(res, "SELECT %s FROM chrCharacters WHERE characterID = %u", from.c_str(), charID);
-    DBResultRow row;
-    if (res.GetRow(row))
-        balance = row.GetDouble(0);
-
-    balance += amount;
-    DBerror err;
-    sDatabase.RunQuery(err, "UPDATE chrCharacters SET %s = %f WHERE characterID = %u", from.c_str(), balance, charID);
-    return balance;
+    return nullptr;
 }
 
-
-double AccountDB::GetCorpBalance(uint32 corpID, uint16 accountKey)
+bool AccountDB::GetCharacterBalances(uint32 charID, double& isk, double& aur)
 {
-    std::string acctKey = "";
-    switch (accountKey) {
-        case Account::KeyType::Cash:    acctKey = "balance1"; break;
-        case Account::KeyType::Cash2:   acctKey = "balance2"; break;
-        case Account::KeyType::Cash3:   acctKey = "balance3"; break;
-        case Account::KeyType::Cash4:   acctKey = "balance4"; break;
-        case Account::KeyType::Cash5:   acctKey = "balance5"; break;
-        case Account::KeyType::Cash6:   acctKey = "balance6"; break;
-        case Account::KeyType::Cash7:   acctKey = "balance7"; break;
-    }
     DBQueryResult res;
-    if (!sDatabase.RunQuery(res, "SELECT %s FROM crpWalletDivisons WHERE corporationID = %u ", acctKey.c_str(), corpID)) {
+    if (!sDatabase.RunQuery(res, "SELECT balance, aurBalance FROM chrCharacters WHERE characterID = %u", charID)) {
         codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
+        return false;
     }
     DBResultRow row;
     if (!res.GetRow(row))
-        return 0;
-    return row.GetDouble(0);
+        return false;
+    isk = row.GetDouble(0);
+    aur = row.GetDouble(1);
+    return true;
 }
 
-void AccountDB::UpdateCorpBalance(uint32 corpID, uint16 accountKey, double amount)
+bool AccountDB::GetCorpBalances(uint32 corpID, double* balances)
 {
-    std::string acctKey = "";
-    switch (accountKey) {
-        case Account::KeyType::Cash:    acctKey = "balance1"; break;
-        case Account::KeyType::Cash2:   acctKey = "balance2"; break;
-        case Account::KeyType::Cash3:   acctKey = "balance3"; break;
-        case Account::KeyType::Cash4:   acctKey = "balance4"; break;
-        case Account::KeyType::Cash5:   acctKey = "balance5"; break;
-        case Account::KeyType::Cash6:   acctKey = "balance6"; break;
-        case Account::KeyType::Cash7:   acctKey = "balance7"; break;
-    }
-    DBerror err;
-    sDatabase.RunQuery(err, "UPDATE crpWalletDivisons SET %s = %.2f WHERE corporationID = %u ", acctKey.c_str(), amount, corpID);
-}
-
-
-PyRep *AccountDB::GetWalletDivisionsInfo(uint32 corpID) {
     DBQueryResult res;
     if (!sDatabase.RunQuery(res,
-        "SELECT balance1, balance2, balance3, balance4, balance5, balance6,  balance7"
+        "SELECT balance1, balance2, balance3, balance4, balance5, balance6, balance7"
         " FROM crpWalletDivisons"
         " WHERE corporationID = %u", corpID))
     {
         codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
-        return nullptr;
+        return false;
     }
-
     DBResultRow row;
-    PyList *list = new PyList();
-    if (res.GetRow(row))
-        for (int8 i = 0; i < 7; ++i) {
-            PyDict *dict = new PyDict();
-            dict->SetItemString("key", new PyInt(1000 + i));
-            dict->SetItemString("balance", new PyFloat(row.GetDouble(i)));
-            list->AddItem(new PyObject("util.KeyVal", dict));
-        }
-
-    if (is_log_enabled(ACCOUNT__RSP_DUMP))
-        list->Dump(ACCOUNT__RSP_DUMP, "    ");
-    return list;
+    if (!res.GetRow(row))
+        return false;
+    for (uint8 i = 0; i < 7; ++i)
+        balances[i] = row.GetDouble(i);
+    return true;
 }
 
 PyRep* AccountDB::GetJournal(uint32 ownerID, int8 entryTypeID, uint16 accountKey, int64 fromDate, bool reverse/*false*/)
@@ -163,26 +123,158 @@ PyRep* AccountDB::GetJournal(uint32 ownerID, int8 entryTypeID, uint16 accountKey
     return DBResultToCRowset(res);
 }
 
-void AccountDB::AddJournalEntry(uint32 ownerID, int8 entryTypeID, uint32 ownerFromID, uint32 ownerToID, int8 currency, \
-                                uint16 accountKey, double amount, double newBalance, std::string description, uint32 referenceID/*0*/ )
+void AccountDB::SaveJournal(const std::vector<WalletLedger::Entry>& entries, uint16 batch)
 {
-    if (entryTypeID == Journal::EntryType::SkipLog)
-        return;
-    // account key 0 is usually sent by the client, it should be the main cash account
-    if (accountKey == 0)
-        accountKey = Account::KeyType::Cash;
-
+    // one insert per table for every 'batch' rows, in sequence order
+    std::string query[2];
+    uint16 rows[2] = { 0, 0 };
     std::string eDesc;
-    sDatabase.DoEscapeString(eDesc, description);
+    char buf[256];
+    for (auto& cur : entries) {
+        const uint8 corp = (IsCorp(cur.ownerID) ? 1 : 0);
+        if (query[corp].empty()) {
+            query[corp] = "INSERT INTO ";
+            query[corp] += (corp ? "jnlCorporations" : "jnlCharacters");
+            query[corp] += " (ownerID, entryTypeID, accountKey, transactionDate, ownerID1, ownerID2, referenceID, currency, amount, balance, description, ledgerSeq)"
+                           " VALUES ";
+        } else {
+            query[corp] += ",";
+        }
 
-    std::string tblName = "jnlCharacters";
-    if (IsCorp(ownerID))
-        tblName = "jnlCorporations";
+        snprintf(buf, sizeof(buf), "(%u,%u,%u,%f,%u,%u,%u,%i,%.2f,%.2f,'",
+                 cur.ownerID, cur.entryTypeID, cur.accountKey, cur.date,
+                 cur.ownerFromID, cur.ownerToID, cur.referenceID, cur.currency, cur.amount, cur.balance);
+        query[corp] += buf;
+        sDatabase.DoEscapeString(eDesc, cur.description);
+        query[corp] += eDesc;
+        snprintf(buf, sizeof(buf), "',%lli)", (int64)cur.seq);
+        query[corp] += buf;
 
-    // dont care if this fails...
+        if (++rows[corp] < batch)
+            continue;
+        sDatabase.RunQueryAsync("%s", query[corp].c_str());
+        query[corp].clear();
+        rows[corp] = 0;
+    }
+    for (uint8 i = 0; i < 2; ++i)
+        if (rows[i] > 0)
+            sDatabase.RunQueryAsync("%s", query[i].c_str());
+}
+
+void AccountDB::SaveBalances(const std::vector<WalletLedger::Balance>& balances, uint64_t seq, uint16 batch)
+{
+    std::vector<WalletLedger::Balance> chars, corps;
+    for (auto& cur : balances)
+        (IsCharacterID(cur.ownerID) ? chars : corps).push_back(cur);
+
+    UpdateBalances("chrCharacters", "characterID", chars, batch);
+    UpdateBalances("crpWalletDivisons", "corporationID", corps, batch);
+    // queued after the rest of the flush, so this runs once all of it has
+    sDatabase.RunQueryAsync("UPDATE srvStatus SET walletSeq = %lli WHERE AI = 1", (int64)seq);
+}
+
+void AccountDB::UpdateBalances(const char* table, const char* idColumn, const std::vector<WalletLedger::Balance>& balances, uint16 batch)
+{
+    // balances come by owner; one update for every 'batch' owners, each owner's wallets and walletSeq in one go
+    char buf[128];
+    size_t i(0);
+    while (i < balances.size()) {
+        std::map<std::string, std::string> columns;     // column/its WHEN arms
+        std::string seqs, ids;
+        for (uint16 owners = 0; (owners < batch) and (i < balances.size()); ++owners) {
+            const uint32 ownerID = balances[i].ownerID;
+            uint64_t seq(0);
+            for (; (i < balances.size()) and (balances[i].ownerID == ownerID); ++i) {
+                const char* column = GetBalanceColumn(ownerID, balances[i].accountKey);
+                if (column == nullptr)
+                    continue;
+                snprintf(buf, sizeof(buf), " WHEN %u THEN %.2f", ownerID, balances[i].balance);
+                columns[column] += buf;
+                seq = std::max(seq, balances[i].seq);
+            }
+            if (seq == 0)
+                continue;
+            snprintf(buf, sizeof(buf), " WHEN %u THEN %lli", ownerID, (int64)seq);
+            seqs += buf;
+            if (!ids.empty())
+                ids += ",";
+            ids += std::to_string(ownerID);
+        }
+
+        if (ids.empty())
+            continue;
+        std::string query = "UPDATE ";
+        query += table;
+        query += " SET ";
+        for (auto& cur : columns)
+            query += cur.first + " = CASE " + idColumn + cur.second + " ELSE " + cur.first + " END, ";
+        query += "walletSeq = CASE ";
+        query += idColumn + seqs + " ELSE walletSeq END WHERE " + idColumn + " IN (" + ids + ")";
+        sDatabase.RunQueryAsync("%s", query.c_str());
+    }
+}
+
+uint64_t AccountDB::RecoverWallets(uint32& recovered)
+{
+    recovered = 0;
+    DBQueryResult res;
+    DBResultRow row;
+    if (!sDatabase.RunQuery(res, "SELECT walletSeq FROM srvStatus WHERE AI = 1")) {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+        return 0;
+    }
+    uint64_t flushed(0);
+    if (res.GetRow(row))
+        flushed = row.GetInt64(0);
+
+    /* everything up to 'flushed' was written whole.  past that, a journal row newer than
+     * its wallet's walletSeq is from a flush that stopped before the wallet was written,
+     * and the last such row of each wallet has the balance it should have. */
+    const char* tables[2][3] = {
+        { "jnlCharacters",   "chrCharacters",     "characterID" },
+        { "jnlCorporations", "crpWalletDivisons", "corporationID" }
+    };
     DBerror err;
-    sDatabase.RunQuery(err,
-        "INSERT INTO %s (ownerID, entryTypeID, accountKey, transactionDate, ownerID1, ownerID2, referenceID, currency, amount, balance, description)"
-        " VALUES (%u,%u,%u,%f,%u,%u,%u,%i,%.2f,%.2f,'%s')",
-        tblName.c_str(), ownerID, entryTypeID, accountKey, GetFileTimeNow(), ownerFromID, ownerToID, referenceID, currency, amount, newBalance, eDesc.c_str());
+    for (auto& cur : tables) {
+        if (!sDatabase.RunQuery(res,
+            "SELECT j.ownerID, j.accountKey, j.balance, j.ledgerSeq"
+            " FROM %s AS j"
+            "  JOIN %s AS w ON w.%s = j.ownerID"
+            " WHERE j.ledgerSeq > %lli AND j.ledgerSeq > w.walletSeq"
+            " ORDER BY j.ledgerSeq", cur[0], cur[1], cur[2], (int64)flushed))
+        {
+            codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+            continue;
+        }
+
+        std::map<std::pair<uint32, uint16>, std::pair<double, uint64_t>> last;
+        while (res.GetRow(row))
+            last[std::make_pair(row.GetUInt(0), (uint16)row.GetUInt(1))] = std::make_pair(row.GetDouble(2), (uint64_t)row.GetInt64(3));
+
+        for (auto& wallet : last) {
+            const char* column = GetBalanceColumn(wallet.first.first, wallet.first.second);
+            if (column == nullptr)
+                continue;   // journal only; not a wallet we keep
+            sDatabase.RunQuery(err, "UPDATE %s SET %s = %.2f, walletSeq = GREATEST(walletSeq, %lli) WHERE %s = %u",
+                               cur[1], column, wallet.second.first, (int64)wallet.second.second, cur[2], wallet.first.first);
+            ++recovered;
+        }
+    }
+
+    if (!sDatabase.RunQuery(res,
+        "SELECT GREATEST(%lli,"
+        "  (SELECT COALESCE(MAX(ledgerSeq), 0) FROM jnlCharacters),"
+        "  (SELECT COALESCE(MAX(ledgerSeq), 0) FROM jnlCorporations),"
+        "  (SELECT COALESCE(MAX(walletSeq), 0) FROM chrCharacters),"
+        "  (SELECT COALESCE(MAX(walletSeq), 0) FROM crpWalletDivisons))", (int64)flushed))
+    {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+        return flushed;
+    }
+    uint64_t seq(flushed);
+    if (res.GetRow(row))
+        seq = row.GetInt64(0);
+
+    sDatabase.RunQuery(err, "UPDATE srvStatus SET walletSeq = %lli WHERE AI = 1", (int64)seq);
+    return seq;
 }
@@ -27,22 +27,31 @@
 #define EVE_ACCOUNT_DB_H
 
 #include "ServiceDB.h"
+#include "account/WalletLedger.h"
 
 
 class AccountDB
 {
 public:
-    PyRep* GetWalletDivisionsInfo(uint32 corpID);
-
     PyRep* GetJournal(uint32 ownerID, int8 entryTypeID, uint16 accountKey, int64 fromDate, bool reverse = false);
 
-    static double OfflineFundXfer(uint32 charID, double amount, uint8 type=Account::CreditType::ISK);
-    static double GetCorpBalance(uint32 corpID, uint16 accountKey);
-    static void UpdateCorpBalance(uint32 corpID, uint16 accountKey, double amount);
-
-    static void AddJournalEntry(uint32 ownerID, int8 entryTypeID, uint32 ownerFromID, uint32 ownerToID, int8 currency, uint16 accountKey, \
-                                double amount, double newBalance, std::string description, uint32 referenceID = 0);
-
+    /* the column of 'ownerID's table holding the wallet for 'accountKey'.
+     * nullptr if there's no such wallet (only characters and player corps have them) */
+    static const char* GetBalanceColumn(uint32 ownerID, uint16 accountKey);
+    static bool GetCharacterBalances(uint32 charID, double& isk, double& aur);
+    /* 'balances' gets the seven divisions, Cash first */
+    static bool GetCorpBalances(uint32 corpID, double* balances);
+
+    /* wallet write-behind, queued on the async write connection in call order.
+     * SaveJournal() then SaveBalances() for each flush; see WalletMgr */
+    static void SaveJournal(const std::vector<WalletLedger::Entry>& entries, uint16 batch);
+    static void SaveBalances(const std::vector<WalletLedger::Balance>& balances, uint64_t seq, uint16 batch);
+    /* sets wallets the last run journaled but didn't get to write, and marks everything written.
+     * @return the highest ledger sequence number used so far */
+    static uint64_t RecoverWallets(uint32& recovered);
+
+private:
+    static void UpdateBalances(const char* table, const char* idColumn, const std::vector<WalletLedger::Balance>& balances, uint16 batch);
 };
 
 
@@ -31,6 +31,7 @@
 
 #include "StaticDataMgr.h"
 #include "account/AccountService.h"
+#include "account/WalletMgr.h"
 #include "cache/ObjCacheService.h"
 #include "corporation/CorporationDB.h"
 
@@ -83,7 +84,18 @@ PyResult AccountService::GetEntryTypes(PyCallArgs &call)
 
 PyResult AccountService::GetWalletDivisionsInfo(PyCallArgs &call)
 {
-    return m_db.GetWalletDivisionsInfo(call.client->GetCorporationID());
+    const uint32 corpID(call.client->GetCorporationID());
+    PyList *list = new PyList();
+    for (uint16 key = Account::KeyType::Cash; key <= Account::KeyType::Cash7; ++key) {
+        PyDict *dict = new PyDict();
+        dict->SetItemString("key", new PyInt(key));
+        dict->SetItemString("balance", new PyFloat(sWalletMgr.GetBalance(corpID, key)));
+        list->AddItem(new PyObject("util.KeyVal", dict));
+    }
+
+    if (is_log_enabled(ACCOUNT__RSP_DUMP))
+        list->Dump(ACCOUNT__RSP_DUMP, "    ");
+    return list;
 }
 
 // from mail/label window->settings
@@ -140,7 +152,7 @@ PyResult AccountService::GetCashBalance(PyCallArgs &call, std::optional<PyInt*>
         accountKey = walletKey.value()->value();
 
     if (isCorpWallet.has_value() && isCorpWallet.value()->value()) {
-        balance = AccountDB::GetCorpBalance( call.client->GetCorporationID(), accountKey);
+        balance = sWalletMgr.GetBalance(call.client->GetCorporationID(), accountKey);
     } else {
         int8 type = Account::CreditType::ISK;
         if (accountKey == Account::KeyType::AUR) {
@@ -329,31 +341,14 @@ void AccountService::TransferFunds(
 
     double newBalanceFrom(0), newBalanceTo(0);
 
-    Client* pClientFrom(nullptr);
-
     if (IsCharacterID(fromID)) {
-        pClientFrom = sEntityList.FindClientByCharID(fromID);
-        if (pClientFrom == nullptr) {
-            // sender is offline. transfer funds through the database instead
-            newBalanceFrom = AccountDB::OfflineFundXfer(fromID, -amount, fromCurrency);
-        } else {
-            // this will throw if it fails
-            pClientFrom->AddBalance(-amount, fromCurrency);
-            newBalanceFrom = pClientFrom->GetBalance(fromCurrency);
+        if (!sWalletMgr.Apply(fromID, WalletMgr::GetCharacterKey(fromCurrency), fromCurrency, -amount, newBalanceFrom,
+                              entryTypeID, fromID, toID, reason, referenceID))
+        {
+            throw UserError ("NotEnoughMoney")
+                    .AddISK ("amount", amount)
+                    .AddISK ("balance", newBalanceFrom);
         }
-
-        AccountDB::AddJournalEntry(
-            fromID,
-            entryTypeID,
-            fromID,
-            toID,
-            fromCurrency,
-            fromKey,
-            -amount,
-            newBalanceFrom,
-            reason,
-            referenceID
-        );
     } else if (IsPlayerCorp(fromID)) {
         uint32 userID(0);
         if (pClient != nullptr) {
@@ -384,29 +379,8 @@ void AccountService::TransferFunds(
 
     if (IsCharacterID(toID)) {
         pClientTo = sEntityList.FindClientByCharID(toID);
-        if (pClientTo == nullptr) {
-            // receipient is offline. xfer funds thru db
-            newBalanceTo = AccountDB::OfflineFundXfer(toID, amount, toCurrency);
-        } else {
-            // this will throw if it fails
-            pClientTo->AddBalance(amount, toCurrency);
-            /** @todo if this DOES fail, return funds to origin.  this needs a try/catch block */
-            //TransferFunds(corpSCC, fromID, amount, reason, Journal::EntryType::Undefined, referenceID, fromKey, fromKey);
-            newBalanceTo = pClientTo->GetBalance(toCurrency);
-        }
-
-        AccountDB::AddJournalEntry(
-            toID,
-            entryTypeID,
-            fromID,
-            toID,
-            toCurrency,
-            toKey,
-            amount,
-            newBalanceTo,
-            reason,
-            referenceID
-        );
+        sWalletMgr.Apply(toID, WalletMgr::GetCharacterKey(toCurrency), toCurrency, amount, newBalanceTo,
+                         entryTypeID, fromID, toID, reason, referenceID);
     } else if (IsPlayerCorp(toID)) {
         uint32 userID(0);
 
@@ -427,18 +401,7 @@ void AccountService::TransferFunds(
         );
         return;
     } else {
-        AccountDB::AddJournalEntry(
-            toID,
-            entryTypeID,
-            fromID,
-            toID,
-            toCurrency,
-            toKey,
-            amount,
-            newBalanceTo,
-            reason,
-            referenceID
-        );
+        sWalletMgr.Apply(toID, toKey, toCurrency, amount, newBalanceTo, entryTypeID, fromID, toID, reason, referenceID);
 
         _log(ACCOUNT__TRACE,
             "TransferFunds() - toID: %s(%u) is neither player nor player corp.  Not sending update.",
@@ -535,26 +498,14 @@ void AccountService::HandleCorpTransaction(uint32 corpID, int8 entryTypeID, uint
     if (is_log_enabled(ACCOUNT__TRACE))
         _log(ACCOUNT__TRACE, "HandleCorpTransaction() - corp: %u, from: %u, to: %u, entry: %u, refID: %u, amount: %.2f, key: %u, currency: %u", \
                         corpID, fromID, toID, entryTypeID, referenceID, amount, accountKey, currency);
-    double balance = AccountDB::GetCorpBalance(corpID, accountKey);
-    // verify funds available for withdraw first
-    if (amount < 0) {
-        if (-amount > balance) {
-            std::map<std::string, PyRep *> args;
-            args["owner"] = new PyString(CorporationDB::GetCorpName(corpID));
-            args["amount"] = new PyFloat(-amount);
-            args["balance"] = new PyFloat(balance);
-            args["division"] = new PyString(CorporationDB::GetDivisionName(corpID, accountKey));
-            throw UserError ("NotEnoughMoneyCorp")
-                    .AddOwnerName ("owner", corpID)
-                    .AddISK ("amount", -amount)
-                    .AddISK ("balance", balance)
-                    .AddFormatValue ("division", new PyString (CorporationDB::GetDivisionName (corpID, accountKey)));
-        }
+    double balance(0);
+    if (!sWalletMgr.Apply(corpID, accountKey, currency, amount, balance, entryTypeID, fromID, toID, description, referenceID)) {
+        throw UserError ("NotEnoughMoneyCorp")
+                .AddOwnerName ("owner", corpID)
+                .AddISK ("amount", -amount)
+                .AddISK ("balance", balance)
+                .AddFormatValue ("division", new PyString (CorporationDB::GetDivisionName (corpID, accountKey)));
     }
-    // get new corp balance
-    balance += amount;
-    // update corp balance
-    AccountDB::UpdateCorpBalance(corpID, accountKey, balance);
 
     OnAccountChange oac;
     switch (accountKey) {
@@ -570,5 +521,4 @@ void AccountService::HandleCorpTransaction(uint32 corpID, int8 entryTypeID, uint
     oac.balance = balance;
     oac.ownerid = corpID;
     sEntityList.CorpNotify(corpID, 126 /*WalletChange*/, "OnAccountChange", "*corpid&corpAccountKey", oac.Encode());
-    AccountDB::AddJournalEntry(corpID, entryTypeID, fromID, toID, currency, accountKey, amount, balance, description, referenceID);
 }
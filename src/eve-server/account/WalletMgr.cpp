@@ -0,0 +1,167 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-server.h"
+
+#include "Client.h"
+#include "EntityList.h"
+#include "EVEServerConfig.h"
+#include "account/AccountDB.h"
+#include "account/WalletMgr.h"
+
+WalletMgr::WalletMgr()
+{
+}
+
+int WalletMgr::Initialize()
+{
+    uint32 recovered(0);
+    m_ledger.SetSequence(AccountDB::RecoverWallets(recovered));
+    if (recovered > 0)
+        sLog.Warning("        WalletMgr", "%u wallets set from journal entries the last run didn't finish writing.", recovered);
+
+    m_flushTimer.Start(sConfig.world.walletInterval * 1000);
+    sLog.Blue("        WalletMgr", "Wallet Manager Initialized.");
+    return 1;
+}
+
+void WalletMgr::Close()
+{
+    // the db pool runs everything queued before it closes
+    Flush();
+    sLog.Warning("        WalletMgr", "Wallet Manager has been closed.  %lu wallets held.", m_ledger.size());
+    m_ledger.Clear();
+}
+
+void WalletMgr::Process()
+{
+    if ((m_ledger.JournalCount() < BATCH) and !m_flushTimer.Check())
+        return;
+    Flush();
+}
+
+void WalletMgr::Flush()
+{
+    if ((m_ledger.JournalCount() == 0) and (m_ledger.DirtyCount() == 0))
+        return;
+
+    std::vector<WalletLedger::Entry> journal;
+    std::vector<WalletLedger::Balance> balances;
+    m_ledger.TakePending(journal, balances);
+    AccountDB::SaveJournal(journal, BATCH);
+    AccountDB::SaveBalances(balances, m_ledger.GetSequence(), BATCH);
+    _log(ACCOUNT__TRACE, "WalletMgr::Flush() - %u journal entries, %u wallets.", (uint32)journal.size(), (uint32)balances.size());
+}
+
+uint16 WalletMgr::GetCharacterKey(uint8 currency)
+{
+    switch (currency) {
+        case Account::CreditType::AURUM:    return Account::KeyType::AUR;
+        case Account::CreditType::MPLEX:    return Account::KeyType::DUST_ISK;
+    }
+    return Account::KeyType::Cash;
+}
+
+bool WalletMgr::LoadOwner(uint32 ownerID)
+{
+    if (IsCharacterID(ownerID)) {
+        double isk(0), aur(0);
+        if (!AccountDB::GetCharacterBalances(ownerID, isk, aur))
+            return false;
+        m_ledger.Load(ownerID, Account::KeyType::Cash, isk);
+        m_ledger.Load(ownerID, Account::KeyType::AUR, aur);
+        return true;
+    }
+
+    double balances[7];
+    if (!AccountDB::GetCorpBalances(ownerID, balances))
+        return false;
+    for (uint16 i = 0; i < 7; ++i)
+        m_ledger.Load(ownerID, Account::KeyType::Cash + i, balances[i]);
+    return true;
+}
+
+double WalletMgr::GetBalance(uint32 ownerID, uint16 accountKey)
+{
+    double balance(0);
+    if (m_ledger.GetBalance(ownerID, accountKey, balance))
+        return balance;
+    if (AccountDB::GetBalanceColumn(ownerID, accountKey) == nullptr)
+        return 0;
+    if (LoadOwner(ownerID))
+        m_ledger.GetBalance(ownerID, accountKey, balance);
+    return balance;
+}
+
+bool WalletMgr::Apply(uint32 ownerID, uint16 accountKey, uint8 currency, double amount, double& balance,
+                      int8 entryTypeID/*SkipLog*/, uint32 fromID/*0*/, uint32 toID/*0*/,
+                      const std::string& description/*""*/, uint32 referenceID/*0*/)
+{
+    // account key 0 is usually sent by the client, it should be the main cash account
+    if (accountKey == 0)
+        accountKey = Account::KeyType::Cash;
+
+    WalletLedger::Entry entry;
+    entry.ownerID = ownerID;
+    entry.ownerFromID = fromID;
+    entry.ownerToID = toID;
+    entry.referenceID = referenceID;
+    entry.accountKey = accountKey;
+    entry.entryTypeID = entryTypeID;
+    entry.currency = currency;
+    entry.date = GetFileTimeNow();
+    entry.amount = amount;
+    entry.description = description;
+
+    const bool journal = (entryTypeID != Journal::EntryType::SkipLog);
+    if (!m_ledger.Has(ownerID, accountKey)
+    and ((AccountDB::GetBalanceColumn(ownerID, accountKey) == nullptr) or !LoadOwner(ownerID))) {
+        // no wallet to change
+        balance = 0;
+        if (journal)
+            m_ledger.Journal(entry);
+        return true;
+    }
+
+    const bool isk = (IsCharacterID(ownerID) and (accountKey == Account::KeyType::Cash));
+    if (!m_ledger.Apply(entry, journal, (isk ? MAX_ISK : std::numeric_limits<double>::max()))) {
+        m_ledger.GetBalance(ownerID, accountKey, balance);
+        return false;
+    }
+    balance = entry.balance;
+
+    if (IsCharacterID(ownerID)) {
+        Client* pClient = sEntityList.FindClientByCharID(ownerID);
+        if (pClient != nullptr) {
+            OnAccountChange ac;
+            ac.ownerid = ownerID;
+            ac.balance = balance;
+            ac.accountKey = (accountKey == Account::KeyType::AUR ? "AURUM" : "cash");
+            PyTuple* answer = ac.Encode();
+            pClient->SendNotification("OnAccountChange", "cash", &answer, false);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,96 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __ACCOUNT__WALLET_MGR_H__INCL__
+#define __ACCOUNT__WALLET_MGR_H__INCL__
+
+#include "eve-server.h"
+#include "account/WalletLedger.h"
+
+/**
+ * Holds character and player corp wallets in a WalletLedger, so paying isk
+ * doesn't read and write the balance and insert a journal row on the spot.
+ *
+ * Changes are written every walletInterval seconds (sooner once a batch of
+ * journal rows waits) on the async write connection, in this order: the
+ * journal rows, then the changed balances with the sequence number of their
+ * last entry (walletSeq), then that the whole flush is written (srvStatus).
+ * A crash loses what changed since the last flush, and if it comes part way
+ * through a flush, Initialize() sets each wallet from its journal rows that
+ * are past walletSeq, so balances and journal always agree.
+ *
+ * Journal reads (AccountDB::GetJournal) may be up to one flush behind.
+ * Main thread only.
+ */
+class WalletMgr
+: public Singleton< WalletMgr >
+{
+public:
+    WalletMgr();
+
+    int Initialize();
+    void Close();
+
+    // 1Hz tic
+    void Process();
+    // queues the writes for everything changed so far
+    void Flush();
+
+    /* @return the balance of 'ownerID's wallet for 'accountKey', 0 if it has none */
+    double GetBalance(uint32 ownerID, uint16 accountKey);
+
+    /**
+     * Moves 'amount' in or out of 'ownerID's wallet for 'accountKey' and journals it, unless entryTypeID is SkipLog.
+     * Owners without that wallet (npc corps, the system) only get the journal row.
+     * A character's isk is held to MAX_ISK, and an online character is sent OnAccountChange.
+     *
+     * @param balance - set to the balance after
+     * @return false, with nothing changed, if the wallet can't cover a withdrawal.
+     */
+    bool Apply(uint32 ownerID, uint16 accountKey, uint8 currency, double amount, double& balance,
+               int8 entryTypeID = Journal::EntryType::SkipLog, uint32 fromID = 0, uint32 toID = 0,
+               const std::string& description = "", uint32 referenceID = 0);
+
+    // the account key of a character's wallet in 'currency'.  there are no MPLEX wallets (yet)
+    static uint16 GetCharacterKey(uint8 currency);
+
+    static constexpr double MAX_ISK = 1000000000000.0;
+    // journal rows or wallets per statement
+    static const uint16 BATCH = 500;
+
+protected:
+    /* loads the wallets of 'ownerID'.  @return false if it has none */
+    bool LoadOwner(uint32 ownerID);
+
+private:
+    WalletLedger m_ledger;
+    Timer m_flushTimer;
+};
+
+//Singleton
+#define sWalletMgr \
+( WalletMgr::get() )
+
+#endif  // __ACCOUNT__WALLET_MGR_H__INCL__
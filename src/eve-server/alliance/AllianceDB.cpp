@@ -12,6 +12,7 @@
 #include "StaticDataMgr.h"
 #include "character/Character.h"
 #include "alliance/AllianceDB.h"
+#include "search/SearchMgr.h"
 
 void AllianceDB::AddBulletin(uint32 allyID, uint32 ownerID, uint32 cCharID, const std::string &title, const std::string &body)
 {
@@ -453,6 +454,10 @@ bool AllianceDB::CreateAlliance(std::string name, std::string shortName, std::st
     // It has to go into the eveStaticOwners too
     sDatabase.RunQuery(err, " INSERT INTO eveStaticOwners (ownerID,ownerName,typeID) VALUES (%u, '%s', 16159)", allyID, aName.c_str());
 
+    // and the search names
+    sSearchMgr.SetName(searchResultAlliance, allyID, shortName);
+    sSearchMgr.SetName(searchResultAllianceName, allyID, name);
+
     return true;
 }
 
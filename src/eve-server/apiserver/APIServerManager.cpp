@@ -45,6 +45,8 @@ std::tr1::shared_ptr<std::string> APIServerManager::ProcessCall(const APICommand
 
     if ( pAPICommandCall->find( "servicehandler" )->second == "ServerStatus.xml.aspx" )
         return _ServerStatus(pAPICommandCall);
+    else if ( pAPICommandCall->find( "servicehandler" )->second == "Profile.xml.aspx" )
+        return _Profile(pAPICommandCall);
     //else if ( pAPICommandCall->find( "servicehandler" )->second == "TODO.xml.aspx" )
     //    return _TODO(pAPICommandCall);
     else
@@ -73,3 +75,49 @@ std::tr1::shared_ptr<std::string> APIServerManager::_ServerStatus(const APIComma
 
     return _GetXMLDocumentString();
 }
+
+std::tr1::shared_ptr<std::string> APIServerManager::_Profile(const APICommandCall * pAPICommandCall)
+{
+    // times in us, slowest p99 first; empty unless the server runs with profiling
+    std::vector<ProfileStats> stats;
+    if (sConfig.debug.UseProfiling)
+        sProfiler.GetStats( stats );
+
+    char buf[32];
+    auto us = [&buf]( double value ) -> std::string { snprintf( buf, sizeof( buf ), "%.1f", value ); return buf; };
+
+    std::vector<std::string> rowset;
+    _BuildXMLHeader();
+    {
+        _BuildXMLTag( "result" );
+        {
+            rowset.push_back("name");
+            rowset.push_back("count");
+            rowset.push_back("p50");
+            rowset.push_back("p90");
+            rowset.push_back("p99");
+            rowset.push_back("max");
+            rowset.push_back("avg");
+            _BuildXMLRowSet( "calls", "name", &rowset );
+            {
+                for (auto cur : stats)
+                {
+                    rowset.clear();
+                    rowset.push_back(cur.name);
+                    rowset.push_back(std::to_string(cur.count));
+                    rowset.push_back(us(cur.p50));
+                    rowset.push_back(us(cur.p90));
+                    rowset.push_back(us(cur.p99));
+                    rowset.push_back(us(cur.max));
+                    rowset.push_back(us(cur.avg));
+                    _BuildXMLRow( &rowset );
+                }
+            }
+            _CloseXMLRowSet();  // close rowset "calls"
+        }
+        _CloseXMLTag(); // close tag "result"
+    }
+    _CloseXMLHeader( EVEAPI::CacheStyles::Modified );
+
+    return _GetXMLDocumentString();
+}
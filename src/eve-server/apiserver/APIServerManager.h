@@ -51,6 +51,8 @@ public:
 
 protected:
     std::tr1::shared_ptr<std::string> _ServerStatus(const APICommandCall * pAPICommandCall);
+    /* per-key call times of the Profiler: count, p50, p90, p99, max and avg */
+    std::tr1::shared_ptr<std::string> _Profile(const APICommandCall * pAPICommandCall);
 
 };
 
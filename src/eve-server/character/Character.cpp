@@ -33,6 +33,7 @@
 #include "StaticDataMgr.h"
 #include "StatisticMgr.h"
 #include "account/AccountService.h"
+#include "account/WalletMgr.h"
 #include "character/Character.h"
 #include "effects/EffectsProcessor.h"
 #include "fleet/FleetService.h"
@@ -362,50 +363,20 @@ void Character::Delete() {
 
 float Character::balance(uint8 type)
 {
-    if (type == Account::CreditType::ISK) {
-        return m_charData.balance;
-    } else if (type == Account::CreditType::AURUM) {
-        return m_charData.aurBalance;
-    } else {
-        _log(ACCOUNT__ERROR, "Character::balance() - invalid type %u", type);
-    }
-    return 0.0f;
+    return sWalletMgr.GetBalance(m_itemID, WalletMgr::GetCharacterKey(type));
 }
 
 bool Character::AlterBalance(float amount, uint8 type) {
     if (amount == 0)
         return true;
 
-    // amount can be negative.  check for funds to remove, if applicable
-    if ((balance(type) + amount) < 0) {
-        std::map<std::string, PyRep *> args;
-        args["amount"] = new PyFloat(-amount);
-        args["balance"] = new PyFloat(balance(type));
+    // amount can be negative.  the wallet refuses to go below zero.  isk is capped at one trillion
+    double balance(0);
+    if (!sWalletMgr.Apply(m_itemID, WalletMgr::GetCharacterKey(type), type, amount, balance)) {
         throw UserError ("NotEnoughMoney")
                 .AddISK ("amount", -amount)
-                .AddISK ("balance", balance (type));
-    }
-
-    //adjust balance and send notification of change
-    OnAccountChange ac;
-    ac.ownerid = m_itemID;
-    if (type == Account::CreditType::ISK) {
-        m_charData.balance += amount;
-        // cap isk balance at one trillion
-        if (m_charData.balance > 1000000000000)
-            m_charData.balance = 1000000000000;
-        ac.balance = m_charData.balance;
-        ac.accountKey = "cash";
-    } else if (type == Account::CreditType::AURUM) {
-        m_charData.aurBalance += amount;
-        ac.balance = m_charData.aurBalance;
-        ac.accountKey = "AURUM";
+                .AddISK ("balance", balance);
     }
-
-    PyTuple *answer = ac.Encode();
-    m_pClient->SendNotification("OnAccountChange", "cash", &answer, false);
-
-    SaveCharacter();
     return true;
 }
 
@@ -514,7 +485,7 @@ void Character::ProcessEffects(ShipItem* pShip)
             fxData data = fxData();
             data.action = FX::Action::Invalid;
             data.srcRef = curSkill;
-            sFxProc.ParseExpression(this, sFxDataMgr.GetExpression(curEffect.preExpression), data);
+            sFxProc.ParseExpression(this, curEffect.preExpression, data);
         }
     }
     // apply processed char effects
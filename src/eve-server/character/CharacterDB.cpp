@@ -29,6 +29,8 @@
 #include "EVEServerConfig.h"
 #include "character/Character.h"
 #include "character/CharacterDB.h"
+#include "market/MarketMgr.h"
+#include "search/SearchMgr.h"
 
 uint32 CharacterDB::NewCharacter(const CharacterData& data, const CorpData& corpData) {
     DBerror err;
@@ -59,6 +61,7 @@ uint32 CharacterDB::NewCharacter(const CharacterData& data, const CorpData& corp
     }
 
     AddEmployment(charID, corpData.corporationID);
+    sSearchMgr.SetName(searchResultCharacter, charID, data.name);
 
     return charID;
 }
@@ -76,8 +79,6 @@ bool CharacterDB::SaveCharacter(uint32 characterID, const CharacterData &data) {
         "  title = '%s',"
         "  description = '%s',"
         "  bounty = %f,"
-        "  balance = %f,"
-        "  aurBalance = %f,"
         "  securityRating = %f,"
         "  logonMinutes = %u,"
         "  skillPoints = %u,"
@@ -87,7 +88,7 @@ bool CharacterDB::SaveCharacter(uint32 characterID, const CharacterData &data) {
         "  constellationID = %u,"
         "  regionID = %u"
         " WHERE characterID = %u",
-            titleEsc.c_str(), descriptionEsc.c_str(), data.bounty, data.balance, data.aurBalance, data.securityRating, data.logonMinutes,
+            titleEsc.c_str(), descriptionEsc.c_str(), data.bounty, data.securityRating, data.logonMinutes,
             data.skillPoints, data.locationID, data.stationID, data.solarSystemID, data.constellationID, data.regionID, characterID))
     {
         codelog(DATABASE__ERROR, "Failed to save character %u: %s.", characterID, err.c_str());
@@ -144,11 +145,13 @@ void CharacterDB::DeleteCharacter(uint32 characterID) {
     sDatabase.RunQuery(err, "DELETE FROM bookmarkFolders WHERE ownerID = %u",  characterID);
     //sDatabase.RunQuery(err, "DELETE FROM bookmarkVouchers WHERE ownerID = %u",  characterID);
     sDatabase.RunQuery(err, "DELETE FROM mktOrders WHERE ownerID = %u", characterID);
+    sMktMgr.RemoveOwnerOrders(characterID);
     sDatabase.RunQuery(err, "DELETE FROM mktTransactions WHERE clientID = %u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM repStandings WHERE (fromID = %u OR toID = %u)", characterID, characterID);
     sDatabase.RunQuery(err, "DELETE FROM repStandingChanges WHERE (fromID = %u OR toID = %u)", characterID, characterID);
     sDatabase.RunQuery(err, "DELETE FROM chrCertificates WHERE characterID=%u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM chrCharacters WHERE characterID=%u", characterID);
+    sSearchMgr.RemoveName(searchResultCharacter, characterID);
     sDatabase.RunQuery(err, "DELETE FROM chrEmployment WHERE characterID=%u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM jnlCharacters WHERE ownerID=%u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM crpShares WHERE shareholderID=%u", characterID);
@@ -28,6 +28,7 @@
 
 
 #include "chat/LookupService.h"
+#include "search/SearchMgr.h"
 
 LookupService::LookupService() :
     Service("lookupSvc", eAccessLevel_Character)
@@ -45,41 +46,177 @@ LookupService::LookupService() :
     this->Add("LookupNoneNPCAccountOwners", &LookupService::LookupNoneNPCAccountOwners);
 }
 
+namespace {
+
+// lookups had no limit in the db; keep one that a single letter can't blow past
+const size_t sLookupLimit = searchMaxResults;
+
+void FindNames(const std::string& match, bool exact, uint32 kindMask, std::vector<const NameIndex::Entry*>& into)
+{
+    if (exact)
+        sSearchMgr.FindExact(match, kindMask, into);
+    else
+        sSearchMgr.Find(match, kindMask, sLookupLimit, into);
+}
+
+PyRep* CharacterRowset(const std::string& match, bool exact)
+{
+    // the full list isn't a name search
+    if (match == "__ALL__")
+        return ServiceDB::LookupChars(match.c_str(), exact);
+
+    std::vector<const NameIndex::Entry*> found;
+    FindNames(match, exact, (1 << searchResultAgent) | (1 << searchResultCharacter), found);
+
+    util_Rowset rs;
+        rs.lines = new PyList();
+        rs.header.push_back( "ownerID" );
+    for (auto cur : found) {
+        PyList* fieldData = new PyList();
+            fieldData->AddItemInt( cur->id );
+        rs.lines->AddItem( fieldData );
+    }
+    return rs.Encode();
+}
+
+PyRep* OwnerRowset(const std::string& match, bool exact)
+{
+    std::vector<const NameIndex::Entry*> found;
+    FindNames(match, exact, (1 << searchResultCharacter) | (1 << searchResultCorporation) | (1 << searchResultCorporationTicker)
+                          | (1 << searchResultAlliance) | (1 << searchResultAllianceName), found);
+
+    // groupID is 1 for character, 2 for corporation, 32 for alliance.  a ticker finds its corporation by name
+    util_Rowset rs;
+        rs.lines = new PyList();
+        rs.header.push_back( "ownerID" );
+        rs.header.push_back( "ownerName" );
+        rs.header.push_back( "groupID" );
+    std::set<uint32> seen;
+    for (auto cur : found) {
+        if (!seen.insert(cur->id).second)
+            continue;
+        const NameIndex::Entry* pName = cur;
+        if (cur->kind == searchResultCorporationTicker)
+            pName = sSearchMgr.GetName(searchResultCorporation, cur->id);
+        if (pName == nullptr)
+            continue;
+
+        PyList* fieldData = new PyList();
+            fieldData->AddItemInt( cur->id );
+            fieldData->AddItemString( pName->name.c_str() );
+        switch (cur->kind) {
+            case searchResultCharacter:
+                fieldData->AddItemInt( 1 );
+                break;
+            case searchResultCorporation:
+            case searchResultCorporationTicker:
+                fieldData->AddItemInt( 2 );
+                break;
+            default:
+                fieldData->AddItemInt( 32 );
+                break;
+        }
+        rs.lines->AddItem( fieldData );
+    }
+    return rs.Encode();
+}
+
+}
+
 PyResult LookupService::LookupEvePlayerCharacters(PyCallArgs& call, PyWString* searchString, PyInt* exact) {
-    return ServiceDB::LookupChars(searchString->content().c_str(), exact->value() ? true : false);
+    return CharacterRowset(searchString->content(), exact->value() ? true : false);
 }
 
 PyResult LookupService::LookupCharacters(PyCallArgs &call, PyWString* searchString, PyInt* exact) {
-    return ServiceDB::LookupChars(searchString->content().c_str(), exact->value() ? true : false);
+    return CharacterRowset(searchString->content(), exact->value() ? true : false);
 }
 
 // this may actually be a call to search for player corps by name.
 PyResult LookupService::LookupPCOwners(PyCallArgs &call, PyWString* searchString, PyInt* exact) {
-    return ServiceDB::LookupChars(searchString->content().c_str(), exact->value() ? true : false);
+    return CharacterRowset(searchString->content(), exact->value() ? true : false);
 }
 //LookupOwners
 PyResult LookupService::LookupOwners(PyCallArgs &call, PyWString* searchString, PyInt* exact) {
-    return ServiceDB::LookupOwners(searchString->content().c_str(), exact->value() ? true : false);
+    return OwnerRowset(searchString->content(), exact->value() ? true : false);
 }
 
 PyResult LookupService::LookupNoneNPCAccountOwners(PyCallArgs &call, PyWString* searchString, PyInt* exact) {
-    return ServiceDB::LookupOwners(searchString->content().c_str(), exact->value() ? true : false);
+    return OwnerRowset(searchString->content(), exact->value() ? true : false);
 }
 
 PyResult LookupService::LookupPlayerCharacters(PyCallArgs &call, PyWString* searchString) {
-    return ServiceDB::LookupChars(searchString->content().c_str(), false);
+    return CharacterRowset(searchString->content(), false);
 }
 PyResult LookupService::LookupCorporations(PyCallArgs &call, PyWString* searchString) {
-    return ServiceDB::LookupCorporations(searchString->content().c_str());
+    std::vector<const NameIndex::Entry*> found;
+    sSearchMgr.Find(searchString->content(), 1 << searchResultCorporation, sLookupLimit, found);
+
+    util_Rowset rs;
+        rs.lines = new PyList();
+        rs.header.push_back( "corporationID" );
+        rs.header.push_back( "corporationName" );
+        rs.header.push_back( "corporationType" );
+    for (auto cur : found) {
+        PyList* fieldData = new PyList();
+            fieldData->AddItemInt( cur->id );
+            fieldData->AddItemString( cur->name.c_str() );
+            fieldData->AddItemInt( cur->data );
+        rs.lines->AddItem( fieldData );
+    }
+    return rs.Encode();
 }
 PyResult LookupService::LookupFactions(PyCallArgs &call, PyWString* searchString) {
-    return ServiceDB::LookupFactions(searchString->content().c_str());
+    std::vector<const NameIndex::Entry*> found;
+    sSearchMgr.Find(searchString->content(), 1 << searchResultFaction, sLookupLimit, found);
+
+    util_Rowset rs;
+        rs.lines = new PyList();
+        rs.header.push_back( "factionID" );
+        rs.header.push_back( "factionName" );
+    for (auto cur : found) {
+        PyList* fieldData = new PyList();
+            fieldData->AddItemInt( cur->id );
+            fieldData->AddItemString( cur->name.c_str() );
+        rs.lines->AddItem( fieldData );
+    }
+    return rs.Encode();
 }
 PyResult LookupService::LookupCorporationTickers(PyCallArgs &call, PyWString* searchString) {
-    return ServiceDB::LookupCorporationTickers(searchString->content().c_str());
+    std::vector<const NameIndex::Entry*> found;
+    sSearchMgr.Find(searchString->content(), 1 << searchResultCorporationTicker, sLookupLimit, found);
+
+    util_Rowset rs;
+        rs.lines = new PyList();
+        rs.header.push_back( "corporationID" );
+        rs.header.push_back( "corporationName" );
+        rs.header.push_back( "tickerName" );
+    for (auto cur : found) {
+        const NameIndex::Entry* pCorp = sSearchMgr.GetName(searchResultCorporation, cur->id);
+        PyList* fieldData = new PyList();
+            fieldData->AddItemInt( cur->id );
+            fieldData->AddItemString( pCorp == nullptr ? "" : pCorp->name.c_str() );
+            fieldData->AddItemString( cur->name.c_str() );
+        rs.lines->AddItem( fieldData );
+    }
+    return rs.Encode();
 }
 PyResult LookupService::LookupStations(PyCallArgs &call, PyWString* searchString) {
-    return ServiceDB::LookupStations(searchString->content().c_str());
+    std::vector<const NameIndex::Entry*> found;
+    sSearchMgr.Find(searchString->content(), 1 << searchResultStation, sLookupLimit, found);
+
+    util_Rowset rs;
+        rs.lines = new PyList();
+        rs.header.push_back( "stationID" );
+        rs.header.push_back( "stationName" );
+        rs.header.push_back( "stationTypeID" );
+    for (auto cur : found) {
+        PyList* fieldData = new PyList();
+            fieldData->AddItemInt( cur->id );
+            fieldData->AddItemString( cur->name.c_str() );
+            fieldData->AddItemInt( cur->data );
+        rs.lines->AddItem( fieldData );
+    }
+    return rs.Encode();
 }
 
 PyResult LookupService::LookupKnownLocationsByGroup(PyCallArgs &call, PyWString* searchString, PyInt* exact) {
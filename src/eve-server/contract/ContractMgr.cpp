@@ -0,0 +1,120 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-server.h"
+
+#include "StaticDataMgr.h"
+#include "contract/ContractMgr.h"
+#include "contract/ContractUtils.h"
+
+ContractMgr::ContractMgr()
+{
+}
+
+int ContractMgr::Initialize()
+{
+    LoadContracts();
+    sLog.Blue("      ContractMgr", "Contract Manager Initialized.");
+    return 1;
+}
+
+void ContractMgr::Close()
+{
+    m_index.Clear();
+    sLog.Warning("      ContractMgr", "Contract Manager has been closed." );
+}
+
+void ContractMgr::LoadContracts()
+{
+    double start = GetTimeMSeconds();
+    m_index.Clear();
+
+    // item types first, so each contract goes in whole
+    std::unordered_map<uint32, std::vector<uint32>> itemTypes;
+    DBQueryResult res;
+    DBResultRow row;
+    ContractUtils::GetOutstandingContractItems(res);
+    while (res.GetRow(row))
+        itemTypes[row.GetUInt(0)].push_back(row.GetUInt(1));
+
+    ContractUtils::GetOutstandingContracts(res);
+    while (res.GetRow(row)) {
+        Contract::IndexData data = Contract::IndexData();
+        data.contractID     = row.GetUInt(0);
+        data.type           = row.GetUInt(1);
+        data.isPrivate      = row.GetBool(2);
+        data.forCorp        = row.GetBool(3);
+        data.issuerID       = row.GetUInt(4);
+        data.issuerCorpID   = row.GetUInt(5);
+        data.assigneeID     = row.IsNull(6) ? 0 : row.GetUInt(6);
+        data.startSystemID  = row.GetUInt(7);
+        data.startRegionID  = row.GetUInt(8);
+        data.endSystemID    = row.IsNull(9) ? 0 : row.GetUInt(9);
+        data.endRegionID    = row.IsNull(10) ? 0 : row.GetUInt(10);
+        data.price          = row.GetDouble(11);
+        data.reward         = row.GetDouble(12);
+
+        std::unordered_map<uint32, std::vector<uint32>>::const_iterator itr = itemTypes.find(data.contractID);
+        if (itr != itemTypes.end())
+            for (uint32 typeID : itr->second)
+                AddItemType(data, typeID);
+
+        m_index.Add(data);
+    }
+
+    sLog.Cyan("      ContractMgr", "%lu outstanding contracts loaded in %.3fms.", m_index.size(), (GetTimeMSeconds() - start));
+}
+
+void ContractMgr::AddItemType(Contract::IndexData& data, uint32 typeID)
+{
+    data.typeIDs.push_back(typeID);
+
+    const Inv::TypeData* pType = sDataMgr.FindType(typeID);
+    if (pType == nullptr)
+        return;
+    data.groupIDs.push_back(pType->groupID);
+
+    const Inv::GrpData* pGroup = sDataMgr.FindGroup(pType->groupID);
+    if (pGroup != nullptr)
+        data.categoryIDs.push_back(pGroup->catID);
+}
+
+void ContractMgr::AddContract(const Contract::IndexData& data)
+{
+    if (!m_index.Add(data))
+        _log(SERVICE__ERROR, "ContractMgr::AddContract() - contract %u is already indexed.", data.contractID);
+}
+
+void ContractMgr::RemoveContract(uint32 contractID)
+{
+    m_index.Remove(contractID);
+}
+
+size_t ContractMgr::Search(const Contract::SearchFilter& filter, size_t limit, std::vector<int>& into)
+{
+    const size_t found = m_index.Search(filter, limit, m_found);
+    into.assign(m_found.begin(), m_found.end());
+    return found;
+}
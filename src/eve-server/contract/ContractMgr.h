@@ -0,0 +1,68 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __CONTRACT__CONTRACT_MGR_H__INCL__
+#define __CONTRACT__CONTRACT_MGR_H__INCL__
+
+#include "eve-server.h"
+#include "contract/ContractIndex.h"
+
+/**
+ * Keeps the outstanding contracts in a ContractIndex, so contract searches don't
+ * go to the db.  ctrContracts stays the record; ContractProxy tells this when a
+ * contract is created, accepted, completed or deleted.
+ */
+class ContractMgr
+: public Singleton< ContractMgr >
+{
+public:
+    ContractMgr();
+
+    int Initialize();
+    void Close();
+
+    // adds 'typeID' and its group and category to the items 'data' offers
+    static void AddItemType(Contract::IndexData& data, uint32 typeID);
+
+    void AddContract(const Contract::IndexData& data);
+    // once it's no longer outstanding
+    void RemoveContract(uint32 contractID);
+
+    // contractIDs, newest first, at most 'limit'.  returns the number found in all
+    size_t Search(const Contract::SearchFilter& filter, size_t limit, std::vector<int>& into);
+
+protected:
+    void LoadContracts();
+
+private:
+    ContractIndex m_index;
+    std::vector<uint32> m_found;
+};
+
+//Singleton
+#define sContractMgr \
+( ContractMgr::get() )
+
+#endif  // __CONTRACT__CONTRACT_MGR_H__INCL__
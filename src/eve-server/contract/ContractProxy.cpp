@@ -30,6 +30,7 @@
 #include "eve-server.h"
 
 
+#include "contract/ContractMgr.h"
 #include "contract/ContractProxy.h"
 #include "station/Station.h"
 #include "inventory/Inventory.h"
@@ -73,130 +74,106 @@ ContractProxy::ContractProxy () :
 }
 
 PyResult ContractProxy::SearchContracts(PyCallArgs &call) {
+    // named args the client left out or sent as None don't filter anything
+    auto arg = [&call](const char* name) -> PyRep* {
+        std::map<std::string, PyRep*>::iterator itr = call.byname.find(name);
+        if ((itr == call.byname.end()) or (itr->second == nullptr) or itr->second->IsNone())
+            return nullptr;
+        return itr->second;
+    };
+
     // We will not proceed, if contractType is not specified
-    if (!call.byname.find("contractType")->second->IsNone()) {
-        int contractType = call.byname.find("contractType")->second->AsInt()->value();
+    if (arg("contractType") != nullptr) {
+        int contractType = arg("contractType")->AsInt()->value();
 
         /**
-         * We're using sort of query constructor here - if request have certain value specified, we add it as another AND block.
-         * For now, we will only filter by contract type, item type, item category, min/max price, min/max reward, location/end location, issuer and availability
+         * Outstanding contracts are kept in memory by ContractMgr, so the search itself doesn't touch the DB.
+         * We only filter by what the request has specified: contract type, item types, item group/category, min/max price,
+         * min/max reward, location/end location, issuer and availability
          */
-        std::string query = "SELECT cC.contractId FROM ctrContracts cC "
-                            "JOIN ctrItems cI on cC.contractId = cI.contractId "
-                            "JOIN entity e on cI.itemID = e.itemID "
-                            "JOIN invTypes iT on iT.typeID = e.typeID "
-                            "JOIN invGroups iG on iG.groupID = iT.groupID "
-                            "JOIN invCategories iC on iG.categoryID = iC.categoryID "
-                            "WHERE cC.contractType IN " + std::string(contractType == 10 ? "(1,2)" : "(" + std::to_string(contractType) + ")");
-                                                         // Type 10 is "All" and "Exclude WTB", for some reason. We'll assume it's "All", lol
-
-        if (!call.byname.find("itemTypes")->second->IsNone()) {
-            PyList* itemTypes = call.byname.find("itemTypes")->second->AsObjectEx()->header()->AsTuple()->GetItem(1)->AsTuple()->GetItem(0)->AsList();
-            std::string types;
-            for (auto index = 0; index < itemTypes->size(); index++) {
-                types.append(std::to_string(itemTypes->GetItem(index)->AsInt()->value()));
-                if (index != itemTypes->size() - 1) {
-                    types.append(",");
-                }
-            }
-
-            if (!types.empty()) {
-                query.append(" AND e.typeID IN (" + types + ")");
-            }
+        Contract::SearchFilter filter;
+        // Type 10 is "All" and "Exclude WTB", for some reason. We'll assume it's "All", lol
+        if (contractType == 10) {
+            filter.typeMask = (1 << 1) | (1 << 2);
+        } else {
+            filter.typeMask = ((contractType > 0) and (contractType < 32)) ? (1u << contractType) : 0;
         }
 
-        if (!call.byname.find("itemGroupID")->second->IsNone()) {
-            query.append(" AND iG.groupID = " + std::to_string(call.byname.find("itemGroupID")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("itemCategoryID")->second->IsNone()) {
-            query.append(" AND iC.categoryID = " + std::to_string(call.byname.find("itemCategoryID")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("minPrice")->second->IsNone()) {
-            query.append(" AND cC.price >= " + std::to_string(call.byname.find("minPrice")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("maxPrice")->second->IsNone()) {
-            query.append(" AND cC.price <= " + std::to_string(call.byname.find("maxPrice")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("minReward")->second->IsNone()) {
-            query.append(" AND cC.reward >= " + std::to_string(call.byname.find("minReward")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("maxReward")->second->IsNone()) {
-            query.append(" AND cC.reward <= " + std::to_string(call.byname.find("maxReward")->second->AsInt()->value()));
+        if (arg("itemTypes") != nullptr) {
+            PyList* itemTypes = arg("itemTypes")->AsObjectEx()->header()->AsTuple()->GetItem(1)->AsTuple()->GetItem(0)->AsList();
+            for (auto index = 0; index < itemTypes->size(); index++)
+                filter.typeIDs.push_back(itemTypes->GetItem(index)->AsInt()->value());
         }
-        if (!call.byname.find("availability")->second->IsNone()) {
-            int availability = call.byname.find("availability")->second->AsInt()->value();
+
+        if (arg("itemGroupID") != nullptr)
+            filter.groupID = arg("itemGroupID")->AsInt()->value();
+        if (arg("itemCategoryID") != nullptr)
+            filter.categoryID = arg("itemCategoryID")->AsInt()->value();
+        if (arg("minPrice") != nullptr)
+            filter.minPrice = arg("minPrice")->AsInt()->value();
+        if (arg("maxPrice") != nullptr)
+            filter.maxPrice = arg("maxPrice")->AsInt()->value();
+        if (arg("minReward") != nullptr)
+            filter.minReward = arg("minReward")->AsInt()->value();
+        if (arg("maxReward") != nullptr)
+            filter.maxReward = arg("maxReward")->AsInt()->value();
+        if (arg("availability") != nullptr) {
+            int availability = arg("availability")->AsInt()->value();
             if (availability == 0) {
                 // Public contracts
-                query.append(" AND cC.isPrivate = 0");
+                filter.availability = 0;
             } else if (availability == 1) {
                 // Private contracts, assigned to character
-                query.append(" AND cC.isPrivate = 1 AND cC.assigneeId = " + std::to_string(call.client->GetCharacterID()));
+                filter.availability = 1;
+                filter.assigneeID = call.client->GetCharacterID();
             } else if(availability == 2) {
                 // Private contracts, assigned to corp
-                query.append(" AND cC.isPrivate = 1 AND cC.assigneeId = " + std::to_string(call.client->GetCorporationID()));
+                filter.availability = 1;
+                filter.assigneeID = call.client->GetCorporationID();
             }
         }
-        // According to what i had during testing, locationID can only be system, constellation or region. Given that we only store system and region ID, we use OR clause for these
-        if (!call.byname.find("locationID")->second->IsNone()) {
-            int locationId = call.byname.find("locationID")->second->AsInt()->value();
+        // According to what i had during testing, locationID can only be system, constellation or region. Given that we only store system and region ID, we filter by these
+        if (arg("locationID") != nullptr) {
+            int locationId = arg("locationID")->AsInt()->value();
             if (IsSolarSystemID(locationId)) {
                 // Solar system range
-                query.append(" AND cC.startSolarSystemID = " + std::to_string(locationId));
+                filter.startSystemID = locationId;
             } else if (IsRegionID(locationId)) {
                 // Region range
-                query.append(" AND cC.startRegionID = " + std::to_string(locationId));
+                filter.startRegionID = locationId;
             }
         }
         // Same applies to endLocationID - it uses the same search::QuickQuery() call to get it
-        if (!call.byname.find("endLocationID")->second->IsNone()) {
-            int locationId = call.byname.find("endLocationID")->second->AsInt()->value();
+        if (arg("endLocationID") != nullptr) {
+            int locationId = arg("endLocationID")->AsInt()->value();
             if (IsSolarSystemID(locationId)) {
                 // Solar system range
-                query.append(" AND cC.endSolarSystemID = " + std::to_string(locationId));
+                filter.endSystemID = locationId;
             } else if (IsRegionID(locationId)) {
                 // Region range
-                query.append(" AND cC.endRegionID = " + std::to_string(locationId));
+                filter.endRegionID = locationId;
             }
         }
         // Once again, issuer can be either a character or a corporation. We use separate filters depending on value
-        if (!call.byname.find("issuerID")->second->IsNone()) {
-            int issuerId = call.byname.find("issuerID")->second->AsInt()->value();
-            if (IsCorp(issuerId)) {
-                // Corporation case
-                query.append(" AND cC.issuerCorpID = " + std::to_string(issuerId) + " AND cC.forCorp = true");
-            } else {
-                query.append(" AND cC.issuerID = " + std::to_string(issuerId) + " AND cC.forCorp = false");
-            }
+        if (arg("issuerID") != nullptr) {
+            filter.issuerID = arg("issuerID")->AsInt()->value();
+            filter.issuerIsCorp = IsCorp(filter.issuerID);
         }
-        query.append(" AND cC.status = 0");
+
         /**
-         * Once query is constructed, we execute it and collect contractID's. Since we can have duplicate values, we first
-         * collect it to std::vector, and then we pass it to GetContractEntries function
+         * The index gives us the newest contracts first, no duplicates and no more than the client will show;
+         * only their full rows come from the DB, by primary key.
          */
-
-        DBQueryResult contractRes;
-        if (!sDatabase.RunQuery(contractRes, query.c_str()))
-        {
-            codelog(DATABASE__ERROR, "Error in query: %s", contractRes.error.c_str());
-            return nullptr;
-        }
+        const size_t maxResults = 1000;
         std::vector<int> contractIDs;
-        DBResultRow contractRow;
-        while (contractRes.GetRow(contractRow)) {
-            int contractId = contractRow.GetInt(0);
-
-            // To make sure we don't add duplicates, we check whether we already have said contractID in vector already.
-            if (std::find(contractIDs.begin(), contractIDs.end(), contractId) == contractIDs.end()) {
-                contractIDs.push_back(contractId);
-            }
-        }
+        const size_t found = sContractMgr.Search(filter, maxResults, contractIDs);
 
         PyDict* response = new PyDict;
-        PyList* contracts = ContractUtils::GetContractEntries(contractIDs);
+        PyList* contracts = (contractIDs.empty() ? nullptr : ContractUtils::GetContractEntries(contractIDs));
         response->SetItemString("contracts", contracts ? contracts : new PyList);
-        response->SetItemString("numFound", contracts ? new PyInt(contracts->size()) : new PyInt(0));
+        response->SetItemString("numFound", new PyInt(contracts ? found : 0));
         response->SetItemString("searchTime", new PyInt(153));  // Since search time is of no relevance to the client, we simply hard-code it
-        response->SetItemString("maxResults", new PyInt(1000)); // Same here - we do not limit the list of contracts queried, so we leave this value hard-coded
+        response->SetItemString("maxResults", new PyInt(maxResults));
 
         return new PyObject("util.KeyVal", response);
     } else {
@@ -319,6 +296,7 @@ PyResult ContractProxy::CreateContract(PyCallArgs &call,
      * To save resources and reduce amount of DB hits, we compose the query by adding ID's first, then we execute it separately.
      */
     std::string itemsToInsert;
+    std::vector<uint32> offeredTypes;                   // for the search index
     float totalVolume = 0.00;
     if (call.byname.find("itemList")->second->IsList()) {
         PyList *tradedItems = call.byname.find("itemList")->second->AsList();
@@ -385,6 +363,7 @@ PyResult ContractProxy::CreateContract(PyCallArgs &call,
                         std::to_string(runs) + ", " +
                         std::to_string(damage) + ", " +
                         std::to_string(flag)+ "),");
+                     offeredTypes.push_back(row.GetUInt(2));
 
                      // We only calculate volume for courier-type contracts - the other types don't use this value.
                      if (contractType->value() == 3) {
@@ -439,6 +418,25 @@ PyResult ContractProxy::CreateContract(PyCallArgs &call,
         return nullptr;
     }
 
+    // The contract is outstanding now, so it goes in the search index
+    Contract::IndexData data = Contract::IndexData();
+    data.contractID = contractId;
+    data.type = contractType->value();
+    data.isPrivate = isPrivate->value() != 0;
+    data.forCorp = forCorp;
+    data.issuerID = call.client->GetCharacterID();
+    data.issuerCorpID = call.client->GetCorporationID();
+    data.assigneeID = assigneeID.has_value() ? assigneeID.value()->value() : 0;
+    data.startSystemID = startSystemId;
+    data.startRegionID = startRegionId;
+    data.endSystemID = endSystemId;
+    data.endRegionID = endRegionId;
+    data.price = price->value();
+    data.reward = reward->value();
+    for (auto typeID : offeredTypes)
+        ContractMgr::AddItemType(data, typeID);
+    sContractMgr.AddContract(data);
+
     return new PyInt((int) contractId);
 }
 
@@ -468,6 +466,7 @@ PyResult ContractProxy::DeleteContract(PyCallArgs &call, PyInt* contractID) {
     {
         codelog(DATABASE__ERROR, "Failed to update contract volume: %s", err.c_str());
     }
+    sContractMgr.RemoveContract(contractID->value());
 
     return new PyBool(true);
 }
@@ -577,6 +576,7 @@ PyResult ContractProxy::AcceptContract(PyCallArgs &call, PyInt* contractID) {
                     {
                         codelog(DATABASE__ERROR, "Failed to update contract : %s", err.c_str());
                     }
+                    sContractMgr.RemoveContract(contractID->value());
                 } else {
                     if (!iskRequirementMet) {
                         call.client->SendNotifyMsg("You have insufficient funds");
@@ -648,6 +648,7 @@ PyResult ContractProxy::AcceptContract(PyCallArgs &call, PyInt* contractID) {
                 {
                     codelog(DATABASE__ERROR, "Failed to update contract : %s", err.c_str());
                 }
+                sContractMgr.RemoveContract(contractID->value());
                 break;
             }
             default:
@@ -750,6 +751,7 @@ PyResult ContractProxy::CompleteContract(PyCallArgs &call, PyInt* contractID, Py
                 {
                     codelog(DATABASE__ERROR, "Failed to update contract : %s", err.c_str());
                 }
+                sContractMgr.RemoveContract(contractID->value());
             } else {
                 call.client->SendNotifyMsg("Not all required items are located in the container");
                 return new PyBool(false);
@@ -772,6 +774,7 @@ PyResult ContractProxy::CompleteContract(PyCallArgs &call, PyInt* contractID, Py
             {
                 codelog(DATABASE__ERROR, "Failed to update contract : %s", err.c_str());
             }
+            sContractMgr.RemoveContract(contractID->value());
             break;
         }
         default:
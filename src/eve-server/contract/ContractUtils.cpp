@@ -388,4 +388,32 @@ void ContractUtils::GetContractItemIDsAndQuantities(int contractId, std::map<int
     }
 }
 
+/**
+ * Queries every outstanding contract, with the columns ContractMgr indexes for searches.
+ * @param res - Target result, oldest contract first
+ */
+void ContractUtils::GetOutstandingContracts(DBQueryResult& res) {
+    if (!sDatabase.RunQuery(res,
+        "SELECT contractId, contractType, isPrivate, forCorp, issuerID, issuerCorpID, assigneeID, "
+        "startSolarSystemID, startRegionID, endSolarSystemID, endRegionID, price, reward "
+        "FROM ctrContracts WHERE status = 0 ORDER BY contractId"))
+    {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+    }
+}
+
+/**
+ * Queries the types of items offered in outstanding contracts, as contractID <-> typeID
+ * @param res - Target result
+ */
+void ContractUtils::GetOutstandingContractItems(DBQueryResult& res) {
+    if (!sDatabase.RunQuery(res,
+        "SELECT cI.contractId, cI.itemTypeID "
+        "FROM ctrItems cI "
+        "JOIN ctrContracts cC ON cC.contractId = cI.contractId "
+        "WHERE cC.status = 0 AND cI.inCrate = true"))
+    {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+    }
+}
 
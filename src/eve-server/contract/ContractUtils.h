@@ -36,6 +36,8 @@ public:
     static void GetContractItemIDs(int contractId, std::vector<int>* into);
     static void GetRequestedItems(int contractId, std::map<int, int>* into);
     static void GetContractItemIDsAndQuantities(int contractId, std::map<int, int>* into);
+    static void GetOutstandingContracts(DBQueryResult& res);
+    static void GetOutstandingContractItems(DBQueryResult& res);
 private:
     static void FillItemData(DBResultRow* itemRow, PyPackedRow* targetRow);
     static void FillBidData(DBResultRow* bidRow, PyPackedRow* targetRow);
@@ -11,6 +11,7 @@
 #include "CorpData.h"
 #include "StaticDataMgr.h"
 #include "account/AccountService.h"
+#include "account/WalletMgr.h"
 #include "cache/ObjCacheService.h"
 #include "chat/LSCService.h"
 #include "corporation/CorpRegistryService.h"
@@ -770,7 +771,7 @@ PyResult CorpRegistryBound::UpdateLogo(PyCallArgs &call,
 
     // Check if we have enough money
     double logo_change = 100;
-    if (AccountDB::GetCorpBalance(notif.key, Account::KeyType::Cash) < logo_change) {
+    if (sWalletMgr.GetBalance(notif.key, Account::KeyType::Cash) < logo_change) {
         _log( SERVICE__ERROR, "%s: Cannot afford corporation logo change costs", call.client->GetName());
         call.client->SendErrorMsg("Your corporation doesn't have enough money (%u ISK) to change it's logo.", logo_change);
         return nullptr;
@@ -45,6 +45,7 @@
 
 #include "StaticDataMgr.h"
 #include "account/AccountService.h"
+#include "account/WalletMgr.h"
 #include "chat/LSCService.h"
 #include "corporation/CorpStationMgr.h"
 #include "station/Station.h"
@@ -266,7 +267,7 @@ PyResult CorpStationMgrIMBound::RentOffice(PyCallArgs &call, PyInt* amount) {
     AccountService::TransferFunds(pClient->GetCorporationID(), pStationItem->GetOwnerID(), amount->value(), reason.c_str(), Journal::EntryType::OfficeRentalFee);
 
 /** @note  why is this disabled?
-    int64 balance = AccountDB::GetCorpBalance(pClient->GetCorporationID(), Account::KeyType::Cash);
+    int64 balance = sWalletMgr.GetBalance(pClient->GetCorporationID(), Account::KeyType::Cash);
     if (balance < arg.arg) {
         std::map<std::string, PyRep *> args;
         args["amount"] = new PyFloat(arg.arg);
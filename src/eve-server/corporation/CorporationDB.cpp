@@ -29,6 +29,7 @@
 #include "StaticDataMgr.h"
 #include "character/Character.h"
 #include "corporation/CorporationDB.h"
+#include "search/SearchMgr.h"
 
 // this shall be removed when i remove MulticastTarget
 #include "EntityList.h"
@@ -574,6 +575,10 @@ bool CorporationDB::AddCorporation(Call_AddCorporation & corpInfo, Client* pClie
     // It has to go into the eveStaticOwners too
     sDatabase.RunQuery(err, " INSERT INTO eveStaticOwners (ownerID,ownerName,typeID) VALUES (%u, '%s', 2)", corpID, cName.c_str());
 
+    // and the search names
+    sSearchMgr.SetName(searchResultCorporation, corpID, corpInfo.corpName, 2);
+    sSearchMgr.SetName(searchResultCorporationTicker, corpID, corpInfo.corpTicker);
+
     return true;
 }
 
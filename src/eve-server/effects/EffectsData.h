@@ -66,6 +66,23 @@ struct TypeEffects {
     uint16 effectID;
 };
 
+// one AddModifier/RemoveModifier call of an expression, decoded once when effects are loaded
+struct FxModifier {
+    bool remove;        // RemoveModifier instead of AddModifier
+    bool typeFromSrc;   // typeID is that of the source item (GETTYPE), known only when run
+    int8 math;
+    int8 fxSrc;
+    int8 targLoc;
+    uint8 action;
+    uint16 targAttr;
+    uint16 srcAttr;
+    uint16 grpID;
+    uint16 typeID;
+};
+
+// the modifier calls of an expression, in the order the expression tree makes them
+typedef std::vector<FxModifier> fxProgram;
+
 typedef std::map<uint16, Effect> effectMapType;
 
 // these tables are used to decode fields in Effects table
@@ -21,6 +21,7 @@ FxDataMgr::FxDataMgr()
     m_expMap.clear();
     m_effectMap.clear();
     m_typeFxMap.clear();
+    m_programs.clear();
 }
 
 int FxDataMgr::Initialize()
@@ -136,6 +137,10 @@ void FxDataMgr::Populate()
     //cleanup
     SafeDelete(res);
 
+    start = GetTimeMSeconds();
+    CompilePrograms();
+    sLog.Cyan("        FxDataMgr", "%lu Expression Programs compiled in %.3fms.", m_programs.size(), (GetTimeMSeconds() - start));
+
     m_loaded = true;
     sLog.Cyan("        FxDataMgr", "Effects Data loaded in %.3fms.", (GetTimeMSeconds() - begin));
 }
@@ -163,6 +168,28 @@ Expression FxDataMgr::GetExpression(uint16 eID)
     return m_expMap.at(0);
 }
 
+const fxProgram& FxDataMgr::GetProgram(uint16 eID, bool skill)
+{
+    static const fxProgram empty;
+    std::unordered_map<uint32, fxProgram>::const_iterator itr = m_programs.find((eID << 1) | (skill ? 1 : 0));
+    if (itr != m_programs.end())
+        return itr->second;
+    return empty;
+}
+
+void FxDataMgr::CompilePrograms()
+{
+    // only effect roots are run; sub-expressions are compiled into them
+    for (auto cur : m_effectMap) {
+        for (uint16 expID : {cur.second.preExpression, cur.second.postExpression}) {
+            if ((expID == 0) or (m_programs.find(expID << 1) != m_programs.end()))
+                continue;
+            sFxProc.CompileExpression(expID, false, m_programs[expID << 1]);
+            sFxProc.CompileExpression(expID, true, m_programs[(expID << 1) | 1]);
+        }
+    }
+}
+
 Operand FxDataMgr::GetOperand(uint16 oID)
 {
     std::map<uint16, Operand>::const_iterator itr = m_opMap.find(oID);
@@ -33,6 +33,8 @@ public:
     Effect GetEffect(uint16 eID);
     Operand GetOperand(uint16 oID);
     Expression GetExpression(uint16 eID);
+    /* the expression's modifier calls, for a source item that is (skill) or is not a skill/implant */
+    const fxProgram& GetProgram(uint16 eID, bool skill);
 
     void GetTypeEffect(uint16 typeID, std::vector< TypeEffects >& typeEffMap);
 
@@ -45,6 +47,8 @@ protected:
     void GetExpressions(DBQueryResult& res);
     void GetDgmTypeEffects(DBQueryResult &res);
 
+    void CompilePrograms();
+
 private:
     bool m_loaded;
     float m_time;
@@ -57,6 +61,7 @@ private:
     std::map<uint16, Expression> m_expMap;
     std::map<std::string, uint16> m_effectName;  // k,v of effectID, effectName.  maps all effectIDs to their name.
     std::unordered_multimap<uint16, TypeEffects> m_typeFxMap;  // k,v of typeID, data<effectID, isDefault>
+    std::unordered_map<uint32, fxProgram> m_programs;  // k,v of (expressionID << 1 | skill), modifier calls
 };
 
 #define sFxDataMgr \
@@ -27,14 +27,10 @@
  * EFFECTS__TRACE=0
  */
 
-void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData& data, GenericModule* pMod/*nullptr*/)
+void FxProc::ParseExpression(InventoryItem* pItem, uint16 expressionID, fxData& data, GenericModule* pMod/*nullptr*/)
 {
     double profileStartTime(GetTimeUSeconds());
 
-    if (is_log_enabled(EFFECTS__TRACE) and 0)
-        _log(EFFECTS__TRACE, "FxProc::ParseExpression(): container: %s(%u) parsing %s ", \
-                pItem->name(), pItem->itemID(), expression.expressionName.c_str());
-
     bool skill(false);
     switch (data.srcRef->categoryID()) {
         case  EVEDB::invCategories::Skill:
@@ -43,39 +39,58 @@ void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData
         } break;
     }
 
+    // the expression tree was walked once, when effects were loaded.  make its modifier calls.
+    for (auto& cur : sFxDataMgr.GetProgram(expressionID, skill)) {
+        fxData mod = fxData();
+        mod.math = cur.math;
+        mod.fxSrc = cur.fxSrc;
+        mod.targLoc = cur.targLoc;
+        mod.action = cur.action;
+        mod.targAttr = cur.targAttr;
+        mod.srcAttr = cur.srcAttr;
+        mod.grpID = cur.grpID;
+        mod.typeID = (cur.typeFromSrc ? data.srcRef->typeID() : cur.typeID);
+        mod.srcRef = data.srcRef;
+        mod.tracked = data.tracked;
+        if (cur.remove) {
+            pItem->RemoveModifier(mod);
+        } else {
+            pItem->AddModifier(mod);
+        }
+    }
+
+    if (sConfig.debug.UseProfiling)
+        sProfiler.AddTime(Profile::parseFX, GetTimeUSeconds() - profileStartTime);
+}
+
+void FxProc::CompileExpression(uint16 expressionID, bool skill, fxProgram& program)
+{
+    FxModifier data = FxModifier();
+    data.action = FX::Action::Invalid;
+    CompileExpression(sFxDataMgr.GetExpression(expressionID), skill, data, program);
+}
+
+/* walks the expression tree the way effects were evaluated on every call before,
+ * keeping the modifier calls it makes.  'skill' is whether the source item is a skill/implant,
+ * the only thing about the source the tree depends on, besides GETTYPE (typeFromSrc)
+ */
+void FxProc::CompileExpression(const Expression& expression, bool skill, FxModifier& data, fxProgram& program)
+{
+    if (is_log_enabled(EFFECTS__TRACE) and 0)
+        _log(EFFECTS__TRACE, "FxProc::CompileExpression(): compiling %s ", expression.expressionName.c_str());
+
     using namespace FX;
     switch(expression.operandID) {
         // these return the given expressionValue
         case Operands::DEFBOOL:   //23  this evaulates to 'true' (Bool(1))
         case Operands::DEFINT: {  //27  this is used as  0,1,2,{raceID}
             //  seems to be called only to online/offline modules (and screws up my Online/Offline code...)
-            /*
-            int8 value = atoi(expression.expressionValue.c_str());
-            if (module) {
-                if (value == 0)
-                    data.srcRef->PutOffline();
-                if (value == 1)
-                    data.srcRef->PutOnline(isRig);
-                return; // we are done at this point
-            } */
         } break;
         case Operands::DEFASSOCIATION: { //21
             data.math = GetAssociationEnum(expression.expressionValue);
-            /*
-            if (data.math > Math::MaxMathMethod) {
-                Operand operand = sFxDataMgr.GetOperand(expression.operandID);
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): out of range mathOp: %s(%i) for operand %u (%s).", \
-                        GetMathMethodName(data.math), data.math, expression.operandID, operand.operandKey.c_str());
-            } */
         } break;
         case Operands::DEFENVIDX: {     //24
             data.targLoc = GetEnvironmentEnum(expression.expressionValue);
-            /*
-            if (data.targLoc > Target::MaxTargLocation) {
-                Operand operand = sFxDataMgr.GetOperand(expression.operandID);
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): out of range targLoc: %i for operand %u (%s).", \
-                        data.targAttr, expression.operandID, operand.operandKey.c_str());
-            } */
         } break;
         // these provide the given expressionID (attrib/grp)
         case Operands::DEFATTRIBUTE: {  //22
@@ -86,7 +101,7 @@ void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData
                     data.targAttr = expression.expressionAttributeID;
                 }
             } else {
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): opATTR called with no expressionAttributeID defined");
+                _log(EFFECTS__ERROR, "FxProc::CompileExpression(): opATTR called with no expressionAttributeID defined");
             }
         } break;
         case Operands::DEFGROUP: {      //26
@@ -95,10 +110,10 @@ void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData
                 data.grpID = expression.expressionGroupID;
             } else if (expression.expressionValue != "") {
                 ;   // will have to figure out how to do this one.
-                _log(EFFECTS__WARNING, "FxProc::ParseExpression(): opGROUP using expressionValue %s called by %s",\
+                _log(EFFECTS__WARNING, "FxProc::CompileExpression(): opGROUP using expressionValue %s called by %s",\
                         expression.expressionValue.c_str(), expression.expressionName.c_str());
             } else {
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): opGROUP called with no expressionGroupID or expressionValue defined");
+                _log(EFFECTS__ERROR, "FxProc::CompileExpression(): opGROUP called with no expressionGroupID or expressionValue defined");
             }
         } break;
         case Operands::DEFTYPEID: {     //29
@@ -106,70 +121,66 @@ void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData
                 data.fxSrc = Source::Skill;
             if (expression.expressionTypeID) {
                 data.typeID = expression.expressionTypeID;
+                data.typeFromSrc = false;
             } else if (expression.expressionValue != "") {
                 ;   // will have to figure out how to do this one.
-                _log(EFFECTS__WARNING, "FxProc::ParseExpression(): opTYPEID using expressionValue %s", expression.expressionValue.c_str());
+                _log(EFFECTS__WARNING, "FxProc::CompileExpression(): opTYPEID using expressionValue %s", expression.expressionValue.c_str());
             } else {
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): opTYPEID called with no expressionTypeID or expressionValue defined");
+                _log(EFFECTS__ERROR, "FxProc::CompileExpression(): opTYPEID called with no expressionTypeID or expressionValue defined");
             }
         } break;
         case Operands::GETTYPE: { //36, %(arg1)s.GetTypeID()  --used by SRLG in AORSM
-            if (!data.typeID)
-                data.typeID = data.srcRef->typeID();    // get items on ship that require SkillItem in srcRef
+            if ((!data.typeID) and (!data.typeFromSrc))
+                data.typeFromSrc = true;    // get items on ship that require SkillItem in srcRef
         } break;
         // do as stated
         case Operands::GM:      //37, %(arg1)s.GetModule(%(arg2)s)      --used by subsystems as (GetModule(Ship:201):55)
-        case Operands::RSA: {   //64, %(arg1)s.%(arg2)s      -- used by AGRSM
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
+        case Operands::RSA:     //64, %(arg1)s.%(arg2)s      -- used by AGRSM
+        case Operands::LG: {    //48, %(arg1)s.LocationGroup.%(arg2)s  -- specify a group by grpID for a location'  used by ALGM
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg1), skill, data, program);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg2), skill, data, program);
         } break;
         case Operands::COMBINE: { //17, %(arg1)s); (%(arg2)s      --executes two statements
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            fxData data1 = fxData();
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg1), skill, data, program);
+            FxModifier data1 = FxModifier();
             data1.action = Action::Invalid;
-            data1.srcRef = data.srcRef;
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data1, pMod);
-        } break;
-        case Operands::LG: {    //48, %(arg1)s.LocationGroup.%(arg2)s  -- specify a group by grpID for a location'  used by ALGM
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);   //source
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);   //groupID
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg2), skill, data1, program);
         } break;
         case Operands::SRLG: {    //49, %(arg1)s.SkillRequiredLocationGroup[%(arg2)s]  --  specify a group by skillID for a location   used by ALRSM and AORSM
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);   //source
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);   //skillID
-            if (!data.fxSrc) {    // fxSrc = Self in this case.  update to remove this hack?
-                //_log(EFFECTS__TRACE, "FxProc::ParseExpression(): SRLG: setting fxSrc from %s to Skill for %s.  self: %s", \
-                        GetSourceName(data.fxSrc), data.srcRef->name(), (pItem == data.srcRef.get() ? "true" : "false"));
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg1), skill, data, program);   //source
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg2), skill, data, program);   //skillID
+            if (!data.fxSrc)    // fxSrc = Self in this case.  update to remove this hack?
                 data.fxSrc = Source::Skill;
-            }
         } break;
         case Operands::ATT:     //12, %(arg1)s->%(arg2)s               --(item:attribID)
         case Operands::EFF:     //31, %(arg2)s.%(arg1)s                --define association type
         case Operands::GA:      //34, %(arg1)s.%(arg2)s                --GetAttribute      (no known uses)
         case Operands::GET:     //35, %(arg1)s.%(arg2)s()              --used a lot.  eg. Get(Ship:101) means 'get attribute 101 on ShipItem'
         case Operands::IA: {    //40, %(arg1)s                         --used by AGSM
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg1), skill, data, program);
             if (expression.arg2)
-                ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data);
+                CompileExpression(sFxDataMgr.GetExpression(expression.arg2), skill, data, program);
         } break;
         // effect function calls.
-        // here is where we'll actually add the modifier data to the item's map
+        // here is where the modifier data will be added to the item's map
         case Operands::AIM:     //6,  AddItemModifier(env,%(arg1)s, %(arg2)s)
         case Operands::AGRSM:   //5,  [%(arg1)s].AGRSM(%(arg2)s)    --AddGangRequiredSkillModifier
         case Operands::AGSM: {  //3,  [%(arg1)s].AGSM(%(arg2)s)        --AddGangShipModifier
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
-            pItem->AddModifier(data);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg1), skill, data, program);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg2), skill, data, program);
+            data.remove = false;
+            program.push_back(data);
         } break;
         case Operands::ALGM:    //7,  (%(arg1)s).AddLocationGroupModifier (%(arg2)s)
         case Operands::ALM:     //8,  (%(arg1)s).AddLocationModifier (%(arg2)s)
         case Operands::ALRSM:   //9,  (%(arg1)s).AddLocationRequiredSkillModifier(%(arg2)s)
         case Operands::AORSM: { //11, (%(arg1)s).AddOwnerRequiredSkillModifier(%(arg2)s)
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg1), skill, data, program);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg2), skill, data, program);
             if ((skill) and (!data.fxSrc))      // fxSrc = Self in this case.  update to remove this hack?
                 data.fxSrc = Source::Skill;
-            pItem->AddModifier(data);
+            data.remove = false;
+            program.push_back(data);
         } break;
         // remove modifier calls only partially enabled for modules and charges.
         // will implement for implants and boosters when those systems are written.
@@ -178,19 +189,23 @@ void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData
         case Operands::RGSM:    //55, [%(arg1)s].RemoveGangShipModifier(%(arg2)s)
         case Operands::RGORSM:  //56, [%(arg1)s].RemoveGangOwnerRequiredSkillModifier(%(arg2)s)
         case Operands::RGRSM: { //57, [%(arg1)s].RemoveGangRequiredSkillModifier(%(arg2)s)
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
-            pItem->RemoveModifier(data);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg1), skill, data, program);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg2), skill, data, program);
+            data.remove = true;
+            program.push_back(data);
+            data.math = GetInverseMath(data.math);  // as RemoveModifier() leaves it
         } break;
         case Operands::RLGM:    //59, (%(arg1)s).RemoveLocationGroupModifier (%(arg2)s)
         case Operands::RLM:     //60, (%(arg1)s).RemoveLocationModifier (%(arg2)s)
         case Operands::RLRSM:   //61, (%(arg1)s).RemoveLocationRequiredSkillModifier(%(arg2)s)
         case Operands::RORSM: { //62, (%(arg1)s).RemoveOwnerRequiredSkillModifier(%(arg2)s)
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg1), skill, data, program);
+            CompileExpression(sFxDataMgr.GetExpression(expression.arg2), skill, data, program);
             if ((skill) and (!data.fxSrc))     // fxSrc = Self in this case.  update to remove this hack?
                 data.fxSrc = Source::Skill;
-            pItem->RemoveModifier(data);
+            data.remove = true;
+            program.push_back(data);
+            data.math = GetInverseMath(data.math);  // as RemoveModifier() leaves it
         } break;
         /*
         // next 3 not used here, as they are only used by effect 16 (Online), which is covered in GenericModule class.
@@ -269,17 +284,40 @@ void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData
         } break;
         */
     }
+}
 
-    if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::parseFX, GetTimeUSeconds() - profileStartTime);
+int8 FxProc::GetInverseMath(int8 math)
+{
+    switch (math) {
+        case FX::Math::PreMul:         return FX::Math::PreDiv;
+        case FX::Math::PreDiv:         return FX::Math::PreMul;
+        case FX::Math::ModAdd:         return FX::Math::ModSub;
+        case FX::Math::ModSub:         return FX::Math::ModAdd;
+        case FX::Math::PostMul:        return FX::Math::PostDiv;
+        case FX::Math::PostDiv:        return FX::Math::PostMul;
+        case FX::Math::PostPercent:    return FX::Math::RevPostPercent;
+        case FX::Math::PreAssignment:  return FX::Math::PostAssignment;
+        case FX::Math::PostAssignment: return FX::Math::PreAssignment;
+    }
+    return math;
 }
 
 void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShip, bool update/*false*/)
 {
     double profileStartTime(GetTimeUSeconds());
     using namespace FX;
+    // char skills that require a given skill, gathered once per call (applying skills needs most of them)
+    std::vector<InventoryItemRef> allSkills;
+    std::unordered_map<uint16, std::vector<InventoryItemRef>> skillTargets;
+    // items whose kept modifiers changed, refigured once each when all are in
+    std::vector<InventoryItemRef> kept;
     //uint8 action = Action::dgmActInvalid;
-    for (auto cur : pItem->GetModifiers()) {  // k,v of assoc, data<math, src, targLoc, targAttr, srcAttr, grpID, typeID>
+    for (auto& cur : pItem->GetModifiers()) {  // k,v of assoc, data<math, src, targLoc, targAttr, srcAttr, grpID, typeID>
+        if (cur.second.tracked and cur.second.remove) {
+            // taken off the items the source put it on, even if the ship's target changed since
+            cur.second.srcRef->GetAttributeMap()->RemoveDependents(cur.second.srcAttr, cur.second.targAttr, cur.first, kept);
+            continue;
+        }
         /*
         if (cur.second.action) {
             action = cur.second.action;
@@ -288,15 +326,13 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
         //InventoryItemRef srcItemRef = cur.second.srcRef;
 
         std::vector<InventoryItemRef> itemRefVec;
+        // selections kept by the ship's fitting (or for this call) are used as they are
+        const std::vector<InventoryItemRef>* targets = &itemRefVec;
         // affected target depends on source.  get source and target(s) here.
         switch (cur.second.fxSrc) {
             case Source::Group: {     // not a source per se, but defines effect's target selection requirements
                 // this is to apply modifiers to ship's modules of groupID defined in 'grpID'
-                std::vector<InventoryItemRef> moduleList;
-                pShip->GetModuleManager()->GetModuleListOfRefsAsc(moduleList);
-                for (auto mod : moduleList)
-                    if (mod->groupID() == cur.second.grpID)
-                        itemRefVec.push_back(mod);
+                targets = &pShip->GetModuleManager()->GetFxModulesByGroup(cur.second.grpID);
             } break;
             case Source::Skill: {    // source of this effect is skill, implant, or booster
                 if (cur.second.typeID == EVEDB::invTypes::Invalid) {    //invalid
@@ -312,7 +348,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                     case Target::Ship:  {
                         if (cur.second.typeID) {
                             // ... ship's modules that require skillID defined in "typeID"
-                            pShip->GetModuleManager()->GetModuleListByReqSkill(cur.second.typeID, itemRefVec);
+                            targets = &pShip->GetModuleManager()->GetFxModulesByReqSkill(cur.second.typeID);
                         } else {
                             // ... ship that require skill in 'srcRef'
                             if (pShip->HasReqSkill(cur.second.srcRef->typeID()))
@@ -322,11 +358,16 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                     case Target::Char: {
                         if (cur.second.typeID) {
                             // ... char skills that require skill in 'srcRef' or defined in 'typeID'
-                            std::vector<InventoryItemRef> allSkills;
-                            pChar->GetSkillsList(allSkills);
-                            for (auto curSkill : allSkills)
-                                if (curSkill->HasReqSkill(cur.second.typeID))
-                                    itemRefVec.push_back(curSkill);
+                            auto itr = skillTargets.find(cur.second.typeID);
+                            if (itr == skillTargets.end()) {
+                                if (allSkills.empty())
+                                    pChar->GetSkillsList(allSkills);
+                                itr = skillTargets.emplace(cur.second.typeID, std::vector<InventoryItemRef>()).first;
+                                for (auto curSkill : allSkills)
+                                    if (curSkill->HasReqSkill(cur.second.typeID))
+                                        itr->second.push_back(curSkill);
+                            }
+                            targets = &itr->second;
                         } else {
                             // ... character itself
                             itemRefVec.push_back(static_cast<InventoryItemRef>(pChar));
@@ -339,11 +380,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                     case Target::Charge: {
                         // ... charges
                         // will need more testing to verify this.
-                        std::map<EVEItemFlags, InventoryItemRef> charges;
-                        pShip->GetModuleManager()->GetLoadedCharges(charges);
-                        for (auto mod : charges)
-                            if (mod.second->HasReqSkill(cur.second.typeID))
-                                itemRefVec.push_back(mod.second);
+                        targets = &pShip->GetModuleManager()->GetFxChargesByReqSkill(cur.second.typeID);
                     } break;
                     case Target::Target: {
                         // ... current target (focused, volatile...removed on 'invalid target')
@@ -452,7 +489,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
             } break;
         }
 
-        if (itemRefVec.empty())
+        if (targets->empty())
             if ((cur.second.typeID == 0)
             and (cur.second.grpID == 0)) {
                 // only concerned when typeID/grpID is 0.  when either are populated, ship dont have that module.  nbd
@@ -477,11 +514,16 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
 
         // set target attr to modified value
         EvilNumber targValue(EvilZero), newValue(EvilZero);
-        for (auto item : itemRefVec) {
+        for (auto& item : *targets) {
             if (item.get() == nullptr)  // still occasional nulls in the vector (segfaults)
                 continue;
-            // get targAttr
-            targValue = item->GetAttribute(cur.second.targAttr);
+            if (cur.second.tracked) {
+                item->GetAttributeMap()->AddModifier(cur.second.targAttr, cur.first, *cur.second.srcRef, cur.second.srcAttr);
+                kept.push_back(item);
+                continue;
+            }
+            // get targAttr, without any kept modifiers on it
+            targValue = item->GetBaseAttribute(cur.second.targAttr);
             // check for inf/nan and then reset?  this will fuck up all previous fx processing on this value.
             // but it will allow continuing w/o error in subsequent processing
             if (targValue.isNaN() or targValue.isInf()) {
@@ -521,6 +563,10 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
         sFxAct.DoAction(action, pShip->GetPilot()->GetShipSE());   // this MUST be called AFTER all active effects are applied, as it uses those modified values
      */
 
+    // update is used the same as above
+    for (auto& cur : kept)
+        cur->GetAttributeMap()->Update(update);
+
     pItem->ClearModifiers();
 
     if (sConfig.debug.UseProfiling)
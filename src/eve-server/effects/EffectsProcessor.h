@@ -31,7 +31,10 @@ public:
     void            ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShip, bool update=false);
     // pItem is modifier container
     // pMod is not used
-    void            ParseExpression(InventoryItem* pItem, Expression expression, fxData& data, GenericModule* pMod=nullptr);
+    // runs the modifier calls compiled for expressionID with data.srcRef as source
+    void            ParseExpression(InventoryItem* pItem, uint16 expressionID, fxData& data, GenericModule* pMod=nullptr);
+    // decodes an expression tree into its modifier calls.  called by sFxDataMgr when loading
+    void            CompileExpression(uint16 expressionID, bool skill, fxProgram& program);
     int8            GetEnvironmentEnum(const std::string& domain);
     int8            GetAssociationEnum(const std::string& association);
 
@@ -41,11 +44,14 @@ public:
     const char*     GetStateName(int8 id);
 
     EvilNumber      CalculateAttributeValue(EvilNumber val1, EvilNumber val2, /*FX::Math*/int8 method);
+    // the math undoing 'math'
+    int8            GetInverseMath(int8 math);
 
     void DecodeEffects(const uint16 fxID);
 protected:
     void EvaluateExpression(const uint16 expID, const char* type);
     void DecodeExpression(Expression expression, fxData& data);
+    void CompileExpression(const Expression& expression, bool skill, FxModifier& data, fxProgram& program);
 
 private:
 
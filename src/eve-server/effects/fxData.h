@@ -22,6 +22,8 @@ struct fxData {
     uint16 srcAttr;
     uint16 grpID;       // used to define items in env grouped by item groupID
     uint16 typeID;      // used to define items in env grouped by skill requirement
+    bool tracked;       // kept in the target's attribute modifiers (active module states)
+    bool remove;        // from RemoveModifier()
     InventoryItemRef srcRef;   // source item ref, if required
 };
 #endif // _EVE_FX_DATA_H__
\ No newline at end of file
@@ -29,11 +29,13 @@
 #include "../eve-common/EVEVersion.h"
 
 #include "EVEServerConfig.h"
+#include "log/LogQueue.h"
 #include "NetService.h"
 // data managers
 #include "StaticDataMgr.h"
 #include "StatisticMgr.h"
 #include "missions/MissionDataMgr.h"
+#include "threading/TaskGraph.h"
 //console commands
 #include "ConsoleCommands.h"
 // account services
@@ -44,6 +46,7 @@
 #include "account/InfoGatheringMgr.h"
 #include "account/TutorialService.h"
 #include "account/UserService.h"
+#include "account/WalletMgr.h"
 // admin services
 #include "admin/AlertService.h"
 #include "admin/AllCommands.h"
@@ -83,6 +86,7 @@
 #include "config/LanguageService.h"
 #include "config/LocalizationServerService.h"
 // contract services
+#include "contract/ContractMgr.h"
 #include "contract/ContractProxy.h"
 // corporation services
 #include "corporation/BillMgr.h"
@@ -149,6 +153,7 @@
 #include "qaTools/zActionServer.h"
 // search services
 #include "search/Search.h"
+#include "search/SearchMgr.h"
 // ship services
 #include "ship/BeyonceService.h"
 #include "ship/ShipService.h"
@@ -247,6 +252,11 @@ int main( int argc, char* argv[] )
             sLog.Warning( "       ServerInit", "Unable to find log directory '%s', only logging to the screen now.", sConfig.files.logDir.c_str() );
         }
     }
+    /* move log output off the logging threads if asked */
+    if (sConfig.threads.LogThreads > 0) {
+        sLogQueue.Start();
+        sLog.Green( "       ServerInit", "Log lines are written on a background thread." );
+    }
     std::printf("\n");     // spacer
 
     sLog.Green("       ServerInit", "Server Configuration Files Loaded.");
@@ -582,6 +592,15 @@ int main( int argc, char* argv[] )
 
     sAllocators.tickAllocator.Init(Allocators::TICK_ALLOCATOR_SIZE, "TickAllocator");
 
+    /* Start up the network reactor.  connections fall back to their own threads if this fails */
+    if (sConfig.net.useReactor) {
+        if (sTCPReactor.Start(sConfig.threads.NetworkThreads)) {
+            sLog.Blue( "       TCPReactor", "Network reactor started with %u threads.", sConfig.threads.NetworkThreads );
+        } else {
+            sLog.Warning( "       TCPReactor", "Network reactor not available.  Using thread per connection." );
+        }
+    }
+
     /* Start up the TCP server */
     EVETCPServer tcps;
     char errbuf[ TCPCONN_ERRBUF_SIZE ];
@@ -614,6 +633,7 @@ int main( int argc, char* argv[] )
         std::cout << std::endl << "press any key to exit...";  std::cin.get();
         return EXIT_FAILURE;
     }
+    sDatabase.StartPool(sConfig.database.poolSize);
     std::printf("\n");     // spacer
 
     // Clean DB upon initialisation
@@ -764,6 +784,14 @@ int main( int argc, char* argv[] )
     /* create the MarketMgr singleton */
     sLog.Green("       ServerInit", "Starting Market Manager");
     sMktMgr.Initialize(newSvcMgr);
+    /* create the ContractMgr singleton */
+    sLog.Green("       ServerInit", "Starting Contract Manager");
+    sContractMgr.Initialize();
+    /* create the SearchMgr singleton */
+    sLog.Green("       ServerInit", "Starting Search Manager");
+    sSearchMgr.Initialize();
+    sLog.Green("       ServerInit", "Starting Wallet Manager");
+    sWalletMgr.Initialize();
     sLog.Green("       ServerInit", "Starting Statistics Manager");
     sStatMgr.Initialize();
     /* create console command interperter singleton */
@@ -796,32 +824,41 @@ int main( int argc, char* argv[] )
     /** @note  this is NOT used correctly yet...  */
     //sLog.Green("       ServerInit", "Priming cached objects.");
     //pyServMgr.cache_service->PrimeCache();
-    sLog.Green("       ServerInit", "Initializing BulkData");
-    if (sConfig.server.BulkDataOD) {
+    if (sConfig.server.BulkDataOD)
         sLog.Yellow("      BulkDataMgr", "PreLoading Disabled. BulkData will load on first call.");
-    } else {
-        sBulkDB.Initialize();
-    }
-    std::printf("\n");     // spacer
 
-    sLog.Green("       ServerInit", "Loading Data Sets");
-    sDataMgr.Initialize();
-    std::printf("\n");     // spacer
-    sMissionDataMgr.Initialize();
-    std::printf("\n");     // spacer
-    sFxDataMgr.Initialize();
-    std::printf("\n");     // spacer
-    sMapData.Initialize();
-    std::printf("\n");     // spacer
-    sDunDataMgr.Initialize();
-    std::printf("\n");     // spacer
-    sPlanetDataMgr.Initialize();
-    std::printf("\n");     // spacer
-    sPIDataMgr.Initialize();
-    std::printf("\n");     // spacer
-    stDataMgr.Initialize();
+    /* the data managers each read their own tables into their own singleton, and none
+     * of them looks at another's data while loading, so they have no order between them
+     * and all start at once.  a loader that comes to need another's data names it in Add().
+     * each loader thread gets its own db connection.
+     */
+    sLog.Green("       ServerInit", "Loading Data Sets on %u threads", sConfig.database.loaderThreads);
+    TaskGraph loaders;
+    if (!sConfig.server.BulkDataOD)
+        loaders.Add("BulkData",     []() { sBulkDB.Initialize(); return true; });
+    loaders.Add("StaticData",       []() { sDataMgr.Initialize(); return true; });
+    loaders.Add("MissionData",      []() { sMissionDataMgr.Initialize(); return true; });
+    loaders.Add("FxData",           []() { sFxDataMgr.Initialize(); return true; });
+    loaders.Add("MapData",          []() { sMapData.Initialize(); return true; });
+    loaders.Add("DungeonData",      []() { sDunDataMgr.Initialize(); return true; });
+    loaders.Add("PlanetData",       []() { sPlanetDataMgr.Initialize(); return true; });
+    loaders.Add("PIData",           []() { sPIDataMgr.Initialize(); return true; });
+    loaders.Add("StationData",      []() { stDataMgr.Initialize(); return true; });
+    loaders.Add("SovData",          []() { svDataMgr.Initialize(); return true; });
+
+    double loadStartTime(GetTimeMSeconds());
+    if (!loaders.Run(sConfig.database.loaderThreads,
+                     []() { return sDatabase.OpenThreadConnection(); },
+                     []() { sDatabase.CloseThreadConnection(); })) {
+        sLog.Error("       ServerInit", "Data Sets failed to load.");
+        std::cout << std::endl << "press return to exit..." << std::endl;
+        std::cin.get();
+        return EXIT_FAILURE;
+    }
     std::printf("\n");     // spacer
-    svDataMgr.Initialize();
+    for (uint32 i = 0; i < loaders.size(); ++i)
+        sLog.Cyan("       ServerInit", "%-12s %9.3fms - %9.3fms", loaders.GetName(i).c_str(), loaders.GetStart(i), loaders.GetEnd(i));
+    sLog.Green("       ServerInit", "Data Sets loaded in %.3fms", (GetTimeMSeconds() - loadStartTime));
     std::printf("\n");     // spacer
 
     // clear dynamic system data (player counts, etc) on server start
@@ -908,6 +945,9 @@ int main( int argc, char* argv[] )
         if ((tcpc = tcps.PopConnection()))
             sEntityList.Add(new Client(newSvcMgr, &tcpc));
 
+        /* fire game timers that are due (target locks, reloads, spawns, skill training) */
+        sTimerWheel.Advance(Timer::Now());
+
         sEntityList.Process();
 
         /*  process console commands, if any, and check for 'exit' command */
@@ -940,6 +980,10 @@ int main( int argc, char* argv[] )
     sLog.Warning("   ServerShutdown", "Image Server stopped." );
     /* Close the MarketMgr */
     sMktMgr.Close();
+    /* Close the ContractMgr */
+    sContractMgr.Close();
+    /* Close the SearchMgr */
+    sSearchMgr.Close();
     /* Close the bulk data manager */
     sBulkDB.Close();
     /* Close the station data manager */
@@ -957,6 +1001,8 @@ int main( int argc, char* argv[] )
         sItemFactory.SaveItems();
     /* Close the entity list */
     sEntityList.Close();
+    /* stop network reactor; all clients are gone by now */
+    sTCPReactor.Stop();
     /* Shut down the Item system */
     sLog.Warning("   ServerShutdown", "Shutting down Item Factory." );
     sItemFactory.Close();
@@ -966,14 +1012,20 @@ int main( int argc, char* argv[] )
     command_dispatcher.Close();
     /* Stop Console Command Interpreter */
     //sConsole.Stop();
+    /* write out the wallets before the db handler goes */
+    sLog.Warning("   ServerShutdown", "Flushing Wallets." );
+    sWalletMgr.Close();
     /* close the db handler */
     sLog.Warning("   ServerShutdown", "Closing DataBase Connection." );
+    sDatabase.StopPool();
     sDatabase.Close();
     /** @todo  the thread system is only implemented for tcp connections at this time. */
     sLog.Warning("   ServerShutdown", "Shutting down Thread Manager." );
     /* join open threads */
     sThread.EndThreads();
     sLog.Warning("   ServerShutdown", "EVEmu is Offline.");
+    /* write out queued log lines */
+    sLogQueue.Stop();
     /* close logfile */
     log_close_logfile();
     exit(EXIT_SUCCESS);
@@ -1047,6 +1099,12 @@ static void CleanUp() {
     /* Close the MarketMgr */
     sLog.Warning("   ServerShutdown", "Shutting down Market Manager." );
     sMktMgr.Close();
+    /* Close the ContractMgr */
+    sLog.Warning("   ServerShutdown", "Shutting down Contract Manager." );
+    sContractMgr.Close();
+    /* Close the SearchMgr */
+    sLog.Warning("   ServerShutdown", "Shutting down Search Manager." );
+    sSearchMgr.Close();
     /* Close the bulk data manager */
     sLog.Warning("   ServerShutdown", "Closing the BulkData Manager." );
     sBulkDB.Close();
@@ -1064,6 +1122,7 @@ static void CleanUp() {
     /* Close the entity list */
     sLog.Warning("   ServerShutdown", "Closing the Entity List." );
     sEntityList.Close();
+    sTCPReactor.Stop();
     /* Close the service manager */
     sLog.Warning("   ServerShutdown", "Closing the Services Manager." );
     //pyServMgr.Close();
@@ -1076,8 +1135,12 @@ static void CleanUp() {
     //command_dispatcher.Close();
     /* Stop Console Command Interpreter */
     //sConsole.Stop();
+    /* write out the wallets before the db handler goes */
+    sLog.Warning("   ServerShutdown", "Flushing Wallets." );
+    sWalletMgr.Close();
     /* close the db handler */
     sLog.Warning("   ServerShutdown", "Closing DataBase Connection." );
+    sDatabase.StopPool();
     sDatabase.Close();
     /** @todo  the thread system is only implemented for tcp connections at this time. */
     sLog.Warning("   ServerShutdown", "Shutting down Thread Manager." );
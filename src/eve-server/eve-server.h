@@ -53,6 +53,7 @@
 // network
 #include "network/EVETCPConnection.h"
 #include "network/EVETCPServer.h"
+#include "network/TCPReactor.h"
 #include "network/EVEPktDispatch.h"
 #include "network/EVESession.h"
 // marshal
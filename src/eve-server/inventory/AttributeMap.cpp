@@ -30,10 +30,44 @@
 #include "Client.h"
 #include "EntityList.h"
 #include "StaticDataMgr.h"
+#include "effects/EffectsProcessor.h"
 #include "inventory/AttributeMap.h"
 #include "inventory/InventoryItem.h"
 
 
+namespace {
+
+/* 'value' of a multiplying modifier of 'math' as a factor.  @return false for other maths */
+bool GetFactor(int8 math, EvilNumber value, double& factor)
+{
+    switch (math) {
+        case FX::Math::PreMul:
+        case FX::Math::PostMul: {
+            factor = value.get_double();
+        } return true;
+        case FX::Math::PreDiv:
+        case FX::Math::PostDiv: {
+            factor = (value == EvilZero ? 1.0 : 1.0 / value.get_double());
+        } return true;
+        case FX::Math::PostPercent: {
+            factor = 1.0 + value.get_double() / 100.0;
+        } return true;
+        case FX::Math::RevPostPercent: {
+            factor = (value == -100 ? 0.0 : 1.0 / (1.0 + value.get_double() / 100.0));
+        } return true;
+    }
+    return false;
+}
+
+/* share of the 'n'th strongest (from 0) of like modifiers that counts */
+double GetStackingPenalty(size_t n)
+{
+    const double x = n / 2.67;
+    return exp(-(x * x));
+}
+
+}
+
 /*
  * ATTRIBUTE__ADD
  * ATTRIBUTE__CHANGE
@@ -46,9 +80,9 @@
 
 
 AttributeMap::AttributeMap( InventoryItem& item)
-: mItem(item)
+: mItem(item),
+mLoading(false)
 {
-    mAttributes.clear();
 }
 
 AttributeMap::~AttributeMap()
@@ -58,27 +92,37 @@ AttributeMap::~AttributeMap()
 
 
 bool AttributeMap::Load(bool reset/*false*/) {
+    mLoading = true;
+    /* default attribute values are our itemType's, loaded when type is loaded.  we only keep what differs */
+    mAttributes.SetBase(&mItem.type().GetAttributes());
     if (reset) {
         // this will allow total clearing of attribs to eliminate the necessity of 'removing' effects
-        mAttributes.clear();
+        mAttributes.Clear();
+        mNodes.clear();
+    } else if ((mAttributes.OwnCount() > 0) or !mNodes.empty()) {
+        // put type attribs back to their defaults, keeping others.  equal ones are skipped in SetValue()
+        for (auto cur : mItem.type().GetAttributes())
+            SetAttribute(cur.first, cur.second, false);
     }
-    /* First, we copy default attributes values from our itemType, loaded into memObj when type is loaded */
-    // (except char ability scores...dunno why yet)
-    mItem.type().CopyAttributes(mItem);
 
-    // check for temp items.  they arent saved to db
-    if (!IsTempItem(mItem.itemID()) and !IsNPC(mItem.itemID())) {
+    ItemPreload* pPreload(sItemFactory.GetPreload(mItem.itemID()));
+    if (pPreload != nullptr) {
+        // read with the rest of our container's contents
+        for (auto& cur : pPreload->attribs)
+            SetAttribute(cur.first, cur.second, false);
+    } else if (!IsTempItem(mItem.itemID()) and !IsNPC(mItem.itemID())) {
+        // check for temp items.  they arent saved to db
         /* load saved attribs from the db, if any, to update the defaults with items current (saved) values*/
-        DBQueryResult res;
+        DBPreparedResult res;
         if (IsCharacterID(mItem.itemID())) {
-            if (!sDatabase.RunQuery(res, "SELECT attributeID, valueInt, valueFloat FROM chrCharacterAttributes WHERE charID=%u", mItem.itemID()))
+            if (!sDatabase.RunPrepared(res, "SELECT attributeID, valueInt, valueFloat FROM chrCharacterAttributes WHERE charID=?", mItem.itemID()))
                 _log(DATABASE__ERROR, "AttributeMap Error in db load query: %s", res.error.c_str());
         } else {
-            if (!sDatabase.RunQuery(res, "SELECT attributeID, valueInt, valueFloat FROM entity_attributes WHERE itemID=%u", mItem.itemID()))
+            if (!sDatabase.RunPrepared(res, "SELECT attributeID, valueInt, valueFloat FROM entity_attributes WHERE itemID=?", mItem.itemID()))
                 _log(DATABASE__ERROR, "AttributeMap Error in db load query: %s", res.error.c_str());
         }
 
-        DBResultRow row;
+        DBPreparedRow row;
         EvilNumber value(EvilZero);
         while (res.GetRow(row)) {
             if (row.IsNull(1)) {
@@ -93,9 +137,10 @@ bool AttributeMap::Load(bool reset/*false*/) {
             SetAttribute(row.GetUInt(0), value, false);
         }
     }
+    mLoading = false;
     /* item now has it's own attribute map, and is deleted when item object is destroyed or reset */
     if (is_log_enabled(ATTRIBUTE__INFO))
-        _log(ATTRIBUTE__INFO, "AttributeMap::Load()  Loaded %lu attribs for %s.", mAttributes.size(), mItem.name());
+        _log(ATTRIBUTE__INFO, "AttributeMap::Load()  Loaded %lu attribs (%lu own) for %s.", mAttributes.Count(), mAttributes.OwnCount(), mItem.name());
     return true;
 }
 
@@ -117,104 +162,133 @@ bool AttributeMap::Save() {
     if (IsStaticItem(mItem.itemID()))
         return true;
 
-    bool save(false);
     std::vector<Inv::AttrData> attribs;
-    attribs.clear();
-    AttrMapItr itr = mAttributes.begin(), end = mAttributes.end();
+    GetSaveData(attribs);
+    if (!attribs.empty())
+        ItemDB::SaveAttributes(IsCharacterID(mItem.itemID()), attribs);
+    return true;
+}
+
+bool AttributeMap::IsSavedAttribute(uint16 attrID) const
+{
     if (IsCharacterID(mItem.itemID())) {
-        for (; itr != end; ++itr) {
-            switch (itr->first) {
-                case AttrCharisma:
-                case AttrIntelligence:
-                case AttrMemory:
-                case AttrPerception:
-                case AttrWillpower:
-                case AttrCustomCharismaBonus:
-                case AttrCustomWillpowerBonus:
-                case AttrCustomPerceptionBonus:
-                case AttrCustomMemoryBonus:
-                case AttrCustomIntelligenceBonus:
-                case AttrCharismaBonus:
-                case AttrIntelligenceBonus:
-                case AttrMemoryBonus:
-                case AttrPerceptionBonus:
-                case AttrWillpowerBonus: {
-                    if (itr->second == EvilZero)
-                        continue;
-                    Inv::AttrData data = Inv::AttrData();
-                    data.itemID = mItem.itemID();
-                    data.attrID = itr->first;
-                    data.type = false;
-                    data.valueInt = itr->second.get_int();
-                    attribs.push_back(data);
-                }
-            }
+        switch (attrID) {
+            case AttrCharisma:
+            case AttrIntelligence:
+            case AttrMemory:
+            case AttrPerception:
+            case AttrWillpower:
+            case AttrCustomCharismaBonus:
+            case AttrCustomWillpowerBonus:
+            case AttrCustomPerceptionBonus:
+            case AttrCustomMemoryBonus:
+            case AttrCustomIntelligenceBonus:
+            case AttrCharismaBonus:
+            case AttrIntelligenceBonus:
+            case AttrMemoryBonus:
+            case AttrPerceptionBonus:
+            case AttrWillpowerBonus:
+                return true;
         }
-    } else {
-        bool skill(false), damage(false), owner(false), module(false);
-        switch (mItem.categoryID()) {
-            case EVEDB::invCategories::Asteroid:    // asteroids and blueprints are NOT saved here
-            case EVEDB::invCategories::Blueprint: {
-                return false;
-            } break;
-            case EVEDB::invCategories::Ship: {      // ship attribs saved in shipItem, not here.
+        return false;
+    }
+
+    switch (mItem.categoryID()) {
+        // asteroids and blueprints are NOT saved here
+        // ship attribs saved in shipItem, not here.
+        case EVEDB::invCategories::Skill: {     // save SP, Level and times for skills
+            return ((attrID == AttrSkillPoints) or (attrID == AttrSkillLevel));
+        }
+        case EVEDB::invCategories::Celestial:       // save all attribs for these
+        case EVEDB::invCategories::Structure:
+        case EVEDB::invCategories::StructureUpgrade:
+        case EVEDB::invCategories::SovereigntyStructure:
+        case EVEDB::invCategories::Orbitals:
+        case EVEDB::invCategories::Deployable: {
+            return true;
+        }
+        case EVEDB::invCategories::Module:      // save online state for modules
+            if (attrID == AttrOnline)
                 return true;
-            } break;
-            case EVEDB::invCategories::Skill: {     // save SP, Level and times for skills
-                skill = true;
-            } break;
-            case EVEDB::invCategories::Celestial:       // save all attribs for these
-            case EVEDB::invCategories::Structure:
-            case EVEDB::invCategories::StructureUpgrade:
-            case EVEDB::invCategories::SovereigntyStructure:
-            case EVEDB::invCategories::Orbitals:
-            case EVEDB::invCategories::Deployable: {
-                owner = true;
-            } break;
-            case EVEDB::invCategories::Module:      // save online state for modules
-                module = true;            // we're falling thru on purpose here to save module damage
-            case EVEDB::invCategories::Charge:   // remember, crystals and lenses are charges, too.
-            case EVEDB::invCategories::Drone:     // this may need more.  check once system is working
-            case EVEDB::invCategories::Subsystem: {
-                damage = true;
-            } break;
+            // we're falling thru on purpose here to save module damage
+        case EVEDB::invCategories::Charge:   // remember, crystals and lenses are charges, too.
+        case EVEDB::invCategories::Drone:     // this may need more.  check once system is working
+        case EVEDB::invCategories::Subsystem: {
+            return (attrID == AttrDamage);
         }
+    }
+    return false;
+}
 
-        for (; itr != end; ++itr) {
-            save = false;
-            if (skill)
-                if ((itr->first == AttrSkillPoints)
-                or  (itr->first == AttrSkillLevel))
-                    save = true;
-            if (damage)
-                if (itr->first == AttrDamage)
-                    save = true;
-            if (module)
-                if (itr->first == AttrOnline)
-                    save = true;
-            if (save or owner) {
-                Inv::AttrData data = Inv::AttrData();
-                data.itemID = mItem.itemID();
-                data.attrID = itr->first;
-                if (itr->second.isInt()) {
-                    data.type = false;
-                    data.valueInt = itr->second.get_int();
-                } else {
-                    data.type = true;
-                    data.valueFloat = itr->second.get_double();
-                }
-                attribs.push_back(data);
+void AttributeMap::MarkDirty(uint16 attrID)
+{
+    if (mLoading)
+        return;
+    if (!IsSavedAttribute(attrID))
+        return;
+    if (mDirty.insert(attrID).second)
+        sItemFactory.SetDirty(mItem.itemID());
+}
+
+void AttributeMap::GetSaveData(std::vector<Inv::AttrData>& into)
+{
+    if (mDirty.empty())
+        return;
+
+    if (IsCharacterID(mItem.itemID())) {
+        // these are deleted and rewritten as a set
+        for (auto cur : mAttributes) {
+            if (!IsSavedAttribute(cur.first))
+                continue;
+            if (cur.second == EvilZero)
+                continue;
+            Inv::AttrData data = Inv::AttrData();
+            data.itemID = mItem.itemID();
+            data.attrID = cur.first;
+            data.type = false;
+            data.valueInt = cur.second.get_int();
+            into.push_back(data);
+        }
+    } else {
+        for (auto cur : mDirty) {
+            const EvilNumber* pValue = mAttributes.Find(cur);
+            if (pValue == nullptr)
+                continue;
+            EvilNumber value(*pValue);
+            Inv::AttrData data = Inv::AttrData();
+            data.itemID = mItem.itemID();
+            data.attrID = cur;
+            if (value.isInt()) {
+                data.type = false;
+                data.valueInt = value.get_int();
+            } else {
+                data.type = true;
+                data.valueFloat = value.get_double();
             }
+            into.push_back(data);
         }
     }
-
-    if (!attribs.empty())
-        ItemDB::SaveAttributes(IsCharacterID(mItem.itemID()), attribs);
-    return true;
+    mDirty.clear();
 }
 
 
 void AttributeMap::SetAttribute(uint16 attrID, EvilNumber& num, bool notify/*true*/)
+{
+    if (!mNodes.empty()) {
+        std::map<uint16, Node>::iterator itr = mNodes.find(attrID);
+        if ((itr != mNodes.end()) and !num.isNaN() and !num.isInf()) {
+            itr->second.base = num;
+            itr->second.dirty = false;
+            EvilNumber value(Figure(attrID, itr->second));
+            SetValue(attrID, value, notify);
+            return;
+        }
+    }
+
+    SetValue(attrID, num, notify);
+}
+
+void AttributeMap::SetValue(uint16 attrID, EvilNumber& num, bool notify)
 {
     if (num.isNaN() or num.isInf()) {
         _log(ATTRIBUTE__ERROR, "AttributeMap::SetAttribute() - Something sent NaN or Inf for Attr %u on %s(%u). Returning without modifying.",\
@@ -223,9 +297,10 @@ void AttributeMap::SetAttribute(uint16 attrID, EvilNumber& num, bool notify/*tru
         //ResetAttribute(attrID, notify);
         return;
     }
-    AttrMapItr itr = mAttributes.find(attrID);
-    if (itr == mAttributes.end()) {
-        mAttributes.emplace(attrID, num);
+    const EvilNumber* pValue = mAttributes.Find(attrID);
+    if (pValue == nullptr) {
+        mAttributes.Set(attrID, num);
+        MarkDirty(attrID);
         if (notify) {
             Add(attrID, num);
         }
@@ -248,36 +323,43 @@ void AttributeMap::SetAttribute(uint16 attrID, EvilNumber& num, bool notify/*tru
             }
         }
 
+        if (!mDependents.empty())
+            UpdateDependents(attrID, num, notify);
         return;
     }
 
-    if (itr->second == num)
+    EvilNumber oldValue(*pValue);
+    if (oldValue == num)
         return;
 
     if (notify) {
-        Change(attrID, itr->second, num);
+        Change(attrID, oldValue, num);
     }
     if (is_log_enabled(ATTRIBUTE__CHANGE)) {
-        if (itr->second.isFloat()) {
+        if (oldValue.isFloat()) {
             if (num.isFloat()) {
                 _log(ATTRIBUTE__CHANGE, "Changing Attribute %u from %.2f to %.2f for %s(%u)", \
-                        attrID, itr->second.get_float(), num.get_float(), mItem.name(), mItem.itemID());
+                        attrID, oldValue.get_float(), num.get_float(), mItem.name(), mItem.itemID());
             } else {
                 _log(ATTRIBUTE__CHANGE, "Changing Attribute %u from %.2f to %lli for %s(%u)", \
-                        attrID, itr->second.get_float(), num.get_int(), mItem.name(), mItem.itemID());
+                        attrID, oldValue.get_float(), num.get_int(), mItem.name(), mItem.itemID());
             }
         } else {
             if (num.isFloat()) {
                 _log(ATTRIBUTE__CHANGE, "Changing Attribute %u from %lli to %.2f for %s(%u)", \
-                        attrID, itr->second.get_int(), num.get_float(), mItem.name(), mItem.itemID());
+                        attrID, oldValue.get_int(), num.get_float(), mItem.name(), mItem.itemID());
             } else {
                 _log(ATTRIBUTE__CHANGE, "Changing Attribute %u from %lli to %lli for %s(%u)", \
-                        attrID, itr->second.get_int(), num.get_int(), mItem.name(), mItem.itemID());
+                        attrID, oldValue.get_int(), num.get_int(), mItem.name(), mItem.itemID());
             }
         }
     }
 
-    itr->second = num;
+    mAttributes.Set(attrID, num);
+    MarkDirty(attrID);
+
+    if (!mDependents.empty())
+        UpdateDependents(attrID, num, notify);
 }
 
 void AttributeMap::MultiplyAttribute(uint16 attrID, EvilNumber& num, bool notify/*false*/)
@@ -297,45 +379,256 @@ void AttributeMap::MultiplyAttribute(uint16 attrID, EvilNumber& num, bool notify
         EvE::traceStack();
         return;
     }
-    AttrMapItr itr = mAttributes.find(attrID);
-    if (itr == mAttributes.end())
+    const EvilNumber* pValue = mAttributes.Find(attrID);
+    if (pValue == nullptr)
         return; // it doesnt exist...nothing to do.
 
-    EvilNumber oldValue(itr->second);
-    itr->second *= num;
+    if (!mNodes.empty()) {
+        std::map<uint16, Node>::iterator node = mNodes.find(attrID);
+        if (node != mNodes.end()) {
+            EvilNumber base(node->second.base * num);
+            SetAttribute(attrID, base, notify);
+            return;
+        }
+    }
+
+    EvilNumber oldValue(*pValue);
+    EvilNumber newValue(oldValue * num);
+    mAttributes.Set(attrID, newValue);
+    MarkDirty(attrID);
 
     if (notify)
-        Change(attrID, oldValue, itr->second);
+        Change(attrID, oldValue, newValue);
+    if (!mDependents.empty())
+        UpdateDependents(attrID, newValue, notify);
 }
 
 
 EvilNumber AttributeMap::GetAttribute(const uint16 attrID) const
 {
-    AttrMapConstItr itr = mAttributes.find(attrID);
-    if (itr != mAttributes.end())
-        return itr->second;
+    if (!mNodes.empty()) {
+        // modifiers changed but not refigured yet
+        std::map<uint16, Node>::const_iterator node = mNodes.find(attrID);
+        if ((node != mNodes.end()) and node->second.dirty)
+            return Figure(attrID, node->second);
+    }
+
+    const EvilNumber* pValue = mAttributes.Find(attrID);
+    if (pValue != nullptr)
+        return *pValue;
     return EvilZero;
 }
 
 bool AttributeMap::HasAttribute(const uint16 attrID) const
 {
-    AttrMapConstItr itr = mAttributes.find(attrID);
-    if (itr != mAttributes.end())
-        return true;
-    return false;
+    return mAttributes.Has(attrID);
 }
 
 bool AttributeMap::HasAttribute(const uint16 attrID, EvilNumber &value) const
 {
-    AttrMapConstItr itr = mAttributes.find(attrID);
-    if (itr != mAttributes.end()) {
-        value = itr->second;
+    const EvilNumber* pValue = mAttributes.Find(attrID);
+    if (pValue != nullptr) {
+        value = (mNodes.empty() ? *pValue : GetAttribute(attrID));
         return true;
     }
     value = EvilZero;
     return false;
 }
 
+EvilNumber AttributeMap::GetBaseAttribute(const uint16 attrID) const
+{
+    if (!mNodes.empty()) {
+        std::map<uint16, Node>::const_iterator node = mNodes.find(attrID);
+        if (node != mNodes.end())
+            return node->second.base;
+    }
+    return GetAttribute(attrID);
+}
+
+void AttributeMap::AddModifier(uint16 attrID, int8 math, InventoryItem& src, uint16 srcAttr)
+{
+    if ((&src == &mItem) and (srcAttr == attrID)) {
+        _log(ATTRIBUTE__WARNING, "AttributeMap::AddModifier() - Attr %u of %s(%u) modifies itself.  Ignored.", attrID, mItem.name(), mItem.itemID());
+        return;
+    }
+
+    std::map<uint16, Node>::iterator itr = mNodes.find(attrID);
+    if (itr == mNodes.end()) {
+        Node node = Node();
+        node.base = GetAttribute(attrID);
+        itr = mNodes.emplace(attrID, node).first;
+    }
+    itr->second.dirty = true;
+
+    // a module activated again (or a charge swapped) replaces its modifier
+    EvilNumber value(src.GetAttribute(srcAttr));
+    for (auto& cur : itr->second.mods)
+        if ((cur.srcID == src.itemID()) and (cur.srcAttr == srcAttr) and (cur.math == math)) {
+            cur.value = value;
+            return;
+        }
+
+    Modifier mod = Modifier();
+        mod.srcID = src.itemID();
+        mod.srcAttr = srcAttr;
+        mod.math = math;
+        mod.value = value;
+    itr->second.mods.push_back(mod);
+
+    Dependent dep = Dependent();
+        dep.srcAttr = srcAttr;
+        dep.targAttr = attrID;
+        dep.targID = mItem.itemID();
+        dep.math = math;
+    src.GetAttributeMap()->mDependents.push_back(dep);
+}
+
+void AttributeMap::RemoveModifier(uint16 attrID, uint32 srcID, uint16 srcAttr, int8 math)
+{
+    std::map<uint16, Node>::iterator itr = mNodes.find(attrID);
+    if (itr == mNodes.end())
+        return;
+
+    std::vector<Modifier>& mods = itr->second.mods;
+    for (auto cur = mods.begin(); cur != mods.end(); ++cur)
+        if ((cur->srcID == srcID) and (cur->srcAttr == srcAttr) and (cur->math == math)) {
+            mods.erase(cur);
+            itr->second.dirty = true;
+            return;
+        }
+}
+
+void AttributeMap::RemoveDependents(uint16 srcAttr, uint16 targAttr, int8 math, std::vector<InventoryItemRef>& into)
+{
+    for (size_t i = 0; i < mDependents.size();) {
+        Dependent& cur = mDependents[i];
+        if ((cur.srcAttr != srcAttr) or (cur.targAttr != targAttr) or (cur.math != math)) {
+            ++i;
+            continue;
+        }
+        // not loaded anymore means its attribs are gone too
+        InventoryItemRef iRef = sItemFactory.GetItemRefFromID(cur.targID, false);
+        if (iRef.get() != nullptr) {
+            iRef->GetAttributeMap()->RemoveModifier(targAttr, mItem.itemID(), srcAttr, math);
+            into.push_back(iRef);
+        }
+        mDependents[i] = mDependents.back();
+        mDependents.pop_back();
+    }
+}
+
+void AttributeMap::SetModifierValue(uint16 attrID, uint32 srcID, uint16 srcAttr, EvilNumber& value)
+{
+    std::map<uint16, Node>::iterator itr = mNodes.find(attrID);
+    if (itr == mNodes.end())
+        return;
+
+    for (auto& cur : itr->second.mods)
+        if ((cur.srcID == srcID) and (cur.srcAttr == srcAttr)) {
+            cur.value = value;
+            itr->second.dirty = true;
+        }
+}
+
+void AttributeMap::UpdateDependents(uint16 srcAttr, EvilNumber& value, bool notify)
+{
+    // copied, as updating a target may come back here
+    std::vector<Dependent> deps;
+    for (auto& cur : mDependents)
+        if (cur.srcAttr == srcAttr)
+            deps.push_back(cur);
+
+    for (auto& cur : deps) {
+        InventoryItemRef iRef = sItemFactory.GetItemRefFromID(cur.targID, false);
+        if (iRef.get() == nullptr)
+            continue;
+        iRef->GetAttributeMap()->SetModifierValue(cur.targAttr, mItem.itemID(), srcAttr, value);
+        iRef->GetAttributeMap()->Update(notify);
+    }
+}
+
+void AttributeMap::Update(bool notify/*true*/)
+{
+    // setting a value may update other items, and through them, us
+    std::vector<uint16> dirty;
+    for (auto& cur : mNodes)
+        if (cur.second.dirty)
+            dirty.push_back(cur.first);
+
+    for (auto attrID : dirty) {
+        std::map<uint16, Node>::iterator itr = mNodes.find(attrID);
+        if ((itr == mNodes.end()) or !itr->second.dirty)
+            continue;
+        EvilNumber value(Figure(attrID, itr->second));
+        itr->second.dirty = false;
+        if (itr->second.mods.empty())
+            mNodes.erase(itr);
+        SetValue(attrID, value, notify);
+    }
+}
+
+EvilNumber AttributeMap::Figure(uint16 attrID, const Node& node) const
+{
+    EvilNumber value(node.base);
+    if (node.mods.empty())
+        return value;
+
+    // in math order, the same as FxProc::ApplyEffects() goes thru an item's modifiers
+    std::vector<const Modifier*> mods;
+    mods.reserve(node.mods.size());
+    for (auto& cur : node.mods)
+        mods.push_back(&cur);
+    std::stable_sort(mods.begin(), mods.end(), [](const Modifier* a, const Modifier* b) { return a->math < b->math; });
+
+    const bool penalize = (sConfig.testing.StackingPenalty and !sDataMgr.IsStackable(attrID));
+    std::vector<double> up, down;
+    for (size_t i = 0; i < mods.size();) {
+        const int8 math = mods[i]->math;
+        size_t end = i;
+        while ((end < mods.size()) and (mods[end]->math == math))
+            ++end;
+
+        double factor(0.0);
+        if (penalize and GetFactor(math, mods[i]->value, factor)) {
+            // each group of multipliers by itself; strongest first, each weaker one counting less
+            up.clear();
+            down.clear();
+            for (size_t j = i; j < end; ++j) {
+                GetFactor(math, mods[j]->value, factor);
+                if (factor > 1.0) {
+                    up.push_back(factor);
+                } else if (factor < 1.0) {
+                    down.push_back(factor);
+                }
+            }
+            std::sort(up.begin(), up.end(), std::greater<double>());
+            std::sort(down.begin(), down.end());
+            if (value == EvilZero)
+                value = EvilOne;
+            for (size_t j = 0; j < up.size(); ++j)
+                value = value * (1.0 + (up[j] - 1.0) * GetStackingPenalty(j));
+            for (size_t j = 0; j < down.size(); ++j)
+                value = value * (1.0 + (down[j] - 1.0) * GetStackingPenalty(j));
+        } else {
+            for (size_t j = i; j < end; ++j) {
+                switch (math) {
+                    case FX::Math::PreMul:
+                    case FX::Math::PostMul:
+                    case FX::Math::PreDiv:
+                    case FX::Math::PostDiv: {
+                        if (value == EvilZero)
+                            value = EvilOne;
+                    } break;
+                }
+                value = sFxProc.CalculateAttributeValue(value, mods[j]->value, math);
+            }
+        }
+        i = end;
+    }
+
+    return value;
+}
+
 // [eventName,] ownerID, itemID, attributeID, time, newValue, oldValue = change (unless attrib = quantity)
 bool AttributeMap::Change(uint16 attrID, EvilNumber& old_val, EvilNumber& new_val) {
     // check for internal skill time data
@@ -494,74 +787,20 @@ void AttributeMap::SaveShipState()
     Inserts << "REPLACE INTO entity_attributes ";
     Inserts << " (itemID, attributeID, valueInt, valueFloat) VALUES";
     bool save(false);
-    AttrMap::iterator itr = mAttributes.find(AttrShieldCharge);
-    if (itr != mAttributes.end()) {
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << itr->first << ", ";
-        if ( itr->second.get_type() == evil_number_int ) {
-            Inserts << itr->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << itr->second.get_double() << ")";
-        }
-    }
-    itr = mAttributes.find(AttrArmorDamage);
-    if (itr != mAttributes.end()) {
-        if (save)
-            Inserts << ",";
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << itr->first << ", ";
-        if ( itr->second.get_type() == evil_number_int ) {
-            Inserts << itr->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << itr->second.get_double() << ")";
-        }
-    }
-    itr = mAttributes.find(AttrDamage);
-    if (itr != mAttributes.end()) {
-        if (save)
-            Inserts << ",";
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << itr->first << ", ";
-        if ( itr->second.get_type() == evil_number_int ) {
-            Inserts << itr->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << itr->second.get_double() << ")";
-        }
-    }
-    itr = mAttributes.find(AttrHeatHi);
-    if (itr != mAttributes.end()) {
-        if (save)
-            Inserts << ",";
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << itr->first << ", ";
-        if ( itr->second.get_type() == evil_number_int ) {
-            Inserts << itr->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << itr->second.get_double() << ")";
-        }
-    }
-    itr = mAttributes.find(AttrHeatMed);
-    if (itr != mAttributes.end()) {
-        if (save)
-            Inserts << ",";
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << itr->first << ", ";
-        if ( itr->second.get_type() == evil_number_int ) {
-            Inserts << itr->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << itr->second.get_double() << ")";
-        }
-    }
-    itr = mAttributes.find(AttrHeatLow);
-    if (itr != mAttributes.end()) {
+    static const uint16 attribs[] = { AttrShieldCharge, AttrArmorDamage, AttrDamage, AttrHeatHi, AttrHeatMed, AttrHeatLow };
+    for (auto attrID : attribs) {
+        const EvilNumber* pValue = mAttributes.Find(attrID);
+        if (pValue == nullptr)
+            continue;
         if (save)
             Inserts << ",";
         save = true;
-        Inserts << "(" << mItem.itemID() << ", " << itr->first << ", ";
-        if ( itr->second.get_type() == evil_number_int ) {
-            Inserts << itr->second.get_int() << ", NULL)";
+        EvilNumber value(*pValue);
+        Inserts << "(" << mItem.itemID() << ", " << attrID << ", ";
+        if ( value.get_type() == evil_number_int ) {
+            Inserts << value.get_int() << ", NULL)";
         } else {
-            Inserts << " NULL, " << itr->second.get_double() << ")";
+            Inserts << " NULL, " << value.get_double() << ")";
         }
     }
 
@@ -575,14 +814,15 @@ void AttributeMap::SaveShipState()
 
 // Delete() only called from InventoryItem::Delete()
 void AttributeMap::Delete() {
-    mAttributes.clear();
+    mAttributes.Clear();
+    mDirty.clear();
 }
 
 void AttributeMap::DeleteAttribute(uint16 attrID) {
     _log(ATTRIBUTE__DELETE, "Delete Attribute %u for %s(%u)", attrID, mItem.name(), mItem.itemID());
-    AttrMapItr itr = mAttributes.find(attrID);
-    if (itr != mAttributes.end()) {
-        mAttributes.erase(itr);
+    if (mAttributes.Erase(attrID)) {
+        mDirty.erase(attrID);
+        mNodes.erase(attrID);
         // if it's not in the map, it's not in db, either...
         DBerror err;
         if (IsCharacterID(mItem.itemID())) {
@@ -599,10 +839,10 @@ void AttributeMap::DeleteAttribute(uint16 attrID) {
     }
 }
 
-AttrMapItr AttributeMap::begin() {
+AttrMapItr AttributeMap::begin() const {
     return mAttributes.begin();
 }
 
-AttrMapItr AttributeMap::end() {
+AttrMapItr AttributeMap::end() const {
     return mAttributes.end();
 }
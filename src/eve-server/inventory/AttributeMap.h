@@ -29,12 +29,12 @@
 
 #include "./eve-common.h"
 
+#include "utils/AttrTable.h"
+
 #include "inventory/InventoryDB.h"
 #include "inventory/InventoryItem.h"
 
-typedef std::map<uint16, EvilNumber>    AttrMap;
-typedef AttrMap::iterator               AttrMapItr;
-typedef AttrMap::const_iterator         AttrMapConstItr;
+typedef AttrTable::const_iterator       AttrMapItr;
 
 class PyTuple;
 
@@ -63,23 +63,43 @@ public:
     /* only save the ship damage and heat. other attribs are calculated when ship activated */
     void SaveShipState();
     bool SaveAttributes();
+    /* appends changed attribs that are kept in db to 'into' and marks them saved.
+     * character ability attribs are always returned as a full set, as Save() replaces them. */
+    void GetSaveData(std::vector<Inv::AttrData>& into);
+    bool IsDirty() const                                { return !mDirty.empty(); }
 
     void ResetAttribute(uint16 attrID, bool notify=false);
     void CopyAttributes(std::map<uint16, EvilNumber>& attrMap);
 
+    /* kept modifiers.
+     * modifiers of active modules (and what they target) are kept per attribute instead of
+     * being folded into the value and unfolded again with inverse math.  the attribute
+     * keeps its value without them as base, and is refigured from base and its modifiers
+     * when one of them (or the source attribute feeding one) changes.
+     * SetAttribute() on such an attribute sets its base.
+     */
+    /* adds (or updates) the modifier of 'src' attrib 'srcAttr' on our attrib 'attrID' */
+    void AddModifier(uint16 attrID, int8 math, InventoryItem& src, uint16 srcAttr);
+    /* removes the modifiers our attrib 'srcAttr' put on other items' 'targAttr', adding the items changed to 'into' */
+    void RemoveDependents(uint16 srcAttr, uint16 targAttr, int8 math, std::vector<InventoryItemRef>& into);
+    /* refigures attribs whose modifiers changed since last call */
+    void Update(bool notify=true);
+    /* @return value of 'attrID' without kept modifiers */
+    EvilNumber GetBaseAttribute(const uint16 attrID) const;
+
     /**
      * @brief return the begin iterator of the AttributeMap
      * @return the begin iterator of the AttributeMap
      * @note this way to solve the attribute system problems are quite hacky... but atm its needed
      */
-    AttrMapItr begin();
+    AttrMapItr begin() const;
 
     /**
      * @brief return the end iterator of the AttributeMap
      * @return the end iterator of the AttributeMap
      * @note this way to solve the attribute system problems are quite hacky... but atm its needed
      */
-    AttrMapItr end();
+    AttrMapItr end() const;
 
 protected:
     /**
@@ -114,13 +134,49 @@ protected:
      */
     bool SendChanges(PyTuple* attrChange);
 
+    /* true for attribs Save() writes to db for this item */
+    bool IsSavedAttribute(uint16 attrID) const;
+    /* queues item in ItemFactory's write-behind if attrID is saved */
+    void MarkDirty(uint16 attrID);
+
     InventoryItem& mItem;
 
-    AttrMap mAttributes;
+    AttrTable mAttributes;          // over our type's attribs; only what differs is held here
 
 private:
+    struct Modifier {
+        uint32 srcID;
+        uint16 srcAttr;
+        int8 math;
+        EvilNumber value;           // srcAttr of srcID, updated when that changes
+    };
+    struct Node {
+        bool dirty;
+        EvilNumber base;
+        std::vector<Modifier> mods;
+    };
+    /* an attrib of ours feeding 'targAttr' of item 'targID' */
+    struct Dependent {
+        uint16 srcAttr;
+        uint16 targAttr;
+        uint32 targID;
+        int8 math;
+    };
+
+    void SetValue(uint16 attrID, EvilNumber& num, bool notify);
+    void SetModifierValue(uint16 attrID, uint32 srcID, uint16 srcAttr, EvilNumber& value);
+    void RemoveModifier(uint16 attrID, uint32 srcID, uint16 srcAttr, int8 math);
+    /* pushes the new value of our 'srcAttr' to the attribs it feeds */
+    void UpdateDependents(uint16 srcAttr, EvilNumber& value, bool notify);
+    EvilNumber Figure(uint16 attrID, const Node& node) const;
+
     InventoryDB m_db;
 
+    bool mLoading;                  // values come from type/db; dont mark them
+    std::set<uint16> mDirty;        // saved attribs changed since last save
+    std::map<uint16, Node> mNodes;  // attribs with kept modifiers
+    std::vector<Dependent> mDependents;
+
 };
 
 #endif /* __EVE_ATTRIBUTE_MGR__H__INCL__ */
@@ -82,18 +82,14 @@ void Inventory::Unload()
                     continue;
                 }
 
-                Inv::SaveData data = Inv::SaveData();
-                    data.itemID = itr->first;
-                    data.contraband = itr->second->contraband();
-                    data.flag = itr->second->flag();
-                    data.locationID = itr->second->locationID();
-                    data.ownerID = itr->second->ownerID();
-                    data.position = itr->second->position();
-                    data.quantity = itr->second->quantity();
-                    data.singleton = itr->second->isSingleton();
-                    data.typeID = itr->second->typeID();
-                    data.customInfo = itr->second->customInfo();
-                items.push_back(data);
+                // unchanged items are already in db
+                if (itr->second->IsDirty()) {
+                    Inv::SaveData data = Inv::SaveData();
+                    itr->second->GetSaveData(data);
+                    items.push_back(data);
+                    itr->second->ClearDirty();
+                }
+                itr->second->GetAttributeMap()->Save();
             }
             sItemFactory.RemoveItem(itr->first);
             itr = mContents.erase(itr);
@@ -106,8 +102,8 @@ void Inventory::Unload()
     mContentsLoaded = false;
 }
 
-bool Inventory::GetItems(OwnerData od, std::vector< uint32 >& into ) {
-    return m_db.GetItemContents(od, into);
+bool Inventory::GetItems(OwnerData od, std::vector< uint32 >& into, std::map<uint32, ItemPreload>& preload) {
+    return m_db.GetItemContents(od, into, preload);
 }
 
 bool Inventory::LoadContents() {
@@ -140,6 +136,7 @@ bool Inventory::LoadContents() {
         od.locID = m_myID;
 
     std::vector<uint32> items;
+    std::map<uint32, ItemPreload> preload;
     if (pClient != nullptr) {
         if (pClient->IsValidSession())
             od.corpID = pClient->GetCorporationID();
@@ -150,7 +147,7 @@ bool Inventory::LoadContents() {
                 /* this will load all non-NPC corp items in this station */
                 od.ownerID = od.corpID;
                 _log(INV__TRACE, "Inventory::LoadContents()::IsPlayerCorp() - Loading inventory %u(%p) with owner %u", m_myID, this , od.ownerID);
-                GetItems(od, items);
+                GetItems(od, items, preload);
             }
         } else if (IsOfficeID(m_myID)) {
             if (IsPlayerCorp(od.corpID)) {
@@ -158,7 +155,7 @@ bool Inventory::LoadContents() {
                 od.ownerID = od.corpID;
                 _log(INV__TRACE, "Inventory::LoadContents() - Loading office inventory %u(%p) for corp %u in station %s",\
                             m_myID, this , od.ownerID, (pClient->IsValidSession() ? itoa(pClient->GetStationID()) : "(invalid)"));
-                GetItems(od, items);
+                GetItems(od, items, preload);
             } else {
                 // make error for loading office and NOT a PC corp
                 _log(INV__WARNING, "Inventory::LoadContents() - inventory of officeID %u using corpID %u. Continuing...", m_myID, od.corpID);
@@ -172,13 +169,18 @@ bool Inventory::LoadContents() {
     }
 
     _log(INV__TRACE, "Inventory::LoadContents() - Loading inventory of %s(%u) with owner %u", m_self->name(), m_myID, od.ownerID);
-    if (!GetItems(od, items)) {
+    if (!GetItems(od, items, preload)) {
         _log(INV__ERROR, "Inventory::LoadContents() - Failed to get inventory items for %s(%u)", m_self->name(), m_myID);
         if ((pClient != nullptr) and sDataMgr.IsStation(m_myID))
             pClient->RemoveStationHangar(m_myID);
         return false;
     }
 
+    // items load from the rows read above, not one query each.  popped however we leave
+    struct PreloadScope {
+        PreloadScope(std::map<uint32, ItemPreload>& rows)   { sItemFactory.PushPreload(&rows); }
+        ~PreloadScope()                                     { sItemFactory.PopPreload(); }
+    } scope(preload);
     for (auto cur : items) {
         if ((cur == od.ownerID) or (cur == od.locID) or (cur == m_myID))
             continue;
@@ -192,6 +194,9 @@ bool Inventory::LoadContents() {
         }
     }
 
+    _log(INV__TRACE, "Inventory::LoadContents() - Loaded %lu items (%lu preloaded) of %s(%u) in %.3fms", \
+            items.size(), preload.size(), m_self->name(), m_myID, (GetTimeUSeconds() - profileStartTime) / 1000.0);
+
     if (sConfig.debug.UseProfiling)
         sProfiler.AddTime(Profile::itemload, GetTimeUSeconds() - profileStartTime);
 
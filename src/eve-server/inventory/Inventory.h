@@ -98,7 +98,8 @@ public:
     void GetCargoList(std::multimap<uint8, InventoryItemRef> &cargoMap);     // returns map of cargoFlag:iRef from mContents
 
 protected:
-    bool GetItems(OwnerData od, std::vector< uint32 >& into);
+    /* also reads the entity rows and attribs of what it finds into 'preload' */
+    bool GetItems(OwnerData od, std::vector< uint32 >& into, std::map<uint32, ItemPreload>& preload);
     void List(CRowSet* into, EVEItemFlags flag, uint32 ownerID=0) const;
 
     InventoryDB m_db;
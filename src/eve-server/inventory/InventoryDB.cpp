@@ -29,15 +29,15 @@
 #include "eve-server.h"
 
 #include "Client.h"
+#include "inventory/ItemDB.h"
 
 
 /* this is only called by Inventory::LoadContents()
  * it is optimized for specific calling objects, to avoid multiple db hits while loading,
  * and to load only things needed for this object at the time of the call.
  */
-bool InventoryDB::GetItemContents(OwnerData &od, std::vector<uint32> &into) {
-    std::stringstream query;
-    query << "SELECT itemID FROM entity WHERE locationID = ";
+void InventoryDB::GetContentsWhere(OwnerData &od, std::stringstream &query) {
+    query << " WHERE locationID = ";
     query << od.locID;
 
     if (sDataMgr.IsSolarSystem(od.locID)) {
@@ -68,7 +68,12 @@ bool InventoryDB::GetItemContents(OwnerData &od, std::vector<uint32> &into) {
         // may not need this, as location is officeID, but items MAY be owned by players in corp hangar.
         //query << " AND ownerID = " << od.ownerID;
     }
+}
 
+bool InventoryDB::GetItemContents(OwnerData &od, std::vector<uint32> &into) {
+    std::stringstream query;
+    query << "SELECT itemID FROM entity";
+    GetContentsWhere(od, query);
     query << " ORDER BY itemID";
 
     DBQueryResult res;
@@ -85,6 +90,86 @@ bool InventoryDB::GetItemContents(OwnerData &od, std::vector<uint32> &into) {
     return true;
 }
 
+/* loading a hangar used to cost two queries per item (entity row, then attribs).
+ * this reads both for the whole location, for ItemFactory to hand out as the items load.
+ */
+bool InventoryDB::GetItemContents(OwnerData &od, std::vector<uint32> &into, std::map<uint32, ItemPreload> &preload) {
+    std::stringstream where;
+    GetContentsWhere(od, where);
+
+    std::stringstream query;
+    query << "SELECT itemID, itemName, typeID, ownerID, locationID, flag, contraband,";
+    query << " singleton, quantity, x, y, z, customInfo FROM entity";
+    query << where.str() << " ORDER BY itemID";
+
+    DBQueryResult res;
+    if (!sDatabase.RunQuery(res, query.str().c_str())) {
+        codelog(DATABASE__ERROR, "Error in GetItemContents query for locationID %u: %s", od.locID, res.error.c_str());
+        return false;
+    }
+
+    _log(DATABASE__RESULTS, "GetItemContents: '%s' returned %lu items", query.str().c_str(), res.GetRowCount());
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        const uint32 itemID = row.GetUInt(0);
+        into.push_back(itemID);
+        // others are read from their own tables
+        if (!ItemDB::IsEntityItem(itemID))
+            continue;
+
+        ItemData& data = preload[itemID].data;
+        data.name = row.GetText(1);
+        data.typeID = row.GetUInt(2);
+        data.ownerID = (row.IsNull(3) ? 1 : row.GetUInt(3));
+        data.locationID = (row.IsNull(4) ? 0 : row.GetUInt(4));
+        data.flag = (EVEItemFlags)row.GetUInt(5);
+        data.contraband = row.GetInt(6) ? true : false;
+        data.singleton = row.GetInt(7) ? true : false;
+        data.quantity = row.GetUInt(8);
+        data.position.x = row.GetDouble(9);
+        data.position.y = row.GetDouble(10);
+        data.position.z = row.GetDouble(11);
+        data.customInfo = (row.IsNull(12) ? "" : row.GetText(12));
+    }
+
+    if (preload.empty())
+        return true;
+
+    query.str("");
+    query << "SELECT itemID, attributeID, valueInt, valueFloat FROM entity_attributes";
+    query << " WHERE itemID IN (SELECT itemID FROM entity" << where.str() << ")";
+
+    if (!sDatabase.RunQuery(res, query.str().c_str())) {
+        // items still load, each reading its own attribs
+        codelog(DATABASE__ERROR, "Error in GetItemContents attribute query for locationID %u: %s", od.locID, res.error.c_str());
+        preload.clear();
+        return true;
+    }
+
+    std::map<uint32, ItemPreload>::iterator itr = preload.end();
+    EvilNumber value(EvilZero);
+    while (res.GetRow(row)) {
+        const uint32 itemID = row.GetUInt(0);
+        if ((itr == preload.end()) or (itr->first != itemID)) {
+            itr = preload.find(itemID);
+            if (itr == preload.end())
+                continue;
+        }
+        if (row.IsNull(2)) {
+            if (row.IsNull(3)) {
+                value = EvilZero;
+            } else {
+                value = row.GetDouble(3);
+            }
+        } else {
+            value = row.GetInt64(2);
+        }
+        itr->second.attribs.emplace_back((uint16)row.GetUInt(1), value);
+    }
+
+    return true;
+}
+
 /*  not used? */
 bool InventoryDB::GetItemContents(uint32 itemID, EVEItemFlags flag, std::vector<uint32> &into)
 {
@@ -27,6 +27,7 @@
 #define __INVENTORYDB_H_INCL__
 
 #include "ServiceDB.h"
+#include "inventory/ItemType.h"
 //#include "inventory/ItemRef.h"
 
 
@@ -35,10 +36,16 @@ class InventoryDB
 {
 public:
     bool GetItemContents(OwnerData &od, std::vector<uint32> &into);
+    /* as above, also reading entity rows and saved attribs of entity items into 'preload', in two queries */
+    bool GetItemContents(OwnerData &od, std::vector<uint32> &into, std::map<uint32, ItemPreload> &preload);
     bool GetItemContents(uint32 itemID, EVEItemFlags flag, std::vector<uint32> &into);
     bool GetItemContents(uint32 itemID, EVEItemFlags flag, uint32 ownerID, std::vector<uint32> &into);
 
     static void DeleteTrackingCans();
+
+private:
+    /* appends the WHERE clause selecting the contents of od.locID */
+    void GetContentsWhere(OwnerData &od, std::stringstream &query);
 };
 
 #endif
@@ -61,7 +61,8 @@ m_data(_data),
 m_type(_type),
 m_itemID(_itemID),
 m_timestamp(0),  // placeholder for fx timestamp, once implemented
-m_delete(false)
+m_delete(false),
+m_dirty(false)
 {
     // assert for data consistency
     assert(_data.typeID == _type.id());
@@ -82,7 +83,8 @@ m_itemID(oth.m_itemID),
 m_data(oth.m_data),
 m_type(oth.m_type),
 m_timestamp(oth.m_timestamp),
-m_delete(false)
+m_delete(false),
+m_dirty(false)
 {
     sLog.Error("InventoryItem()", "InventoryItem copy c'tor called.");
     EvE::traceStack();
@@ -98,7 +100,8 @@ m_itemID(oth.m_itemID),
 m_data(oth.m_data),
 m_type(oth.m_type),
 m_timestamp(oth.m_timestamp),
-m_delete(false)
+m_delete(false),
+m_dirty(false)
 {
     sLog.Error("InventoryItem()", "InventoryItem move c'tor called.");
     EvE::traceStack();
@@ -759,6 +762,7 @@ void InventoryItem::Move(uint32 new_location/*locTemp*/, EVEItemFlags new_flag/*
     // update data
     m_data.flag = new_flag;
     m_data.locationID = new_location;
+    MarkDirty();
 
     if ((old_location != m_data.locationID) // diff container
     or ((old_location == m_data.locationID) // or same container
@@ -828,6 +832,7 @@ void InventoryItem::Relocate(uint32 locID, EVEItemFlags flag) {
     // update data
     m_data.flag = flag;
     m_data.locationID = locID;
+    MarkDirty();
 
     if ((old_location != m_data.locationID) // diff container
     or ((old_location == m_data.locationID) // or same container
@@ -948,6 +953,7 @@ bool InventoryItem::SetQuantity(int32 qty, bool notify/*false*/, bool deleteOnZe
     }
     int32 old_qty = m_data.quantity;
     m_data.quantity = qty;
+    MarkDirty();
 
     /* this isnt needed.  quantity has hard limit.
     if (m_data.quantity > maxEveItem) {
@@ -991,6 +997,7 @@ bool InventoryItem::SetFlag(EVEItemFlags flag, bool notify/*false*/) {
 
     EVEItemFlags old_flag = m_data.flag;
     m_data.flag = flag;
+    MarkDirty();
 
     ItemDB::UpdateLocation(m_itemID, m_data.locationID, m_data.flag);
 
@@ -1009,6 +1016,7 @@ bool InventoryItem::ChangeSingleton(bool singleton, bool notify/*false*/) {
 
     bool old_singleton(m_data.singleton);
     m_data.singleton = singleton;
+    MarkDirty();
 
     //verify quantity is -1 for singletons
     if (m_data.singleton)
@@ -1038,6 +1046,7 @@ void InventoryItem::ChangeOwner(uint32 new_owner, bool notify/*false*/) {
 
     uint32 old_owner = m_data.ownerID;
     m_data.ownerID = new_owner;
+    MarkDirty();
 
     if (sConfig.world.saveOnUpdate)
         SaveItem();
@@ -1108,11 +1117,33 @@ void InventoryItem::SaveItem()
                   );
 
     ItemDB::SaveItem(m_itemID, data);
-    // item attributes are saved in ItemFactory.cpp:96  (save loop on shutdown for loaded items)
-    // make call here for items saved after *some* change
+    m_dirty = false;
+    // changed attributes are saved here and in ItemFactory's write-behind
     pAttributeMap->Save();
 }
 
+void InventoryItem::MarkDirty()
+{
+    if (m_dirty)
+        return;
+    m_dirty = true;
+    sItemFactory.SetDirty(m_itemID);
+}
+
+void InventoryItem::GetSaveData(Inv::SaveData& into) const
+{
+    into.itemID = m_itemID;
+    into.contraband = m_data.contraband;
+    into.flag = m_data.flag;
+    into.locationID = m_data.locationID;
+    into.ownerID = m_data.ownerID;
+    into.position = m_data.position;
+    into.quantity = m_data.quantity;
+    into.singleton = (m_data.singleton != 0);
+    into.typeID = m_type.id();
+    into.customInfo = m_data.customInfo;
+}
+
 void InventoryItem::UpdateLocation() {
     ItemDB::UpdateLocation(m_itemID, m_data.locationID, m_data.flag);
 }
@@ -1295,6 +1326,7 @@ void InventoryItem::SetCustomInfo(const char *ci) {
     } else {
         m_data.customInfo = "";
     }
+    MarkDirty();
 
     if (sConfig.world.saveOnUpdate)
         SaveItem();
@@ -1311,6 +1343,7 @@ void InventoryItem::SetPosition(const GPoint& pos)
     } */
 
     m_data.position = pos;
+    MarkDirty();
     _log(ITEM__RELOCATE, "%s(%u) Relocating to %.2f, %.2f, %.2f.", m_data.name.c_str(), \
             m_itemID, m_data.position.x, m_data.position.y, m_data.position.z);
 }
@@ -1482,17 +1515,10 @@ void InventoryItem::AddModifier(fxData &data)
 
 void InventoryItem::RemoveModifier(fxData &data)
 {
-    switch (data.math) {
-        case FX::Math::PreMul:         data.math = FX::Math::PreDiv;          break;
-        case FX::Math::PreDiv:         data.math = FX::Math::PreMul;          break;
-        case FX::Math::ModAdd:         data.math = FX::Math::ModSub;          break;
-        case FX::Math::ModSub:         data.math = FX::Math::ModAdd;          break;
-        case FX::Math::PostMul:        data.math = FX::Math::PostDiv;         break;
-        case FX::Math::PostDiv:        data.math = FX::Math::PostMul;         break;
-        case FX::Math::PostPercent:    data.math = FX::Math::RevPostPercent;  break;
-        case FX::Math::PreAssignment:  data.math = FX::Math::PostAssignment;  break;
-        case FX::Math::PostAssignment: data.math = FX::Math::PreAssignment;   break;
-    }
+    // kept modifiers are removed by what they are, not undone
+    data.remove = true;
+    if (!data.tracked)
+        data.math = sFxProc.GetInverseMath(data.math);
 
     ModifierContainer* modifierContainer = static_cast<ModifierContainer*>(m_modifierContainer);
     modifierContainer->modifiers.emplace(data.math, data);
@@ -135,12 +135,19 @@ public:
     // sets new flag, if different, saves update to db, and (optionally) notifies client of change
     bool                    SetFlag(EVEItemFlags flag, bool notify=false);
     // sets owner for player-owned npc types (drone, missile, etc)
-    void                    SetOwner(uint32 ownerID)    { m_data.ownerID = ownerID; }
+    void                    SetOwner(uint32 ownerID)    { m_data.ownerID = ownerID; MarkDirty(); }
 
     /* public-access data functions handled in base class. */
     void                    SaveItem();  //save the item to the DB.
     void                    UpdateLocation();   // save item's location, owner, flag
-    void                   UpdateLocation(uint32 locID) { m_data.locationID = locID; }  // change item's locationID without saving
+    void                   UpdateLocation(uint32 locID) { m_data.locationID = locID; MarkDirty(); }  // change item's locationID without saving now.  write-behind saves it
+
+    /* write-behind.  changed items are queued in ItemFactory and saved on its timer, or by SaveItem() */
+    bool                    IsDirty() const             { return m_dirty; }
+    void                    ClearDirty()                { m_dirty = false; }
+    void                    MarkDirty();
+    // fills 'into' with this item's entity row
+    void                    GetSaveData(Inv::SaveData& into) const;
 
     /* virtual functions default to base class and overridden as needed */
     virtual void            Delete();  //totally removes item from game and deletes from the DB.
@@ -241,10 +248,14 @@ protected:
     template<class _Ty>
     static RefPtr<_Ty> _Load( uint32 itemID)
     {
-        // pull the specific item info from db
+        // pull the specific item info from db, unless its container read it already
         ItemData data;
-        if (!ItemDB::GetItemData(itemID, data))
+        ItemPreload* pPreload = sItemFactory.GetPreload(itemID);
+        if (pPreload != nullptr) {
+            data = pPreload->data;
+        } else if (!ItemDB::GetItemData(itemID, data)) {
             return RefPtr<_Ty>(nullptr);
+        }
 
         // obtain type
         const ItemType *type = sItemFactory.GetType( data.typeID );
@@ -281,6 +292,7 @@ protected:
 
 private:
     bool m_delete;
+    bool m_dirty;       // entity row differs from db
     ItemData m_data;
     ItemType m_type;
 
@@ -323,6 +335,7 @@ public:
     void DeleteAttribute(uint16 attrID)                                { pAttributeMap->DeleteAttribute(attrID); }
 
     EvilNumber GetAttribute(const uint16 attrID) const                 { return pAttributeMap->GetAttribute(attrID); }
+    EvilNumber GetBaseAttribute(const uint16 attrID) const             { return pAttributeMap->GetBaseAttribute(attrID); }
     EvilNumber GetDefaultAttribute(const uint16 attrID) const          { return m_type.GetAttribute(attrID); }
 
 protected:
@@ -31,133 +31,144 @@
 #include "inventory/ItemType.h"
 
 
+bool ItemDB::IsEntityItem(uint32 itemID) {
+    // keep in step with GetItemData()
+    if (IsRegionID(itemID) or IsConstellationID(itemID) or sDataMgr.IsSolarSystem(itemID))
+        return false;
+    if (IsStargateID(itemID) or sDataMgr.IsStation(itemID) or IsCelestialID(itemID))
+        return false;
+    if (IsAsteroidID(itemID) or IsCharacterID(itemID) or IsOfficeID(itemID))
+        return false;
+    return true;
+}
+
 bool ItemDB::GetItemData(uint32 itemID, ItemData &into) {
-    DBQueryResult res;
+    DBPreparedResult res;
 
     // For ranges of itemIDs we use specialized tables:
     if (IsRegionID(itemID)) {
         //region
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  regionName, 3 AS typeID, factionID, 1 AS locationID, 0 AS flag, 0 AS contraband,"
             "  1 AS singleton, 1 AS quantity, x, y, z, '' AS customInfo"
             " FROM mapRegions"
-            " WHERE regionID=%u", itemID))
+            " WHERE regionID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for region %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else if (IsConstellationID(itemID)) {
         //contellation
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  constellationName, 4 AS typeID, factionID, regionID, 0 AS flag, 0 AS contraband,"
             "  1 AS singleton, 1 AS quantity, x, y, z, '' AS customInfo"
             " FROM mapConstellations"
-            " WHERE constellationID=%u", itemID))
+            " WHERE constellationID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for contellation %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else if (sDataMgr.IsSolarSystem(itemID)) {
         //solar system
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  solarSystemName, 5 AS typeID, factionID, constellationID, 0 AS flag, 0 AS contraband,"
             "  1 AS singleton, 1 AS quantity, x, y, z, '' AS customInfo"
             " FROM mapSolarSystems"
-            " WHERE solarSystemID=%u", itemID))
+            " WHERE solarSystemID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for solar system %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else if (IsStargateID(itemID)) {
         //use mapDenormalize LEFT-JOIN-ing mapSolarSystems to get factionID
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  itemName, typeID, factionID, solarSystemID, 0 AS flag, 0 AS contraband,"
             "  1 AS singleton, 1 AS quantity, mapDenormalize.x, mapDenormalize.y, mapDenormalize.z, '' AS customInfo"
             " FROM mapDenormalize"
             " LEFT JOIN mapSolarSystems USING (solarSystemID)"
-            " WHERE itemID=%u", itemID))
+            " WHERE itemID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for stargate %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else if (sDataMgr.IsStation(itemID)) {
         //station
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  stationName, stationTypeID, corporationID, solarSystemID, 0 AS flag, 0 AS contraband,"
             "  1 AS singleton, 1 AS quantity, x, y, z, '' AS customInfo"
             " FROM staStations"
-            " WHERE stationID=%u", itemID))
+            " WHERE stationID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for station %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else if (IsCelestialID(itemID)) {
         //use mapDenormalize
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  itemName, typeID, 1 AS ownerID, solarSystemID, 0 AS flag, 0 AS contraband,"
             "  1 AS singleton, 1 AS quantity, x, y, z, '' AS customInfo"
             " FROM mapDenormalize"
-            " WHERE itemID=%u", itemID))
+            " WHERE itemID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for universe celestial %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else if (IsAsteroidID(itemID)) {
         //use sysAsteroids
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  itemName, typeID, 1 AS ownerID, systemID, 0 AS flag, 0 AS contraband,"
             "  1 AS singleton, quantity, x, y, z, '' AS customInfo"
             " FROM sysAsteroids"
-            " WHERE itemID=%u", itemID))
+            " WHERE itemID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for asteroid %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else if (IsCharacterID(itemID)) {
         //use chrCharacters
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  characterName, typeID, 1 AS ownerID, solarSystemID, flag, 0 AS contraband,"
             "  1 AS singleton, 1 AS quantity, 0 AS x, 0 AS y, 0 AS z, '' AS customInfo"
             " FROM chrCharacters"
-            " WHERE characterID=%u", itemID))
+            " WHERE characterID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for character %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else if (IsOfficeID(itemID)) {
         //use staOffices
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  name, typeID, corporationID, solarSystemID, flag, 0 AS contraband,"
             "  1 AS singleton, 1 AS quantity, 0 AS x, 0 AS y, 0 AS z, '' AS customInfo"
             " FROM staOffices"
-            " WHERE itemID=%u", itemID))
+            " WHERE itemID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for character %u: %s", itemID, res.error.c_str());
             return false;
         }
     } else {
         //fallback to entity
-        if (!sDatabase.RunQuery(res,
+        if (!sDatabase.RunPrepared(res,
             "SELECT"
             "  itemName, typeID, ownerID, locationID, flag, contraband,"
             "  singleton, quantity, x, y, z, customInfo"
-            " FROM entity WHERE itemID=%u", itemID))
+            " FROM entity WHERE itemID=?", itemID))
         {
             codelog(DATABASE__ERROR, "Error in query for item %u: %s", itemID, res.error.c_str());
             return false;
         }
     }
 
-    DBResultRow row;
+    DBPreparedRow row;
     if (!res.GetRow(row)) {
         _log(DATABASE__MESSAGE, "ItemDB::GetItem() - Item %u not found.", itemID);
         return false;
@@ -37,6 +37,8 @@ class ItemDB
 public:
     // get item data based on itemID
     static bool GetItemData(uint32 itemID, ItemData &into);   // called by RefPtr<_Ty> _Load() at InventoryItem.h:245
+    /* true if GetItemData() reads this item from the entity table */
+    static bool IsEntityItem(uint32 itemID);
     static bool DeleteItem(uint32 itemID);
 
     static void UpdateLocation(uint32 itemID, uint32 locationID, EVEItemFlags flag);
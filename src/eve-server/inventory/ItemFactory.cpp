@@ -47,6 +47,11 @@
 
 ItemFactory::ItemFactory()
 :m_pClient(nullptr),
+m_saveTimer(0),
+m_savedRows(0),
+m_passRows(0),
+m_passTime(0.0),
+m_lastSaveTime(0.0),
 m_nextTempID(0),
 m_nextNPCID(0),
 m_nextDroneID(0),
@@ -62,6 +67,9 @@ int ItemFactory::Initialize()
         InventoryDB::DeleteTrackingCans();
 
     m_items.clear();
+    m_dirtyItems.clear();
+    m_saveQueue.clear();
+    m_saveTimer.Start(sConfig.world.saveInterval * 1000);
 
     // Initialize ID Authority variables:
     m_nextTempID = TEMP_ENTITY_ID;
@@ -92,30 +100,82 @@ void ItemFactory::Close()
 void ItemFactory::SaveItems() {
     if (sConfig.debug.DeleteTrackingCans)
         InventoryDB::DeleteTrackingCans();
-    uint32 count(0);
     double startTime = GetTimeMSeconds();
+    for (auto cur : m_dirtyItems)
+        m_saveQueue.push_back(cur);
+    m_dirtyItems.clear();
+    uint32 count(m_saveQueue.size()), rows(0);
+    while (!m_saveQueue.empty())
+        rows += SaveBatch(sConfig.world.saveBatch);
+    m_passRows = 0;
+    m_passTime = 0.0;
+    sLog.Warning("        SaveItems", "Saved %u changed Items (%u rows) in %.3fms.", count, rows, (GetTimeMSeconds() -startTime));
+}
+
+void ItemFactory::Process()
+{
+    if (m_saveQueue.empty()) {
+        if (!m_saveTimer.Check())
+            return;
+        if (m_dirtyItems.empty())
+            return;
+        // start a new pass.  items changed from here on wait for the next one
+        m_saveQueue.assign(m_dirtyItems.begin(), m_dirtyItems.end());
+        m_dirtyItems.clear();
+        m_passRows = 0;
+        m_passTime = 0.0;
+    }
+
+    double startTime = GetTimeMSeconds();
+    m_passRows += SaveBatch(sConfig.world.saveBatch);
+    m_passTime += GetTimeMSeconds() - startTime;
+    if (!m_saveQueue.empty())
+        return;
+
+    m_lastSaveTime = m_passTime;
+    _log(ITEM__SAVE, "ItemFactory::Process() - saved %u rows in %.3fms.  %u items changed since.", \
+            m_passRows, m_passTime, (uint32)m_dirtyItems.size());
+}
+
+void ItemFactory::SetDirty(uint32 itemID)
+{
+    // only player items are saved.  this is a hack for now.  will eventually move to static/dynamic item maps
+    if (!IsPlayerItem(itemID))
+        return;
+    m_dirtyItems.insert(itemID);
+}
+
+uint32 ItemFactory::SaveBatch(uint32 count)
+{
     std::vector<Inv::SaveData> items;
-    items.clear();
-    for (auto cur : m_items) {
-        if (IsPlayerItem(cur.first)) { // this is a hack for now.  will eventually move to static/dynamic item maps
-            cur.second->SaveAttributes();
+    std::vector<Inv::AttrData> attribs;
+    if (count < 1)
+        count = 1;
+    while ((count > 0) and !m_saveQueue.empty()) {
+        std::map<uint32, InventoryItemRef>::iterator itr = m_items.find(m_saveQueue.front());
+        m_saveQueue.pop_front();
+        --count;
+        if (itr == m_items.end())
+            continue;   // removed since it was queued.  deleted or saved by its inventory
+
+        InventoryItemRef iRef = itr->second;
+        if (iRef->IsDirty()) {
             Inv::SaveData data = Inv::SaveData();
-                data.itemID = cur.first;
-                data.contraband = cur.second->contraband();
-                data.flag = cur.second->flag();
-                data.locationID = cur.second->locationID();
-                data.ownerID = cur.second->ownerID();
-                data.position = cur.second->position();
-                data.quantity = cur.second->quantity();
-                data.singleton = cur.second->isSingleton();
-                data.typeID = cur.second->typeID();
-                data.customInfo = cur.second->customInfo();
+            iRef->GetSaveData(data);
             items.push_back(data);
-            ++count;
+            iRef->ClearDirty();
         }
+        // characters are not player items; they save their own attribs
+        iRef->GetAttributeMap()->GetSaveData(attribs);
     }
-    ItemDB::SaveItems(items);
-    sLog.Warning("        SaveItems", "Saved %u Dynamic Items in %.3fms.", count, (GetTimeMSeconds() -startTime));
+
+    if (!items.empty())
+        ItemDB::SaveItems(items);
+    if (!attribs.empty())
+        ItemDB::SaveAttributes(false, attribs);
+    uint32 rows(items.size() + attribs.size());
+    m_savedRows += rows;
+    return rows;
 }
 
 void ItemFactory::AddItem(InventoryItemRef iRef)
@@ -132,6 +192,8 @@ void ItemFactory::AddItem(InventoryItemRef iRef)
 
 void ItemFactory::RemoveItem(uint32 itemID)
 {
+    // caller has saved or deleted it.  a queued save would bring back a deleted row
+    m_dirtyItems.erase(itemID);
     m_items.erase(itemID);
 }
 
@@ -239,6 +301,16 @@ Inventory* ItemFactory::GetItemContainerInventory(uint32 itemID, bool load/*true
     return iRef->GetMyInventory();
 }
 
+ItemPreload* ItemFactory::GetPreload(uint32 itemID)
+{
+    for (auto cur : m_preloads) {
+        std::map<uint32, ItemPreload>::iterator itr = cur->find(itemID);
+        if (itr != cur->end())
+            return &itr->second;
+    }
+    return nullptr;
+}
+
 template<class _Ty>
 const _Ty* ItemFactory::_GetType(uint16 typeID) {
     std::map<uint16, ItemType*>::iterator itr = m_types.find(typeID);
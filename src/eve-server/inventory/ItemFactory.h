@@ -37,6 +37,7 @@ struct OfficeData;
 struct AsteroidData;
 
 class ItemData;
+struct ItemPreload;
 class ItemType;
 class BlueprintType;
 class CharacterType;
@@ -59,13 +60,34 @@ public:
     int Initialize();
     uint32 Count()                                      { return m_items.size(); }
 
+    // saves every changed item now.  called from console and on shutdown
     void SaveItems();
     void RemoveItem(uint32 itemID);
+
+    /* write-behind for item and attribute changes.
+     * changed player items are queued by SetDirty(), and Process() saves them in batches of
+     * <saveBatch> items, one batch per tic, every <saveInterval> seconds. */
+    void Process();
+    void SetDirty(uint32 itemID);
+    // items changed since last save
+    uint32 DirtyCount()                                 { return m_dirtyItems.size() + m_saveQueue.size(); }
+    // rows written by the write-behind since startup
+    uint32 SavedRows()                                  { return m_savedRows; }
+    // time taken by the last complete save pass (ms)
+    double LastSaveTime()                               { return m_lastSaveTime; }
     void SetUsingClient(Client *pClient)                { m_pClient = pClient; }
     void UnsetUsingClient()                             { m_pClient = nullptr; }
     void AddItem(InventoryItemRef iRef);
 
     Client* GetUsingClient()                            { return m_pClient; }
+
+    /* rows read in bulk by Inventory::LoadContents().  loading an item in 'pPreload' uses its
+     * rows instead of querying them.  the caller keeps the map until PopPreload() */
+    void PushPreload(std::map<uint32, ItemPreload>* pPreload)   { m_preloads.push_back(pPreload); }
+    void PopPreload()                                   { m_preloads.pop_back(); }
+    /* @return preloaded rows of 'itemID', nullptr if none */
+    ItemPreload* GetPreload(uint32 itemID);
+
     // load=true will load the item and its container (recursively) into server, up to solarSystem
     Inventory* GetInventoryFromId(uint32 itemID, bool load=true);
     // load=true will load the item and its container (recursively) into server, up to solarSystem
@@ -140,6 +162,7 @@ protected:
     std::map<uint32, InventoryItemRef> m_items;
     std::map<uint32, InventoryItemRef> m_staticItems;
     std::map<uint32, InventoryItemRef> m_dynamicItems;
+    std::vector<std::map<uint32, ItemPreload>*> m_preloads;     // nested while contents load contents
 
     template<class _Ty>
     const _Ty *_GetType(uint16 typeID);
@@ -148,6 +171,17 @@ protected:
     RefPtr<_Ty> _GetItem(uint32 itemID);
 
 private:
+    // saves up to 'count' items from m_saveQueue; returns rows written
+    uint32 SaveBatch(uint32 count);
+
+    Timer m_saveTimer;
+    std::set<uint32> m_dirtyItems;      // changed since last pass started
+    std::deque<uint32> m_saveQueue;     // this pass, saved a batch per tic
+    uint32 m_savedRows;
+    uint32 m_passRows;
+    double m_passTime;
+    double m_lastSaveTime;
+
     // ID Authority:
     // these hold the next valid ID for in-memory only objects
     uint32 m_nextNPCID;
@@ -45,7 +45,6 @@ ItemType::ItemType(uint16 _id, const Inv::TypeData& _data)
     assert(m_type.id == _id);
     sDataMgr.GetGroup(_data.groupID, m_group);
     assert(_data.groupID == m_group.id);
-    m_AttributeMap.clear();
 
     _log(ITEM__TRACE, "Created ItemType object %p for type %s (%u).", this, name().c_str(), id());
 }
@@ -114,22 +113,23 @@ _Ty* ItemType::_LoadType(uint16 typeID, const Inv::TypeData& data) {
 bool ItemType::_Load()
 {
     // load type attribs
-    std::vector< DmgTypeAttribute > typeAttrVec;
-    sDataMgr.GetDgmTypeAttrVec(m_type.id, typeAttrVec);
-    for (auto cur : typeAttrVec)
-        m_AttributeMap.insert(std::pair<uint16, EvilNumber>(cur.attributeID, cur.value));
+    for (auto& cur : sDataMgr.GetDgmTypeAttrs(m_type.id))
+        if (!m_AttributeMap.Has(cur.attributeID))
+            m_AttributeMap.Set(cur.attributeID, cur.value);
 
     // load attributes that are needed but NOT in default DgmTypeAttributes set (but found in invTypes)
-    if (m_type.mass)
-        m_AttributeMap.insert(std::pair<uint16, EvilNumber>(AttrMass, m_type.mass));
-    if (m_type.radius)
-        m_AttributeMap.insert(std::pair<uint16, EvilNumber>(AttrRadius, m_type.radius));
-    if (m_type.volume)
-        m_AttributeMap.insert(std::pair<uint16, EvilNumber>(AttrVolume, m_type.volume));
-    if (m_type.capacity)
-        m_AttributeMap.insert(std::pair<uint16, EvilNumber>(AttrCapacity, m_type.capacity));
-    if (m_type.race)
-        m_AttributeMap.insert(std::pair<uint16, EvilNumber>(AttrRaceID, m_type.race));
+    if (m_type.mass and !m_AttributeMap.Has(AttrMass))
+        m_AttributeMap.Set(AttrMass, m_type.mass);
+    if (m_type.radius and !m_AttributeMap.Has(AttrRadius))
+        m_AttributeMap.Set(AttrRadius, m_type.radius);
+    if (m_type.volume and !m_AttributeMap.Has(AttrVolume))
+        m_AttributeMap.Set(AttrVolume, m_type.volume);
+    if (m_type.capacity and !m_AttributeMap.Has(AttrCapacity))
+        m_AttributeMap.Set(AttrCapacity, m_type.capacity);
+    if (m_type.race and !m_AttributeMap.Has(AttrRaceID))
+        m_AttributeMap.Set(AttrRaceID, m_type.race);
+    // every item of this type looks up its defaults here
+    m_AttributeMap.Compact();
 
     // load required skills and levels into their own map, for later checks
     if (HasAttribute(AttrRequiredSkill1))
@@ -150,26 +150,16 @@ bool ItemType::_Load()
     return true;
 }
 
-const void ItemType::CopyAttributes(InventoryItem& itemRef) const
-{
-    // set attributes in the item's own attrMap.
-    for (auto cur : m_AttributeMap)
-        itemRef.SetAttribute(cur.first, cur.second, false);
-}
-
 const bool ItemType::HasAttribute(const uint16 attributeID) const
 {
-    AttrMapConstItr itr = m_AttributeMap.find(attributeID);
-    if (itr != m_AttributeMap.end())
-        return true;
-    return false;
+    return m_AttributeMap.Has(attributeID);
 }
 
 EvilNumber ItemType::GetAttribute(const uint16 attributeID) const
 {
-    AttrMapConstItr itr = m_AttributeMap.find(attributeID);
-    if (itr != m_AttributeMap.end())
-        return itr->second;
+    const EvilNumber* pValue = m_AttributeMap.Find(attributeID);
+    if (pValue != nullptr)
+        return *pValue;
     return 0;
 }
 
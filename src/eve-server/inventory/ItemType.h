@@ -31,6 +31,7 @@
 
 #include "StaticDataMgr.h"
 #include "effects/EffectsData.h"
+#include "utils/AttrTable.h"
 //#include "inventory/AttributeMap.h"
 //#include "inventory/ItemFactory.h"
 
@@ -88,7 +89,8 @@ public:
     /* new attribute system */
     const bool HasAttribute(const uint16 attributeID) const;
     EvilNumber GetAttribute(const uint16 attributeID) const;
-    const void CopyAttributes(InventoryItem& itemRef) const;
+    /* type's default attribs; items' AttributeMaps sit over these */
+    const AttrTable& GetAttributes() const              { return m_AttributeMap; }
 
     bool HasReqSkill(const uint16 skillID) const;
 
@@ -161,7 +163,7 @@ private:
     uint16 m_defaultFxID;                 // default effectID
 
     std::map<uint16, uint8> m_reqSkillMap;              // k,v map of required skill, level for this ItemType, if any.
-    std::map<uint16, EvilNumber> m_AttributeMap;        // k,v map of attributeID, value
+    AttrTable m_AttributeMap;                           // attributeID, value
 
 };
 
@@ -196,6 +198,14 @@ public:
     std::string     customInfo;
 };
 
+/*
+ * An item's entity row and saved attributes, read in bulk with the rest of its location's contents.
+ */
+struct ItemPreload {
+    ItemData data;
+    std::vector<std::pair<uint16, EvilNumber>> attribs;
+};
+
 #endif /* __ITEM_TYPE__H__INCL__ */
 
 
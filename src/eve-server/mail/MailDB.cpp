@@ -56,7 +56,7 @@ PyRep* MailDB::GetNewMail(int charId)
     return DBResultToCRowset(res);
 }
 
-int MailDB::SendMail(int sender, std::vector<int>& toCharacterIDs, int toListID, int toCorpOrAllianceID, const std::string& title, const std::string& body, int isReplyTo, int isForwardedFrom)
+int MailDB::SendMail(int sender, std::vector<int>& toCharacterIDs, int toListID, int toCorpOrAllianceID, const std::string& title, const std::string& body, int isReplyTo, int isForwardedFrom, const DeliveredCallback& onDelivered)
 {
     // build a string with ',' seperated char ids
     std::string toStr;
@@ -103,49 +103,76 @@ int MailDB::SendMail(int sender, std::vector<int>& toCharacterIDs, int toListID,
                                bodyEscaped.c_str(), Win32TimeNow()))
     {
         codelog(DATABASE__ERROR, " Failed to insert mailMessage" );
-        // TODO: Why returning false always?
-    }
-
-    if (toCharacterIDs.size() > 0) {
-        for (int i = 0; i < toCharacterIDs.size(); i++) {
-            uint32 id = toCharacterIDs[i];
-            if (!sDatabase.RunQuery(err,
-                                    " INSERT INTO mailStatus "
-                                    " (messageID, characterID, statusMask, labelMask)"
-                                    " VALUES (%u, %u, %u, %u)" , messageID, id, 0, mailLabelInbox))
-            {
-                codelog(DATABASE__ERROR, " Failed to insert mailStatus for character ids" );
-                return 0;
+        return 0;
+    }
+
+    std::vector<uint32> recipients(toCharacterIDs.begin(), toCharacterIDs.end());
+
+    // list, corp and alliance members are looked up on the pool, then delivered to with the others
+    std::string members;
+    if (toListID > 0)
+        members += " SELECT characterID FROM mailListUsers WHERE listID = " + std::to_string(toListID);
+    if (IsCorp(toCorpOrAllianceID)) {
+        if (!members.empty())
+            members += " UNION ";
+        members += " SELECT characterID FROM chrCharacters WHERE corporationID = " + std::to_string(toCorpOrAllianceID);
+    } else if (IsAlliance(toCorpOrAllianceID)) {
+        if (!members.empty())
+            members += " UNION ";
+        members += " SELECT c.characterID FROM chrCharacters AS c"
+                   "  JOIN crpCorporation AS co USING (corporationID)"
+                   "  WHERE co.allianceID = " + std::to_string(toCorpOrAllianceID);
+    }
+
+    if (members.empty()) {
+        DeliverMail(messageID, recipients, onDelivered);
+        return messageID;
+    }
+
+    sDatabase.RunQueryAsync(
+        [messageID, recipients, onDelivered](DBQueryResult& res) mutable {
+            if (res.error.GetErrNo() != 0) {
+                codelog(DATABASE__ERROR, " Failed to get members for mail %u", messageID);
+            } else {
+                DBResultRow row;
+                while (res.GetRow(row))
+                    recipients.push_back(row.GetUInt(0));
             }
-        }
-    }
+            DeliverMail(messageID, recipients, onDelivered);
+        },
+        "%s", members.c_str());
 
-    if (toListID > 0) {
-        DBQueryResult res;
-        if (!sDatabase.RunQuery(res,
-                                " SELECT characterID FROM mailListUsers "
-                                " WHERE listID = %u" , toListID))
-        {
-            codelog(DATABASE__ERROR, " Failed to get mailing list members" );
-            return 0;
-        }
-        DBResultRow row;
-        while (res.GetRow(row))
-        {
-            uint32 id = row.GetInt(0);
-            if (!sDatabase.RunQuery(err,
-                                    " INSERT INTO mailStatus "
-                                    " (messageID, characterID, statusMask, labelMask)"
-                                    " VALUES (%u, %u, %u, %u)" , messageID, id, 0, mailLabelInbox))
-            {
-                codelog(DATABASE__ERROR, " Failed to insert mailStatus for character ids" );
-                return 0;
-            }
+    return messageID;
+}
+
+void MailDB::DeliverMail(uint32 messageID, std::vector<uint32>& recipients, const DeliveredCallback& onDelivered)
+{
+    std::sort(recipients.begin(), recipients.end());
+    recipients.erase(std::unique(recipients.begin(), recipients.end()), recipients.end());
+    recipients.erase(std::remove(recipients.begin(), recipients.end(), 0), recipients.end());
+    if (recipients.empty())
+        return;
+
+    // one multi-row insert per batch, on the write connection in order; the last one reports back
+    std::string query;
+    for (size_t i = 0; i < recipients.size(); ++i) {
+        query += (query.empty() ? " INSERT INTO mailStatus (messageID, characterID, statusMask, labelMask) VALUES " : ", ");
+        query += "(" + std::to_string(messageID) + ", " + std::to_string(recipients[i]) + ", 0, " + std::to_string(mailLabelInbox) + ")";
+
+        if (i + 1 == recipients.size()) {
+            sDatabase.RunWriteAsync(
+                [messageID, recipients, onDelivered](DBQueryResult& res) {
+                    if (res.error.GetErrNo() != 0)
+                        return;     // already logged
+                    if (onDelivered)
+                        onDelivered(messageID, recipients);
+                },
+                "%s", query.c_str());
+        } else if ((i + 1) % MAIL_STATUS_BATCH == 0) {
+            sDatabase.RunQueryAsync("%s", query.c_str());
+            query.clear();
         }
     }
-    // TODO(groove) corp/alliance mails
-
-    return messageID;
 }
 
 PyString* MailDB::GetMailBody(int id) const
@@ -107,12 +107,23 @@ public:
     void RemoveLabelMask(int32 messageID, int mask);
     void RemoveLabelMasks(std::vector<int32> messageIDs, int mask);
 
-    int SendMail(int sender, std::vector<int>& toCharacterIDs, int toListID, int toCorpOrAllianceID, const std::string& title, const std::string& body, int isReplyTo, int isForwardedFrom);
+    // called on the main thread once a mail's status rows are written, with who they were written for
+    typedef std::function<void(uint32 messageID, const std::vector<uint32>& recipients)> DeliveredCallback;
+
+    /* stores the message and returns its id (0 on failure).  status rows are written on the db pool,
+     * after list/corp/alliance members are looked up there, so the mail may not be in inboxes yet on return. */
+    int SendMail(int sender, std::vector<int>& toCharacterIDs, int toListID, int toCorpOrAllianceID, const std::string& title, const std::string& body, int isReplyTo, int isForwardedFrom, const DeliveredCallback& onDelivered = nullptr);
     PyRep* GetNewMail(int charId);
     PyRep* GetMailStatus(int charId);
 
 protected:
     static int BitFromLabelID(int id);
+
+    // sorts and dedupes 'recipients', then writes their status rows in batches
+    static void DeliverMail(uint32 messageID, std::vector<uint32>& recipients, const DeliveredCallback& onDelivered);
+
+    // rows per mailStatus insert
+    static const size_t MAIL_STATUS_BATCH = 1000;
 };
 
 #endif
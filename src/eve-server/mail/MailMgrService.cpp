@@ -26,6 +26,7 @@
 #include "eve-server.h"
 
 
+#include "EntityList.h"
 #include "mail/MailMgrService.h"
 #include "EVE_Mail.h"
 
@@ -79,18 +80,44 @@ PyResult MailMgrService::SendMail(PyCallArgs &call, PyList* toCharacterIDs, std:
     }
 
     int sender = call.client->GetCharacterID();
+    std::string subject = title->content();
+    int64 sentTime = Win32TimeNow();
     return new PyInt(
         m_db.SendMail(
             sender, characters,
             listID.has_value() ? listID.value()->value() : -1,
             toCorpOrAllianceID.has_value() ? toCorpOrAllianceID.value()->value() : -1,
-            title->content(), body->content(),
+            subject, body->content(),
             isReplyTo->value(),
-            isForwardedFrom->value()
+            isForwardedFrom->value(),
+            [sender, subject, sentTime](uint32 messageID, const std::vector<uint32>& recipients) {
+                NotifyMailDelivered(messageID, sender, subject, sentTime, recipients);
+            }
         )
     );
 }
 
+void MailMgrService::NotifyMailDelivered(uint32 messageID, int sender, const std::string& subject, int64 sentTime, const std::vector<uint32>& recipients)
+{
+    // only those online get told; the rest see it in their inbox on login
+    std::set<uint32> online;
+    for (auto cur : recipients)
+        if (sEntityList.IsOnline(cur))
+            online.insert(cur);
+    if (online.empty())
+        return;
+
+    NotifyOnMessage notify;
+    notify.recipients.assign(online.begin(), online.end());
+    notify.messageID = messageID;
+    notify.senderID = sender;
+    notify.subject = subject;
+    notify.sentTime = sentTime;
+
+    PyTuple* answer = notify.Encode();
+    sEntityList.Multicast(online, "OnMessage", "*multicastID", &answer, false);
+}
+
 PyResult MailMgrService::PrimeOwners(PyCallArgs &call, PyList* ownerIDs)
 {
     std::vector<int32> owners;
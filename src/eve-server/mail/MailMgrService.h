@@ -40,6 +40,9 @@ public:
 protected:
     MailDB m_db;
 
+    // sends OnMessage for a delivered mail to those of its recipients who are online
+    static void NotifyMailDelivered(uint32 messageID, int sender, const std::string& subject, int64 sentTime, const std::vector<uint32>& recipients);
+
     PyResult SendMail(PyCallArgs& call, PyList* toCharacterIDs, std::optional<PyInt*> listID, std::optional<PyInt*> toCorpOrAllianceID, PyWString* title, PyWString* body, PyBool* isReplyTo, PyBool* isForwardedFrom);
     PyResult PrimeOwners(PyCallArgs& call, PyList* ownerIDs);
     PyResult SyncMail(PyCallArgs& call, std::optional<PyInt*> first, std::optional<PyInt*> second);
@@ -332,6 +332,35 @@ const GPoint MapData::GetRandPointInSystem(uint32 systemID, int64 distance) {
     return NULL_ORIGIN;
 }
 
+uint16 MapData::GetJumpCount(uint32 fromSystemID, uint32 toSystemID, uint16 maxJumps)
+{
+    if (fromSystemID == toSystemID)
+        return 0;
+
+    // breadth-first over every gate, one ring of systems per jump
+    std::unordered_set<uint32> seen;
+    std::vector<uint32> ring, next;
+    seen.insert(fromSystemID);
+    ring.push_back(fromSystemID);
+    for (uint16 jumps = 1; (jumps <= maxJumps) and !ring.empty(); ++jumps) {
+        next.clear();
+        for (uint32 systemID : ring) {
+            for (std::multimap<uint32, uint32>* pJumps : {&m_systemJumps, &m_constJumps, &m_regionJumps}) {
+                auto itr = pJumps->equal_range(systemID);
+                for (auto it = itr.first; it != itr.second; ++it) {
+                    if (it->second == toSystemID)
+                        return jumps;
+                    if (seen.insert(it->second).second)
+                        next.push_back(it->second);
+                }
+            }
+        }
+        ring.swap(next);
+    }
+
+    return maxJumps + 1;
+}
+
 const GPoint MapData::GetAnomalyPoint(SystemManager* pSys)
 {
     uint8 total = 0;
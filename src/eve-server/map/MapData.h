@@ -51,6 +51,9 @@ public:
     const GPoint        GetRandPointOnPlanet(uint32 systemID);
     const GPoint        GetRandPointInSystem(uint32 systemID, int64 distance);// incomplete
 
+    // shortest gate route between two systems; maxJumps +1 when it is longer than maxJumps
+    uint16              GetJumpCount(uint32 fromSystemID, uint32 toSystemID, uint16 maxJumps);
+
 protected:
     void                Populate();
 
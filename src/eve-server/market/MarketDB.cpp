@@ -103,46 +103,20 @@ PyRep *MarketDB::GetRegionBest(uint32 regionID) {
     return DBResultToIndexRowset(res, "typeID");
 }
 
-PyRep *MarketDB::GetOrders( uint32 regionID, uint16 typeID )
+void MarketDB::GetAllOrders(DBQueryResult& res)
 {
-    // returns a tuple (sell, buy) of PyObjectEx with data in PyPackedRows
-
-    PyTuple* tup = new PyTuple(2);
-    DBQueryResult res;
-    //query sell orders
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        "    price, volRemaining, typeID, orderRange AS `range`, orderID,"
-        "   volEntered, minVolume, bid, issued as issueDate, duration,"
-        "   stationID, regionID, solarSystemID, jumps"
-        " FROM mktOrders "
-        " WHERE regionID=%u AND typeID=%u AND bid=%u", regionID, typeID, Market::Type::Sell))
-    {
-        codelog( MARKET__DB_ERROR, "Error in query: %s", res.error.c_str() );
-        return nullptr;
-    }
-    _log(MARKET__DB_TRACE, "GetOrders() - Fetched %u sell orders for type %u", res.GetRowCount(), typeID);
-    tup->SetItem(0, DBResultToCRowset( res ) );
-
-    //query buy orders
+    // the first 14 columns are the GetOrders() row, in the order the client expects
     if (!sDatabase.RunQuery(res,
         "SELECT"
         "    price, volRemaining, typeID, orderRange AS `range`, orderID,"
         "   volEntered, minVolume, bid, issued as issueDate, duration,"
-        "   stationID, regionID, solarSystemID, jumps"
-        " FROM mktOrders "
-        " WHERE regionID=%u AND typeID=%u AND bid=%u", regionID, typeID, Market::Type::Buy))
+        "   stationID, regionID, solarSystemID, jumps,"
+        "   ownerID, escrow, contraband, isCorp, accountKey, memberID"
+        " FROM mktOrders"
+        " ORDER BY issued, orderID"))
     {
-        codelog( MARKET__DB_ERROR, "Error in query: %s", res.error.c_str() );
-        PyDecRef( tup );
-        return nullptr;
+        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
     }
-    _log(MARKET__DB_TRACE, "GetOrders() - Fetched %u buy orders for type %u", res.GetRowCount(), typeID);
-    tup->SetItem(1, DBResultToCRowset( res ) );
-
-    if (is_log_enabled(MARKET__DUMP))
-        tup->Dump(MARKET__DUMP, "    ");
-    return tup;
 }
 
 PyRep* MarketDB::GetOrdersForOwner(uint32 ownerID)
@@ -166,157 +140,18 @@ PyRep* MarketDB::GetOrdersForOwner(uint32 ownerID)
     return DBResultToRowset(res);
 }
 
-PyRep *MarketDB::GetOrderRow(uint32 orderID) {
-    DBQueryResult res;
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        "   price, volRemaining, typeID, orderRange AS `range`, orderID,"
-        "   volEntered, minVolume, bid, issued as issueDate, duration,"
-        "   stationID, regionID, solarSystemID, jumps"
-        " FROM mktOrders"
-        " WHERE orderID=%u", orderID))
-    {
-        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
-        return nullptr;
-    }
-
-    DBResultRow row;
-    if (!res.GetRow(row)) {
-        codelog(MARKET__ERROR, "Order %u not found.", orderID);
-        return nullptr;
-    }
-
-    return DBRowToPackedRow(row);
-}
-
-//NOTE: needs a lot of work to implement orderRange
-uint32 MarketDB::FindBuyOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price) {
-    DBQueryResult res;
-    if (!sDatabase.RunQuery(res,
-        "SELECT orderID"
-        " FROM mktOrders"
-        " WHERE bid=1"
-        "  AND typeID=%u"
-        "  AND stationID=%u"
-        "  AND volRemaining >= %u"
-        "  AND price > %.2f"
-        " ORDER BY price DESC"
-        " LIMIT 1;",
-        typeID,
-        stationID,
-        quantity,
-        price - 0.1/*, sConfig.market.FindBuyOrder*/))
-    {
-        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
-    }
-
-    DBResultRow row;
-    if (res.GetRow(row))
-        return row.GetUInt(0);
-
-    return 0;    //no order found.
-}
-
-uint32 MarketDB::FindSellOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price)
-{
-    DBQueryResult res;
-    if (!sDatabase.RunQuery(res,
-        "SELECT orderID"
-        " FROM mktOrders"
-        " WHERE bid=0"
-        "  AND typeID=%u"
-        "  AND stationID=%u"
-        "  AND volRemaining >= %u"
-        "  AND price < %.2f"
-        " ORDER BY price ASC"
-        " LIMIT 1;",
-        typeID,
-        stationID,
-        quantity,
-        price + 0.1/*, sConfig.market.FindSellOrder*/))
-    {
-        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
-    }
-
-    DBResultRow row;
-    if (res.GetRow(row))
-        return row.GetUInt(0);
-
-    return 0;
-}
-
-bool MarketDB::GetOrderInfo(uint32 orderID, Market::OrderInfo &oInfo) {
-    //orderID, typeID, ownerID, regionID, stationID, orderRange, bid, price, escrow,
-    // minVolume, volEntered, volRemaining, issued, contraband, duration, jumps, isCorp, accountKey, memberID
-    DBQueryResult res;
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        " volRemaining,"
-        " price,"
-        " typeID,"
-        " stationID,"
-        " regionID,"
-        " ownerID,"
-        " bid,"
-        " isCorp,"
-        " memberID,"
-        " accountKey"
-        " FROM mktOrders"
-        " WHERE orderID=%u",
-        orderID))
-    {
-        _log(MARKET__DB_ERROR, "Error in query: %s.", res.error.c_str());
-        return false;
-    }
-
-    DBResultRow row;
-    if (!res.GetRow(row)) {
-        _log(MARKET__WARNING, "Order %u not found.", orderID);
-        return false;
-    }
-
-    oInfo.quantity   = row.GetUInt(0);
-    oInfo.price      = row.GetFloat(1);
-    oInfo.typeID     = row.GetUInt(2);
-    oInfo.stationID  = row.GetUInt(3);
-    oInfo.regionID   = row.GetUInt(4);
-    oInfo.ownerID    = row.GetUInt(5);
-    oInfo.isBuy      = row.GetBool(6);
-    oInfo.isCorp     = row.GetBool(7);
-    oInfo.memberID   = row.GetUInt(8);
-    oInfo.accountKey = row.GetUInt(9);
-
-    return true;
-}
-
 //NOTE: this logic needs some work if there are multiple concurrent market services running at once.  there wont be.
-bool MarketDB::AlterOrderQuantity(uint32 orderID, uint32 new_qty) {
-    DBerror err;
-    if (!sDatabase.RunQuery(err, "UPDATE mktOrders SET volRemaining = %u WHERE orderID = %u",  new_qty, orderID)) {
-        _log(MARKET__DB_ERROR, "Error in query: %s.", err.c_str());
-        return false;
-    }
-    return true;
+// the order book in MarketMgr is authoritative; nothing reads these back, so run them on the db pool
+void MarketDB::AlterOrderQuantity(uint32 orderID, uint32 new_qty) {
+    sDatabase.RunQueryAsync("UPDATE mktOrders SET volRemaining = %u WHERE orderID = %u",  new_qty, orderID);
 }
 
-bool MarketDB::AlterOrderPrice(uint32 orderID, double new_price) {
-    DBerror err;
-    if (!sDatabase.RunQuery(err, "UPDATE mktOrders SET price = %.2f WHERE orderID = %u", new_price, orderID)) {
-        _log(MARKET__DB_ERROR, "Error in query: %s.", err.c_str());
-        return false;
-    }
-    return true;
+void MarketDB::AlterOrderPrice(uint32 orderID, double new_price) {
+    sDatabase.RunQueryAsync("UPDATE mktOrders SET price = %.2f WHERE orderID = %u", new_price, orderID);
 }
 
-bool MarketDB::DeleteOrder(uint32 orderID) {
-    DBerror err;
-    if (!sDatabase.RunQuery(err, "DELETE FROM mktOrders WHERE orderID = %u", orderID)) {
-        _log(MARKET__DB_ERROR, "Error in query: %s.", err.c_str());
-        return false;
-    }
-    return true;
+void MarketDB::DeleteOrder(uint32 orderID) {
+    sDatabase.RunQueryAsync("DELETE FROM mktOrders WHERE orderID = %u", orderID);
 }
 
 uint32 MarketDB::StoreOrder(Market::SaveData &data) {
@@ -497,16 +332,14 @@ int64 MarketDB::GetUpdateTime()
 
 void MarketDB::SetUpdateTime(int64 setTime)
 {
-    DBerror err;
-    sDatabase.RunQuery(err, "UPDATE mktUpdates SET timeStamp = %lli WHERE server = 1", setTime);
+    sDatabase.RunQueryAsync("UPDATE mktUpdates SET timeStamp = %lli WHERE server = 1", setTime);
 }
 
 /** @todo this needs work for better logic.   may need to pull data from transactions */
 void MarketDB::UpdateHistory()
 {
     //  'date'  needs to be an actual column to pull data from....
-    DBerror err;
-    sDatabase.RunQuery(err,
+    sDatabase.RunQueryAsync(
                    "INSERT INTO"
                    "    mktHistory"
                    "     (regionID, typeID, historyDate, lowPrice, highPrice, avgPrice, volume, orders)"
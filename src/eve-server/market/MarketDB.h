@@ -38,8 +38,7 @@ class MarketDB
 {
 public:
     static PyRep* GetMarketGroups();
-    static PyRep* GetOrders(uint32 regionID, uint16 typeID);
-    static PyRep* GetOrderRow(uint32 orderID);
+    static void GetAllOrders(DBQueryResult& res);
     static PyRep* GetRegionBest(uint32 regionID);
     static PyRep* GetSystemAsks(uint32 solarSystemID);
     static PyRep* GetStationAsks(uint32 stationID);
@@ -47,14 +46,12 @@ public:
 
     static PyRep* GetTransactions(uint32 ownerID, Market::TxData &data);
 
-    static bool DeleteOrder(uint32 orderID);
-    static bool GetOrderInfo(uint32 orderID, Market::OrderInfo &oInfo);
-    static bool AlterOrderPrice(uint32 orderID, double new_price);
     static bool RecordTransaction(Market::TxData &data);
-    static bool AlterOrderQuantity(uint32 orderID, uint32 new_qty);
 
-    static uint32 FindBuyOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price);
-    static uint32 FindSellOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price);
+    /* MarketMgr keeps the open orders; these write its changes behind it */
+    static void DeleteOrder(uint32 orderID);
+    static void AlterOrderPrice(uint32 orderID, double new_price);
+    static void AlterOrderQuantity(uint32 orderID, uint32 new_qty);
     static uint32 StoreOrder(Market::SaveData& data);
 
 
@@ -18,6 +18,7 @@
 #include "account/AccountService.h"
 #include "cache/ObjCacheService.h"
 #include "inventory/InventoryItem.h"
+#include "map/MapData.h"
 #include "market/MarketMgr.h"
 #include "station/StationDataMgr.h"
 
@@ -66,8 +67,7 @@ void MarketMgr::Populate()
 
     Process();
 
-    // market orders stored as {regionID/typeID}    --do we want to store orders in memory for loaded region??
-    // MarketDB::GetOrders(call.client->GetRegionID(), args.arg);
+    LoadOrders();
 
     sLog.Cyan("        MarketMgr", "Market Manager Updates Price History every %u hours.", sConfig.market.HistoryUpdateTime);
     sLog.Blue("        MarketMgr", "Market Manager loaded in %.3fms.", (GetTimeMSeconds() - start));
@@ -101,14 +101,14 @@ void MarketMgr::UpdatePriceHistory()
     m_timeStamp = GetFileTimeNow() + (EvE::Time::Hour * sConfig.market.HistoryUpdateTime);
     MarketDB::SetUpdateTime(m_timeStamp);
 
-    DBerror err;
     int64 cutoff_time = m_timeStamp;
     cutoff_time -= cutoff_time % EvE::Time::Day;    //round down to an even day boundary.
     cutoff_time -= EvE::Time::Day * 2;  //the cutoff between "new" and "old" price history in days
 
     /** @todo  this doesnt belong here...  */
     //build the history record from the recent market transactions.
-    sDatabase.RunQuery(err,
+    // these are long writes nothing here waits on; run them on the db pool
+    sDatabase.RunQueryAsync(
             "INSERT INTO"
             "    mktHistory"
             "     (regionID, typeID, historyDate, lowPrice, highPrice, avgPrice, volume, orders)"
@@ -129,7 +129,7 @@ void MarketMgr::UpdatePriceHistory()
     /** @todo  this doesnt belong here...  */
     // remove the transactions which have been aged out?
     if (sConfig.market.DeleteOldTransactions)
-        sDatabase.RunQuery(err, "DELETE FROM mktTransactions WHERE transactionDate < %lli", (cutoff_time - EvE::Time::Year));
+        sDatabase.RunQueryAsync("DELETE FROM mktTransactions WHERE transactionDate < %lli", (cutoff_time - EvE::Time::Year));
 }
 
     /*DBColumnTypeMap colmap;
@@ -233,7 +233,7 @@ void MarketMgr::SendOnOwnOrderChanged(Client* pClient, uint32 orderID, uint8 act
     if (order != nullptr) {
         ooc.order = order;
     } else {
-        ooc.order = MarketDB::GetOrderRow(orderID);
+        ooc.order = GetOrderRow(orderID);
     }
 
     switch (action) {
@@ -268,6 +268,290 @@ void MarketMgr::InvalidateOrdersCache(uint32 regionID, uint32 typeID) {
     this->m_cache->InvalidateCache(method_id);
 }
 
+void MarketMgr::LoadOrders()
+{
+    double start = GetTimeMSeconds();
+    m_books.clear();
+    m_orderBooks.clear();
+    m_orderColumns.clear();
+
+    DBQueryResult res;
+    MarketDB::GetAllOrders(res);
+    if (res.ColumnCount() < 20) {
+        sLog.Error("        MarketMgr", "Failed to load market orders.");
+        return;
+    }
+
+    // keep the db's column types so rows built from memory marshal like rows read from it
+    for (uint32 i = 0; i < 14; ++i)
+        m_orderColumns.emplace_back(res.ColumnName(i), res.ColumnType(i));
+
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        Market::SaveData data = Market::SaveData();
+        data.price          = row.GetDouble(0);
+        data.volRemaining   = row.GetUInt(1);
+        data.typeID         = row.GetUInt(2);
+        data.orderRange     = row.GetInt(3);
+        data.orderID        = row.GetUInt(4);
+        data.volEntered     = row.GetUInt(5);
+        data.minVolume      = row.GetUInt(6);
+        data.bid            = row.GetBool(7);
+        data.issued         = row.GetInt64(8);
+        data.duration       = row.GetUInt(9);
+        data.stationID      = row.GetUInt(10);
+        data.regionID       = row.GetUInt(11);
+        data.solarSystemID  = row.GetUInt(12);
+        data.jumps          = row.GetUInt(13);
+        data.ownerID        = row.GetUInt(14);
+        data.escrow         = row.GetDouble(15);
+        data.contraband     = row.GetBool(16);
+        data.isCorp         = row.GetBool(17);
+        data.accountKey     = row.GetUInt(18);
+        data.memberID       = row.GetUInt(19);
+
+        // loaded oldest first, so each price level is in time order
+        MarketOrderBook* pBook = GetBook(data.regionID, data.typeID);
+        pBook->Add(data);
+        m_orderBooks[data.orderID] = pBook;
+    }
+
+    sLog.Cyan("        MarketMgr", "%lu market orders in %lu books loaded in %.3fms.", m_orderBooks.size(), m_books.size(), (GetTimeMSeconds() - start));
+}
+
+MarketOrderBook* MarketMgr::GetBook(uint32 regionID, uint32 typeID)
+{
+    return &m_books[((uint64_t)regionID << 32) | typeID];
+}
+
+uint32 MarketMgr::StoreOrder(Market::SaveData& data)
+{
+    // the db keeps prices to the cent
+    data.price = std::round(data.price * 100.0) / 100.0;
+
+    // the insert stays synchronous, callers need the orderID right away
+    data.orderID = MarketDB::StoreOrder(data);
+    if (data.orderID == 0)
+        return 0;
+
+    MarketOrderBook* pBook = GetBook(data.regionID, data.typeID);
+    pBook->Add(data);
+    m_orderBooks[data.orderID] = pBook;
+    return data.orderID;
+}
+
+bool MarketMgr::DeleteOrder(uint32 orderID)
+{
+    // the row goes either way, in case the book and the db disagree
+    MarketDB::DeleteOrder(orderID);
+
+    std::unordered_map<uint32, MarketOrderBook*>::iterator itr = m_orderBooks.find(orderID);
+    if (itr == m_orderBooks.end())
+        return false;
+
+    itr->second->Remove(orderID);
+    m_orderBooks.erase(itr);
+    return true;
+}
+
+bool MarketMgr::AlterOrderPrice(uint32 orderID, double price)
+{
+    std::unordered_map<uint32, MarketOrderBook*>::iterator itr = m_orderBooks.find(orderID);
+    if (itr == m_orderBooks.end())
+        return false;
+
+    price = std::round(price * 100.0) / 100.0;
+    itr->second->SetPrice(orderID, price);
+    MarketDB::AlterOrderPrice(orderID, price);
+    return true;
+}
+
+bool MarketMgr::AlterOrderQuantity(uint32 orderID, uint32 quantity)
+{
+    std::unordered_map<uint32, MarketOrderBook*>::iterator itr = m_orderBooks.find(orderID);
+    if (itr == m_orderBooks.end())
+        return false;
+
+    itr->second->SetQuantity(orderID, quantity);
+    MarketDB::AlterOrderQuantity(orderID, quantity);
+    return true;
+}
+
+void MarketMgr::RemoveOwnerOrders(uint32 ownerID)
+{
+    std::vector<uint32> orders;
+    for (std::unordered_map<uint32, MarketOrderBook*>::value_type& cur : m_orderBooks)
+        if (cur.second->Find(cur.first)->ownerID == ownerID)
+            orders.push_back(cur.first);
+
+    for (uint32 orderID : orders) {
+        m_orderBooks[orderID]->Remove(orderID);
+        m_orderBooks.erase(orderID);
+    }
+}
+
+bool MarketMgr::GetOrderInfo(uint32 orderID, Market::OrderInfo& oInfo)
+{
+    std::unordered_map<uint32, MarketOrderBook*>::iterator itr = m_orderBooks.find(orderID);
+    if (itr == m_orderBooks.end()) {
+        _log(MARKET__WARNING, "Order %u not found.", orderID);
+        return false;
+    }
+
+    const Market::SaveData* pOrder = itr->second->Find(orderID);
+    oInfo.orderID    = pOrder->orderID;
+    oInfo.quantity   = pOrder->volRemaining;
+    oInfo.price      = pOrder->price;
+    oInfo.typeID     = pOrder->typeID;
+    oInfo.stationID  = pOrder->stationID;
+    oInfo.regionID   = pOrder->regionID;
+    oInfo.ownerID    = pOrder->ownerID;
+    oInfo.isBuy      = pOrder->bid;
+    oInfo.isCorp     = pOrder->isCorp;
+    oInfo.memberID   = pOrder->memberID;
+    oInfo.accountKey = pOrder->accountKey;
+    return true;
+}
+
+DBRowDescriptor* MarketMgr::NewOrderHeader()
+{
+    DBRowDescriptor* header = new DBRowDescriptor();
+    for (const std::pair<std::string, DBTYPE>& cur : m_orderColumns)
+        header->AddColumn(cur.first.c_str(), cur.second);
+    return header;
+}
+
+// same PyRep types DBColumnToPyRep() makes for a column of this type
+static PyRep* OrderField(DBTYPE type, int64 value)
+{
+    switch (type) {
+        case DBTYPE_I8:
+        case DBTYPE_UI8:
+        case DBTYPE_CY:
+        case DBTYPE_FILETIME:
+            return new PyLong(value);
+        case DBTYPE_R4:
+        case DBTYPE_R8:
+            return new PyFloat((double)value);
+        case DBTYPE_BOOL:
+            return new PyBool(value != 0);
+        default:
+            return new PyInt((int32)value);
+    }
+}
+
+static PyRep* OrderField(DBTYPE type, double value)
+{
+    if ((type == DBTYPE_R4) or (type == DBTYPE_R8))
+        return new PyFloat(value);
+    return OrderField(type, (int64)value);
+}
+
+PyPackedRow* MarketMgr::NewOrderRow(DBRowDescriptor* header, const Market::SaveData& data)
+{
+    // price, volRemaining, typeID, range, orderID, volEntered, minVolume, bid, issueDate, duration,
+    //  stationID, regionID, solarSystemID, jumps
+    PyPackedRow* row = new PyPackedRow(header);
+    row->SetField((uint32)0, OrderField(header->GetColumnType(0), data.price));
+    row->SetField(1, OrderField(header->GetColumnType(1), (int64)data.volRemaining));
+    row->SetField(2, OrderField(header->GetColumnType(2), (int64)data.typeID));
+    row->SetField(3, OrderField(header->GetColumnType(3), (int64)data.orderRange));
+    row->SetField(4, OrderField(header->GetColumnType(4), (int64)data.orderID));
+    row->SetField(5, OrderField(header->GetColumnType(5), (int64)data.volEntered));
+    row->SetField(6, OrderField(header->GetColumnType(6), (int64)data.minVolume));
+    row->SetField(7, OrderField(header->GetColumnType(7), (int64)data.bid));
+    row->SetField(8, OrderField(header->GetColumnType(8), data.issued));
+    row->SetField(9, OrderField(header->GetColumnType(9), (int64)data.duration));
+    row->SetField(10, OrderField(header->GetColumnType(10), (int64)data.stationID));
+    row->SetField(11, OrderField(header->GetColumnType(11), (int64)data.regionID));
+    row->SetField(12, OrderField(header->GetColumnType(12), (int64)data.solarSystemID));
+    row->SetField(13, OrderField(header->GetColumnType(13), (int64)data.jumps));
+    return row;
+}
+
+PyRep* MarketMgr::GetOrders(uint32 regionID, uint16 typeID)
+{
+    // returns a tuple (sell, buy) of PyObjectEx with data in PyPackedRows
+    if (m_orderColumns.empty())
+        return nullptr;
+
+    std::unordered_map<uint64_t, MarketOrderBook>::iterator itr = m_books.find(((uint64_t)regionID << 32) | typeID);
+
+    PyTuple* tup = new PyTuple(2);
+    for (uint8 side = 0; side < 2; ++side) {
+        // the rowset keeps one reference to the header and each row another
+        DBRowDescriptor* header = NewOrderHeader();
+        CRowSet* rowset = new CRowSet(&header);
+        if (itr != m_books.end())
+            itr->second.ForEach(side == Market::Type::Buy, [&](const Market::SaveData& data) {
+                PyIncRef(header);
+                rowset->list().AddItem(NewOrderRow(header, data));
+            });
+        tup->SetItem(side, rowset);
+    }
+
+    if (is_log_enabled(MARKET__DUMP))
+        tup->Dump(MARKET__DUMP, "    ");
+    return tup;
+}
+
+PyRep* MarketMgr::GetOrderRow(uint32 orderID)
+{
+    std::unordered_map<uint32, MarketOrderBook*>::iterator itr = m_orderBooks.find(orderID);
+    if ((itr == m_orderBooks.end()) or m_orderColumns.empty()) {
+        codelog(MARKET__ERROR, "Order %u not found.", orderID);
+        return nullptr;
+    }
+
+    return NewOrderRow(NewOrderHeader(), *itr->second->Find(orderID));
+}
+
+bool MarketMgr::InRange(uint32 fromStationID, uint32 toStationID, int16 range)
+{
+    if (fromStationID == toStationID)
+        return true;
+
+    switch (range) {
+        case Market::Range::Station:
+            return false;
+        case Market::Range::Region:
+            // books are regional
+            return true;
+    }
+
+    uint32 fromSystemID(sDataMgr.GetStationSystem(fromStationID)), toSystemID(sDataMgr.GetStationSystem(toStationID));
+    if (fromSystemID == toSystemID)
+        return true;
+    if (range <= Market::Range::System)
+        return false;
+
+    return sMapData.GetJumpCount(fromSystemID, toSystemID, range) <= range;
+}
+
+uint32 MarketMgr::FindSellOrder(uint32 typeID, uint32 stationID, int16 range, uint32 quantity, double price)
+{
+    std::unordered_map<uint64_t, MarketOrderBook>::iterator itr = m_books.find(((uint64_t)sDataMgr.GetStationRegion(stationID) << 32) | typeID);
+    if (itr == m_books.end())
+        return 0;
+
+    // any ask the buyer's range reaches
+    const Market::SaveData* pOrder = itr->second.FindAsk(std::round((price + 0.1) * 100.0) / 100.0, quantity,
+        [&](const Market::SaveData& ask) { return InRange(stationID, ask.stationID, range); });
+    return (pOrder == nullptr ? 0 : pOrder->orderID);
+}
+
+uint32 MarketMgr::FindBuyOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price)
+{
+    std::unordered_map<uint64_t, MarketOrderBook>::iterator itr = m_books.find(((uint64_t)sDataMgr.GetStationRegion(stationID) << 32) | typeID);
+    if (itr == m_books.end())
+        return 0;
+
+    // any bid whose own range reaches the seller's station
+    const Market::SaveData* pOrder = itr->second.FindBid(std::round((price - 0.1) * 100.0) / 100.0, quantity,
+        [&](const Market::SaveData& bid) { return InRange(bid.stationID, stationID, bid.orderRange); });
+    return (pOrder == nullptr ? 0 : pOrder->orderID);
+}
+
 /** @todo take off market overhead fees */
 /*
  *    def BrokersFee(self, stationID, amount, commissionPercentage):
@@ -302,7 +586,7 @@ void MarketMgr::InvalidateOrdersCache(uint32 regionID, uint32 typeID) {
  */
 bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef iRef, uint32 quantity, bool useCorp, uint32 typeID, uint32 stationID, double price, uint16 accountKey/*Account::KeyType::Cash*/) {
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!MarketDB::GetOrderInfo(orderID, oInfo)) {
+    if (!GetOrderInfo(orderID, oInfo)) {
         _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to get order info for #%u.", orderID);
 
         return false;
@@ -524,7 +808,7 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
 
         _log(MARKET__TRACE, "ExecuteBuyOrder - Partially satisfied order #%u, altering quantity to %u.", orderID, newQty);
 
-        if (!MarketDB::AlterOrderQuantity(orderID, newQty)) {
+        if (!AlterOrderQuantity(orderID, newQty)) {
             _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to alter quantity of order #%u.", orderID);
             return false;
         }
@@ -540,8 +824,8 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
 
     _log(MARKET__TRACE, "ExecuteBuyOrder - Satisfied order #%u, deleting.", orderID);
 
-    PyRep* order = MarketDB::GetOrderRow(orderID);
-    if (!MarketDB::DeleteOrder(orderID)) {
+    PyRep* order = GetOrderRow(orderID);
+    if (!DeleteOrder(orderID)) {
         _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to delete order #%u.", orderID);
         return false;
     }
@@ -559,7 +843,7 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
 void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, uint32 sellQuantity, float price, uint32 stationID, uint32 typeID, bool useCorp) {
     // attempt to retrieve information about the sell order, fail if not found
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!MarketDB::GetOrderInfo(orderID, oInfo)) {
+    if (!GetOrderInfo(orderID, oInfo)) {
         _log(MARKET__ERROR,
             "ExecuteSellOrder - Failed to get info about sell order %u.",
             orderID
@@ -659,8 +943,8 @@ void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, uint32 sellQuant
     if (orderConsumed) {
         _log(MARKET__TRACE, "ExecuteSellOrder - satisfied order #%u, deleting.", orderID);
 
-        PyRep* order = MarketDB::GetOrderRow(orderID);
-        if (!MarketDB::DeleteOrder(orderID)) {
+        PyRep* order = GetOrderRow(orderID);
+        if (!DeleteOrder(orderID)) {
             _log(MARKET__ERROR, "ExecuteSellOrder - Failed to delete order #%u.", orderID);
             return;
         }
@@ -673,7 +957,7 @@ void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, uint32 sellQuant
 
         _log(MARKET__TRACE, "ExecuteSellOrder - Partially satisfied order #%u, altering quantity to %u.", orderID, newQty);
 
-        if (!MarketDB::AlterOrderQuantity(orderID, newQty)) {
+        if (!AlterOrderQuantity(orderID, newQty)) {
             _log(MARKET__ERROR, "ExecuteSellOrder - Failed to alter quantity of order #%u.", orderID);
             return;
         }
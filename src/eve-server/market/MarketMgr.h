@@ -17,6 +17,7 @@
 
 #include "EntityList.h"
 #include "market/MarketDB.h"
+#include "market/MarketOrderBook.h"
 #include "cache/ObjCacheService.h"
 
 class Client;
@@ -53,6 +54,21 @@ public:
 
     void InvalidateOrdersCache(uint32 regionID, uint32 typeID);
 
+    // open orders are kept here, one book per region/type, and written to the db behind
+    uint32 StoreOrder(Market::SaveData& data);      // returns the new orderID, 0 on failure
+    bool DeleteOrder(uint32 orderID);
+    bool AlterOrderPrice(uint32 orderID, double price);
+    bool AlterOrderQuantity(uint32 orderID, uint32 quantity);
+    void RemoveOwnerOrders(uint32 ownerID);         // memory only, for callers deleting the rows themselves
+    bool GetOrderInfo(uint32 orderID, Market::OrderInfo& oInfo);
+    // tuple (sell, buy) of CRowsets
+    PyRep* GetOrders(uint32 regionID, uint16 typeID);
+    PyRep* GetOrderRow(uint32 orderID);
+
+    // best order to fill an immediate buy/sell from, 0 if none.  same price tolerance the client uses
+    uint32 FindSellOrder(uint32 typeID, uint32 stationID, int16 range, uint32 quantity, double price);
+    uint32 FindBuyOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price);
+
     bool NeedsUpdate()                                  { return m_timeStamp > GetFileTimeNow()?false:true; }
 
     PyRep* GetMarketGroups()                            { PyIncRef(m_marketGroups); return m_marketGroups; }
@@ -70,6 +86,12 @@ public:
 
 protected:
     void Populate();
+    void LoadOrders();
+
+    MarketOrderBook* GetBook(uint32 regionID, uint32 typeID);
+    bool InRange(uint32 fromStationID, uint32 toStationID, int16 range);
+    DBRowDescriptor* NewOrderHeader();
+    PyPackedRow* NewOrderRow(DBRowDescriptor* header, const Market::SaveData& data);
 
 private:
     MarketDB m_db;
@@ -80,11 +102,11 @@ private:
     int64 m_timeStamp;
 
     // markets are regional.  there are 66 regions.
-    // market orders are stored as {regionID/typeID}
-    //  load market data by region, sorted by system/station.
-    //  station data will also store StationRef to owning/containing station for easier access later
-    //  will be able to implement 'jumps' and other market conditionals
-    //  ** this could take ~16m for average market data per region
+    // market orders are stored as {regionID/typeID}, all of them loaded at startup
+    std::unordered_map<uint64_t, MarketOrderBook> m_books;
+    std::unordered_map<uint32, MarketOrderBook*> m_orderBooks;  // orderID/book
+    // name and type of the GetOrders() row columns, as the db reported them
+    std::vector<std::pair<std::string, DBTYPE>> m_orderColumns;
 };
 
 //Singleton
@@ -151,7 +151,7 @@ PyResult MarketProxyService::GetOrders(PyCallArgs &call, PyInt* typeID) {
     if (!this->m_cache->IsCacheLoaded(method_id))
     {
         //this method is not in cache yet, load up the contents and cache it.
-        result = MarketDB::GetOrders(call.client->GetRegionID(), typeID->value());
+        result = sMktMgr.GetOrders(call.client->GetRegionID(), typeID->value());
         if (result == nullptr) {
             _log(MARKET__DB_ERROR, "Failed to load cache, generating empty contents.");
             result = PyStatic.NewNone();
@@ -237,21 +237,22 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
 
         // is this standing order or immediate?
         if (duration->value() == 0) {
-            // immediate. look for open sell order that matches all reqs (price, qty, distance, etc)
-            // check distance, set order range and make station list.
-            uint32 orderID(MarketDB::FindSellOrder(
+            // immediate. look for open sell order that matches all reqs (price, qty, distance)
+            uint32 orderID(sMktMgr.FindSellOrder(
                 typeID->value(),
                 stationID->value(),
+                orderRange->value(),
                 quantity->value(),
                 price->value()
             ));
 
-            if (orderID) {
-                // found one.
+            Market::OrderInfo oInfo = Market::OrderInfo();
+            if (orderID and sMktMgr.GetOrderInfo(orderID, oInfo)) {
+                // found one.  items are delivered where the seller has them
                 _log(MARKET__TRACE,
                     "PlaceCharOrder - Found sell order #%u in %s for %s. (type %i, price %.2f, qty %i, range %i)",
                     orderID,
-                    stDataMgr.GetStationName(stationID->value()).c_str(),
+                    stDataMgr.GetStationName(oInfo.stationID).c_str(),
                     call.client->GetName(),
                     typeID->value(),
                     price->value(),
@@ -264,7 +265,7 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
                     orderID,
                     quantity->value(),
                     price->value(),
-                    stationID->value(),
+                    oInfo.stationID,
                     typeID->value(),
                     useCorp->value()
                 );
@@ -313,7 +314,7 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
         data.jumps = 1;     // not sure if this is used....
 
         // create buy order
-        uint32 orderID(MarketDB::StoreOrder(data));
+        uint32 orderID(sMktMgr.StoreOrder(data));
         if (orderID == 0) {
             _log(MARKET__ERROR, "PlaceCharOrder - Failed to record buy order in the DB.");
             call.client->SendErrorMsg("Failed to record the order.");
@@ -460,56 +461,45 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
 
         // is this standing order or immediate?
         if (duration->value() == 0) {
-            bool completedOrder(false);
-
-            uint32 orderID(0), origQty(quantity->value());
-
-            // set an upper bound (this used to be a while loop that spun
-            // forever in some cases)
-            for (int i = 0; i < 1000; i++) {
-                _log(MARKET__DUMP, "Mkt::PlaceCharOrder(): finding buy order: %i, %i, %i, %.2f", typeID->value(), stationID->value(), quantity->value(), price->value());
-
-                orderID = MarketDB::FindBuyOrder(typeID->value(), stationID->value(), quantity->value(), price->value());
-
-                if (!orderID) {
-                    continue;
-                }
+            _log(MARKET__DUMP, "Mkt::PlaceCharOrder(): finding buy order: %i, %i, %i, %.2f", typeID->value(), stationID->value(), quantity->value(), price->value());
 
+            uint32 orderID(sMktMgr.FindBuyOrder(typeID->value(), stationID->value(), quantity->value(), price->value()));
+            if (orderID == 0) {
                 _log(MARKET__TRACE,
-                    "PlaceCharOrder - Found buy order #%u in %s for %s.",
-                    orderID,
-                    stDataMgr.GetStationName(stationID->value()).c_str(),
-                    call.client->GetName()
-                );
-
-                completedOrder = sMktMgr.ExecuteBuyOrder(
-                    call.client,
-                    orderID,
-                    iRef,
+                    "PlaceCharOrder - Failed to satisfy sell order for %i of type %i at %.2f ISK.",
                     quantity->value(),
-                    useCorp->value(),
                     typeID->value(),
-                    stationID->value(),
                     price->value()
                 );
 
-                if (!completedOrder) {
-                    continue;
-                }
-
-                _log(MARKET__DUMP, "Mkt::PlaceCharOrder(): order resolved");
+                call.client->SendErrorMsg("No buy order found.");
 
-                break;
+                return nullptr;
             }
 
-            if (!completedOrder) {
-                _log(MARKET__ERROR, "PlaceCharOrder - failed to find a matching market order within 1000 attempts.");
-
-                call.client->SendErrorMsg("Failed to find a suitable market order in a reasonable amount of time.");
+            _log(MARKET__TRACE,
+                "PlaceCharOrder - Found buy order #%u in %s for %s.",
+                orderID,
+                stDataMgr.GetStationName(stationID->value()).c_str(),
+                call.client->GetName()
+            );
 
+            if (!sMktMgr.ExecuteBuyOrder(
+                call.client,
+                orderID,
+                iRef,
+                quantity->value(),
+                useCorp->value(),
+                typeID->value(),
+                stationID->value(),
+                price->value()
+            )) {
+                _log(MARKET__ERROR, "PlaceCharOrder - Failed to execute buy order #%u.", orderID);
                 return nullptr;
             }
 
+            _log(MARKET__DUMP, "Mkt::PlaceCharOrder(): order resolved");
+
             return nullptr;
         }
 
@@ -605,7 +595,7 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
         }
 
         // store the order in the DB.
-        uint32 orderID(MarketDB::StoreOrder(data));
+        uint32 orderID(sMktMgr.StoreOrder(data));
         if (orderID == 0) {
             _log(MARKET__ERROR, "PlaceCharOrder - Failed to record sell order in the DB.");
             call.client->SendErrorMsg("Failed to record the order in the DB!");
@@ -641,7 +631,7 @@ PyResult MarketProxyService::ModifyCharOrder(PyCallArgs &call, PyInt* orderID, P
     // client coded to throw error if price > 9223372036854.0
     // we need to pull data from db for typeID and isCorp...
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!MarketDB::GetOrderInfo(orderID->value(), oInfo)) {
+    if (!sMktMgr.GetOrderInfo(orderID->value(), oInfo)) {
         _log(MARKET__ERROR, "ModifyCharOrder - Failed to get info about order #%i.", orderID->value());
         return nullptr;
     }
@@ -664,7 +654,7 @@ PyResult MarketProxyService::ModifyCharOrder(PyCallArgs &call, PyInt* orderID, P
         Account::KeyType::Escrow
     );
 
-    if (!MarketDB::AlterOrderPrice(orderID->value(), newPrice->value())) {
+    if (!sMktMgr.AlterOrderPrice(orderID->value(), newPrice->value())) {
         _log(MARKET__ERROR, "ModifyCharOrder - Failed to modify price for order #%i.", orderID->value());
         return nullptr;
     }
@@ -677,7 +667,7 @@ PyResult MarketProxyService::ModifyCharOrder(PyCallArgs &call, PyInt* orderID, P
 
 PyResult MarketProxyService::CancelCharOrder(PyCallArgs &call, PyInt* orderID, PyInt* regionID) {
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!MarketDB::GetOrderInfo(orderID->value(), oInfo)) {
+    if (!sMktMgr.GetOrderInfo(orderID->value(), oInfo)) {
         _log(MARKET__ERROR, "CancelCharOrder - Failed to get info about order #%i.", orderID->value());
         return nullptr;
     }
@@ -706,8 +696,8 @@ PyResult MarketProxyService::CancelCharOrder(PyCallArgs &call, PyInt* orderID, P
             iRef->Donate(call.client->GetCharacterID(), oInfo.stationID, flagHangar, true);
     }
 
-    PyRep* order(MarketDB::GetOrderRow(orderID->value()));
-    if (!MarketDB::DeleteOrder(orderID->value())) {
+    PyRep* order(sMktMgr.GetOrderRow(orderID->value()));
+    if (!sMktMgr.DeleteOrder(orderID->value())) {
         _log(MARKET__ERROR, "CancelCharOrder - Failed to delete order #%i.", orderID->value());
         return nullptr;
     }
@@ -27,6 +27,7 @@
 #include "eve-server.h"
 
 #include "search/Search.h"
+#include "search/SearchMgr.h"
 
 Search::Search() :
     Service("search")
@@ -39,7 +40,7 @@ PyResult Search::Query(PyCallArgs& call, PyWString* filter, PyList* data) {
     std::string str = filter->content();
     Replace(str);
 
-    // this hits db directly, so test for possible sql injection code
+    // owned items still come from the db, so test for possible sql injection code
     for (const auto cur : badCharsSearch)
         if (EvE::icontains(str, cur))
             throw CustomError ("Search String contains invalid characters");
@@ -59,7 +60,30 @@ PyResult Search::Query(PyCallArgs& call, PyWString* filter, PyList* data) {
         ids.push_back(t->value());
     }
 
-    return m_db->Query( str, &ids, call.client->GetCharacterID() );
+    PyDict* dict = new PyDict();
+    std::vector<const NameIndex::Entry*> found;
+    for (auto kind : ids) {
+        PyDict* hits = nullptr;
+        if (kind == searchResultInventoryType) {
+            // items the caller owns aren't indexed
+            DBQueryResult res;
+            SearchDB::GetOwnedItemTypes(res, str, call.client->GetCharacterID());
+            if (res.GetRowCount())
+                hits = DBResultToIntIntDict(res);
+        } else if ((kind > 0) and (kind < searchResultInventoryType)) {
+            found.clear();
+            sSearchMgr.Find(str, 1 << kind, Limit(kind), found);
+            if (!found.empty()) {
+                hits = new PyDict();
+                for (auto cur : found)
+                    hits->SetItem(new PyInt(cur->id), PyStatic.NewNone());
+            }
+        }
+        if (hits != nullptr)
+            dict->SetItem(new PyInt(kind), hits);
+    }
+
+    return dict;
 }
 
 
@@ -76,12 +100,6 @@ PyResult Search::QuickQuery(PyCallArgs& call, PyWString* filter, PyList* data)
     if (call.byname.find("onlyAltName") != call.byname.end())
         onlyAltName = (PyRep::IntegerValue(call.byname.find("onlyAltName")->second) != 0);
 
-    // this hits db directly, so test for possible sql injection code
-    for (const auto cur : badCharsSearch)
-        if (EvE::icontains(str, cur))
-            throw CustomError ("Search String contains invalid characters");
-
-
     // TODO: this should be possible to improve once there's updates to the type system
     // all the collections needs some overhaul on how they work
     std::vector<int> ids;
@@ -97,7 +115,30 @@ PyResult Search::QuickQuery(PyCallArgs& call, PyWString* filter, PyList* data)
         ids.push_back(t->value());
     }
 
-    return m_db->QuickQuery( str, &ids, call.client->GetCharacterID(), hideNPC, onlyAltName);
+    if (((ids.size() == 1) and (ids[0] == searchResultCharacter))
+    or  (hideNPC)) {
+        /** @todo i dont remember what this was for, but need to finish it anyway */
+    }
+
+    PyList* result = new PyList();
+    std::vector<const NameIndex::Entry*> found;
+    for (auto kind : ids) {
+        if ((kind <= 0) or (kind > searchResultInventoryType))
+            continue;
+        found.clear();
+        sSearchMgr.Find(str, 1 << kind, Limit(kind), found);
+        for (auto cur : found)
+            result->AddItem(new PyInt(cur->id));
+    }
+
+    return result;
+}
+
+size_t Search::Limit(int kind) {
+    // characters and types were never limited; the rest were 10
+    if ((kind == searchResultCharacter) or (kind == searchResultInventoryType))
+        return searchMaxResults;
+    return 10;
 }
 
 void Search::Replace(std::string &str) {
@@ -41,7 +41,8 @@ protected:
       PyResult QuickQuery(PyCallArgs& call, PyWString* filter, PyList* data);
 
   private:
-    SearchDB* m_db;
+    // most results of 'kind' a query returns
+    static size_t Limit(int kind);
 
     // this is specific to Search class.  replaces EvE wildcard (*) with MYSQL wildcard (%)
 	void Replace(std::string &s);
@@ -44,196 +44,38 @@ searchMaxResults = 500
 searchMinWildcardLength = 3
 */
 
-PyRep *SearchDB::Query(std::string string, std::vector<int> *searchID, uint32 charID) {
-    std::string id = "";
-
-    PyDict *dict = new PyDict();
-    DBQueryResult res;
-
-    for (uint8 i=0; i < searchID->size(); i++) {
-        switch(searchID->at(i)) {
-            case 1: //searchResultAgent = 1
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   characterID AS agentID"
-                    " FROM chrNPCCharacters"
-                    " WHERE characterName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "agentID";
-                break;
-            case 2: //searchResultCharacter = 2
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   characterID AS ownerID"
-                    " FROM chrCharacters"
-                    " WHERE characterName LIKE '%s' ", string.c_str() );
-                id = "ownerID";
-                break;
-            case 3: //searchResultCorporation = 3
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   corporationID AS ownerID"
-                    " FROM crpCorporation"
-                    " WHERE corporationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "ownerID";
-                break;
-            case 4: //searchResultAlliance = 4
-                sDatabase.RunQuery(res,
-                    "SELECT allianceID AS ownerID"
-                    " FROM alnAlliance"
-                    " WHERE shortName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "ownerID";
-                break;
-            case 5: //searchResultFaction = 5
-                sDatabase.RunQuery(res,
-                    "SELECT factionID AS ownerID"
-                    " FROM facFactions"
-                    " WHERE factionName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "ownerID";
-                break;
-            case 6: //searchResultConstellation = 6
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   constellationID AS itemID"
-                    " FROM mapConstellations"
-                    " WHERE constellationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "itemID";
-                break;
-            case 7: //searchResultSolarSystem = 7
-                sDatabase.RunQuery(res,
-                    "SELECT "
-                    "   solarSystemID AS itemID"
-                    " FROM mapSolarSystems "
-                    " WHERE solarSystemName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "itemID";
-                break;
-            case 8: //searchResultRegion = 8
-                sDatabase.RunQuery(res,
-                    "SELECT "
-                    "   regionID AS itemID"
-                    " FROM mapRegions"
-                    " WHERE regionName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "itemID";
-                break;
-            case 9: //searchResultStation = 9
-                sDatabase.RunQuery(res,
-                    "SELECT "
-                    "   stationID AS itemID"
-                    " FROM staStations "
-                    " WHERE stationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "itemID";
-                break;
-            case 10:    //searchResultInventoryType = 10
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   typeID"
-                    " FROM entity"
-                    " WHERE itemName LIKE '%s'"
-                    " AND ownerID = %u", string.c_str(), charID );
-                id = "typeID";
-                break;
-        }
-        if (res.GetRowCount())
-            dict->SetItem(new PyInt(searchID->at(i)),DBResultToIntIntDict(res));
+void SearchDB::GetSearchNames(DBQueryResult& res)
+{
+    if (!sDatabase.RunQuery(res,
+        "SELECT %u, characterID, characterName, 0 FROM chrNPCCharacters"
+        " UNION ALL SELECT %u, characterID, characterName, 0 FROM chrCharacters"
+        " UNION ALL SELECT %u, corporationID, corporationName, corporationType FROM crpCorporation"
+        " UNION ALL SELECT %u, corporationID, tickerName, 0 FROM crpCorporation"
+        " UNION ALL SELECT %u, allianceID, shortName, 0 FROM alnAlliance"
+        " UNION ALL SELECT %u, allianceID, allianceName, 0 FROM alnAlliance"
+        " UNION ALL SELECT %u, factionID, factionName, 0 FROM facFactions"
+        " UNION ALL SELECT %u, constellationID, constellationName, 0 FROM mapConstellations"
+        " UNION ALL SELECT %u, solarSystemID, solarSystemName, 0 FROM mapSolarSystems"
+        " UNION ALL SELECT %u, regionID, regionName, 0 FROM mapRegions"
+        " UNION ALL SELECT %u, stationID, stationName, stationTypeID FROM staStations"
+        " UNION ALL SELECT %u, typeID, typeName, 0 FROM invTypes",
+        searchResultAgent, searchResultCharacter, searchResultCorporation, searchResultCorporationTicker,
+        searchResultAlliance, searchResultAllianceName, searchResultFaction, searchResultConstellation,
+        searchResultSolarSystem, searchResultRegion, searchResultStation, searchResultInventoryType))
+    {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
     }
-
-    return dict;
 }
 
-PyRep *SearchDB::QuickQuery(std::string string, std::vector<int> *searchID, uint32 charID, bool hideNPC, bool onlyAltName) {
-    uint8 size(searchID->size());
-
-    if (((size == 1) and (searchID->at(0) == 2))
-    or  (hideNPC)) {
-        /** @todo i dont remember what this was for, but need to finish it anyway */
+void SearchDB::GetOwnedItemTypes(DBQueryResult& res, const std::string& pattern, uint32 charID)
+{
+    if (!sDatabase.RunQuery(res,
+        "SELECT"
+        "   typeID"
+        " FROM entity"
+        " WHERE itemName LIKE '%s'"
+        " AND ownerID = %u", pattern.c_str(), charID ))
+    {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
     }
-
-    PyList *result = new PyList();
-    DBQueryResult res;
-    DBResultRow row;
-
-    for (uint8 i=0; i < searchID->size(); i++) {
-        switch(searchID->at(i)) {
-            case 1: //searchResultAgent = 1
-                sDatabase.RunQuery(res,
-                    "SELECT characterID"
-                    " FROM chrNPCCharacters"
-                    " WHERE characterName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 2: //searchResultCharacter = 2
-                sDatabase.RunQuery(res,
-                    "SELECT characterID"
-                    " FROM chrCharacters"
-                    " WHERE characterName LIKE '%s' ", string.c_str() );
-                break;
-            case 3: //searchResultCorporation = 3
-                sDatabase.RunQuery(res,
-                    "SELECT corporationID"
-                    " FROM crpCorporation"
-                    " WHERE corporationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 4: //searchResultAlliance = 4
-                sDatabase.RunQuery(res,
-                    "SELECT allianceID"
-                    " FROM alnAlliance"
-                    " WHERE shortName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 5: //searchResultFaction = 5
-                sDatabase.RunQuery(res,
-                    "SELECT factionID"
-                    " FROM facFactions"
-                    " WHERE factionName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 6: //searchResultConstellation = 6
-                sDatabase.RunQuery(res,
-                    "SELECT constellationID"
-                    " FROM mapConstellations"
-                    " WHERE constellationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 7: //searchResultSolarSystem = 7
-                sDatabase.RunQuery(res,
-                    "SELECT solarSystemID"
-                    " FROM mapSolarSystems "
-                    " WHERE solarSystemName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 8: //searchResultRegion = 8
-                sDatabase.RunQuery(res,
-                    "SELECT regionID"
-                    " FROM mapRegions"
-                    " WHERE regionName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 9: //searchResultStation = 9
-                sDatabase.RunQuery(res,
-                    "SELECT stationID"
-                    " FROM staStations "
-                    " WHERE stationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 10:    //searchResultInventoryType = 10
-                sDatabase.RunQuery(res,
-                    "SELECT typeID"
-                    " FROM invTypes"
-                    " WHERE typeName LIKE '%s'", string.c_str() );
-                break;
-        }
-        while (res.GetRow(row)) {
-            result->AddItem( new PyInt(row.GetUInt(0) ));
-        }
-    }
-
-    return result;
 }
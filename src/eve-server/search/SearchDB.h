@@ -41,6 +41,9 @@ enum SearchTypes {
     searchResultRegion          = 8,
     searchResultStation         = 9,
     searchResultInventoryType   = 10,
+    // not client search kinds; more names LookupService finds owners by
+    searchResultCorporationTicker = 11,
+    searchResultAllianceName    = 12,
     //searchResultAllOwners = [1, 2, 3, 4, 5],
     //searchResultAllLocations = [6, 7, 8, 9],
     searchMaxResults            = 500,
@@ -50,9 +53,10 @@ enum SearchTypes {
 class SearchDB
 : public ServiceDB {
 public:
-
-    PyRep* Query(std::string string, std::vector<int> *searchID, uint32 charID);
-    PyRep* QuickQuery(std::string string, std::vector<int> *searchID, uint32 charID, bool hideNPC = false, bool onlyAltName = false);
+    // every searchable name, as kind (SearchTypes), id, name, data (corporationType, stationTypeID or 0)
+    static void GetSearchNames(DBQueryResult& res);
+    // typeIDs of the items 'charID' owns whose names match 'pattern'
+    static void GetOwnedItemTypes(DBQueryResult& res, const std::string& pattern, uint32 charID);
 
 };
 
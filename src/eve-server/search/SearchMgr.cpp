@@ -0,0 +1,90 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-server.h"
+
+#include "search/SearchMgr.h"
+
+SearchMgr::SearchMgr()
+{
+}
+
+int SearchMgr::Initialize()
+{
+    LoadNames();
+    sLog.Blue("        SearchMgr", "Search Manager Initialized.");
+    return 1;
+}
+
+void SearchMgr::Close()
+{
+    m_index.Clear();
+    sLog.Warning("        SearchMgr", "Search Manager has been closed." );
+}
+
+void SearchMgr::LoadNames()
+{
+    double start = GetTimeMSeconds();
+
+    DBQueryResult res;
+    SearchDB::GetSearchNames(res);
+
+    std::vector<NameIndex::Entry> names;
+    names.reserve(res.GetRowCount());
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        if (row.IsNull(2))
+            continue;
+        NameIndex::Entry entry;
+        entry.kind = row.GetUInt(0);
+        entry.id   = row.GetUInt(1);
+        entry.name = row.GetText(2);
+        entry.data = row.IsNull(3) ? 0 : row.GetUInt(3);
+        names.push_back(entry);
+    }
+    m_index.Load(names);
+
+    sLog.Cyan("        SearchMgr", "%lu names loaded in %.3fms.", m_index.size(), (GetTimeMSeconds() - start));
+}
+
+void SearchMgr::SetName(uint8 kind, uint32 id, const std::string& name, uint32 data)
+{
+    m_index.Set(kind, id, name, data);
+}
+
+void SearchMgr::RemoveName(uint8 kind, uint32 id)
+{
+    m_index.Remove(kind, id);
+}
+
+void SearchMgr::Find(const std::string& pattern, uint32 kindMask, size_t limit, std::vector<const NameIndex::Entry*>& into)
+{
+    m_index.Search(pattern, kindMask, limit, into);
+}
+
+void SearchMgr::FindExact(const std::string& name, uint32 kindMask, std::vector<const NameIndex::Entry*>& into)
+{
+    m_index.Lookup(name, kindMask, into);
+}
@@ -0,0 +1,70 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __SEARCH__SEARCH_MGR_H__INCL__
+#define __SEARCH__SEARCH_MGR_H__INCL__
+
+#include "eve-server.h"
+#include "search/NameIndex.h"
+#include "search/SearchDB.h"
+
+/**
+ * Keeps every searchable name (characters, corporations, alliances, factions,
+ * map locations, stations and item types) in a NameIndex, kinds as SearchTypes,
+ * so Search and LookupService don't scan tables with LIKE.  The tables stay
+ * the record; character, corporation and alliance create and delete tell this.
+ */
+class SearchMgr
+: public Singleton< SearchMgr >
+{
+public:
+    SearchMgr();
+
+    int Initialize();
+    void Close();
+
+    // adds the name, or renames the one already there
+    void SetName(uint8 kind, uint32 id, const std::string& name, uint32 data = 0);
+    void RemoveName(uint8 kind, uint32 id);
+
+    /* names matching 'pattern' (LIKE syntax) of each kind in 'kindMask', at most 'limit' per kind.
+     * the entries are good until the next SetName() or RemoveName() */
+    void Find(const std::string& pattern, uint32 kindMask, size_t limit, std::vector<const NameIndex::Entry*>& into);
+    /* names equal to 'name', ignoring case */
+    void FindExact(const std::string& name, uint32 kindMask, std::vector<const NameIndex::Entry*>& into);
+    const NameIndex::Entry* GetName(uint8 kind, uint32 id)  { return m_index.Find(kind, id); }
+
+protected:
+    void LoadNames();
+
+private:
+    NameIndex m_index;
+};
+
+//Singleton
+#define sSearchMgr \
+( SearchMgr::get() )
+
+#endif  // __SEARCH__SEARCH_MGR_H__INCL__
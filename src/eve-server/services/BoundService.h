@@ -178,6 +178,10 @@ protected:
     {
         this->mBoundId = this->GetServiceManager().RegisterBoundService(this);
 
+        // profiled under the service that binds it
+        Dispatcher* service = dynamic_cast <Dispatcher*> (&parent);
+        this->mHandlers.SetOwner((service != nullptr ? service->GetName() : std::string("Bound")) + "(bound)");
+
         // build the id string
         std::stringstream strBuilder;
         strBuilder << "N=" << this->GetServiceManager().GetNodeID() << ":" << this->mBoundId;
@@ -202,7 +206,7 @@ protected:
      */
     template <class H, class... Args>
     void Add(const std::string& name, PyResult(H::*callHandler)(PyCallArgs&, Args...)) {
-        this->mHandlers.push_back(std::make_pair(std::string(name), new CallHandler <H> (callHandler)));
+        this->mHandlers.Add(name, new CallHandler <H> (callHandler));
     }
 
 public:
@@ -213,38 +217,14 @@ public:
         if (this->CanClientCall(args.client) == false)
             throw CustomError("This client is not allowed to call this bound service");
 
-        for (auto handler : this->mHandlers) {
-            if (handler.first != name)
-                continue;
-
-            try
-            {
-                return (*handler.second)(reinterpret_cast <void*> (this), args);
-            }
-            catch (std::invalid_argument)
-            {
-                // ignored, this just means the function does not match the possible calls
-            }
-        }
-
-        throw method_not_found ();
+        return this->mHandlers.Dispatch(reinterpret_cast <void*> (this), name, args);
     }
 
     /**
      * @brief Builds a string with information about calling a method in this service
      */
     std::string DebugDispatch (const std::string& name) override {
-        std::string result = name + " candidates: \n";
-
-        for (auto handler : this->mHandlers) {
-            if (handler.first != name)
-                continue;
-
-            result += "\t(" + handler.second->getSignature () + ")";
-            result += "\n";
-        }
-
-        return result;
+        return name + " candidates: \n" + this->mHandlers.GetCandidates(name);
     }
 
     /**
@@ -314,7 +294,7 @@ private:
     /** @var The numeric ID of the bound service */
     BoundID mBoundId;
     /** @var The map of handlers for this service */
-    std::vector <std::pair <std::string, CallHandlerBase*>> mHandlers;
+    CallHandlerTable mHandlers;
     /** @var The clients that have access to this bound service */
     std::map <Client*, bool> mClients;
 };
@@ -1,6 +1,8 @@
 #include "Callable.h"
 #include "Client.h"
 
+#include "utils/TimeStats.h"
+
 PyCallArgs::PyCallArgs(Client* c, PyTuple* tup, PyDict* dict) :
         client(c),
         tuple(tup)
@@ -38,6 +40,55 @@ void PyCallArgs::Dump(LogType type) const {
     }
 }
 
+/* CallHandlerTable */
+PyResult CallHandlerTable::Dispatch(void* service, const std::string& name, PyCallArgs& args) const {
+    auto it = this->mHandlers.find(name);
+
+    if (it == this->mHandlers.end())
+        throw method_not_found ();
+
+    uint32 timeKey = UINT32_MAX;
+    if (TimeStats::IsEnabled()) {
+        timeKey = it->second.timeKey.load(std::memory_order_relaxed);
+        if (timeKey == UINT32_MAX) {
+            timeKey = sTimeStats.GetKey(this->mOwner + "::" + name);
+            it->second.timeKey.store(timeKey, std::memory_order_relaxed);
+        }
+    }
+    TimeStatsScope timer(timeKey);
+
+    for (auto handler : it->second.overloads) {
+        if (handler->accepts(args) == false)
+            continue;
+
+        try
+        {
+            return (*handler)(service, args);
+        }
+        catch (std::invalid_argument&)
+        {
+            // thrown by the handler itself; as before, treat it like the overload did not match
+        }
+    }
+
+    throw method_not_found ();
+}
+
+std::string CallHandlerTable::GetCandidates(const std::string& name) const {
+    std::string result;
+    auto it = this->mHandlers.find(name);
+
+    if (it == this->mHandlers.end())
+        return result;
+
+    for (auto handler : it->second.overloads) {
+        result += "\t(" + handler->getSignature () + ")";
+        result += "\n";
+    }
+
+    return result;
+}
+
 /* PyResult */
 PyResult::PyResult() : ssResult(nullptr), ssNamedResult(nullptr) {}
 PyResult::PyResult(PyRep* result)
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <optional>
+#include <unordered_map>
 
 #include "eve-server.h"
 
@@ -63,7 +64,10 @@ template <class T> struct is_optional<std::optional<T>> : std::true_type {};
 
 struct CallHandlerBase {
 public:
+    /** Calls the handler, args must have passed accepts() */
     virtual PyResult operator() (void* service, PyCallArgs& args) const = 0;
+    /** Checks the argument types against the handler's signature */
+    virtual bool accepts (PyCallArgs& args) = 0;
     virtual const std::string& getSignature () = 0;
 };
 
@@ -76,20 +80,23 @@ struct CallHandler : public CallHandlerBase {
                     auto handler = reinterpret_cast <PyResult(S::*)(PyCallArgs&, Args...)> (erasedHandler);
 
                     if constexpr (sizeof...(Args) == 0) {
-                        // ensure there's no arguments in the data
-                        if (args.tuple->size() != 0)
-                            throw std::invalid_argument("expected 0 arguments");
-
                         // all the functions must have the PyCallArgs to know important info about the call
                         // like the client that sent it
                         return (service->*handler) (args);
                     } else {
-                        if (this->validateArgs <std::decay_t<Args>...>(args) == false)
-                            throw std::invalid_argument("arguments do not match");
-
                         return this->apply(service, handler, args);
                     }
                 }
+            },
+            validatorImpl {
+                [this](PyCallArgs& args) -> bool {
+                    if constexpr (sizeof...(Args) == 0) {
+                        // ensure there's no arguments in the data
+                        return args.tuple->size() == 0;
+                    } else {
+                        return this->validateArgs <std::decay_t<Args>...>(args);
+                    }
+                }
             }
     {
         this->generateSignature <std::decay_t <Args>...> ();
@@ -99,6 +106,10 @@ struct CallHandler : public CallHandlerBase {
         return handlerImpl(reinterpret_cast <S*> (service), erasedHandler, args);
     }
 
+    bool accepts (PyCallArgs& args) override {
+        return validatorImpl(args);
+    }
+
     const std::string& getSignature () {
         return this->signature;
     }
@@ -322,7 +333,46 @@ private:
 
     PyResult(S::*erasedHandler)() = nullptr;
     std::function <PyResult(S* service, PyResult(S::* erasedHandler)(), PyCallArgs& args)> handlerImpl;
+    std::function <bool(PyCallArgs& args)> validatorImpl;
     std::string signature;
 };
 
+/**
+ * @brief Method handlers of a service by name, built as the handlers are registered
+ *
+ * Overloads of a name are kept in registration order and the first one whose
+ * signature accepts the arguments is called.
+ */
+class CallHandlerTable {
+public:
+    void Add(const std::string& name, CallHandlerBase* handler) { this->mHandlers[name].overloads.push_back(handler); }
+
+    /**
+     * @brief Names the profiler keys of the methods, "<owner>::<method>"
+     */
+    void SetOwner(const std::string& owner) { this->mOwner = owner; }
+
+    /**
+     * @brief Calls the overload of the given method matching the arguments
+     *
+     * @throws method_not_found when there is no such method or no overload accepts the arguments
+     */
+    PyResult Dispatch(void* service, const std::string& name, PyCallArgs& args) const;
+
+    /**
+     * @brief Lists the signatures of the overloads of the given method, one per line
+     */
+    std::string GetCandidates(const std::string& name) const;
+
+private:
+    struct Method {
+        std::vector <CallHandlerBase*> overloads;
+        /** TimeStats key, registered on the first call made while profiling */
+        mutable std::atomic <uint32> timeKey {UINT32_MAX};
+    };
+
+    std::string mOwner;
+    std::unordered_map <std::string, Method> mHandlers;
+};
+
 #endif //EVEMU_CALLABLE_H
@@ -72,6 +72,7 @@ protected:
         mName(std::move(name)),
         mAccessLevel(level)
     {
+        this->mHandlers.SetOwner(this->mName);
     }
 
     /**
@@ -79,7 +80,7 @@ protected:
      */
     template <class H, class... Args>
     void Add(const std::string& name, PyResult(H::*callHandler)(PyCallArgs&, Args...)) {
-        this->mHandlers.push_back(std::make_pair(std::string(name), new CallHandler <H> (callHandler)));
+        this->mHandlers.Add(name, new CallHandler <H> (callHandler));
     }
 
 public:
@@ -92,38 +93,14 @@ public:
      * @brief Handles dispatching a call to this service
      */
     PyResult Dispatch(const std::string& name, PyCallArgs& args) override {
-        for (auto handler : this->mHandlers) {
-            if (handler.first != name)
-                continue;
-
-            try
-            {
-                return (*handler.second)(reinterpret_cast <void*> (this), args);
-            }
-            catch (std::invalid_argument)
-            {
-                // ignored, this just means the function does not match the possible calls
-            }
-        }
-
-        throw method_not_found ();
+        return this->mHandlers.Dispatch(reinterpret_cast <void*> (this), name, args);
     }
 
     /**
      * @brief Builds a string with information about calling a method in this service
      */
     std::string DebugDispatch (const std::string& name) override {
-        std::string result = GetName () + "::" + name + " candidates: \n";
-
-        for (auto handler : this->mHandlers) {
-            if (handler.first != name)
-                continue;
-
-            result += "\t(" + handler.second->getSignature () + ")";
-            result += "\n";
-        }
-
-        return result;
+        return GetName () + "::" + name + " candidates: \n" + this->mHandlers.GetCandidates(name);
     }
 
 private:
@@ -132,7 +109,7 @@ private:
     /** @var The access level required to access this service */
     AccessLevel mAccessLevel;
     /** @var The map of handlers for this service */
-    std::vector <std::pair <std::string, CallHandlerBase*>> mHandlers;
+    CallHandlerTable mHandlers;
 };
 
 #endif /* !__SERVICE_H__ */
\ No newline at end of file
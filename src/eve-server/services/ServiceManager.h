@@ -28,6 +28,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 
 #include "services/Callable.h"
 #include "services/Service.h"
@@ -48,7 +49,7 @@ public:
 
 class EVEServiceManager {
 public:
-    typedef std::map<std::string, Dispatcher*> ServicesMap;
+    typedef std::unordered_map<std::string, Dispatcher*> ServicesMap;
     typedef std::map<BoundID, BoundDispatcher*> BoundServicesMap;
 
     EVEServiceManager(NodeID nodeId);
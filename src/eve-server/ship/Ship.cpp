@@ -1838,7 +1838,7 @@ void ShipItem::ProcessShipEffects(bool update/*false*/)
         fxData data = fxData();
         data.action = FX::Action::Invalid;
         data.srcRef = static_cast<InventoryItemRef>(this);
-        sFxProc.ParseExpression(this, sFxDataMgr.GetExpression(it.second.preExpression), data);
+        sFxProc.ParseExpression(this, it.second.preExpression, data);
     }
 
     // On both undock and login/board, trust the persisted AttrOnline flags
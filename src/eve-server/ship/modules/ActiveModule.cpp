@@ -23,7 +23,6 @@
 ActiveModule::ActiveModule(ModuleItemRef mRef, ShipItemRef sRef)
 : GenericModule(mRef, sRef),
 m_timer(0, true),
-m_reloadTimer(0),
 m_bubble(nullptr),
 m_sysMgr(nullptr),
 m_targMgr(nullptr),
@@ -268,20 +267,6 @@ void ActiveModule::Clear()
 
 void ActiveModule::Process()
 {
-    // the order of Reload/Unload is significant.
-    if (m_reloadTimer.Enabled()) {
-        if (m_reloadTimer.Check(false)) {
-            // charge loading complete
-            m_reloadTimer.Disable();
-            // apply charge effects here after loading is complete, but only for empty modules (no previous charge fx)
-            if (!m_chargeLoaded)
-                sFxProc.ApplyEffects(m_modRef.get(), m_shipRef->GetPilot()->GetChar().get(), m_shipRef.get(), true);
-
-            m_ChargeState = Module::State::Loaded;
-            m_chargeLoaded = true;
-        }
-    }
-
     if (m_ModuleState < Module::State::Deactivating)
         return;
 
@@ -314,6 +299,17 @@ void ActiveModule::Process()
     }
 }
 
+void ActiveModule::LoadComplete()
+{
+    // apply charge effects here after loading is complete, but only for empty modules (no previous charge fx)
+    if (!m_chargeLoaded)
+        if (m_shipRef->GetPilot() != nullptr)
+            sFxProc.ApplyEffects(m_modRef.get(), m_shipRef->GetPilot()->GetChar().get(), m_shipRef.get(), true);
+
+    m_ChargeState = Module::State::Loaded;
+    m_chargeLoaded = true;
+}
+
 void ActiveModule::RemoveTarget(SystemEntity* pSE) {
     if (m_targetSE == pSE) {
         _log(MODULE__TRACE, "ActiveModule::RemoveTarget called on %s on %s to remove %s", m_modRef->name(), m_shipRef->name(), pSE->GetName());
@@ -890,7 +886,7 @@ void ActiveModule::LoadCharge(InventoryItemRef chargeRef)
             fxData data = fxData();
             data.action = FX::Action::Invalid;
             data.srcRef = chargeRef;
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+            sFxProc.ParseExpression(m_modRef.get(), it.second.preExpression, data, this);
         }
         if (pClient->IsInSpace()) {
             /*  **** this sets "reload blink" status on weapon button
@@ -909,7 +905,7 @@ void ActiveModule::LoadCharge(InventoryItemRef chargeRef)
                 tmp->SetItem(1, new PyInt(chargeRef->typeID()));
                 tmp->SetItem(2, new PyInt(m_reloadTime));
             pClient->SendNotification("OnChargeBeingLoadedToModule", "shipid", &tmp);
-            m_reloadTimer.Start(m_reloadTime);
+            m_reloadTimer.Start(m_reloadTime, [this]() { LoadComplete(); });
         }
     }
 
@@ -949,7 +945,7 @@ void ActiveModule::UnloadCharge()
             fxData data = fxData();
             data.action = FX::Action::Invalid;
             data.srcRef = m_chargeRef;
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.postExpression), data, this);
+            sFxProc.ParseExpression(m_modRef.get(), it.second.postExpression, data, this);
         }
 
         // apply to containing module to properly remove effects  -this doesnt work right for scripts.
@@ -1044,7 +1040,7 @@ void ActiveModule::ReprocessCharge()
         fxData data = fxData();
         data.action = FX::Action::dgmActInvalid;
         data.srcRef = m_chargeRef;
-        sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+        sFxProc.ParseExpression(m_modRef.get(), it.second.preExpression, data, this);
     } */
     sFxProc.ApplyEffects(m_modRef.get(), m_shipRef->GetPilot()->GetChar().get(), m_shipRef.get(), m_shipRef->GetPilot()->IsInSpace());
     m_chargeRef->ClearModifiers();
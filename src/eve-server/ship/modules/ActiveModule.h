@@ -90,6 +90,7 @@ protected:
 
     /* for modules that use charges */
     void                ConsumeCharge();                // common code to reduce ammo by one unit.
+    void                LoadComplete();                 // called by m_reloadTimer
 
     uint32              GetRemainingCycleTimeMS()       { return m_timer.GetRemainingTime(); }
 
@@ -108,7 +109,7 @@ protected:
 
 private:
     Timer               m_timer;
-    Timer               m_reloadTimer;
+    WheelTimer          m_reloadTimer;
 
 };
 
@@ -182,7 +182,7 @@ void GenericModule::Online()
                 data.srcRef = m_chargeRef;
                 sFxProc.ParseExpression(
                     m_modRef.get(),
-                    sFxDataMgr.GetExpression(it.second.preExpression),
+                    it.second.preExpression,
                     data, this);
             }
         }
@@ -272,7 +272,7 @@ void GenericModule::Offline()
                 data.srcRef = m_chargeRef;
                 sFxProc.ParseExpression(
                     m_modRef.get(),
-                    sFxDataMgr.GetExpression(it.second.postExpression),
+                    it.second.postExpression,
                     data, this);
             }
         }
@@ -318,13 +318,15 @@ void GenericModule::ProcessEffects(int8 state, bool active/*false*/)
         fxData data = fxData();
         data.action = FX::Action::Invalid;
         data.srcRef = m_modRef;
+        // these come and go with module cycles, so their targets keep them apart from their values
+        data.tracked = ((state == FX::State::Active) or (state == FX::State::Target) or (state == FX::State::Overloaded));
         /* module and charge effects will be added/removed from it's item
          * active/overload/gang/other effects will be applied and removed when called.
          */
         if (active) {
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+            sFxProc.ParseExpression(m_modRef.get(), it.second.preExpression, data, this);
         } else {
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.postExpression), data, this);
+            sFxProc.ParseExpression(m_modRef.get(), it.second.postExpression, data, this);
         }
     }
 }
@@ -150,6 +150,7 @@ bool ModuleManager::Initialize() {
                         //cur->SetQuantity(cur->quantity());    //OIC
                         cur->SetAttribute(AttrQuantity, cur->quantity(), false);   // OMAC
                         m_charges.emplace(cur->flag(), cur);
+                        fittingChanged();
                     }
                     pMod = nullptr;
                 } break;
@@ -977,6 +978,7 @@ void ModuleManager::LoadCharge(InventoryItemRef chargeRef, EVEItemFlags flag)
         chargeRef->Move(pShipItem->itemID(), flag, pShipItem->HasPilot()?pShipItem->GetPilot()->IsDocked():false);
         //chargeRef->Move(pShipItem->itemID(), flag, false);
         m_charges.emplace(flag, chargeRef);
+        fittingChanged();
     }
 
     // this will enable module loading blink if ship in space, even on reload/fillup
@@ -1039,6 +1041,7 @@ void ModuleManager::UnloadCharge(GenericModule* pMod)
 
     // verify no charge at flag in map
     m_charges.erase(pMod->flag());
+    fittingChanged();
 
     if (!pMod->IsLoaded()) {
         _log(MODULE__ERROR, "MM::UnloadCharge() - %s at %s is not loaded", \
@@ -1181,6 +1184,7 @@ void ModuleManager::UnloadAllModules()
         UnloadModule(cur.second->flag());
 
     m_charges.clear();
+    fittingChanged();
 }
 
 void ModuleManager::UpdateModules(std::vector<uint32> modVec)
@@ -1382,6 +1386,43 @@ void ModuleManager::GetModuleListByReqSkill(uint16 skillID, std::vector< Invento
             modVec.push_back(cur);
 }
 
+const std::vector<InventoryItemRef>& ModuleManager::GetFxModulesByGroup(uint16 groupID)
+{
+    auto itr = m_fxTargets.find((1 << 16) | groupID);
+    if (itr != m_fxTargets.end())
+        return itr->second;
+
+    std::vector<InventoryItemRef>& modVec = m_fxTargets[(1 << 16) | groupID];
+    for (auto cur : m_modules)
+        if ((cur.second != nullptr) and (cur.second->groupID() == groupID))
+            modVec.push_back(cur.second->GetSelf());
+    return modVec;
+}
+
+const std::vector<InventoryItemRef>& ModuleManager::GetFxModulesByReqSkill(uint16 skillID)
+{
+    auto itr = m_fxTargets.find((2 << 16) | skillID);
+    if (itr != m_fxTargets.end())
+        return itr->second;
+
+    std::vector<InventoryItemRef>& modVec = m_fxTargets[(2 << 16) | skillID];
+    GetModuleListByReqSkill(skillID, modVec);
+    return modVec;
+}
+
+const std::vector<InventoryItemRef>& ModuleManager::GetFxChargesByReqSkill(uint16 skillID)
+{
+    auto itr = m_fxTargets.find((3 << 16) | skillID);
+    if (itr != m_fxTargets.end())
+        return itr->second;
+
+    std::vector<InventoryItemRef>& chargeVec = m_fxTargets[(3 << 16) | skillID];
+    for (auto cur : m_charges)
+        if (cur.second->HasReqSkill(skillID))
+            chargeVec.push_back(cur.second);
+    return chargeVec;
+}
+
 void ModuleManager::SaveModules()
 {
     for (auto cur : m_modules)
@@ -1516,6 +1557,7 @@ void ModuleManager::addModuleRef(EVEItemFlags flag, GenericModule* pMod)
 {
     // add module to main map
     m_modules.at(flag) = pMod;
+    fittingChanged();
     // add module to proc maps
     if (IsFittingSlot(flag)) {
         m_fittings.at(flag) = pMod;
@@ -1572,6 +1614,7 @@ void ModuleManager::deleteModuleRef(EVEItemFlags flag, GenericModule* pMod)
 {
     // remove module from main map
     m_modules.at(flag) = nullptr;
+    fittingChanged();
     // remove module from proc maps
     if (IsFittingSlot(flag)) {
         m_fittings.at(flag) = nullptr;
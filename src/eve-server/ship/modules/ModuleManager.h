@@ -120,6 +120,11 @@ public:
     // hi, mid, low, rig, subsys
     void GetModuleListOfRefsOrderedRev(std::vector<InventoryItemRef>& modVec);
     void GetModuleListByReqSkill(uint16 skillID, std::vector<InventoryItemRef>& modVec);
+
+    /* effect target selections, kept until the fitting or loaded charges change */
+    const std::vector<InventoryItemRef>& GetFxModulesByGroup(uint16 groupID);
+    const std::vector<InventoryItemRef>& GetFxModulesByReqSkill(uint16 skillID);
+    const std::vector<InventoryItemRef>& GetFxChargesByReqSkill(uint16 skillID);
     void SaveModules();
 
     void GetActiveModules(uint8 rack, std::vector< GenericModule* >& modVec);
@@ -145,6 +150,8 @@ private:
     void addModuleRef(EVEItemFlags flag, GenericModule* pMod);
     // removes module ref from maps and adjusts slot count
     void deleteModuleRef(EVEItemFlags flag, GenericModule* pMod);
+    // drops the effect target selections; called on every change to m_modules or m_charges
+    void fittingChanged()                               { m_fxTargets.clear(); }
 
     bool m_initalized;
 
@@ -164,6 +171,7 @@ private:
     std::map<uint8, GenericModule*> m_systems;          // slot, module (for rigs and subsystems)
     std::map<uint8, GenericModule*> m_fittings;         // slot, module (for hi,mid,lo slots)
     std::map<EVEItemFlags, InventoryItemRef> m_charges; // slot, chargeItem
+    std::unordered_map<uint32, std::vector<InventoryItemRef>> m_fxTargets;  // (selection << 16 | id), targets
 };
 
 
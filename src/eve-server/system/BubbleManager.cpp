@@ -49,6 +49,7 @@ m_bubbleID(0)
     m_wanderers.clear();
     m_bubbleIDMap.clear();
     m_sysBubbleMap.clear();
+    m_sysBubbleGrid.clear();
 }
 
 BubbleManager::~BubbleManager() {
@@ -73,14 +74,7 @@ void BubbleManager::clear() {
 void BubbleManager::Process() {
     double profileStartTime(GetTimeUSeconds());
 
-    for (auto cur : m_bubbles) {
-        // process each belt and gate bubble for spawns
-        if (cur->IsBelt() or cur->IsGate())
-            cur->Process();
-        // process each mission and incursion bubble  -placeholder
-        if (cur->IsMission() or cur->IsIncursion())
-            cur->Process();
-    }
+    // belt and gate spawns run on each bubble's own spawn timer
 
     if (m_wanderTimer.Check()) {    //60s
         m_wanderers.clear();
@@ -249,13 +243,21 @@ SystemBubble* BubbleManager::FindBubble(uint32 systemID, const GPoint &pos) cons
     _log(DESTINY__BUBBLE_DEBUG, "BubbleManager::FindBubble() - Searching point %.1f, %.1f, %.1f in system %u.", \
                 pos.x, pos.y, pos.z, systemID);
 
-    auto range = m_sysBubbleMap.equal_range(systemID);
-    for ( auto itr = range.first; itr != range.second; ++itr )
-        if (itr->second->InBubble(pos))
-            return itr->second;
+    std::unordered_map<uint32, SpatialGrid<SystemBubble*>>::const_iterator itr = m_sysBubbleGrid.find(systemID);
+    if (itr == m_sysBubbleGrid.end())
+        return nullptr;
 
-    //not in any existing bubble.
-    return nullptr;
+    SystemBubble* pBubble(nullptr);
+    // reach includes the grey area InBubble() allows with debug logging on
+    itr->second.Visit(pos, BUBBLE_RADIUS_METERS + BUBBLE_HYSTERESIS_METERS, [&](SystemBubble* cur) {
+        if (!cur->InBubble(pos))
+            return false;
+        pBubble = cur;
+        return true;
+    });
+
+    //nullptr if not in any existing bubble.
+    return pBubble;
 }
 
 SystemBubble* BubbleManager::GetBubble(SystemManager* sysMgr, const GPoint& pos)
@@ -269,22 +271,29 @@ SystemBubble* BubbleManager::GetBubble(SystemManager* sysMgr, const GPoint& pos)
 
 SystemBubble* BubbleManager::MakeBubble(SystemManager* sysMgr, GPoint pos) {
     // determine if new center (pos) is within 2x radius of another bubble center. (overlap)
-    auto range = m_sysBubbleMap.equal_range(sysMgr->GetID());
-    for ( auto itr = range.first; itr != range.second; ++itr )
-        if (itr->second->IsOverlap(pos)) {
-            GVector dir(itr->second->GetCenter(), pos);
-            dir.normalize();
-            _log(DESTINY__BUBBLE_DEBUG, "BubbleManager::MakeBubble()::IsOverlap() - dir: %.3f,%.3f,%.3f", dir.x, dir.y, dir.z);
-            // move pos away from center
-            pos = itr->second->GetCenter() + (dir * (BUBBLE_RADIUS_METERS * 2));
-            break;
-        }
+    SpatialGrid<SystemBubble*>& grid = m_sysBubbleGrid.emplace(sysMgr->GetID(),
+            SpatialGrid<SystemBubble*>(BUBBLE_RADIUS_METERS * 2)).first->second;
+    SystemBubble* pOverlap(nullptr);
+    grid.Visit(pos, BUBBLE_RADIUS_METERS * 2 + BUBBLE_HYSTERESIS_METERS, [&](SystemBubble* cur) {
+        if (!cur->IsOverlap(pos))
+            return false;
+        pOverlap = cur;
+        return true;
+    });
+    if (pOverlap != nullptr) {
+        GVector dir(pOverlap->GetCenter(), pos);
+        dir.normalize();
+        _log(DESTINY__BUBBLE_DEBUG, "BubbleManager::MakeBubble()::IsOverlap() - dir: %.3f,%.3f,%.3f", dir.x, dir.y, dir.z);
+        // move pos away from center
+        pos = pOverlap->GetCenter() + (dir * (BUBBLE_RADIUS_METERS * 2));
+    }
 
     SystemBubble* pBubble = new SystemBubble(sysMgr, pos, BUBBLE_RADIUS_METERS);
     if (pBubble != nullptr) {
         m_bubbles.push_back(pBubble);
         m_bubbleIDMap.emplace(pBubble->GetID(), pBubble);
         m_sysBubbleMap.emplace(sysMgr->GetID(), pBubble);
+        grid.Insert(pBubble->GetCenter(), pBubble);
         if (sConfig.debug.BubbleTrack)
             pBubble->MarkCenter();
     }
@@ -308,6 +317,7 @@ void BubbleManager::ClearSystemBubbles(uint32 systemID)
     }
 
     m_sysBubbleMap.erase(systemID);
+    m_sysBubbleGrid.erase(systemID);
 }
 
 void BubbleManager::RemoveBubble(uint32 systemID, SystemBubble* pSB)
@@ -316,6 +326,12 @@ void BubbleManager::RemoveBubble(uint32 systemID, SystemBubble* pSB)
     for (auto itr = range.first; itr != range.second; ++itr)
         if (itr->second == pSB) {
             m_sysBubbleMap.erase(itr);
+            std::unordered_map<uint32, SpatialGrid<SystemBubble*>>::iterator gItr = m_sysBubbleGrid.find(systemID);
+            if (gItr != m_sysBubbleGrid.end()) {
+                gItr->second.Erase(pSB->GetCenter(), pSB);
+                if (gItr->second.empty())
+                    m_sysBubbleGrid.erase(gItr);
+            }
             return;
         }
     std::map<uint32, SystemBubble*>::iterator itr = m_bubbleIDMap.find(pSB->GetID());
@@ -27,6 +27,7 @@
 
 
 #include <unordered_map>
+#include "math/SpatialGrid.h"
 #include "system/SystemEntity.h"
 
 static const float BUBBLE_RADIUS_METERS = 300000.0f;       // EVE retail uses 250km and allows grid manipulation  NOTE:  this is based on testing for best results.  -allan
@@ -39,10 +40,9 @@ class GPoint;
 //any of the optimized space searching algorithms which we
 // may develop based on bubbles.
 //
-// Right now it is stupid and searches for a bubble using a
-// linear search. obviously a much better spacial partitioning
-// scheme could be written later (octtree or quadtree maybe?)
-// and this would be the place to put it.
+// bubble centers are kept in a hash grid per system, with cells
+// one bubble across, so finding a bubble only looks at the few
+// bubbles in cells near the point instead of all in the system.
 class BubbleManager
 : public Singleton<BubbleManager>
 {
@@ -114,6 +114,8 @@ private:
     std::map<uint32, SystemBubble*> m_bubbleIDMap;     // bubbleID/bubble*
 
     std::unordered_multimap<uint32, SystemBubble*> m_sysBubbleMap;  // systemID/bubble*
+
+    std::unordered_map<uint32, SpatialGrid<SystemBubble*>> m_sysBubbleGrid;  // systemID/bubble centers
 };
 
 //Singleton
@@ -2564,11 +2564,10 @@ void DestinyManager::SpeedBoost(bool deactivate/*false*/)
 
 void DestinyManager::WebbedMe(InventoryItemRef modRef, bool apply/*false*/)
 {
-    if (apply) {
-        m_maxShipSpeed *= (1 + (modRef->GetAttribute(AttrSpeedFactor).get_float() / 100.0f));
-    } else {
-        m_maxShipSpeed /= (1 + (modRef->GetAttribute(AttrSpeedFactor).get_float() / 100.0f));
-    }
+    // the web's modifier is already added to (or removed from) our maxVelocity, with any others on it.
+    //  scaling our speed by the web's factor here drifted over many cycles
+    m_maxShipSpeed = mySE->GetSelf()->GetAttribute(AttrMaxVelocity).get_float();
+    _log(DESTINY__MOVE_TRACE, "Destiny::WebbedMe() - %s %s.  maxShipSpeed: %.2f", modRef->name(), (apply ? "applied" : "removed"), m_maxShipSpeed);
     m_activeSpeedFraction = m_activeSpeedFraction * 0.999f;
     std::vector<PyTuple*> updates;
     SetBallSpeed sbms;
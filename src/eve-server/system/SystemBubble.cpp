@@ -50,8 +50,7 @@ m_tcuSE(nullptr),
 m_sbuSE(nullptr),
 m_ihubSE(nullptr),
 m_towerSE(nullptr),
-m_centerSE(nullptr),
-m_spawnTimer(0)
+m_centerSE(nullptr)
 {
     m_ice = false;
     m_belt = false;
@@ -107,31 +106,22 @@ void SystemBubble::clear() {
     m_dynamicEntities.clear();
 }
 
-void SystemBubble::Process()
+void SystemBubble::SpawnTimer(uint32 delay)
 {
-    /* this will need to process:
+    /* this will need to handle:
      *    belt and gate for spawn/respawn
      *    missions for ??
      *    incursions for ??
      */
-    if (m_belt and (m_system->GetSystemSecurityRating() > 0.90)) // make config option here to spawn rats in secure empire space?   nope.
+    // stays off until ResetBubbleRatSpawn() or the next pilot coming in starts it again
+    if (m_spawned)
         return;
-    if (m_spawned) {
-        m_spawnTimer.Disable();
+    if (m_players.empty())
         return;
-    }
 
-    // this must run a second time for spawn to actually hit.  first time only sets main system spawn timer.
-    // may be nuts, but will remain enabled as long as player in bubble and bubble has no rats.
-    if (m_spawnTimer.Enabled()) {
-        if (m_spawnTimer.Check()) {
-            if (!m_players.empty()) {
-                m_system->DoSpawnForBubble(this);
-            } else {
-                m_spawnTimer.Disable();
-            }
-        }
-    }
+    m_system->DoSpawnForBubble(this);
+    // runs again in case this didnt spawn anything
+    m_spawnTimer.Start(delay, [this, delay]() { SpawnTimer(delay); });
 }
 
 // called regularly (once every minute or so) from the bubble manager.
@@ -481,16 +471,16 @@ void SystemBubble::SetSpawnTimer(bool isBelt/*false*/)
 {
     if (m_system->GetSystemSecurityRating() > 0.90)
         return;
-    if (sConfig.debug.SpawnTest) {
-        m_spawnTimer.Start(5000); /* 5s for testing */
-    } else {
+    uint32 delay(5000); /* 5s for testing */
+    if (!sConfig.debug.SpawnTest) {
         // these randoms should be changed to reflect this npc's faction presence in system
         if (isBelt) {
-            m_spawnTimer.Start(MakeRandomInt(30, sConfig.npc.RoamingTimer) *1000);
+            delay = MakeRandomInt(30, sConfig.npc.RoamingTimer) *1000;
         } else {
-            m_spawnTimer.Start(MakeRandomInt(60, sConfig.npc.StaticTimer) *1000);
+            delay = MakeRandomInt(60, sConfig.npc.StaticTimer) *1000;
         }
     }
+    m_spawnTimer.Start(delay, [this, delay]() { SpawnTimer(delay); });
 }
 
 void SystemBubble::SetBelt(InventoryItemRef itemRef)
@@ -1136,6 +1126,9 @@ void SystemBubble::BubblecastDestinyUpdate( PyTuple** payload, const char* desc
 {
     if (is_log_enabled(DESTINY__BUBBLECAST_DUMP))
         (*payload)->Dump(DESTINY__BUBBLECAST_DUMP, "    ");
+    // every client gets the same bytes; marshal the payload once for all of them
+    if (m_players.size() > 1)
+        (*payload)->EncodeOnce();
     for (auto cur : m_players) {
         _log( DESTINY__BUBBLECAST, "Bubblecast %s update to %s(%u)", desc, cur.second->GetName(), cur.first );
         PyIncRef(*payload);
@@ -1145,6 +1138,8 @@ void SystemBubble::BubblecastDestinyUpdate( PyTuple** payload, const char* desc
 
 void SystemBubble::BubblecastDestinyUpdateExclusive( PyTuple** payload, const char* desc, SystemEntity* pSE ) const
 {
+    if (m_players.size() > 2)
+        (*payload)->EncodeOnce();
     for (auto cur : m_players) {
         // Only queue a Destiny update for this bubble if the current SystemEntity is not 'pSE':
         // (this is an update to all client objects in the bubble EXCLUDING 'pSE')
@@ -1160,6 +1155,8 @@ void SystemBubble::BubblecastDestinyEvent( PyTuple** payload, const char* desc )
 {
     if (is_log_enabled(DESTINY__BUBBLECAST_DUMP))
         (*payload)->Dump(DESTINY__BUBBLECAST_DUMP, "    ");
+    if (m_players.size() > 1)
+        (*payload)->EncodeOnce();
     for (auto cur : m_players) {
         _log( DESTINY__BUBBLECAST, "Bubblecast %s event to %s(%u)", desc, cur.second->GetName(), cur.first );
         PyIncRef(*payload);
@@ -1169,6 +1166,8 @@ void SystemBubble::BubblecastDestinyEvent( PyTuple** payload, const char* desc )
 
 void SystemBubble::BubblecastSendNotification(const char* notifyType, const char* idType, PyTuple** payload, bool seq)
 {
+    if (m_players.size() > 1)
+        (*payload)->EncodeOnce();
     for (auto cur : m_players) {
         _log( DESTINY__BUBBLECAST, "BubblecastNotify %s to %s(%u)", notifyType, cur.second->GetName(), cur.first );
         PyIncRef(*payload);
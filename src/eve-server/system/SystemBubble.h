@@ -55,7 +55,6 @@ public:
     SystemManager* const GetSystem() const              { return m_system; }
 
     /* for spawn system     -allan 15July15 */
-    void Process();
     void SetBelt(InventoryItemRef itemRef);
     void SetGate(uint32 gateID);
     void ResetBubbleRatSpawn();
@@ -204,7 +203,8 @@ private:
     std::map<uint32, DroneSE*> m_drones;                //we do not own these.
 
     // for spawn system     -allan 15July15
-    Timer m_spawnTimer;
+    void SpawnTimer(uint32 delay);      // m_spawnTimer ran out.  rearms itself with 'delay' while the bubble needs a spawn
+    WheelTimer m_spawnTimer;
     bool m_ice :1;
     bool m_belt :1;
     bool m_gate :1;
@@ -77,7 +77,6 @@ m_beltMgr(new BeltMgr(this, svc)),
 m_dungMgr(new DungeonMgr(this, svc)),
 m_spawnMgr(new SpawnMgr(this, svc)),
 m_loaded(false),
-m_entityChanged(false),
 m_docked(0),
 m_players(0),
 m_beltCount(0),
@@ -102,6 +101,7 @@ m_secValue(1.1f)
     m_beltVector.clear();
     m_roidBubbles.clear();
     m_ticEntities.clear();
+    m_ticList.clear();
     m_staticEntities.clear();
     m_opStaticEntities.clear();
 
@@ -227,31 +227,12 @@ bool SystemManager::LoadCosmicMgrs()
 bool SystemManager::ProcessTic() {
     double profileStartTime(GetTimeUSeconds());
 
-    /* the idea here is entities map NEVER has invalid items in it, but our iterator may become invalid
-     *      when SE->Process() returns because Process() will add/remove from the map as needed
-     *      (new objects, destroyed objects, moved objects, etc)
-     *  std::map internally orders items by key(itemID here), so use an int var to hold last-processed itemID (mLast).
-     *  when iteration starts over, increment until cur > mLast and continue from there to end of list.
+    /* SE->Process() may add or remove entities (new objects, destroyed objects, moved objects, etc).
+     *  m_ticList holds back what is added until this pass is done and skips what is removed,
+     *  so every entity here at the start of the tic is processed exactly once.
+     *  entities added during this tic get their first Process() call next tic.
      */
-    std::map<uint32, SystemEntity*>::iterator itr = m_ticEntities.begin();
-    uint32 mLast(0);
-    while (itr != m_ticEntities.end()) {
-        if (mLast >= itr->first) {
-            ++itr;
-            continue;
-        }
-
-         /* main process call. */
-        mLast = itr->first;     // not sure if this will slow this down or not.  check profile
-        itr->second->Process();
-
-        if (m_entityChanged) {
-            m_entityChanged = false;
-            itr = m_ticEntities.begin();
-            continue;
-        }
-        ++itr;
-    }
+    m_ticList.Tic([](SystemEntity* pSE) { pSE->Process(); });
 
     // tic for sov structures (as they aren't in ticEntities)
     for (auto cur : m_opStaticEntities)
@@ -259,7 +240,7 @@ bool SystemManager::ProcessTic() {
             cur.second->GetPOSSE()->Process();
     // check bounty timer
     if (m_bountyTimer.Check(sConfig.server.BountyPayoutDelayed))
-        PayBounties();
+        sEntityList.Stage([this]() { PayBounties(); });     // wallets, db and clients in other systems
     /* the following are coded for single-tic calls */
     m_anomMgr->Process();
     if (m_beltCount)
@@ -358,6 +339,7 @@ void SystemManager::UnloadSystem() {
     m_entities.clear();
     // this is dupe container. contents unloaded in another call
     m_ticEntities.clear();
+    m_ticList.clear();
     // at this point, system static entity list should be clear...but just in case, hit it again
     m_staticEntities.clear();
     // clear operational static entity list too
@@ -1079,8 +1061,8 @@ void SystemManager::AddEntity(SystemEntity* pSE, bool addSignal/*true*/) {
             sEntityList.AddProbe(itemID, pSE->GetProbeSE());
         } else if (!IsStaticItem(itemID)) {
             // *most* dynamic items need proc tics.  add to proc list
-            m_entityChanged = true;
             m_ticEntities[itemID] = pSE;
+            m_ticList.Add(itemID, pSE);
         } else {
             addSignal = false;
         }
@@ -1103,8 +1085,8 @@ void SystemManager::RemoveEntity(SystemEntity* pSE) {
     RemoveItemFromInventory(pSE->GetSelf());
     // remove entity from our maps
     uint32 itemID(pSE->GetID());
-    m_entityChanged = true;
-    m_ticEntities.erase(itemID);
+    if (m_ticEntities.erase(itemID) > 0)
+        m_ticList.Remove(itemID);
     m_staticEntities.erase(itemID);
     m_opStaticEntities.erase(itemID);
 
@@ -27,6 +27,7 @@
 #ifndef __SYSTEMMANAGER_H_INCL__
 #define __SYSTEMMANAGER_H_INCL__
 
+#include "utils/TicList.h"
 #include "system/BubbleManager.h"
 #include "system/SolarSystem.h"
 #include "system/SystemDB.h"
@@ -223,11 +224,11 @@ private:
     uint32 m_activityTime;
 
     // system entity lists:
-    bool m_entityChanged :1;
     std::map<uint32, NPC*> m_npcs;
     std::map<uint32, Client*> m_clients;
     std::map<uint32, SystemEntity*> m_entities;         // this list is all entities in this system.  we own these.
     std::map<uint32, SystemEntity*> m_ticEntities;      // this list is for entities that need process tics (objects, npc, client ships)
+    TicList<uint32, SystemEntity*> m_ticList;           // same entities as m_ticEntities, in the order they are processed
     std::map<uint32, SystemEntity*> m_staticEntities;   // this list is for static entities to send in setstate
     std::map<uint32, SystemEntity*> m_opStaticEntities; // this list is for static entities which are operational and need to be initialized and operated upon even when system is empty
 
@@ -33,7 +33,6 @@
 #include "eve-server.h"
 
 #include "EVEServerConfig.h"
-#include "Profiler.h"
 #include "Client.h"
 #include "inventory/AttributeEnum.h"
 #include "npc/NPC.h"
@@ -60,43 +59,29 @@ TargetManager::TargetManager(SystemEntity *self)
     m_targetedBy.clear();
 }
 
-bool TargetManager::Process() {
-    double profileStartTime(GetTimeUSeconds());
+TargetManager::~TargetManager()
+{
+    // pending lock timers go with the entries
+    Unload();
+}
 
-    if (m_targets.empty())
-        return false;
+void TargetManager::LockComplete(SystemEntity* tSE)
+{
+    std::map<SystemEntity*, TargetEntry*>::iterator itr = m_targets.find(tSE);
+    if (itr == m_targets.end())
+        return;
 
-    //process outgoing targeting (outgoing will call incoming as needed)
-    std::map<SystemEntity*, TargetEntry*>::iterator itr = m_targets.begin();
-    while (itr != m_targets.end()) {
-        if ((itr->first == nullptr) or (itr->second == nullptr)) {
-            itr = m_targets.erase(itr);
-            continue;
-        }
-        switch (itr->second->state) {
-            case TargMgr::State::Idle:
-            case TargMgr::State::Locked:{          //do nothing
-            } break;
-            case TargMgr::State::Passive:   // this will be used with stealth modules (which, ofc, are not written yet)
-            case TargMgr::State::Locking: {
-                if (itr->second->timer.Check(false)) {
-                    itr->second->timer.Disable();
-                    itr->second->state = TargMgr::State::Locked;
-                    _log(TARGET__TRACE, "%s(%u) has finished locking %s(%u)", \
-                            mySE->GetName(), mySE->GetID(), itr->first->GetName(), itr->first->GetID());
-                    TargetAdded(itr->first);
-                    itr->first->TargetMgr()->TargetedByLocked(mySE);
-                    m_canAttack = true;
-                }
-            } break;
-        }
-        ++itr;
+    switch (itr->second->state) {
+        case TargMgr::State::Passive:   // this will be used with stealth modules (which, ofc, are not written yet)
+        case TargMgr::State::Locking: {
+            itr->second->state = TargMgr::State::Locked;
+            _log(TARGET__TRACE, "%s(%u) has finished locking %s(%u)", \
+                    mySE->GetName(), mySE->GetID(), tSE->GetName(), tSE->GetID());
+            TargetAdded(tSE);
+            tSE->TargetMgr()->TargetedByLocked(mySE);
+            m_canAttack = true;
+        } break;
     }
-
-    if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::targets, GetTimeUSeconds() - profileStartTime);
-
-    return true;
 }
 
 void TargetManager::Unload() {
@@ -184,8 +169,8 @@ bool TargetManager::StartTargeting(SystemEntity *tSE, ShipItemRef sRef)
 
     TargetEntry *te = new TargetEntry();
         te->state = TargMgr::State::Locking;
-        te->timer.Start(lockTime *1000);      //timer has ms resolution
     m_targets[tSE] = te;
+    te->timer.Start(lockTime *1000, [this, tSE]() { LockComplete(tSE); });      //timer has ms resolution
     tSE->TargetMgr()->TargetedAdd(mySE);
 
     if (is_log_enabled(TARGET__INFO))
@@ -193,8 +178,6 @@ bool TargetManager::StartTargeting(SystemEntity *tSE, ShipItemRef sRef)
                 mySE->GetPilot()->GetName(), mySE->GetName(), mySE->GetID(), tSE->GetName(), \
                 tSE->GetID(), targetDistance, lockTime);
 
-    sEntityList.AddTargMgr(mySE, this);
-
     Dump();
     return true;
 }
@@ -223,15 +206,13 @@ bool TargetManager::StartTargeting(SystemEntity *tSE, float lockTime, uint8 maxL
 
     TargetEntry *te = new TargetEntry();
         te->state = TargMgr::State::Locking;
-        te->timer.Start(lockTime);
     m_targets[tSE] = te;
+    te->timer.Start(lockTime, [this, tSE]() { LockComplete(tSE); });
     tSE->TargetMgr()->TargetedAdd(mySE);
 
     _log(TARGET__INFO, "NPC %s(%u) started targeting %s(%u) (%.2fs lock time)", \
             mySE->GetName(), mySE->GetID(), tSE->GetName(), tSE->GetID(), (lockTime /1000));
 
-    sEntityList.AddTargMgr(mySE, this);
-
     Dump();
 
     return true;
@@ -243,11 +224,8 @@ void TargetManager::RemoveTarget(SystemEntity* tSE) {
         SafeDelete(itr->second);
         m_targets.erase(itr);
     }
-    if (m_targets.empty()) {
+    if (m_targets.empty())
         m_canAttack = false;
-        // no targets to process.  remove from proc map
-        sEntityList.DeleteTargMgr(mySE);
-    }
     _log(TARGET__TRACE, "RemoveTarget:  %s(%u) has removed target %s(%u).", \
             mySE->GetName(), mySE->GetID(), tSE->GetName(), tSE->GetID());
 }
@@ -257,11 +235,8 @@ void TargetManager::ClearTarget(SystemEntity *tSE) {
     tSE->TargetMgr()->TargetedByLost(mySE);
     //clear it from our own state
     TargetLost(tSE);
-    if (m_targets.empty()) {
+    if (m_targets.empty())
         m_canAttack = false;
-        // no targets to process.  remove from proc map
-        sEntityList.DeleteTargMgr(mySE);
-    }
     _log(TARGET__TRACE, "ClearTarget:  %s(%u) has cleared target %s(%u).", \
             mySE->GetName(), mySE->GetID(), tSE->GetName(), tSE->GetID());
 }
@@ -302,9 +277,6 @@ void TargetManager::ClearTargets(bool notify/*true*/) {
     }
 
     m_targets.clear();
-
-    // no targets to process.  remove from proc map
-    sEntityList.DeleteTargMgr(mySE);
 }
 
 void TargetManager::ClearFromTargets() {
@@ -335,11 +307,8 @@ void TargetManager::TargetLost(SystemEntity *tSE) {
     SafeDelete(itr->second);
     m_targets.erase(itr);
 
-    if (m_targets.empty()) {
+    if (m_targets.empty())
         m_canAttack = false;
-        // no targets to process.  remove from proc map
-        sEntityList.DeleteTargMgr(mySE);
-    }
     _log(TARGET__INFO, "%s(%u) has lost lock on %s(%u)", mySE->GetName(), mySE->GetID(), tSE->GetName(), tSE->GetID());
 
     if (mySE->IsSentrySE())
@@ -79,10 +79,9 @@ class PyList;
 class TargetManager {
 public:
     TargetManager(SystemEntity* self);
-    ~TargetManager()                            { /* do nothing here */ }
+    ~TargetManager();
 
     /* Common Methods for all objects */
-    bool                Process();
     void                Unload();       // called on npcs from sysMgr when unloading system.
 
     // iterate thru the map of modules targeting this object and call AbortCycle on each.
@@ -164,6 +163,9 @@ protected:
     static const char*  GetModeName(uint8 mode);
     static const char*  GetStateName(uint8 state);
 
+    // lock timer of a target ran out
+    void                LockComplete(SystemEntity* tSE);
+
     //called in reaction to outgoing targeting events in other target managers.
     void                TargetedByLocked(SystemEntity *tSE);
     void                TargetedByLost(SystemEntity *tSE);
@@ -171,13 +173,13 @@ protected:
     class TargetEntry {
     public:
         TargetEntry()
-        : state(TargMgr::State::Idle), timer(0) {}
+        : state(TargMgr::State::Idle) {}
 
         void Dump(SystemEntity* pSE) const;
 
         uint8 state;
 
-        Timer timer;
+        WheelTimer timer;   // lock time; calls LockComplete()
     };
 
     class TargetedByEntry {
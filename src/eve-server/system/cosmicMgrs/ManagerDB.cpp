@@ -77,7 +77,7 @@ void ManagerDB::GetSkillList(DBQueryResult& res)
 
 void ManagerDB::GetAttributeTypes(DBQueryResult& res)
 {
-    if (!sDatabase.RunQuery(res, "SELECT attributeID, attributeName, attributeCategory, displayName, categoryID FROM dgmAttributeTypes"))
+    if (!sDatabase.RunQuery(res, "SELECT attributeID, attributeName, attributeCategory, displayName, categoryID, stackable FROM dgmAttributeTypes"))
         codelog(DATABASE__ERROR, "Error in GetAttributeTypes query: %s", res.error.c_str());
 
     _log(DATABASE__RESULTS, "GetAttributeTypes returned %lu items", res.GetRowCount());
@@ -91,6 +91,48 @@ void ManagerDB::GetTypeAttributes(DBQueryResult& res)
     _log(DATABASE__RESULTS, "GetTypeAttributes returned %lu items", res.GetRowCount());
 }
 
+bool ManagerDB::GetSnapshotChecksum(std::string& into)
+{
+    // every table a snapshotted set is read from.  CHECKSUM TABLE reads the whole table, but it's one pass per table
+    DBQueryResult res;
+    if (!sDatabase.RunQuery(res,
+        "CHECKSUM TABLE invTypes, invMetaTypes, ramTypeRequirements, mapSolarSystems, mapDenormalize, staStations, dgmTypeAttributes"))
+    {
+        codelog(DATABASE__ERROR, "Error in GetSnapshotChecksum query: %s", res.error.c_str());
+        return false;
+    }
+
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        // a table that's missing has a null checksum; that's as good as a change
+        into += row.GetText(0);
+        into += ":";
+        into += (row.IsNull(1) ? "-" : row.GetText(1));
+        into += ";";
+    }
+
+    if (!sDatabase.RunQuery(res,
+        "SELECT TABLE_NAME, COLUMN_NAME, COLUMN_TYPE FROM information_schema.COLUMNS"
+        " WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME IN"
+        " ('invTypes', 'invMetaTypes', 'ramTypeRequirements', 'mapSolarSystems', 'mapDenormalize', 'staStations', 'dgmTypeAttributes')"
+        " ORDER BY TABLE_NAME, ORDINAL_POSITION"))
+    {
+        codelog(DATABASE__ERROR, "Error in GetSnapshotChecksum query: %s", res.error.c_str());
+        return false;
+    }
+
+    while (res.GetRow(row)) {
+        into += row.GetText(0);
+        into += ".";
+        into += row.GetText(1);
+        into += " ";
+        into += row.GetText(2);
+        into += ";";
+    }
+
+    return true;
+}
+
 void ManagerDB::LoadNPCCorpFactionData(DBQueryResult& res)
 {
     if (!sDatabase.RunQuery(res, "SELECT corporationID, factionID FROM crpNPCCorporations" ))
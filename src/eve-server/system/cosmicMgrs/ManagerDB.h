@@ -43,6 +43,8 @@ public:
     static void GetAttributeTypes(DBQueryResult& res);
     static void GetTypeAttributes(DBQueryResult& res);
     static void LoadNPCCorpFactionData(DBQueryResult& res);
+    /* checksums and column types of the tables behind the data manager's snapshot, as text */
+    static bool GetSnapshotChecksum(std::string& into);
 
     static void LoadCorpFactions(std::map<uint32, uint32> &into);
     static void LoadFactionStationCounts(std::map<uint32, uint32> &into);
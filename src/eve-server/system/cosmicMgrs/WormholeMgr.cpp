@@ -289,7 +289,7 @@ void WormholeMgr::CreateExit(SystemManager* pFromSys, uint32 exitSystemID, uint3
 
 // Pick a random type of wormhole to create based upon the class of the system in question
 const ItemType* WormholeMgr::GetRandomWormholeType(uint32 systemID) {
-    std::vector<uint32> destTypes = sDataMgr.GetWHDestinationTypes(sDataMgr.GetWHSystemClass(systemID));
+    Span<uint32> destTypes = sDataMgr.GetWHDestinationTypes(sDataMgr.GetWHSystemClass(systemID));
     if(destTypes.size()<1) {
         return nullptr;
     }
@@ -300,7 +300,9 @@ const ItemType* WormholeMgr::GetRandomWormholeType(uint32 systemID) {
 // Pick a random destination of wormhole based upon its typeID
 uint32 WormholeMgr::GetRandomDestination(const ItemType* whType) {
     uint8 targetClass = whType->GetAttribute(AttrWormholeTargetSystemClass).get_uint32();
-    std::vector<uint32> destSystems = sDataMgr.GetWHClassSystems(targetClass);
+    Span<uint32> destSystems = sDataMgr.GetWHClassSystems(targetClass);
+    if (destSystems.empty())
+        return 0;
     return destSystems[MakeRandomInt(0,destSystems.size()-1)];
 }
 
@@ -0,0 +1,266 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "EVE_Corp.h"
+#include "EVE_Wallet.h"
+#include "account/WalletLedger.h"
+
+/*
+ * Pays bounties the way SystemManager::PayBounties() does on its tic: every
+ * character gets a BountyPrizes entry, and its corp takes its tax back out of
+ * the character's wallet into the corp's master wallet.  Every few tics the
+ * pending rows are taken, as WalletMgr's flush does.
+ *
+ * Each batch taken is written to a model of the db (journal rows, then the
+ * balances, then the flushed sequence), and the model is checked against the
+ * ledger.  One flush "crashes" after the journal rows and half the balances;
+ * the recovery WalletMgr runs at startup has to bring the model back to the
+ * ledger's balances.  Overdrafts must be refused without changing anything.
+ *
+ * usage: eve-test account/WalletLedgerBench [characters] [tics]
+ */
+
+namespace {
+
+const uint32 sCharacterBase = 90000001;
+const uint32 sCorpBase = 98000001;
+const uint32 sCharactersPerCorp = 20;
+const uint32 sTicsPerFlush = 5;
+const double sTaxRate = 0.1;
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+uint32 CorpOf( uint32 charID )      { return sCorpBase + ( charID - sCharacterBase ) / sCharactersPerCorp; }
+
+/* what the db holds of the wallets and journal */
+struct ModelDB
+{
+    struct Row { double balance; uint64_t seq; };
+
+    std::map<std::pair<uint32, uint16>, Row> wallets;
+    std::vector<WalletLedger::Entry> journal;
+    uint64_t flushed = 0;
+
+    /* one flush, in the order WalletMgr queues it; 'crash' stops after the journal and half the balances */
+    void Write( const std::vector<WalletLedger::Entry>& rows, const std::vector<WalletLedger::Balance>& balances, uint64_t seq, bool crash )
+    {
+        journal.insert( journal.end(), rows.begin(), rows.end() );
+        const size_t count = ( crash ? balances.size() / 2 : balances.size() );
+        for( size_t i = 0; i < count; ++i ) {
+            Row& row = wallets[ std::make_pair( balances[ i ].ownerID, balances[ i ].accountKey ) ];
+            row.balance = balances[ i ].balance;
+            row.seq = balances[ i ].seq;
+        }
+        if( !crash )
+            flushed = seq;
+    }
+
+    /* what AccountDB::RecoverWallets() does: a journal row past both the flushed
+     * sequence and its wallet's sequence holds a balance the wallet never got */
+    size_t Recover()
+    {
+        size_t count = 0;
+        for( const WalletLedger::Entry& cur : journal ) {
+            if( cur.seq <= flushed )
+                continue;
+            std::map<std::pair<uint32, uint16>, Row>::iterator itr = wallets.find( std::make_pair( cur.ownerID, cur.accountKey ) );
+            if( ( itr == wallets.end() ) or ( cur.seq <= itr->second.seq ) )
+                continue;
+            itr->second.balance = cur.balance;
+            itr->second.seq = cur.seq;
+            ++count;
+        }
+        for( const WalletLedger::Entry& cur : journal )
+            flushed = std::max( flushed, cur.seq );
+        return count;
+    }
+
+    bool Matches( const WalletLedger& ledger ) const
+    {
+        for( const auto& cur : wallets ) {
+            double balance = 0.0;
+            ledger.GetBalance( cur.first.first, cur.first.second, balance );
+            if( std::fabs( balance - cur.second.balance ) > 0.005 ) {
+                ::printf( "wallet %u/%u: ledger %.2f, db %.2f\n", cur.first.first, cur.first.second, balance, cur.second.balance );
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/* one bounty and its tax.  @return entries made */
+size_t PayBounty( WalletLedger& ledger, uint32 charID, double amount, uint32 systemID )
+{
+    WalletLedger::Entry entry;
+    entry.ownerID = charID;
+    entry.ownerFromID = corpCONCORD;
+    entry.ownerToID = charID;
+    entry.referenceID = systemID;
+    entry.accountKey = Account::KeyType::Cash;
+    entry.entryTypeID = Journal::EntryType::BountyPrizes;
+    entry.currency = Account::CreditType::ISK;
+    entry.date = GetFileTimeNow();
+    entry.amount = amount;
+    entry.description = "NBLT: 23323:1,23332:2,...";
+    if( !ledger.Apply( entry ) )
+        return 0;
+
+    entry.ownerFromID = charID;
+    entry.ownerToID = CorpOf( charID );
+    entry.entryTypeID = Journal::EntryType::CorporationTaxNpcBounties;
+    entry.amount = -amount * sTaxRate;
+    entry.description = "DESC: Corporation Tax on pirate bounty";
+    if( !ledger.Apply( entry ) )
+        return 1;
+
+    entry.ownerID = entry.ownerToID;
+    entry.amount = amount * sTaxRate;
+    return ( ledger.Apply( entry ) ? 3 : 2 );
+}
+
+}
+
+int account_WalletLedgerBench( int argc, char* argv[] )
+{
+    const uint32 characters = ( 1 < argc ? atoi( argv[1] ) : 1000 );
+    const uint32 tics = ( 2 < argc ? atoi( argv[2] ) : 1000 );
+    const uint32 corps = ( characters + sCharactersPerCorp - 1 ) / sCharactersPerCorp;
+
+    WalletLedger ledger;
+    ModelDB db;
+    for( uint32 i = 0; i < characters; ++i ) {
+        const double balance = 1000000.0 * ( i % 7 );
+        ledger.Load( sCharacterBase + i, Account::KeyType::Cash, balance );
+        db.wallets[ std::make_pair( sCharacterBase + i, (uint16)Account::KeyType::Cash ) ] = { balance, 0 };
+    }
+    for( uint32 i = 0; i < corps; ++i ) {
+        ledger.Load( sCorpBase + i, Account::KeyType::Cash, 0.0 );
+        db.wallets[ std::make_pair( sCorpBase + i, (uint16)Account::KeyType::Cash ) ] = { 0.0, 0 };
+    }
+
+    // an overdraft changes nothing
+    WalletLedger::Entry entry;
+    entry.ownerID = sCharacterBase;
+    entry.accountKey = Account::KeyType::Cash;
+    entry.amount = -1.0;
+    if( ledger.Apply( entry ) or ( ledger.GetSequence() != 0 ) or ( ledger.JournalCount() != 0 ) or ( ledger.DirtyCount() != 0 ) ) {
+        ::printf( "overdraft of an empty wallet was applied\n" );
+        return 1;
+    }
+    entry.ownerID = 1;      // nobody loaded it
+    entry.amount = 1.0;
+    if( ledger.Apply( entry ) ) {
+        ::printf( "a wallet that isn't loaded was changed\n" );
+        return 1;
+    }
+
+    uint32 seed = 1234;
+    std::vector<WalletLedger::Entry> rows;
+    std::vector<WalletLedger::Balance> balances;
+    size_t entries = 0, flushes = 0, taken = 0, recovered = 0;
+    double paid = 0.0, payTime = 0.0, takeTime = 0.0;
+    for( uint32 tic = 1; tic <= tics; ++tic ) {
+        double start = GetTimeUSeconds();
+        for( uint32 i = 0; i < characters; ++i ) {
+            const double amount = 10000.0 * ( 1 + Random( seed, 500 ) );
+            const size_t made = PayBounty( ledger, sCharacterBase + i, amount, 30000001 + i % 50 );
+            if( made != 3 ) {
+                ::printf( "tic %u: bounty to %u stopped after %lu entries\n", tic, sCharacterBase + i, made );
+                return 1;
+            }
+            entries += made;
+            paid += amount;
+        }
+        payTime += GetTimeUSeconds() - start;
+
+        if( ( tic % sTicsPerFlush ) and ( tic < tics ) )
+            continue;
+
+        start = GetTimeUSeconds();
+        ledger.TakePending( rows, balances );
+        takeTime += GetTimeUSeconds() - start;
+        ++flushes;
+        taken += rows.size();
+
+        for( size_t i = 1; i < rows.size(); ++i )
+            if( rows[ i - 1 ].seq >= rows[ i ].seq ) {
+                ::printf( "flush %lu: journal row %lu out of sequence\n", flushes, i );
+                return 1;
+            }
+        if( balances.size() != characters + corps ) {
+            ::printf( "flush %lu: %lu changed wallets, expected %u\n", flushes, balances.size(), characters + corps );
+            return 1;
+        }
+
+        // the second flush crashes half way; recovery has to finish it
+        const bool crash = ( flushes == 2 );
+        db.Write( rows, balances, ledger.GetSequence(), crash );
+        if( crash ) {
+            recovered = db.Recover();
+            if( recovered == 0 ) {
+                ::printf( "recovery found nothing to redo\n" );
+                return 1;
+            }
+        }
+        if( !db.Matches( ledger ) )
+            return 1;
+    }
+
+    if( ( taken != entries ) or ( ledger.JournalCount() != 0 ) or ( ledger.DirtyCount() != 0 ) ) {
+        ::printf( "%lu entries made, %lu taken, %lu left\n", entries, taken, ledger.JournalCount() );
+        return 1;
+    }
+
+    // taxes only move isk around, so everything held is the starting isk plus the bounties
+    double start = 0.0, total = 0.0, balance = 0.0;
+    for( uint32 i = 0; i < characters; ++i ) {
+        start += 1000000.0 * ( i % 7 );
+        ledger.GetBalance( sCharacterBase + i, Account::KeyType::Cash, balance );
+        total += balance;
+    }
+    for( uint32 i = 0; i < corps; ++i ) {
+        ledger.GetBalance( sCorpBase + i, Account::KeyType::Cash, balance );
+        total += balance;
+    }
+    if( std::fabs( total - start - paid ) > 1.0 ) {
+        ::printf( "wallets hold %.2f, expected %.2f\n", total, start + paid );
+        return 1;
+    }
+    ::printf( "%lu entries over %u tics and %lu flushes match the db model (%lu journal rows replayed after a crash)\n",
+              entries, tics, flushes, recovered );
+
+    ::printf( "%10s %10s %12s %12s %12s %12s\n", "chars", "tics", "entries/s", "us/tic", "us/flush", "rows/flush" );
+    ::printf( "%10u %10u %12.0f %12.1f %12.1f %12.0f\n", characters, tics, entries / ( ( payTime + takeTime ) / 1e6 ),
+              payTime / tics, takeTime / flushes, (double)taken / flushes );
+
+    return 0;
+}
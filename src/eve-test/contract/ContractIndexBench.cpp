@@ -0,0 +1,297 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "contract/ContractIndex.h"
+
+/*
+ * Fills a ContractIndex with outstanding contracts spread over regions and
+ * systems, with items of types that fall in groups and categories the way
+ * invTypes does, then runs searches shaped like the client's contract browser:
+ * by contract type, mostly within a region or system, often for an item type,
+ * group or category, sometimes with a price or reward range, issuer or
+ * availability.
+ *
+ * The searches are checked against a scan of every contract, before and after
+ * a round of accepts and new contracts; then searches, adds and removes are
+ * timed on the index alone, and a few searches with the scan for comparison.
+ *
+ * usage: eve-test contract/ContractIndexBench [contracts]
+ */
+
+namespace {
+
+const uint32 sRegions = 66;
+const uint32 sSystemsPerRegion = 80;
+const uint32 sTypes = 3000;
+const uint32 sTypesPerGroup = 25;
+const uint32 sGroupsPerCategory = 12;
+const uint32 sIssuers = 5000;
+const size_t sLimit = 1000;
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+uint32 RegionID( uint32 region )                { return 10000001 + region; }
+uint32 SystemID( uint32 region, uint32 system ) { return 30000001 + region * sSystemsPerRegion + system; }
+uint32 GroupOf( uint32 typeID )                 { return 1 + ( typeID - 1 ) / sTypesPerGroup; }
+uint32 CategoryOf( uint32 typeID )              { return 1 + ( GroupOf( typeID ) - 1 ) / sGroupsPerCategory; }
+
+Contract::IndexData MakeContract( uint32 contractID, uint32& seed )
+{
+    Contract::IndexData data = Contract::IndexData();
+    data.contractID = contractID;
+    const uint32 roll = Random( seed, 100 );
+    data.type = ( roll < 60 ? 1 : ( roll < 85 ? 2 : 3 ) );
+    data.isPrivate = ( Random( seed, 10 ) == 0 );
+    data.forCorp = ( Random( seed, 8 ) == 0 );
+    data.issuerID = 90000001 + Random( seed, sIssuers );
+    data.issuerCorpID = 98000001 + ( data.issuerID - 90000001 ) / 10;
+    data.assigneeID = ( data.isPrivate ? 90000001 + Random( seed, sIssuers ) : 0 );
+
+    // trade hubs: a third of everything sits in four regions
+    const uint32 region = ( Random( seed, 3 ) == 0 ? Random( seed, 4 ) : Random( seed, sRegions ) );
+    data.startRegionID = RegionID( region );
+    data.startSystemID = SystemID( region, Random( seed, 4 ) == 0 ? 0 : Random( seed, sSystemsPerRegion ) );
+    if( data.type == 3 ) {
+        const uint32 endRegion = ( Random( seed, 2 ) == 0 ? region : Random( seed, sRegions ) );
+        data.endRegionID = RegionID( endRegion );
+        data.endSystemID = SystemID( endRegion, Random( seed, sSystemsPerRegion ) );
+    } else {
+        data.endSystemID = data.startSystemID;
+    }
+
+    data.price = ( data.type == 3 ? 0.0 : (double)( 1 + Random( seed, 1000 ) ) * 1e5 );
+    data.reward = ( data.type == 1 ? 0.0 : (double)Random( seed, 200 ) * 1e5 );
+
+    const uint32 items = 1 + ( Random( seed, 4 ) == 0 ? Random( seed, 12 ) : 0 );
+    for( uint32 i = 0; i < items; ++i ) {
+        // a few types are far more common than the rest
+        const uint32 typeID = 1 + ( Random( seed, 2 ) == 0 ? Random( seed, 60 ) : Random( seed, sTypes ) );
+        data.typeIDs.push_back( typeID );
+        data.groupIDs.push_back( GroupOf( typeID ) );
+        data.categoryIDs.push_back( CategoryOf( typeID ) );
+    }
+    return data;
+}
+
+Contract::SearchFilter MakeFilter( uint32& seed )
+{
+    Contract::SearchFilter f;
+    const uint32 type = Random( seed, 4 );
+    f.typeMask = ( type == 0 ? ( ( 1 << 1 ) | ( 1 << 2 ) ) : ( 1 << type ) );
+
+    const uint32 region = ( Random( seed, 2 ) == 0 ? Random( seed, 4 ) : Random( seed, sRegions ) );
+    const uint32 where = Random( seed, 10 );
+    if( where < 6 )
+        f.startRegionID = RegionID( region );
+    else if( where < 8 )
+        f.startSystemID = SystemID( region, Random( seed, 3 ) == 0 ? 0 : Random( seed, sSystemsPerRegion ) );
+
+    const uint32 what = Random( seed, 10 );
+    if( what < 3 ) {
+        const uint32 count = 1 + Random( seed, 3 );
+        for( uint32 i = 0; i < count; ++i )
+            f.typeIDs.push_back( 1 + ( Random( seed, 2 ) == 0 ? Random( seed, 60 ) : Random( seed, sTypes ) ) );
+    } else if( what < 5 ) {
+        f.groupID = GroupOf( 1 + Random( seed, sTypes ) );
+    } else if( what < 7 ) {
+        f.categoryID = CategoryOf( 1 + Random( seed, sTypes ) );
+    }
+
+    if( Random( seed, 4 ) == 0 ) {
+        f.minPrice = (double)Random( seed, 500 ) * 1e5;
+        f.maxPrice = f.minPrice + (double)( 1 + Random( seed, 100 ) ) * 1e5;
+    }
+    if( Random( seed, 6 ) == 0 )
+        f.minReward = (double)Random( seed, 200 ) * 1e5;
+    if( Random( seed, 8 ) == 0 ) {
+        f.endRegionID = RegionID( Random( seed, sRegions ) );
+    }
+    if( Random( seed, 12 ) == 0 ) {
+        f.issuerIsCorp = ( Random( seed, 2 ) == 0 );
+        f.issuerID = ( f.issuerIsCorp ? 98000001 + Random( seed, sIssuers / 10 ) : 90000001 + Random( seed, sIssuers ) );
+    }
+    const uint32 availability = Random( seed, 10 );
+    if( availability < 6 ) {
+        f.availability = 0;
+    } else if( availability == 6 ) {
+        f.availability = 1;
+        f.assigneeID = 90000001 + Random( seed, sIssuers );
+    }
+    return f;
+}
+
+bool Has( const std::vector<uint32>& ids, uint32 id )
+{
+    return std::find( ids.begin(), ids.end(), id ) != ids.end();
+}
+
+/* the reference: every contract checked in full, like the old query did */
+size_t Scan( const std::map<uint32, Contract::IndexData>& all, const Contract::SearchFilter& f, std::vector<uint32>& into )
+{
+    into.clear();
+    size_t found = 0;
+    for( auto itr = all.rbegin(); itr != all.rend(); ++itr ) {
+        const Contract::IndexData& c = itr->second;
+        if( ( f.typeMask & ( 1u << c.type ) ) == 0 )
+            continue;
+        if( f.startRegionID != 0 and c.startRegionID != f.startRegionID )
+            continue;
+        if( f.startSystemID != 0 and c.startSystemID != f.startSystemID )
+            continue;
+        if( f.endRegionID != 0 and c.endRegionID != f.endRegionID )
+            continue;
+        if( f.endSystemID != 0 and c.endSystemID != f.endSystemID )
+            continue;
+        if( c.price < f.minPrice or c.price > f.maxPrice or c.reward < f.minReward or c.reward > f.maxReward )
+            continue;
+        if( f.groupID != 0 and !Has( c.groupIDs, f.groupID ) )
+            continue;
+        if( f.categoryID != 0 and !Has( c.categoryIDs, f.categoryID ) )
+            continue;
+        if( f.issuerID != 0 and ( c.forCorp != f.issuerIsCorp or ( f.issuerIsCorp ? c.issuerCorpID : c.issuerID ) != f.issuerID ) )
+            continue;
+        if( f.availability == 0 and c.isPrivate )
+            continue;
+        if( f.availability == 1 and ( !c.isPrivate or c.assigneeID != f.assigneeID ) )
+            continue;
+        if( !f.typeIDs.empty() ) {
+            bool any = false;
+            for( uint32 typeID : f.typeIDs )
+                any = any or Has( c.typeIDs, typeID );
+            if( !any )
+                continue;
+        }
+        if( into.size() < sLimit )
+            into.push_back( c.contractID );
+        ++found;
+    }
+    return found;
+}
+
+/* @return false (and says why) on the first search the index and the scan disagree on */
+bool Check( const ContractIndex& index, const std::map<uint32, Contract::IndexData>& all, size_t searches, uint32 seed, size_t& hits )
+{
+    std::vector<uint32> a, b;
+    for( size_t i = 0; i < searches; ++i ) {
+        const Contract::SearchFilter f = MakeFilter( seed );
+        const size_t foundA = index.Search( f, sLimit, a );
+        const size_t foundB = Scan( all, f, b );
+        if( foundA != foundB or a != b ) {
+            ::printf( "search %lu: index found %lu, scan found %lu\n", i, foundA, foundB );
+            return false;
+        }
+        hits += foundA;
+    }
+    return true;
+}
+
+}
+
+int contract_ContractIndexBench( int argc, char* argv[] )
+{
+    const size_t count = ( 1 < argc ? atoi( argv[1] ) : 200000 );
+
+    uint32 seed = 4242;
+    std::vector<Contract::IndexData> contracts;
+    contracts.reserve( count );
+    for( size_t i = 0; i < count; ++i )
+        contracts.push_back( MakeContract( (uint32)i + 1, seed ) );
+
+    ContractIndex index;
+    std::map<uint32, Contract::IndexData> all;
+    double start = GetTimeUSeconds();
+    for( const Contract::IndexData& cur : contracts )
+        index.Add( cur );
+    const double loadTime = ( GetTimeUSeconds() - start ) / 1e6;
+    for( const Contract::IndexData& cur : contracts )
+        all.emplace( cur.contractID, cur );
+
+    // verify, then accept a tenth of them, issue as many new ones and verify again
+    const size_t checked = 400;
+    size_t hits = 0;
+    if( !Check( index, all, checked, 77, hits ) )
+        return 1;
+
+    const size_t churn = count / 10;
+    uint32 nextID = (uint32)count + 1;
+    for( size_t i = 0; i < churn; ++i ) {
+        const uint32 contractID = 1 + Random( seed, (uint32)count );
+        if( index.Remove( contractID ) != ( all.erase( contractID ) == 1 ) ) {
+            ::printf( "remove of %u: index and scan disagree\n", contractID );
+            return 1;
+        }
+        const Contract::IndexData data = MakeContract( nextID++, seed );
+        index.Add( data );
+        all.emplace( data.contractID, data );
+    }
+    if( index.size() != all.size() ) {
+        ::printf( "index holds %lu contracts, scan %lu\n", index.size(), all.size() );
+        return 1;
+    }
+    if( !Check( index, all, checked, 78, hits ) )
+        return 1;
+    ::printf( "%lu searches (%lu contracts found) match a full scan\n", checked * 2, hits );
+
+    // time
+    const size_t searches = 20000;
+    std::vector<Contract::SearchFilter> filters;
+    uint32 fseed = 99;
+    for( size_t i = 0; i < searches; ++i )
+        filters.push_back( MakeFilter( fseed ) );
+
+    std::vector<uint32> into;
+    size_t found = 0;
+    start = GetTimeUSeconds();
+    for( const Contract::SearchFilter& f : filters )
+        found += index.Search( f, sLimit, into );
+    const double searchTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    const size_t scans = 200;
+    start = GetTimeUSeconds();
+    for( size_t i = 0; i < scans; ++i )
+        Scan( all, filters[ i ], into );
+    const double scanTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    // accept and reissue: each removes one contract and adds one
+    start = GetTimeUSeconds();
+    for( size_t i = 0; i < churn; ++i ) {
+        index.Remove( 1 + Random( seed, nextID - 1 ) );
+        contracts[ i ].contractID = nextID++;
+        index.Add( contracts[ i ] );
+    }
+    const double churnTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    ::printf( "%10s %12s %12s %12s %12s %12s\n", "contracts", "loads/s", "searches/s", "scans/s", "avg found", "churn/s" );
+    ::printf( "%10lu %12.0f %12.0f %12.0f %12.1f %12.0f\n", index.size(), count / loadTime, searches / searchTime, scans / scanTime,
+              (double)found / searches, churn / churnTime );
+
+    return ( found > 0 ? 0 : 1 );
+}
@@ -0,0 +1,155 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "database/dbcore.h"
+
+/*
+ * Runs a short fixed-rate tick loop against a live MySQL/MariaDB server while
+ * every tick queues a batch of bulk writes, first with RunQuery() and then with
+ * RunQueryAsync() on the pool, and reports how late and how long the ticks were.
+ * Creates and drops table 'dbPoolBench' in the given database.
+ *
+ * usage: eve-test database/DBPoolBench host user password database [port] [ticks] [writes] [rows]
+ */
+
+namespace {
+
+const double TICK_USEC = 100000.0;  // 10Hz, keeps the run short
+
+struct TickResult
+{
+    double avgWork, maxWork;    // ms spent in tick body
+    double maxLate;             // ms a tick started after its slot
+    uint32 callbacks;           // async reads completed during the run
+};
+
+std::string BuildWrite( uint32 tick, uint32 write, uint32 rows )
+{
+    std::ostringstream q;
+    q << "INSERT INTO dbPoolBench (id, val, pad) VALUES ";
+    for( uint32 i = 0; i < rows; ++i ) {
+        if( i > 0 )
+            q << ", ";
+        q << "(" << ( write * rows + i ) << ", " << tick << ", REPEAT('x', 200))";
+    }
+    q << " ON DUPLICATE KEY UPDATE val=VALUES(val), pad=VALUES(pad)";
+    return q.str();
+}
+
+TickResult RunTicks( bool async, uint32 ticks, uint32 writes, uint32 rows )
+{
+    TickResult res = TickResult();
+    double total( 0.0 );
+    double next = GetTimeUSeconds();
+    for( uint32 t = 0; t < ticks; ++t ) {
+        double start = GetTimeUSeconds();
+        res.maxLate = std::max( res.maxLate, ( start - next ) / 1000.0 );
+
+        sDatabase.ProcessCompletions();
+        for( uint32 w = 0; w < writes; ++w ) {
+            std::string q( BuildWrite( t, w, rows ) );
+            if( async ) {
+                sDatabase.RunQueryAsync( "%s", q.c_str() );
+            } else {
+                DBerror err;
+                sDatabase.RunQuery( err, "%s", q.c_str() );
+            }
+        }
+        if( async )
+            sDatabase.RunQueryAsync( [&res]( DBQueryResult& r ) { ++res.callbacks; }, "SELECT COUNT(*) FROM dbPoolBench" );
+
+        double work = ( GetTimeUSeconds() - start ) / 1000.0;
+        total += work;
+        res.maxWork = std::max( res.maxWork, work );
+
+        next += TICK_USEC;
+        double now = GetTimeUSeconds();
+        if( next > now )
+            std::this_thread::sleep_for( std::chrono::microseconds( (int64)( next - now ) ) );
+    }
+    res.avgWork = total / ticks;
+    return res;
+}
+
+void PrintResult( const char* name, const TickResult& res )
+{
+    ::printf( "%-10s tick work avg %8.3fms  max %8.3fms   max late %8.3fms\n",
+              name, res.avgWork, res.maxWork, res.maxLate );
+}
+
+}
+
+int database_DBPoolBench( int argc, char* argv[] )
+{
+    if( argc < 5 ) {
+        ::puts( "usage: database/DBPoolBench host user password database [port] [ticks] [writes] [rows]" );
+        return EXIT_FAILURE;
+    }
+
+    int16 port( 3306 );
+    uint32 ticks( 50 ), writes( 20 ), rows( 500 );
+    if( argc > 5 )
+        port = atoi( argv[5] );
+    if( argc > 6 )
+        ticks = atoi( argv[6] );
+    if( argc > 7 )
+        writes = atoi( argv[7] );
+    if( argc > 8 )
+        rows = atoi( argv[8] );
+
+    sDatabase.Initialize( argv[1], argv[2], argv[3], argv[4], false, false, port );
+    if( sDatabase.GetStatus() != DBcore::Connected )
+        return EXIT_FAILURE;
+
+    DBerror err;
+    if( !sDatabase.RunQuery( err, "CREATE TABLE IF NOT EXISTS dbPoolBench"
+                                  " (id INT UNSIGNED NOT NULL PRIMARY KEY, val INT UNSIGNED NOT NULL, pad VARCHAR(255) NOT NULL)" ) ) {
+        ::printf( "Failed to create table: %s\n", err.c_str() );
+        return EXIT_FAILURE;
+    }
+
+    ::printf( "%u ticks at 10Hz, %u writes of %u rows per tick\n", ticks, writes, rows );
+    PrintResult( "RunQuery", RunTicks( false, ticks, writes, rows ) );
+
+    sDatabase.StartPool( 2 );
+    TickResult async( RunTicks( true, ticks, writes, rows ) );
+    size_t backlog( sDatabase.GetPendingCount() );
+    double drain = GetTimeUSeconds();
+    while( sDatabase.GetPendingCount() > 0 )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    drain = ( GetTimeUSeconds() - drain ) / 1000.0;
+    sDatabase.ProcessCompletions();
+    PrintResult( "Async", async );
+    ::printf( "           %u reads completed on the main loop, %lu writes still queued at the end (drained in %.1fms)\n",
+              async.callbacks, backlog, drain );
+    sDatabase.StopPool();
+
+    sDatabase.RunQuery( err, "DROP TABLE dbPoolBench" );
+    sDatabase.Close();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "database/dbcore.h"
+
+/*
+ * Loads rows one id at a time from an entity-shaped table against a live
+ * MySQL/MariaDB server, the way ItemDB::GetItemData() does on the item-load
+ * path, first with formatted RunQuery() and then with RunPrepared(), and
+ * reports rows/sec for each.
+ * Creates and drops table 'dbPreparedBench' in the given database.
+ *
+ * usage: eve-test database/DBPreparedBench host user password database [port] [rows] [passes]
+ */
+
+namespace {
+
+double LoadText( uint32 rows, uint32 passes, double& checksum )
+{
+    double start = GetTimeUSeconds();
+    DBQueryResult res;
+    DBResultRow row;
+    for( uint32 p = 0; p < passes; ++p ) {
+        for( uint32 id = 0; id < rows; ++id ) {
+            if( !sDatabase.RunQuery( res,
+                    "SELECT itemName, typeID, ownerID, locationID, flag, singleton, quantity, x, y, z, customInfo"
+                    " FROM dbPreparedBench WHERE itemID=%u", id ) )
+                return 0.0;
+            if( res.GetRow( row ) )
+                checksum += row.GetUInt( 1 ) + row.GetDouble( 7 ) + row.ColumnLength( 0 );
+        }
+    }
+    return ( GetTimeUSeconds() - start ) / 1000000.0;
+}
+
+double LoadPrepared( uint32 rows, uint32 passes, double& checksum )
+{
+    double start = GetTimeUSeconds();
+    DBPreparedResult res;
+    DBPreparedRow row;
+    for( uint32 p = 0; p < passes; ++p ) {
+        for( uint32 id = 0; id < rows; ++id ) {
+            if( !sDatabase.RunPrepared( res,
+                    "SELECT itemName, typeID, ownerID, locationID, flag, singleton, quantity, x, y, z, customInfo"
+                    " FROM dbPreparedBench WHERE itemID=?", id ) )
+                return 0.0;
+            if( res.GetRow( row ) )
+                checksum += row.GetUInt( 1 ) + row.GetDouble( 7 ) + row.ColumnLength( 0 );
+        }
+    }
+    return ( GetTimeUSeconds() - start ) / 1000000.0;
+}
+
+void PrintResult( const char* name, uint32 loads, double secs, double checksum )
+{
+    if( secs <= 0.0 ) {
+        ::printf( "%-12s failed\n", name );
+        return;
+    }
+    ::printf( "%-12s %8u rows in %8.3fs  %10.0f rows/sec  (checksum %.0f)\n",
+              name, loads, secs, loads / secs, checksum );
+}
+
+}
+
+int database_DBPreparedBench( int argc, char* argv[] )
+{
+    if( argc < 5 ) {
+        ::puts( "usage: database/DBPreparedBench host user password database [port] [rows] [passes]" );
+        return EXIT_FAILURE;
+    }
+
+    int16 port( 3306 );
+    uint32 rows( 10000 ), passes( 3 );
+    if( argc > 5 )
+        port = atoi( argv[5] );
+    if( argc > 6 )
+        rows = atoi( argv[6] );
+    if( argc > 7 )
+        passes = atoi( argv[7] );
+
+    sDatabase.Initialize( argv[1], argv[2], argv[3], argv[4], false, false, port );
+    if( sDatabase.GetStatus() != DBcore::Connected )
+        return EXIT_FAILURE;
+
+    DBerror err;
+    if( !sDatabase.RunQuery( err, "CREATE TABLE IF NOT EXISTS dbPreparedBench"
+                                  " (itemID INT UNSIGNED NOT NULL PRIMARY KEY, itemName VARCHAR(85) NOT NULL,"
+                                  " typeID INT UNSIGNED NOT NULL, ownerID INT UNSIGNED NOT NULL, locationID INT UNSIGNED NOT NULL,"
+                                  " flag SMALLINT UNSIGNED NOT NULL, singleton TINYINT(1) NOT NULL, quantity INT NOT NULL,"
+                                  " x DOUBLE NOT NULL, y DOUBLE NOT NULL, z DOUBLE NOT NULL, customInfo TEXT)" ) ) {
+        ::printf( "Failed to create table: %s\n", err.c_str() );
+        return EXIT_FAILURE;
+    }
+
+    // fill in batches so setup doesn't dominate the run
+    for( uint32 base = 0; base < rows; base += 1000 ) {
+        std::ostringstream q;
+        q << "INSERT INTO dbPreparedBench VALUES ";
+        for( uint32 id = base; id < std::min( rows, base + 1000 ); ++id ) {
+            if( id > base )
+                q << ", ";
+            q << "(" << id << ", 'Item " << id << "', " << ( 587 + id % 50 ) << ", 140000000, 60003760, 4, 0, "
+              << ( id % 1000 ) << ", " << id * 1.5 << ", " << -( id * 2.5 ) << ", " << id * 0.25 << ", NULL)";
+        }
+        if( !sDatabase.RunQuery( err, "%s", q.str().c_str() ) ) {
+            ::printf( "Failed to fill table: %s\n", err.c_str() );
+            sDatabase.RunQuery( err, "DROP TABLE dbPreparedBench" );
+            return EXIT_FAILURE;
+        }
+    }
+
+    ::printf( "%u rows, %u passes of single-row loads by itemID\n", rows, passes );
+    double textSum( 0.0 ), prepSum( 0.0 );
+    PrintResult( "RunQuery", rows * passes, LoadText( rows, passes, textSum ), textSum );
+    PrintResult( "RunPrepared", rows * passes, LoadPrepared( rows, passes, prepSum ), prepSum );
+
+    sDatabase.RunQuery( err, "DROP TABLE dbPreparedBench" );
+    sDatabase.Close();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "database/dbcore.h"
+
+/*
+ * Delivers one mail to a few thousand recipients against a live MySQL/MariaDB
+ * server, the way MailDB::SendMail() writes its status rows: first one INSERT
+ * per recipient with RunQuery(), then multi-row INSERTs queued on the pool with
+ * the last one as a RunWriteAsync() whose callback marks the mail delivered.
+ * Reports how long the main thread was held and how long until delivery.
+ * Creates and drops table 'mailFanoutBench' in the given database.
+ *
+ * usage: eve-test database/MailFanoutBench host user password database [port] [recipients] [batch]
+ */
+
+namespace {
+
+std::string BuildBatch( uint32 messageID, uint32 first, uint32 count )
+{
+    std::ostringstream q;
+    q << "INSERT INTO mailFanoutBench (messageID, characterID, statusMask, labelMask) VALUES ";
+    for( uint32 i = 0; i < count; ++i ) {
+        if( i > 0 )
+            q << ", ";
+        q << "(" << messageID << ", " << ( 90000000 + first + i ) << ", 0, 1)";
+    }
+    return q.str();
+}
+
+/* @return ms the main thread spent on the inserts */
+double SendSingleRows( uint32 messageID, uint32 recipients )
+{
+    double start = GetTimeUSeconds();
+    DBerror err;
+    for( uint32 i = 0; i < recipients; ++i )
+        sDatabase.RunQuery( err, "INSERT INTO mailFanoutBench (messageID, characterID, statusMask, labelMask) VALUES (%u, %u, 0, 1)",
+                            messageID, 90000000 + i );
+    return ( GetTimeUSeconds() - start ) / 1000.0;
+}
+
+/* sets 'held' to ms the main thread spent queuing; @return ms until the delivery callback ran */
+double SendBatched( uint32 messageID, uint32 recipients, uint32 batch, double& held )
+{
+    bool delivered( false );
+    double start = GetTimeUSeconds();
+    for( uint32 first = 0; first < recipients; first += batch ) {
+        uint32 count = std::min( batch, recipients - first );
+        std::string q( BuildBatch( messageID, first, count ) );
+        if( first + count < recipients )
+            sDatabase.RunQueryAsync( "%s", q.c_str() );
+        else
+            sDatabase.RunWriteAsync( [&delivered]( DBQueryResult& r ) { delivered = true; }, "%s", q.c_str() );
+    }
+    held = ( GetTimeUSeconds() - start ) / 1000.0;
+
+    while( !delivered ) {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        sDatabase.ProcessCompletions();
+    }
+    return ( GetTimeUSeconds() - start ) / 1000.0;
+}
+
+}
+
+int database_MailFanoutBench( int argc, char* argv[] )
+{
+    if( argc < 5 ) {
+        ::puts( "usage: database/MailFanoutBench host user password database [port] [recipients] [batch]" );
+        return EXIT_FAILURE;
+    }
+
+    int16 port( 3306 );
+    uint32 recipients( 5000 ), batch( 1000 );
+    if( argc > 5 )
+        port = atoi( argv[5] );
+    if( argc > 6 )
+        recipients = atoi( argv[6] );
+    if( argc > 7 )
+        batch = std::max( atoi( argv[7] ), 1 );
+
+    sDatabase.Initialize( argv[1], argv[2], argv[3], argv[4], false, false, port );
+    if( sDatabase.GetStatus() != DBcore::Connected )
+        return EXIT_FAILURE;
+
+    DBerror err;
+    if( !sDatabase.RunQuery( err, "CREATE TABLE IF NOT EXISTS mailFanoutBench"
+                                  " (messageID INT UNSIGNED NOT NULL, characterID INT UNSIGNED NOT NULL,"
+                                  "  statusMask TINYINT UNSIGNED NOT NULL, labelMask INT UNSIGNED NOT NULL,"
+                                  "  PRIMARY KEY (messageID, characterID))" ) ) {
+        ::printf( "Failed to create table: %s\n", err.c_str() );
+        return EXIT_FAILURE;
+    }
+
+    ::printf( "one mail to %u recipients\n", recipients );
+    double single = SendSingleRows( 1, recipients );
+    ::printf( "RunQuery   main thread held %9.1fms, delivered after %9.1fms\n", single, single );
+
+    sDatabase.StartPool( 2 );
+    double held( 0.0 );
+    double delivered = SendBatched( 2, recipients, batch, held );
+    ::printf( "Batched    main thread held %9.1fms, delivered after %9.1fms (%u rows per insert)\n", held, delivered, batch );
+    sDatabase.StopPool();
+
+    sDatabase.RunQuery( err, "DROP TABLE mailFanoutBench" );
+    sDatabase.Close();
+
+    return EXIT_SUCCESS;
+}
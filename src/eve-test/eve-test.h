@@ -41,6 +41,8 @@
 // marshal
 #include "marshal/EVEMarshal.h"
 #include "marshal/EVEUnmarshal.h"
+// network
+#include "network/TCPConnection.h"
 // python/classes
 #include "python/classes/PyDatabase.h"
 // utils
@@ -0,0 +1,167 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "log/LogQueue.h"
+
+#ifdef _WIN32
+#   include <io.h>
+#   define dup  _dup
+#   define dup2 _dup2
+#   define NULL_DEVICE "NUL"
+#else
+#   include <unistd.h>
+#   define NULL_DEVICE "/dev/null"
+#endif
+
+/*
+ * Has a number of threads _log() as fast as they can, to console and logfile,
+ * the way the server does with a busy debug category turned on: first printing
+ * on the calling threads (the default), then through LogQueue.
+ *
+ * Checks that with LogQueue every line ends up in the logfile once, whole and
+ * in the order its thread logged it, unless it was counted as dropped.
+ *
+ * Console output goes to the null device while this runs.
+ *
+ * usage: eve-test log/LogQueueBench [threads] [lines per thread]
+ */
+
+namespace {
+
+const char* const LOG_FILE = "LogQueueBench.log";
+
+void LogLines( size_t thread, size_t lines )
+{
+    for( size_t i = 0; i < lines; ++i )
+        _log( COMMON__MESSAGE, "bench thread %lu line %lu: ship %u entered bubble %u at (%.1f, %.1f, %.1f)",
+              thread, i, (uint32)( 140000000 + i ), (uint32)( thread * 7 ), i * 1.5, i * -2.5, thread * 1000.0 );
+}
+
+/* @return wall time in us for all threads to get their lines logged */
+double Run( size_t threads, size_t lines )
+{
+    std::vector<std::thread*> workers;
+    const double start = GetTimeUSeconds();
+    for( size_t t = 0; t < threads; ++t )
+        workers.push_back( new std::thread( LogLines, t, lines ) );
+    for( auto cur : workers ) {
+        cur->join();
+        SafeDelete( cur );
+    }
+    return GetTimeUSeconds() - start;
+}
+
+/* every line there once, in order per thread, unless dropped */
+bool Verify( size_t threads, size_t lines, uint64_t dropped )
+{
+    FILE* file = fopen( LOG_FILE, "r" );
+    if( file == NULL ) {
+        ::printf( "unable to read %s\n", LOG_FILE );
+        return false;
+    }
+
+    std::vector<long> last( threads, -1 );
+    uint64_t found = 0;
+    bool ok = true;
+    char line[ 512 ];
+    while( ok and fgets( line, sizeof( line ), file ) != NULL ) {
+        unsigned long thread = 0, index = 0;
+        const char* text = strstr( line, "bench thread " );
+        if( text == NULL )
+            continue;
+        if( sscanf( text, "bench thread %lu line %lu:", &thread, &index ) != 2 or thread >= threads
+            or strstr( text, "entered bubble" ) == NULL or strchr( text, '\n' ) == NULL ) {
+            ::fprintf( stderr, "garbled line: %s", line );
+            ok = false;
+        } else if( (long)index <= last[ thread ] ) {
+            ::fprintf( stderr, "thread %lu: line %lu after line %ld\n", thread, index, last[ thread ] );
+            ok = false;
+        } else {
+            last[ thread ] = index;
+            ++found;
+        }
+    }
+    fclose( file );
+
+    if( ok and found + dropped != threads * lines ) {
+        ::fprintf( stderr, "%" PRIu64 " lines written and %" PRIu64 " dropped, expected %lu\n", found, dropped, threads * lines );
+        ok = false;
+    }
+    return ok;
+}
+
+}
+
+int log_LogQueueBench( int argc, char* argv[] )
+{
+    const size_t threads = ( 1 < argc ? atoi( argv[1] ) : 8 );
+    const size_t lines = ( 2 < argc ? atoi( argv[2] ) : 20000 );
+    const size_t total = threads * lines;
+
+    const bool enabled = is_log_enabled( COMMON__MESSAGE );
+    log_enable( COMMON__MESSAGE );
+
+    fflush( stdout );
+    const int console = dup( fileno( stdout ) );
+    if( freopen( NULL_DEVICE, "w", stdout ) == NULL )
+        return 1;
+
+    // on the calling threads
+    log_open_logfile( LOG_FILE );
+    const double syncTime = Run( threads, lines );
+    log_close_logfile();
+
+    // through LogQueue; the writer is done once Stop() returns
+    log_open_logfile( LOG_FILE );
+    const uint64_t droppedBefore = sLogQueue.GetDropped();
+    sLogQueue.Start();
+    const double start = GetTimeUSeconds();
+    const double asyncTime = Run( threads, lines );
+    sLogQueue.Stop();
+    const double writtenTime = GetTimeUSeconds() - start;
+    const uint64_t dropped = sLogQueue.GetDropped() - droppedBefore;
+    log_close_logfile();
+
+    fflush( stdout );
+    dup2( console, fileno( stdout ) );
+    close( console );
+    if( !enabled )
+        log_disable( COMMON__MESSAGE );
+
+    const bool ok = Verify( threads, lines, dropped );
+    remove( LOG_FILE );
+    if( !ok )
+        return 1;
+
+    ::printf( "%lu threads, %lu lines each, logged to console and file\n", threads, lines );
+    ::printf( "%10s %14s %14s %10s\n", "", "calls/s", "lines/s out", "dropped" );
+    ::printf( "%10s %14.0f %14.0f %10u\n", "direct", total / ( syncTime / 1e6 ), total / ( syncTime / 1e6 ), 0 );
+    ::printf( "%10s %14.0f %14.0f %10" PRIu64 "\n", "LogQueue", total / ( asyncTime / 1e6 ), ( total - dropped ) / ( writtenTime / 1e6 ), dropped );
+    ::printf( "LogQueue: callers %.1fx faster, every line checked in the logfile\n", syncTime / asyncTime );
+
+    return 0;
+}
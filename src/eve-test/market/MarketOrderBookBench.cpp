@@ -0,0 +1,312 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "market/MarketOrderBook.h"
+
+/*
+ * Replays a stream of order placements against MarketOrderBook the way
+ * MarketMgr uses it: each placement first looks for a counterparty (same price
+ * tolerance and range rules as MarketMgr::FindSellOrder()/FindBuyOrder()), fills
+ * it if found and otherwise rests in the book.  A few placements cancel or
+ * reprice a resting order instead.
+ *
+ * The first placements are checked against a linear scan of every open order
+ * picking by price, then age; the whole stream is then timed on the book alone.
+ *
+ * Stations sit three to a system and systems on a line, so the jump count
+ * between two systems is the difference of their numbers.
+ *
+ * usage: eve-test market/MarketOrderBookBench [placements]
+ */
+
+namespace {
+
+const uint32 sTypes = 25;
+const uint32 sStations = 90;
+const int16 sRanges[] = { -1, -1, 0, 1, 5, 32767 };
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+bool InRange( uint32 fromStationID, uint32 toStationID, int16 range )
+{
+    if( fromStationID == toStationID )
+        return true;
+    if( range == -1 )
+        return false;
+    if( range == 32767 )
+        return true;
+
+    const int32 jumps = std::abs( (int32)( fromStationID / 3 ) - (int32)( toStationID / 3 ) );
+    return jumps <= range;
+}
+
+enum Action { Place, Cancel, Reprice };
+
+struct Step
+{
+    Action action;
+    Market::SaveData order;     // Place: the new order; Cancel/Reprice: order.price only
+    uint32 pick;                // Cancel/Reprice: which open order
+};
+
+void MakeSteps( std::vector<Step>& steps, size_t count, uint32 seed )
+{
+    for( size_t i = 0; i < count; ++i ) {
+        Step s = Step();
+        const uint32 roll = Random( seed, 100 );
+        s.action = ( roll < 90 ? Place : ( roll < 95 ? Cancel : Reprice ) );
+        s.pick = Random( seed, 1 << 20 );
+
+        Market::SaveData& o = s.order;
+        o.orderID = (uint32)i + 1;
+        o.typeID = 34 + Random( seed, sTypes );
+        o.regionID = 10000002;
+        o.stationID = Random( seed, sStations );
+        o.bid = ( Random( seed, 2 ) == 1 );
+        o.orderRange = ( o.bid ? sRanges[ Random( seed, 6 ) ] : -1 );
+        o.price = ( 9000 + Random( seed, 2000 ) ) / 100.0;
+        o.volEntered = o.volRemaining = 1 + Random( seed, 50 );
+        o.issued = (int64)i;
+        steps.push_back( s );
+    }
+}
+
+/* the book side: one book per type, as MarketMgr keeps them per region/type */
+class BookMarket
+{
+public:
+    /* @return orderID filled, 0 if the order rested */
+    uint32 Place( const Market::SaveData& data )
+    {
+        MarketOrderBook& book = mBooks[ data.typeID ];
+        const Market::SaveData* match( nullptr );
+        if( data.bid )
+            match = book.FindAsk( std::round( ( data.price + 0.1 ) * 100.0 ) / 100.0, data.volRemaining,
+                                  [&]( const Market::SaveData& ask ) { return InRange( data.stationID, ask.stationID, data.orderRange ); } );
+        else
+            match = book.FindBid( std::round( ( data.price - 0.1 ) * 100.0 ) / 100.0, data.volRemaining,
+                                  [&]( const Market::SaveData& bid ) { return InRange( bid.stationID, data.stationID, bid.orderRange ); } );
+
+        if( match == nullptr ) {
+            book.Add( data );
+            mOpen.push_back( std::make_pair( data.typeID, data.orderID ) );
+            return 0;
+        }
+
+        const uint32 orderID = match->orderID;
+        if( match->volRemaining == data.volRemaining )
+            book.Remove( orderID );
+        else
+            book.SetQuantity( orderID, match->volRemaining - data.volRemaining );
+        return orderID;
+    }
+
+    /* @return orderID touched, 0 if the picked order was already gone */
+    uint32 Change( const Step& s )
+    {
+        if( mOpen.empty() )
+            return 0;
+
+        const size_t idx = s.pick % mOpen.size();
+        const std::pair<uint16, uint32> cur = mOpen[ idx ];
+        mOpen[ idx ] = mOpen.back();
+        mOpen.pop_back();
+
+        MarketOrderBook& book = mBooks[ cur.first ];
+        if( book.Find( cur.second ) == nullptr )
+            return 0;
+
+        if( s.action == Cancel ) {
+            book.Remove( cur.second );
+        } else {
+            book.SetPrice( cur.second, s.order.price );
+            mOpen.push_back( cur );
+        }
+        return cur.second;
+    }
+
+    size_t size() const
+    {
+        size_t res = 0;
+        for( auto& cur : mBooks )
+            res += cur.second.size();
+        return res;
+    }
+
+protected:
+    std::unordered_map<uint16, MarketOrderBook> mBooks;
+    std::vector<std::pair<uint16, uint32>> mOpen;
+};
+
+/* the reference: every open order in one list, scanned in full */
+class ScanMarket
+{
+public:
+    uint32 Place( const Market::SaveData& data )
+    {
+        Entry* best( nullptr );
+        for( Entry& cur : mOrders ) {
+            const Market::SaveData& o = cur.order;
+            if( o.typeID != data.typeID or o.bid == data.bid or o.volRemaining < data.volRemaining )
+                continue;
+
+            if( data.bid ) {
+                if( !( o.price < std::round( ( data.price + 0.1 ) * 100.0 ) / 100.0 ) or !InRange( data.stationID, o.stationID, data.orderRange ) )
+                    continue;
+                if( best == nullptr or o.price < best->order.price or ( o.price == best->order.price and cur.seq < best->seq ) )
+                    best = &cur;
+            } else {
+                if( !( o.price > std::round( ( data.price - 0.1 ) * 100.0 ) / 100.0 ) or !InRange( o.stationID, data.stationID, o.orderRange ) )
+                    continue;
+                if( best == nullptr or o.price > best->order.price or ( o.price == best->order.price and cur.seq < best->seq ) )
+                    best = &cur;
+            }
+        }
+
+        if( best == nullptr ) {
+            mOrders.push_back( Entry{ data, ++mSeq } );
+            mOpen.push_back( data.orderID );
+            return 0;
+        }
+
+        const uint32 orderID = best->order.orderID;
+        if( best->order.volRemaining == data.volRemaining )
+            Erase( orderID );
+        else
+            best->order.volRemaining -= data.volRemaining;
+        return orderID;
+    }
+
+    uint32 Change( const Step& s )
+    {
+        if( mOpen.empty() )
+            return 0;
+
+        const size_t idx = s.pick % mOpen.size();
+        const uint32 orderID = mOpen[ idx ];
+        mOpen[ idx ] = mOpen.back();
+        mOpen.pop_back();
+
+        Entry* pEntry = Find( orderID );
+        if( pEntry == nullptr )
+            return 0;
+
+        if( s.action == Cancel ) {
+            Erase( orderID );
+        } else {
+            // a repriced order loses its place in time
+            pEntry->order.price = s.order.price;
+            pEntry->seq = ++mSeq;
+            mOpen.push_back( orderID );
+        }
+        return orderID;
+    }
+
+protected:
+    struct Entry
+    {
+        Market::SaveData order;
+        uint64_t seq;
+    };
+
+    Entry* Find( uint32 orderID )
+    {
+        for( Entry& cur : mOrders )
+            if( cur.order.orderID == orderID )
+                return &cur;
+        return nullptr;
+    }
+
+    void Erase( uint32 orderID )
+    {
+        for( size_t i = 0; i < mOrders.size(); ++i )
+            if( mOrders[ i ].order.orderID == orderID ) {
+                mOrders[ i ] = mOrders.back();
+                mOrders.pop_back();
+                return;
+            }
+    }
+
+    std::vector<Entry> mOrders;
+    std::vector<uint32> mOpen;
+    uint64_t mSeq = 0;
+};
+
+template<class M>
+uint32 Apply( M& market, const Step& s )
+{
+    return ( s.action == Place ? market.Place( s.order ) : market.Change( s ) );
+}
+
+}
+
+int market_MarketOrderBookBench( int argc, char* argv[] )
+{
+    const size_t count = ( 1 < argc ? atoi( argv[1] ) : 100000 );
+
+    std::vector<Step> steps;
+    MakeSteps( steps, count, 4242 );
+
+    // verify
+    {
+        BookMarket book;
+        ScanMarket scan;
+        const size_t checked = std::min<size_t>( count, 20000 );
+        for( size_t i = 0; i < checked; ++i ) {
+            const uint32 a = Apply( book, steps[ i ] );
+            const uint32 b = Apply( scan, steps[ i ] );
+            if( a != b ) {
+                ::printf( "step %lu: book picked order %u, scan picked %u\n", i, a, b );
+                return 1;
+            }
+        }
+        ::printf( "%lu steps match a full scan\n", checked );
+    }
+
+    // time
+    BookMarket book;
+    size_t placed = 0, matches = 0;
+    const double start = GetTimeUSeconds();
+    for( const Step& s : steps ) {
+        const uint32 res = Apply( book, s );
+        if( s.action == Place ) {
+            ++placed;
+            if( res != 0 )
+                ++matches;
+        }
+    }
+    const double elapsed = ( GetTimeUSeconds() - start ) / 1e6;
+
+    ::printf( "%10s %10s %10s %14s %14s\n", "placed", "matched", "open", "placements/s", "matches/s" );
+    ::printf( "%10lu %10lu %10lu %14.0f %14.0f\n", placed, matches, book.size(), placed / elapsed, matches / elapsed );
+
+    return ( matches > 0 ? 0 : 1 );
+}
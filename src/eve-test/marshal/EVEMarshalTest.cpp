@@ -71,5 +71,35 @@ int marshal_EVEMarshalTest( int argc, char* argv[] )
     rep->Dump( stdout, "    " );
     PyDecRef( rep );
 
+    ::puts( "Marshaling encoded tuple..." );
+
+    PyTuple* payload = new PyTuple( 3 );
+    payload->SetItem( 0, new PyInt( 140000000 ) );
+    payload->SetItem( 1, new PyString( "GotoPoint" ) );
+    payload->SetItem( 2, new PyFloat( 1234.5 ) );
+    PyTuple* envelope = new PyTuple( 2 );
+    envelope->SetItem( 0, new PyLong( Win32TimeNow() ) );
+    envelope->SetItem( 1, payload );
+    PyIncRef( payload );
+
+    Buffer walked, spliced;
+    Marshal( envelope, walked );
+    payload->EncodeOnce();
+    if( NULL == payload->encoded() )
+    {
+        ::puts( "Failed to encode tuple." );
+        return EXIT_FAILURE;
+    }
+    Marshal( envelope, spliced );
+    PyDecRef( envelope );
+    PyDecRef( payload );
+
+    if( walked.size() != spliced.size()
+        || !std::equal( walked.begin<uint8>(), walked.end<uint8>(), spliced.begin<uint8>() ) )
+    {
+        ::puts( "Encoded tuple marshaled differently." );
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,242 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+/*
+ * Dispatches calls to a service laid out like MarketProxyService, once the way
+ * Service<T>::Dispatch() used to (scan every handler comparing names, call each
+ * overload until one stops throwing std::invalid_argument) and once the way
+ * CallHandlerTable does (hash lookup of the name, overload picked by checking
+ * the argument types up front).
+ *
+ * The service layer lives in eve-server, which eve-test doesn't link, so the
+ * handlers here check PyRep types the same way CallHandler::validateArgs() does
+ * but are not the real templates.
+ *
+ * usage: eve-test network/RPCDispatchBench [calls]
+ */
+
+namespace {
+
+struct Param
+{
+    PyRep::PyType type;     // PyTypeError stands for PyRep*, anything goes
+    bool optional;
+};
+
+struct Handler
+{
+    std::vector<Param> params;
+    size_t id;
+
+    /* same rules as CallHandler::validateArgs() */
+    bool Accepts( const PyTuple* args ) const
+    {
+        if( args->size() > params.size() )
+            return false;
+
+        for( size_t i = 0; i < params.size(); ++i ) {
+            const bool present = ( i < args->size() );
+            if( params[ i ].optional and ( !present or args->GetItem( i )->IsNone() ) )
+                continue;
+            if( !present )
+                return false;
+            if( params[ i ].type != PyRep::PyTypeError and args->GetItem( i )->GetType() != params[ i ].type )
+                return false;
+        }
+        return true;
+    }
+
+    /* stands in for the call of the service method */
+    size_t Call( const PyTuple* args ) const { return id + args->size(); }
+};
+
+class LegacyDispatch
+{
+public:
+    void Add( const std::string& name, const Handler& handler )
+    {
+        mStore.push_back( handler );
+        mHandlers.push_back( std::make_pair( name, &mStore.back() ) );
+    }
+
+    size_t Dispatch( const std::string& name, const PyTuple* args ) const
+    {
+        // by value, as it was
+        for( auto handler : mHandlers ) {
+            if( handler.first != name )
+                continue;
+
+            try {
+                if( !handler.second->Accepts( args ) )
+                    throw std::invalid_argument( "arguments do not match" );
+                return handler.second->Call( args );
+            } catch( std::invalid_argument& ) {
+            }
+        }
+        return 0;
+    }
+
+protected:
+    std::deque<Handler> mStore;
+    std::vector<std::pair<std::string, const Handler*>> mHandlers;
+};
+
+class TableDispatch
+{
+public:
+    void Add( const std::string& name, const Handler& handler ) { mHandlers[ name ].push_back( handler ); }
+
+    size_t Dispatch( const std::string& name, const PyTuple* args ) const
+    {
+        auto itr = mHandlers.find( name );
+        if( itr == mHandlers.end() )
+            return 0;
+
+        for( const Handler& cur : itr->second )
+            if( cur.Accepts( args ) )
+                return cur.Call( args );
+        return 0;
+    }
+
+protected:
+    std::unordered_map<std::string, std::vector<Handler>> mHandlers;
+};
+
+const Param sInt = { PyRep::PyTypeInt, false };
+const Param sFloat = { PyRep::PyTypeFloat, false };
+const Param sBool = { PyRep::PyTypeBool, false };
+const Param sOptInt = { PyRep::PyTypeInt, true };
+const Param sOptRep = { PyRep::PyTypeError, true };
+
+/* MarketProxyService's registrations, in order */
+template<class D>
+void Register( D& dispatch )
+{
+    struct { const char* name; std::vector<Param> params; } methods[] = {
+        { "StartupCheck", {} },
+        { "GetStationAsks", {} },
+        { "GetSystemAsks", {} },
+        { "GetRegionBest", {} },
+        { "GetMarketGroups", {} },
+        { "GetOrders", { sInt } },
+        { "GetOldPriceHistory", { sInt } },
+        { "GetNewPriceHistory", { sInt } },
+        { "PlaceCharOrder", { sInt, sInt, sFloat, sInt, sInt, sInt, sOptInt, sInt, sInt, sBool, sOptRep } },
+        { "PlaceCharOrder", { sInt, sInt, sFloat, sInt, sInt, sInt, sOptInt, sInt, sInt, sInt, sOptRep } },
+        { "GetCharOrders", {} },
+        { "ModifyCharOrder", { sInt, sFloat, sInt, sInt, sInt, sInt } },
+        { "CancelCharOrder", { sInt, sInt } },
+        { "CharGetNewTransactions", { sOptInt, sOptInt, sOptInt, sOptRep, sOptInt, sOptInt } },
+        { "CorpGetNewTransactions", { sOptInt, sOptInt, sOptInt, sOptRep, sOptInt, sOptInt, sOptInt } },
+        { "GetCorporationOrders", {} },
+    };
+
+    size_t id = 0;
+    for( auto& cur : methods ) {
+        Handler handler;
+        handler.params = cur.params;
+        handler.id = ( ++id ) * 100;
+        dispatch.Add( cur.name, handler );
+    }
+}
+
+struct Call
+{
+    std::string name;
+    PyTuple* args;
+};
+
+PyTuple* PlaceOrderArgs( bool useCorp )
+{
+    PyTuple* args = new PyTuple( 11 );
+    for( size_t i = 0; i < 11; ++i )
+        args->SetItem( i, new PyInt( 1 ) );
+    args->SetItem( 2, new PyFloat( 1.5 ) );
+    args->SetItem( 9, useCorp ? (PyRep*)new PyBool( true ) : (PyRep*)new PyInt( 0 ) );
+    args->SetItem( 10, PyStatic.NewNone() );
+    return args;
+}
+
+template<class D>
+double Run( const D& dispatch, const std::vector<Call>& calls, size_t passes, size_t& sum )
+{
+    sum = 0;
+    const double start = GetTimeUSeconds();
+    for( size_t p = 0; p < passes; ++p )
+        for( const Call& cur : calls )
+            sum += dispatch.Dispatch( cur.name, cur.args );
+    return ( GetTimeUSeconds() - start ) / 1e6;
+}
+
+}
+
+int network_RPCDispatchBench( int argc, char* argv[] )
+{
+    const size_t total = ( 1 < argc ? atoi( argv[1] ) : 1000000 );
+
+    LegacyDispatch legacy;
+    TableDispatch table;
+    Register( legacy );
+    Register( table );
+
+    PyTuple* orders = new PyTuple( 1 );
+    orders->SetItem( 0, new PyInt( 34 ) );
+    PyTuple* cancel = new PyTuple( 2 );
+    cancel->SetItem( 0, new PyInt( 1 ) );
+    cancel->SetItem( 1, new PyInt( 2 ) );
+    PyTuple* none = new PyTuple( 0 );
+
+    struct { const char* label; std::vector<Call> calls; } mixes[] = {
+        { "GetOrders", { { "GetOrders", orders } } },
+        { "CancelCharOrder", { { "CancelCharOrder", cancel } } },
+        { "PlaceCharOrder 1st", { { "PlaceCharOrder", PlaceOrderArgs( true ) } } },
+        { "PlaceCharOrder 2nd", { { "PlaceCharOrder", PlaceOrderArgs( false ) } } },
+        { "bad arguments", { { "CancelCharOrder", orders } } },
+        { "unknown method", { { "GetMarketPrices", none } } },
+    };
+
+    ::printf( "%-20s %14s %14s %9s\n", "call", "legacy/s", "table/s", "speedup" );
+    for( auto& mix : mixes ) {
+        // the same handler must be picked by both
+        for( const Call& cur : mix.calls )
+            if( legacy.Dispatch( cur.name, cur.args ) != table.Dispatch( cur.name, cur.args ) ) {
+                ::printf( "%s: legacy and table picked different handlers\n", mix.label );
+                return 1;
+            }
+
+        const size_t passes = total / mix.calls.size();
+        size_t legacySum, tableSum;
+        const double legacyTime = Run( legacy, mix.calls, passes, legacySum );
+        const double tableTime = Run( table, mix.calls, passes, tableSum );
+        ::printf( "%-20s %14.0f %14.0f %8.1fx\n", mix.label, passes / legacyTime, passes / tableTime, legacyTime / tableTime );
+
+        if( legacySum != tableSum )
+            return 1;
+    }
+
+    return 0;
+}
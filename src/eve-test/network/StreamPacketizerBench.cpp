@@ -0,0 +1,302 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+/*
+ * Feeds a stream of length-prefixed packets to StreamPacketizer the way
+ * EVETCPConnection does (recv() into GetWriteSpan()) and compares it against
+ * the previous copying implementation, which got recv()'d chunks via InputData().
+ *
+ * Before timing, both are fed with random chunk sizes while the ring side keeps
+ * packets popped across further receives (as PopRep() does outside of the lock),
+ * and every byte of every packet is hashed on both sides and compared.
+ *
+ * No capture ships with the tree since it would contain session data; record the
+ * raw inbound stream of a client (e.g. with tcpdump/tshark) and pass it as [file].
+ * Without it, synthetic traffic with a client-like mix of packet sizes is used.
+ *
+ * usage: eve-test network/StreamPacketizerBench [passes] [file]
+ */
+
+namespace {
+
+/* StreamPacketizer as it was before the ring buffer: every packet copied into new Buffer. */
+class LegacyPacketizer
+{
+public:
+    ~LegacyPacketizer()
+    {
+        while( !mPackets.empty() ) {
+            SafeDelete( mPackets.front() );
+            mPackets.pop();
+        }
+    }
+
+    void InputData( const Buffer& data )
+    {
+        mBuffer.AppendSeq( data.begin<uint8>(), data.end<uint8>() );
+    }
+    void Process()
+    {
+        Buffer::const_iterator<uint8> cur, end;
+        cur = mBuffer.begin<uint8>();
+        end = mBuffer.end<uint8>();
+        while( true ) {
+            if( sizeof( uint32 ) > ( end - cur ) )
+                break;
+
+            const Buffer::const_iterator<uint32> len = cur.As<uint32>();
+            const Buffer::const_iterator<uint8> start = ( len + 1 ).As<uint8>();
+
+            if( *len > (size_t)( end - start ) )
+                break;
+
+            mPackets.push( new Buffer( start, start + *len ) );
+            cur = ( start + *len );
+        }
+
+        if( cur != mBuffer.begin<uint8>() )
+            mBuffer.AssignSeq( cur, end );
+    }
+    Buffer* PopPacket()
+    {
+        Buffer* res( nullptr );
+        if( !mPackets.empty() ) {
+            res = mPackets.front();
+            mPackets.pop();
+        }
+        return res;
+    }
+
+protected:
+    Buffer mBuffer;
+    std::queue<Buffer*> mPackets;
+};
+
+uint32 Random( uint32& seed )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 );
+}
+
+/* FNV-1a over every byte, chained across packets so order matters too; just packet sizes when timing. */
+bool sFullHash = true;
+uint64_t Hash( uint64_t hash, const uint8* data, size_t len )
+{
+    if( !sFullHash )
+        return hash + len;
+    for( size_t i = 0; i < len; ++i )
+        hash = ( hash ^ data[ i ] ) * 1099511628211ULL;
+    return hash;
+}
+
+/* Roughly what a client sends: mostly small calls, some medium, rare large ones. */
+void GenerateStream( Buffer& stream, size_t packets )
+{
+    uint32 seed = 12345;
+    for( size_t i = 0; i < packets; ++i ) {
+        const uint32 roll = Random( seed ) % 100;
+        uint32 len;
+        if( roll < 80 )
+            len = 16 + Random( seed ) % 240;
+        else if( roll < 98 )
+            len = 256 + Random( seed ) % 3840;
+        else
+            len = 4096 + Random( seed ) % 200000;
+
+        stream.Append<uint32>( len );
+        for( uint32 j = 0; j < len; ++j )
+            stream.Append<uint8>( (uint8)Random( seed ) );
+    }
+}
+
+bool LoadStream( Buffer& stream, const char* path )
+{
+    FILE* f = ::fopen( path, "rb" );
+    if( f == nullptr ) {
+        ::printf( "Unable to open %s.\n", path );
+        return false;
+    }
+
+    uint8 chunk[ 0x1000 ];
+    size_t read;
+    while( 0 < ( read = ::fread( chunk, 1, sizeof( chunk ), f ) ) )
+        stream.AppendSeq( chunk, chunk + read );
+
+    ::fclose( f );
+    return true;
+}
+
+/* Chunk sizes a recv() would return; random when verifying, TCPCONN_RECVBUF_SIZE when timing. */
+size_t ChunkSize( uint32* seed )
+{
+    if( seed == nullptr )
+        return TCPCONN_RECVBUF_SIZE;
+    return 1 + Random( *seed ) % ( 3 * TCPCONN_RECVBUF_SIZE );
+}
+
+size_t FeedLegacy( const Buffer& stream, uint32 passes, uint32* seed, uint64_t& hash )
+{
+    LegacyPacketizer packetizer;
+    size_t count = 0;
+    Buffer chunk;
+    for( uint32 p = 0; p < passes; ++p ) {
+        size_t done = 0;
+        while( done < stream.size() ) {
+            // recv() into mRecvBuf, then copied by InputData()
+            const size_t len = std::min( ChunkSize( seed ), stream.size() - done );
+            chunk.AssignSeq( &stream[ done ], &stream[ done ] + len );
+            done += len;
+
+            packetizer.InputData( chunk );
+            packetizer.Process();
+
+            Buffer* packet( nullptr );
+            while( ( packet = packetizer.PopPacket() ) != nullptr ) {
+                hash = Hash( hash, packet->size() ? &( *packet )[ 0 ] : nullptr, packet->size() );
+                ++count;
+                SafeDelete( packet );
+            }
+        }
+    }
+    return count;
+}
+
+size_t FeedRing( StreamPacketizer& packetizer, const Buffer& stream, uint32 passes, uint32* seed, uint64_t& hash )
+{
+    size_t count = 0;
+    // popped packet not hashed yet
+    bool held = false;
+    BufferView packet;
+    for( uint32 p = 0; p < passes; ++p ) {
+        size_t done = 0;
+        while( done < stream.size() ) {
+            // recv() straight into the ring; it may take several spans
+            size_t left = std::min( ChunkSize( seed ), stream.size() - done );
+            while( 0 < left ) {
+                size_t len( 0 );
+                uint8* span = packetizer.GetWriteSpan( len );
+                len = std::min( len, left );
+                memcpy( span, &stream[ done ], len );
+                packetizer.CommitWrite( len );
+                done += len;
+                left -= len;
+            }
+            packetizer.Process();
+
+            // packet popped before this receive must have survived it
+            if( held ) {
+                hash = Hash( hash, packet.data(), packet.size() );
+                ++count;
+                held = false;
+            }
+
+            if( seed == nullptr ) {
+                while( packetizer.PopPacket( packet ) ) {
+                    hash = Hash( hash, packet.data(), packet.size() );
+                    ++count;
+                }
+                continue;
+            }
+
+            // when verifying, pop a few and keep the last one across next receive
+            const uint32 pops = Random( *seed ) % 6;
+            for( uint32 i = 0; ( i < pops ) and packetizer.PopPacket( packet ); ++i ) {
+                if( i + 1 == pops ) {
+                    held = true;
+                    break;
+                }
+                hash = Hash( hash, packet.data(), packet.size() );
+                ++count;
+            }
+        }
+    }
+
+    if( held ) {
+        hash = Hash( hash, packet.data(), packet.size() );
+        ++count;
+    }
+    while( packetizer.PopPacket( packet ) ) {
+        hash = Hash( hash, packet.data(), packet.size() );
+        ++count;
+    }
+    return count;
+}
+
+}
+
+int network_StreamPacketizerBench( int argc, char* argv[] )
+{
+    const uint32 passes = ( 1 < argc ? atoi( argv[1] ) : 20 );
+
+    Buffer stream;
+    if( 2 < argc ) {
+        if( !LoadStream( stream, argv[2] ) )
+            return 1;
+    } else
+        GenerateStream( stream, 5000 );
+
+    ::printf( "Stream: %lu bytes x %u passes\n\n", stream.size(), passes );
+
+    // verify; random chunking, packets held across receives
+    uint32 legacySeed = 777, ringSeed = 777;
+    uint64_t legacyHash = 14695981039346656037ULL, ringHash = 14695981039346656037ULL;
+    StreamPacketizer verify;
+    const size_t legacyVerified = FeedLegacy( stream, 2, &legacySeed, legacyHash );
+    const size_t ringVerified = FeedRing( verify, stream, 2, &ringSeed, ringHash );
+    if( ( legacyVerified != ringVerified ) or ( legacyHash != ringHash ) ) {
+        ::printf( "Packet mismatch: legacy %lu packets (hash %016llx), ring %lu packets (hash %016llx).\n",
+                  legacyVerified, (unsigned long long)legacyHash, ringVerified, (unsigned long long)ringHash );
+        return 1;
+    }
+    ::printf( "verified %lu packets; %u copied due to wrap\n\n", ringVerified, verify.GetWrappedCount() );
+
+    // time; don't let hashing dominate
+    sFullHash = false;
+    const double mb = (double)stream.size() * passes / ( 1024 * 1024 );
+    legacyHash = ringHash = 14695981039346656037ULL;
+
+    double start = GetTimeUSeconds();
+    const size_t legacyCount = FeedLegacy( stream, passes, nullptr, legacyHash );
+    const double legacyTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    StreamPacketizer ring;
+    start = GetTimeUSeconds();
+    const size_t ringCount = FeedRing( ring, stream, passes, nullptr, ringHash );
+    const double ringTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    ::printf( "               %12s %14s\n", "MB/s", "packets/s" );
+    ::printf( "legacy         %12.1f %14.0f\n", mb / legacyTime, legacyCount / legacyTime );
+    ::printf( "ring           %12.1f %14.0f\n", mb / ringTime, ringCount / ringTime );
+    ::printf( "\nring: %u of %lu packets copied due to wrap\n", ring.GetWrappedCount(), ringCount );
+
+    if( ( legacyCount != ringCount ) or ( legacyHash != ringHash ) ) {
+        ::printf( "Packet mismatch: legacy %lu, ring %lu.\n", legacyCount, ringCount );
+        return 1;
+    }
+
+    return 0;
+}
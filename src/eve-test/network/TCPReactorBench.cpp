@@ -0,0 +1,248 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include <poll.h>
+#include <sys/resource.h>
+
+#include "network/TCPReactor.h"
+#include "network/TCPServer.h"
+
+/*
+ * Opens a number of loopback connections to an echo server and compares
+ * thread-per-connection against TCPReactor: CPU used while all connections
+ * sit idle, and round-trip latency of small packets sent on all of them at once.
+ *
+ * usage: eve-test network/TCPReactorBench [connections] [rounds] [reactorThreads]
+ */
+
+namespace {
+
+class EchoConnection
+: public TCPConnection
+{
+public:
+    EchoConnection( Socket* sock, uint32 rIP, uint16 rPort )
+    : TCPConnection( sock, rIP, rPort )                 { }
+    ~EchoConnection()
+    {
+        // stop processing while our vtable is still intact
+        Disconnect();
+        WaitLoop();
+    }
+
+protected:
+    bool ProcessReceivedData( char* errbuf = 0 )
+    {
+        Buffer* buf = new Buffer( mRecvBuf->begin<uint8>(), mRecvBuf->end<uint8>() );
+        return Send( &buf );
+    }
+};
+
+class EchoServer
+: public TCPServer<EchoConnection>
+{
+protected:
+    void CreateNewConnection( Socket* sock, uint32 rIP, uint16 rPort )
+    {
+        AddConnection( new EchoConnection( sock, rIP, rPort ) );
+    }
+};
+
+double CPUSeconds()
+{
+    rusage usage;
+    ::getrusage( RUSAGE_SELF, &usage );
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+        + ( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) / 1e6;
+}
+
+struct BenchResult
+{
+    bool ok;
+    double idleCPU;     // percent of one core
+    double activeCPU;   // cpu seconds for all rounds
+    double p50, p99, max;  // ms
+};
+
+BenchResult RunBench( uint32 connections, uint32 rounds )
+{
+    BenchResult res = BenchResult();
+
+    EchoServer server;
+    uint16 port( 27000 );
+    while( !server.Open( port ) and ( port < 27100 ) )
+        ++port;
+    if( !server.IsOpen() ) {
+        ::puts( "Failed to open echo server." );
+        return res;
+    }
+
+    sockaddr_in addr = sockaddr_in();
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons( port );
+    addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+    std::vector<int> clients;
+    std::vector<EchoConnection*> conns;
+    clients.reserve( connections );
+    conns.reserve( connections );
+    for( uint32 i = 0; i < connections; ++i ) {
+        int fd = ::socket( AF_INET, SOCK_STREAM, 0 );
+        int nodelay( 1 );
+        ::setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof( nodelay ) );
+        if( ::connect( fd, (sockaddr*)&addr, sizeof( addr ) ) != 0 ) {
+            ::printf( "connect() failed after %u connections: %s\n", i, strerror( errno ) );
+            ::close( fd );
+            break;
+        }
+        clients.push_back( fd );
+    }
+
+    // wait for the server to hand out all connections
+    uint32 deadline = GetTickCount() + 30000;
+    while( ( conns.size() < clients.size() ) and ( GetTickCount() < deadline ) ) {
+        EchoConnection* conn( server.PopConnection() );
+        if( conn != nullptr )
+            conns.push_back( conn );
+        else
+            Sleep( 1 );
+    }
+
+    if( ( conns.size() == connections ) and ( clients.size() == connections ) ) {
+        // idle cost: nothing to send or receive
+        double cpu = CPUSeconds();
+        Sleep( 2000 );
+        res.idleCPU = ( CPUSeconds() - cpu ) / 2.0 * 100.0;
+
+        std::vector<double> latency;
+        latency.reserve( connections * rounds );
+        std::vector<pollfd> fds( connections );
+        std::vector<double> sent( connections );
+        std::vector<uint32> received( connections );
+
+        cpu = CPUSeconds();
+        res.ok = true;
+        for( uint32 r = 0; ( r < rounds ) and res.ok; ++r ) {
+            for( uint32 i = 0; i < connections; ++i ) {
+                double stamp = GetTimeUSeconds();
+                sent[i] = stamp;
+                received[i] = 0;
+                fds[i].fd = clients[i];
+                fds[i].events = POLLIN;
+                if( ::send( clients[i], &stamp, sizeof( stamp ), MSG_NOSIGNAL ) != sizeof( stamp ) )
+                    res.ok = false;
+            }
+
+            uint32 pendingCount( connections );
+            while( ( pendingCount > 0 ) and res.ok ) {
+                if( ::poll( fds.data(), fds.size(), 10000 ) <= 0 ) {
+                    ::puts( "Timed out waiting for echo." );
+                    res.ok = false;
+                    break;
+                }
+                double now = GetTimeUSeconds();
+                for( uint32 i = 0; i < connections; ++i ) {
+                    if( ( fds[i].revents & POLLIN ) == 0 )
+                        continue;
+                    double echo;
+                    int len = ::recv( clients[i], &echo, sizeof( echo ) - received[i], MSG_DONTWAIT );
+                    if( len <= 0 ) {
+                        res.ok = false;
+                        break;
+                    }
+                    received[i] += len;
+                    if( received[i] < sizeof( echo ) )
+                        continue;
+                    latency.push_back( ( now - sent[i] ) / 1000.0 );
+                    fds[i].fd = -1;  // poll() ignores negative descriptors
+                    --pendingCount;
+                }
+            }
+        }
+        res.activeCPU = CPUSeconds() - cpu;
+
+        if( !latency.empty() ) {
+            std::sort( latency.begin(), latency.end() );
+            res.p50 = latency[latency.size() / 2];
+            res.p99 = latency[std::min<size_t>( latency.size() - 1, latency.size() * 99 / 100 )];
+            res.max = latency.back();
+        }
+    } else {
+        ::printf( "Only %lu of %u connections established.\n", conns.size(), connections );
+    }
+
+    for( auto fd : clients )
+        ::close( fd );
+    for( auto conn : conns )
+        SafeDelete( conn );
+    server.Close();
+
+    return res;
+}
+
+void PrintResult( const char* name, const BenchResult& res )
+{
+    ::printf( "%-12s idle CPU %7.2f%%   active CPU %7.3fs   latency p50 %8.3fms  p99 %8.3fms  max %8.3fms\n",
+              name, res.idleCPU, res.activeCPU, res.p50, res.p99, res.max );
+}
+
+}
+
+int network_TCPReactorBench( int argc, char* argv[] )
+{
+    uint32 connections( 2000 ), rounds( 10 ), threads( 2 );
+    if( argc > 1 )
+        connections = atoi( argv[1] );
+    if( argc > 2 )
+        rounds = atoi( argv[2] );
+    if( argc > 3 )
+        threads = atoi( argv[3] );
+
+    // two descriptors per connection, plus some slack
+    rlimit limit;
+    if( ::getrlimit( RLIMIT_NOFILE, &limit ) == 0 ) {
+        limit.rlim_cur = limit.rlim_max;
+        ::setrlimit( RLIMIT_NOFILE, &limit );
+        if( limit.rlim_cur < connections * 2 + 64 )
+            connections = ( limit.rlim_cur - 64 ) / 2;
+    }
+
+    ::printf( "TCPReactorBench: %u loopback connections, %u rounds, %u reactor threads\n", connections, rounds, threads );
+
+    BenchResult threaded = RunBench( connections, rounds );
+    PrintResult( "threads", threaded );
+
+    if( !sTCPReactor.Start( threads ) ) {
+        ::puts( "TCPReactor not available on this platform." );
+        return threaded.ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    BenchResult reactor = RunBench( connections, rounds );
+    sTCPReactor.Stop();
+    PrintResult( "reactor", reactor );
+
+    return ( threaded.ok and reactor.ok ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
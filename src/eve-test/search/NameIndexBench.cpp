@@ -0,0 +1,256 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "search/NameIndex.h"
+
+/*
+ * Fills a NameIndex with made-up names, mostly characters ("Kaelo Virandi")
+ * with some corporations and solar systems, then runs the kind of patterns
+ * the people & places search and the lookup service send: 2-5 characters as
+ * a prefix ("vir%"), a substring ("%ran%"), both ("ka%and%"), or a whole name.
+ *
+ * Results (and Lookup() of whole names) are checked against a LIKE scan of
+ * every name, before and after a round of renames, deletes and new names; then the same patterns are timed
+ * on the index, and a few with the scan for comparison.
+ *
+ * usage: eve-test search/NameIndexBench [names]
+ */
+
+namespace {
+
+const uint8 sCharacter = 2;
+const uint8 sCorporation = 3;
+const uint8 sSolarSystem = 7;
+const uint32 sKinds = ( 1 << sCharacter ) | ( 1 << sCorporation ) | ( 1 << sSolarSystem );
+const size_t sLimit = 10;
+
+const char* sSyllables[] = {
+    "ka", "el", "vi", "ran", "di", "tor", "mi", "sa", "qu", "an", "dor", "is",
+    "le", "no", "va", "rek", "tha", "ul", "zo", "ber", "cy", "ge", "hal", "ix",
+    "jo", "mar", "nel", "os", "pe", "ry", "sul", "tri", "ur", "wen", "xe", "yl"
+};
+const uint32 sSyllableCount = sizeof( sSyllables ) / sizeof( sSyllables[0] );
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+std::string Word( uint32& seed )
+{
+    std::string word;
+    const uint32 count = 2 + Random( seed, 3 );
+    for( uint32 i = 0; i < count; ++i )
+        word += sSyllables[ Random( seed, sSyllableCount ) ];
+    word[0] = (char)toupper( word[0] );
+    return word;
+}
+
+NameIndex::Entry MakeName( uint32 id, uint32& seed )
+{
+    NameIndex::Entry entry;
+    entry.id = id;
+    const uint32 roll = Random( seed, 100 );
+    if( roll < 90 ) {
+        entry.kind = sCharacter;
+        entry.name = Word( seed ) + " " + Word( seed );
+    } else if( roll < 98 ) {
+        entry.kind = sCorporation;
+        entry.name = Word( seed ) + ( Random( seed, 2 ) ? " Industries" : " Holdings" );
+    } else {
+        entry.kind = sSolarSystem;
+        entry.name = Word( seed ) + "-" + std::to_string( Random( seed, 100 ) );
+    }
+    return entry;
+}
+
+/* a pattern cut from one of 'names', so most find something */
+std::string MakePattern( const std::vector<NameIndex::Entry>& names, uint32& seed )
+{
+    const std::string& name = names[ Random( seed, (uint32)names.size() ) ].name;
+    const uint32 roll = Random( seed, 10 );
+    if( roll == 0 )
+        return name;
+
+    const size_t len = std::min<size_t>( 2 + Random( seed, 4 ), name.size() );
+    if( roll < 5 )
+        return name.substr( 0, len ) + "%";
+    const size_t at = Random( seed, (uint32)( name.size() - len + 1 ) );
+    if( roll < 9 )
+        return "%" + name.substr( at, len ) + "%";
+    return name.substr( 0, 2 ) + "%" + name.substr( at, len ) + "%";
+}
+
+typedef std::map<uint64_t, NameIndex::Entry> AllNames;     // kind|id
+
+uint64_t Key( uint8 kind, uint32 id )   { return ( (uint64_t)kind << 32 ) | id; }
+
+/* @return the number of names matching, ids of the matches in 'into', sorted */
+size_t Scan( const AllNames& all, const std::string& pattern, std::vector<uint64_t>& into )
+{
+    into.clear();
+    const std::string folded( NameIndex::Fold( pattern ) );
+    for( const auto& cur : all )
+        if( NameIndex::Like( NameIndex::Fold( cur.second.name ), folded ) )
+            into.push_back( cur.first );
+    return into.size();
+}
+
+bool Check( const NameIndex& index, const AllNames& all, const std::vector<NameIndex::Entry>& names, size_t searches, uint32 seed, size_t& hits )
+{
+    std::vector<const NameIndex::Entry*> found;
+    std::vector<uint64_t> a, b;
+    for( size_t i = 0; i < searches; ++i ) {
+        const std::string pattern = MakePattern( names, seed );
+        found.clear();
+        index.Search( pattern, sKinds, SIZE_MAX, found );
+        a.clear();
+        for( size_t j = 0; j < found.size(); ++j ) {
+            a.push_back( Key( found[ j ]->kind, found[ j ]->id ) );
+            // each kind's matches come in name order
+            if( ( j > 0 ) and ( found[ j - 1 ]->kind == found[ j ]->kind )
+            and ( NameIndex::Fold( found[ j - 1 ]->name ) > NameIndex::Fold( found[ j ]->name ) ) ) {
+                ::printf( "search %lu '%s': results out of order\n", i, pattern.c_str() );
+                return false;
+            }
+        }
+        // a whole name: Lookup() finds the same
+        if( pattern.find_first_of( "%_" ) == std::string::npos ) {
+            std::vector<const NameIndex::Entry*> exact;
+            index.Lookup( pattern, sKinds, exact );
+            if( exact != found ) {
+                ::printf( "lookup %lu '%s': found %lu, search found %lu\n", i, pattern.c_str(), exact.size(), found.size() );
+                return false;
+            }
+        }
+        std::sort( a.begin(), a.end() );
+        Scan( all, pattern, b );
+        if( a != b ) {
+            ::printf( "search %lu '%s': index found %lu, scan found %lu\n", i, pattern.c_str(), a.size(), b.size() );
+            return false;
+        }
+        hits += a.size();
+    }
+    return true;
+}
+
+}
+
+int search_NameIndexBench( int argc, char* argv[] )
+{
+    const size_t count = ( 1 < argc ? atoi( argv[1] ) : 1000000 );
+
+    uint32 seed = 4242;
+    std::vector<NameIndex::Entry> names;
+    names.reserve( count );
+    for( size_t i = 0; i < count; ++i )
+        names.push_back( MakeName( (uint32)i + 1, seed ) );
+
+    NameIndex index;
+    double start = GetTimeUSeconds();
+    index.Load( names );
+    const double loadTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    AllNames all;
+    for( const NameIndex::Entry& cur : names )
+        all.emplace( Key( cur.kind, cur.id ), cur );
+
+    // verify, then rename, delete and add a tenth as many and verify again
+    const size_t checked = 200;
+    size_t hits = 0;
+    if( !Check( index, all, names, checked, 77, hits ) )
+        return 1;
+
+    const size_t churn = count / 10;
+    uint32 nextID = (uint32)count + 1;
+    for( size_t i = 0; i < churn; ++i ) {
+        NameIndex::Entry& cur = names[ Random( seed, (uint32)count ) ];
+        switch( Random( seed, 3 ) ) {
+            case 0:
+                cur.name = MakeName( cur.id, seed ).name;
+                index.Set( cur.kind, cur.id, cur.name );
+                all[ Key( cur.kind, cur.id ) ] = cur;
+                break;
+            case 1:
+                if( index.Remove( cur.kind, cur.id ) != ( all.erase( Key( cur.kind, cur.id ) ) == 1 ) ) {
+                    ::printf( "remove of %u: index and scan disagree\n", cur.id );
+                    return 1;
+                }
+                break;
+            default: {
+                const NameIndex::Entry entry = MakeName( nextID++, seed );
+                index.Set( entry.kind, entry.id, entry.name );
+                all.emplace( Key( entry.kind, entry.id ), entry );
+            } break;
+        }
+    }
+    if( index.size() != all.size() ) {
+        ::printf( "index holds %lu names, scan %lu\n", index.size(), all.size() );
+        return 1;
+    }
+    if( !Check( index, all, names, checked, 78, hits ) )
+        return 1;
+    ::printf( "%lu searches (%lu names found) match a full scan\n", checked * 2, hits );
+
+    // time
+    const size_t searches = 50000;
+    std::vector<std::string> patterns;
+    uint32 pseed = 99;
+    for( size_t i = 0; i < searches; ++i )
+        patterns.push_back( MakePattern( names, pseed ) );
+
+    std::vector<const NameIndex::Entry*> into;
+    size_t found = 0;
+    start = GetTimeUSeconds();
+    for( const std::string& pattern : patterns ) {
+        into.clear();
+        found += index.Search( pattern, sKinds, sLimit, into );
+    }
+    const double searchTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    const size_t scans = 20;
+    std::vector<uint64_t> ids;
+    start = GetTimeUSeconds();
+    for( size_t i = 0; i < scans; ++i )
+        Scan( all, patterns[ i ], ids );
+    const double scanTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    // renames, as on character or corporation rename
+    start = GetTimeUSeconds();
+    for( size_t i = 0; i < churn; ++i ) {
+        const NameIndex::Entry& cur = names[ Random( seed, (uint32)count ) ];
+        index.Set( cur.kind, cur.id, MakeName( cur.id, seed ).name );
+    }
+    const double renameTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    ::printf( "%10s %12s %12s %12s %12s %12s\n", "names", "loads/s", "searches/s", "scans/s", "avg found", "renames/s" );
+    ::printf( "%10lu %12.0f %12.0f %12.1f %12.1f %12.0f\n", index.size(), count / loadTime, searches / searchTime, scans / scanTime,
+              (double)found / searches, churn / renameTime );
+
+    return ( found > 0 ? 0 : 1 );
+}
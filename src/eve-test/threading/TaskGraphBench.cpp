@@ -0,0 +1,142 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+
+#include "eve-test.h"
+
+#include "threading/TaskGraph.h"
+
+/*
+ * Runs a graph of jobs shaped like the server's startup loaders (most of them
+ * independent, a few waiting on others) with 1, 2, 4 and 8 threads.  Jobs
+ * sleep instead of working, as loaders mostly wait on the database.
+ *
+ * Checks every job starts after the jobs it needs are done, that the jobs
+ * after a failed one are skipped, and that a thread which can't start leaves
+ * its share to the others.
+ *
+ * usage: eve-test threading/TaskGraphBench [jobs] [ms per job]
+ */
+
+namespace {
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+/* @return the jobs' dependencies, each on up to two earlier jobs */
+std::vector<std::vector<uint32>> MakeDeps( size_t jobs )
+{
+    uint32 seed = 42;
+    std::vector<std::vector<uint32>> deps( jobs );
+    for( size_t i = 1; i < jobs; ++i )
+        // one job in four waits on others
+        if( Random( seed, 4 ) == 0 ) {
+            deps[ i ].push_back( Random( seed, (uint32)i ) );
+            if( Random( seed, 2 ) == 0 )
+                deps[ i ].push_back( Random( seed, (uint32)i ) );
+        }
+    return deps;
+}
+
+bool CheckOrder( const TaskGraph& graph, const std::vector<std::vector<uint32>>& deps )
+{
+    for( uint32 id = 0; id < graph.size(); ++id )
+        for( uint32 dep : deps[ id ] )
+            if( graph.GetStart( id ) < graph.GetEnd( dep ) ) {
+                ::printf( "job %u started at %.3fms, before job %u was done at %.3fms\n", id, graph.GetStart( id ), dep, graph.GetEnd( dep ) );
+                return false;
+            }
+    return true;
+}
+
+}
+
+int threading_TaskGraphBench( int argc, char* argv[] )
+{
+    const size_t jobs = ( 1 < argc ? atoi( argv[1] ) : 12 );
+    const uint32 ms = ( 2 < argc ? atoi( argv[2] ) : 20 );
+    const uint8 threads[] = { 1, 2, 4, 8 };
+    const std::vector<std::vector<uint32>> deps = MakeDeps( jobs );
+
+    ::printf( "%lu jobs of %ums\n", jobs, ms );
+    ::printf( "%8s %10s %9s\n", "threads", "total ms", "speedup" );
+
+    double base = 0.0;
+    for( uint8 count : threads ) {
+        std::atomic<uint32> ran( 0 );
+        TaskGraph graph;
+        for( size_t i = 0; i < jobs; ++i )
+            graph.Add( "job", [&ran, ms]() {
+                std::this_thread::sleep_for( std::chrono::milliseconds( ms ) );
+                ++ran;
+                return true;
+            }, deps[ i ] );
+
+        const double start = GetTimeMSeconds();
+        if( !graph.Run( count ) or ( ran != jobs ) ) {
+            ::printf( "%u threads: %u of %lu jobs ran\n", count, ran.load(), jobs );
+            return 1;
+        }
+        const double elapsed = GetTimeMSeconds() - start;
+        if( !CheckOrder( graph, deps ) )
+            return 1;
+
+        if( count == 1 )
+            base = elapsed;
+        ::printf( "%8u %10.1f %8.2fx\n", count, elapsed, base / elapsed );
+    }
+
+    // a failed job takes the jobs after it down, and nothing else
+    {
+        TaskGraph graph;
+        const uint32 a = graph.Add( "a", []() { return true; } );
+        const uint32 b = graph.Add( "b", []() { return false; }, { a } );
+        const uint32 c = graph.Add( "c", []() { return true; }, { b } );
+        const uint32 d = graph.Add( "d", []() { return true; }, { c, a } );
+        const uint32 e = graph.Add( "e", []() { return true; }, { a } );
+        if( graph.Run( 4 ) or !graph.IsFailed( b ) or !graph.IsSkipped( c ) or !graph.IsSkipped( d )
+            or graph.IsFailed( e ) or graph.IsSkipped( e ) ) {
+            ::printf( "failed job: wrong jobs skipped\n" );
+            return 1;
+        }
+    }
+
+    // threads that can't start leave the work to the caller
+    {
+        std::atomic<uint32> ran( 0 );
+        TaskGraph graph;
+        for( size_t i = 0; i < jobs; ++i )
+            graph.Add( "job", [&ran]() { ++ran; return true; }, deps[ i ] );
+        if( !graph.Run( 4, []() { return false; } ) or ( ran != jobs ) ) {
+            ::printf( "thread start failing: %u of %lu jobs ran\n", ran.load(), jobs );
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "threading/WorkerPool.h"
+
+/*
+ * Tics a set of synthetic solar systems on a WorkerPool the way
+ * EntityList::Process() does, with 1, 2, 4 and 8 workers.
+ *
+ * Each system moves its ships about (the stand-in for destiny, NPC AI and the
+ * cosmic managers) and now and then sends one through a gate to another
+ * system; the jump is staged, as anything crossing systems has to be, and made
+ * when all systems are done.  Load is uneven: a few systems hold most ships.
+ *
+ * The state after the last tic must be the same for every worker count.
+ *
+ * usage: eve-test threading/WorkerPoolBench [systems] [tics]
+ */
+
+namespace {
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+struct Ship
+{
+    uint32 id;
+    double x, y, z;
+    double vx, vy, vz;
+};
+
+struct System
+{
+    uint32 id;
+    uint32 seed;
+    std::vector<Ship> ships;
+};
+
+class Universe
+{
+public:
+    Universe( size_t systems )
+    {
+        uint32 seed = 99;
+        uint32 nextID = 1;
+        for( size_t i = 0; i < systems; ++i ) {
+            System sys;
+            sys.id = (uint32)i;
+            sys.seed = 1000 + (uint32)i;
+            // every tenth system is busy
+            const uint32 count = ( i % 10 == 0 ? 400 : 20 ) + Random( seed, 20 );
+            for( uint32 s = 0; s < count; ++s ) {
+                Ship ship = Ship();
+                ship.id = nextID++;
+                ship.vx = 1.0 + Random( seed, 100 );
+                ship.vy = 1.0 + Random( seed, 100 );
+                ship.vz = 1.0 + Random( seed, 100 );
+                sys.ships.push_back( ship );
+            }
+            mSystems.push_back( sys );
+        }
+    }
+
+    void Tic( WorkerPool& pool, StagedCalls& staged )
+    {
+        staged.Reset( pool.size() );
+        pool.Run( mSystems.size(), [&]( size_t i ) { TicSystem( mSystems[ i ], staged ); } );
+        staged.Commit();
+    }
+
+    uint64_t Checksum() const
+    {
+        uint64_t res = 0;
+        for( const System& sys : mSystems )
+            for( const Ship& ship : sys.ships ) {
+                res = res * 31 + ship.id + sys.id * 7919;
+                res ^= (uint64_t)( ship.x + ship.y + ship.z );
+            }
+        return res;
+    }
+
+protected:
+    void TicSystem( System& sys, StagedCalls& staged )
+    {
+        for( Ship& ship : sys.ships ) {
+            // a little work per ship, the way destiny steps a ball
+            for( int step = 0; step < 50; ++step ) {
+                ship.vx = ship.vx * 0.999 + std::sin( ship.y * 1e-6 );
+                ship.vy = ship.vy * 0.999 + std::cos( ship.z * 1e-6 );
+                ship.vz = ship.vz * 0.999 + std::sin( ship.x * 1e-6 );
+                ship.x += ship.vx * 0.02;
+                ship.y += ship.vy * 0.02;
+                ship.z += ship.vz * 0.02;
+            }
+        }
+
+        // touching another system is only allowed once every system is done
+        if( !sys.ships.empty() and Random( sys.seed, 4 ) == 0 ) {
+            const size_t idx = Random( sys.seed, (uint32)sys.ships.size() );
+            const uint32 to = Random( sys.seed, (uint32)mSystems.size() );
+            const uint32 shipID = sys.ships[ idx ].id;
+            System* pFrom = &sys;
+            staged.Add( [this, pFrom, to, shipID]() { Jump( *pFrom, mSystems[ to ], shipID ); } );
+        }
+    }
+
+    void Jump( System& from, System& to, uint32 shipID )
+    {
+        for( size_t i = 0; i < from.ships.size(); ++i )
+            if( from.ships[ i ].id == shipID ) {
+                Ship ship = from.ships[ i ];
+                from.ships.erase( from.ships.begin() + i );
+                ship.x = ship.y = ship.z = 0.0;
+                to.ships.push_back( ship );
+                return;
+            }
+    }
+
+    std::vector<System> mSystems;
+};
+
+}
+
+int threading_WorkerPoolBench( int argc, char* argv[] )
+{
+    const size_t systems = ( 1 < argc ? atoi( argv[1] ) : 100 );
+    const size_t tics = ( 2 < argc ? atoi( argv[2] ) : 50 );
+    const uint8 workers[] = { 1, 2, 4, 8 };
+
+    ::printf( "%lu systems, %lu tics, %u hardware threads\n", systems, tics, std::thread::hardware_concurrency() );
+    ::printf( "%8s %12s %12s %9s\n", "workers", "avg tic us", "tics/s", "speedup" );
+
+    uint64_t expected = 0;
+    double base = 0.0;
+    for( uint8 count : workers ) {
+        WorkerPool pool;
+        StagedCalls staged;
+        pool.Start( count );
+
+        Universe universe( systems );
+        const double start = GetTimeUSeconds();
+        for( size_t t = 0; t < tics; ++t )
+            universe.Tic( pool, staged );
+        const double elapsed = GetTimeUSeconds() - start;
+        pool.Stop();
+
+        const uint64_t sum = universe.Checksum();
+        if( count == 1 ) {
+            expected = sum;
+            base = elapsed;
+        } else if( sum != expected ) {
+            ::printf( "%u workers: state differs from 1 worker\n", count );
+            return 1;
+        }
+
+        ::printf( "%8u %12.1f %12.1f %8.2fx\n", count, elapsed / tics, tics / ( elapsed / 1e6 ), base / elapsed );
+    }
+
+    return 0;
+}
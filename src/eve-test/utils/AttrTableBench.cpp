@@ -0,0 +1,246 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "utils/AttrTable.h"
+
+/*
+ * Builds types of about 100 default attributes and items of those types
+ * with a few attributes of their own, the way the server loads them.
+ *
+ * First checks every item's AttrTable (lookups, merged walk, erase, revert)
+ * against a std::map holding a full copy, which is what each item's
+ * AttributeMap used to keep.  Then reports heap bytes per item and the
+ * attribute lookup rate of both.
+ *
+ * usage: eve-test utils/AttrTableBench [items] [lookups]
+ */
+
+namespace {
+
+const size_t TYPES = 50;
+const size_t TYPE_ATTRIBS = 100;
+const uint16 MAX_ATTRIB = 3000;
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+EvilNumber MakeValue( uint32& seed )
+{
+    if( Random( seed, 2 ) )
+        return EvilNumber( (int64)Random( seed, 100000 ) );
+    return EvilNumber( Random( seed, 100000 ) / 100.0 );
+}
+
+/* counts what a std::map allocates, nodes included */
+size_t s_mapBytes = 0;
+
+template<typename T>
+struct CountingAlloc
+{
+    typedef T value_type;
+    CountingAlloc() { }
+    template<typename U> CountingAlloc( const CountingAlloc<U>& ) { }
+    T* allocate( size_t n )                             { s_mapBytes += n * sizeof( T ); return std::allocator<T>().allocate( n ); }
+    void deallocate( T* p, size_t n )                   { s_mapBytes -= n * sizeof( T ); std::allocator<T>().deallocate( p, n ); }
+    template<typename U> bool operator==( const CountingAlloc<U>& ) const { return true; }
+    template<typename U> bool operator!=( const CountingAlloc<U>& ) const { return false; }
+};
+
+typedef std::map<uint16, EvilNumber, std::less<uint16>, CountingAlloc<std::pair<const uint16, EvilNumber>>> CopyMap;
+
+struct Type
+{
+    AttrTable table;
+    std::vector<uint16> ids;
+};
+
+bool Same( EvilNumber a, EvilNumber b )
+{
+    return ( a.get_type() == b.get_type() and a == b );
+}
+
+bool Check( const AttrTable& table, const CopyMap& copy, size_t item )
+{
+    size_t count = 0;
+    CopyMap::const_iterator itr = copy.begin();
+    for( auto cur : table ) {
+        if( itr == copy.end() or itr->first != cur.first or !Same( itr->second, cur.second ) ) {
+            ::printf( "item %lu: walk differs at attribute %u\n", item, cur.first );
+            return false;
+        }
+        ++itr;
+        ++count;
+    }
+    if( itr != copy.end() or count != table.Count() ) {
+        ::printf( "item %lu: walk saw %lu attributes, expected %lu\n", item, count, copy.size() );
+        return false;
+    }
+    for( uint16 id = 0; id < MAX_ATTRIB; ++id ) {
+        const EvilNumber* pValue = table.Find( id );
+        CopyMap::const_iterator found = copy.find( id );
+        if( ( pValue == nullptr ) != ( found == copy.end() ) or ( pValue != nullptr and !Same( *pValue, found->second ) ) ) {
+            ::printf( "item %lu: attribute %u differs\n", item, id );
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Verify( std::vector<Type>& types )
+{
+    uint32 seed = 1234;
+    for( size_t i = 0; i < 2000; ++i ) {
+        Type& type = types[ Random( seed, TYPES ) ];
+        AttrTable table;
+        table.SetBase( &type.table );
+        CopyMap copy;
+        for( auto cur : type.table )
+            copy[ cur.first ] = cur.second;
+
+        for( size_t op = 0; op < 40; ++op ) {
+            const uint32 roll = Random( seed, 10 );
+            const uint16 id = ( roll < 7 ? type.ids[ Random( seed, type.ids.size() ) ] : (uint16)Random( seed, MAX_ATTRIB ) );
+            if( roll == 0 or roll == 7 ) {
+                if( table.Erase( id ) != ( copy.erase( id ) > 0 ) ) {
+                    ::printf( "item %lu: erase of %u differs\n", i, id );
+                    return false;
+                }
+            } else if( roll == 1 ) {
+                // setting the default back
+                const EvilNumber* pBase = type.table.Find( id );
+                if( pBase != nullptr ) {
+                    table.Set( id, *pBase );
+                    copy[ id ] = *pBase;
+                }
+            } else {
+                EvilNumber value( MakeValue( seed ) );
+                table.Set( id, value );
+                copy[ id ] = value;
+            }
+        }
+        if( !Check( table, copy, i ) )
+            return false;
+
+        // Revert() keeps only attributes the type doesn't have
+        table.Revert();
+        for( auto cur : type.table )
+            copy[ cur.first ] = cur.second;
+        if( !Check( table, copy, i ) )
+            return false;
+    }
+    return true;
+}
+
+}
+
+int utils_AttrTableBench( int argc, char* argv[] )
+{
+    const size_t items = ( 1 < argc ? atoi( argv[1] ) : 100000 );
+    const size_t lookups = ( 2 < argc ? atoi( argv[2] ) : 10000000 );
+    const size_t own = 5;
+
+    uint32 seed = 4711;
+    std::vector<Type> types( TYPES );
+    for( auto& type : types ) {
+        while( type.table.Count() < TYPE_ATTRIBS )
+            type.table.Set( (uint16)Random( seed, MAX_ATTRIB ), MakeValue( seed ) );
+        type.table.Compact();
+        for( auto cur : type.table )
+            type.ids.push_back( cur.first );
+    }
+
+    if( !Verify( types ) )
+        return 1;
+    ::printf( "lookups, walks, erases and reverts match a full copy\n" );
+
+    // a few changed defaults and one attribute the type lacks per item
+    std::vector<size_t> itemTypes( items );
+    std::vector<AttrTable> tables( items );
+    std::vector<CopyMap> copies( items );
+    for( size_t i = 0; i < items; ++i ) {
+        itemTypes[ i ] = Random( seed, TYPES );
+        const Type& type = types[ itemTypes[ i ] ];
+        tables[ i ].SetBase( &type.table );
+        for( auto cur : type.table )
+            copies[ i ][ cur.first ] = cur.second;
+        for( size_t k = 0; k < own; ++k ) {
+            const uint16 id = ( k + 1 < own ? type.ids[ Random( seed, type.ids.size() ) ] : (uint16)( MAX_ATTRIB + k ) );
+            EvilNumber value( MakeValue( seed ) );
+            tables[ i ].Set( id, value );
+            copies[ i ][ id ] = value;
+        }
+        tables[ i ].Compact();
+    }
+
+    size_t tableBytes = 0;
+    for( auto& cur : tables )
+        tableBytes += sizeof( AttrTable ) + cur.MemoryUsed();
+    const size_t mapBytes = s_mapBytes + items * sizeof( CopyMap );
+
+    // lookups go to attributes the item's type has, as most do
+    std::vector<std::pair<uint32, uint16>> keys( 1 << 16 );
+    for( auto& cur : keys ) {
+        cur.first = Random( seed, items );
+        const Type& type = types[ itemTypes[ cur.first ] ];
+        cur.second = type.ids[ Random( seed, type.ids.size() ) ];
+    }
+
+    double mapSum = 0.0, tableSum = 0.0;
+    double start = GetTimeUSeconds();
+    for( size_t i = 0; i < lookups; ++i ) {
+        const std::pair<uint32, uint16>& key = keys[ i & ( keys.size() - 1 ) ];
+        CopyMap::const_iterator itr = copies[ key.first ].find( key.second );
+        if( itr != copies[ key.first ].end() )
+            mapSum += EvilNumber( itr->second ).get_double();
+    }
+    const double mapTime = GetTimeUSeconds() - start;
+
+    start = GetTimeUSeconds();
+    for( size_t i = 0; i < lookups; ++i ) {
+        const std::pair<uint32, uint16>& key = keys[ i & ( keys.size() - 1 ) ];
+        const EvilNumber* pValue = tables[ key.first ].Find( key.second );
+        if( pValue != nullptr )
+            tableSum += EvilNumber( *pValue ).get_double();
+    }
+    const double tableTime = GetTimeUSeconds() - start;
+
+    if( mapSum != tableSum ) {
+        ::printf( "lookup sums differ: %f and %f\n", mapSum, tableSum );
+        return 1;
+    }
+
+    ::printf( "%lu items of %lu types, %lu attributes each, %lu their own\n", items, TYPES, TYPE_ATTRIBS, own );
+    ::printf( "%10s %16s %16s\n", "", "bytes per item", "lookups/sec" );
+    ::printf( "%10s %16lu %16.0f\n", "std::map", mapBytes / items, lookups / mapTime * 1000000.0 );
+    ::printf( "%10s %16lu %16.0f\n", "attrtable", tableBytes / items, lookups / tableTime * 1000000.0 );
+    ::printf( "type tables: %lu bytes each, shared\n", types[ 0 ].table.MemoryUsed() );
+
+    return 0;
+}
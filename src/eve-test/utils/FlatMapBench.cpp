@@ -0,0 +1,473 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "utils/FlatMap.h"
+
+/*
+ * Builds tables shaped like StaticDataMgr's (types, groups, systems, static
+ * entities, stations, type attributes, RAM data, ...) at about the sizes of
+ * the real ones, once as the std::map / std::multimap the manager used to
+ * keep and once as FlatMaps.
+ *
+ * First checks FlatMap against std::multimap: every key's range, keys that
+ * aren't there, the walk, Insert() and View().  Then times the manager's 20
+ * most called accessors (and FindType(), which doesn't copy) both ways, on
+ * keys that are mostly there.  The accessors that used to copy a vector out
+ * are timed against the Span the manager hands out now.
+ *
+ * usage: eve-test utils/FlatMapBench [lookups]
+ */
+
+namespace {
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+/* stand-ins for the server's records, about the same size */
+struct TypeRec
+{
+    uint16 groupID;
+    bool refinable;
+    float radius, mass, volume, capacity;
+    double basePrice;
+    std::string name;
+    std::string description;
+};
+
+struct NameRec
+{
+    uint16 id;
+    bool flag;
+    std::string name;
+};
+
+struct SystemRec
+{
+    uint32 constellationID;
+    uint32 regionID;
+    float securityRating;
+    std::string name;
+    std::string securityClass;
+};
+
+struct StaticRec
+{
+    uint16 typeID;
+    uint32 itemID, systemID, constellationID, regionID;
+    float radius;
+    double x, y, z;
+};
+
+struct StationRec
+{
+    uint32 systemID, constellationID, regionID;
+};
+
+struct AttrRec
+{
+    uint16 attributeID;
+    double value;
+};
+
+struct MatlRec
+{
+    uint16 typeID;
+    uint32 quantity;
+};
+
+/* one table both ways, and the keys looked up in it */
+template<typename K, typename V, typename Tree>
+struct Table
+{
+    Tree tree;
+    FlatMap<K, V> flat;
+    std::vector<K> probes;
+
+    /* a std::map keeps the first value of a key, so the FlatMap only gets that one too */
+    void Add( K key, const V& value )
+    {
+        const size_t before = tree.size();
+        tree.emplace( key, value );
+        if( tree.size() > before )
+            flat.Add( key, value );
+    }
+    /* 'absent' of every 16 probes are for keys that aren't there */
+    void Seal( uint32& seed, size_t absent )
+    {
+        flat.Seal();
+        std::vector<K> keys;
+        for( auto cur : flat )
+            if( keys.empty() or keys.back() != cur.first )
+                keys.push_back( cur.first );
+        probes.resize( 1 << 16 );
+        for( size_t i = 0; i < probes.size(); ++i ) {
+            if( Random( seed, 16 ) < absent ) {
+                K key = (K)Random( seed, 0xFFFF );
+                while( tree.find( key ) != tree.end() )
+                    ++key;
+                probes[ i ] = key;
+            } else {
+                probes[ i ] = keys[ Random( seed, keys.size() ) ];
+            }
+        }
+    }
+};
+
+template<typename K, typename V> using MapTable = Table<K, V, std::map<K, V>>;
+template<typename K, typename V> using MultiTable = Table<K, V, std::multimap<K, V>>;
+
+template<typename K, typename V, typename Tree>
+bool Verify( const char* name, Table<K, V, Tree>& table, std::function<bool( const V&, const V& )> same )
+{
+    // the walk, in order
+    size_t count = 0;
+    typename Tree::const_iterator itr = table.tree.begin();
+    for( auto cur : table.flat ) {
+        if( itr == table.tree.end() or itr->first != cur.first or !same( itr->second, cur.second ) ) {
+            ::printf( "%s: walk differs at entry %lu\n", name, count );
+            return false;
+        }
+        ++itr;
+        ++count;
+    }
+    if( itr != table.tree.end() ) {
+        ::printf( "%s: walk saw %lu entries, expected %lu\n", name, count, table.tree.size() );
+        return false;
+    }
+
+    // every probe's range, present or not
+    for( auto key : table.probes ) {
+        auto range = table.tree.equal_range( key );
+        Span<V> span = table.flat.Range( key );
+        if( (size_t)std::distance( range.first, range.second ) != span.size() ) {
+            ::printf( "%s: key %u has %lu values, expected %lu\n", name, (uint32)key, span.size(), (size_t)std::distance( range.first, range.second ) );
+            return false;
+        }
+        size_t i = 0;
+        for( auto it = range.first; it != range.second; ++it, ++i )
+            if( !same( it->second, span[ i ] ) ) {
+                ::printf( "%s: key %u value %lu differs\n", name, (uint32)key, i );
+                return false;
+            }
+        if( ( table.flat.Find( key ) == nullptr ) != ( range.first == range.second ) ) {
+            ::printf( "%s: Find( %u ) differs\n", name, (uint32)key );
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Insert() after Seal() and View() of somebody else's arrays */
+bool VerifyChanges()
+{
+    FlatMap<uint32, uint32> flat;
+    std::multimap<uint32, uint32> tree;
+    uint32 seed = 99;
+    for( uint32 i = 0; i < 1000; ++i ) {
+        const uint32 key = Random( seed, 300 ), value = Random( seed, 1000000 );
+        flat.Add( key, value );
+        tree.emplace( key, value );
+    }
+    flat.Seal();
+    for( uint32 i = 0; i < 100; ++i ) {
+        const uint32 key = Random( seed, 400 ), value = Random( seed, 1000000 );
+        flat.Insert( key, value );
+        tree.emplace( key, value );
+    }
+
+    std::vector<uint32> keys( flat.Keys().begin(), flat.Keys().end() );
+    std::vector<uint32> values( flat.Values().begin(), flat.Values().end() );
+    FlatMap<uint32, uint32> view;
+    view.View( keys.data(), values.data(), keys.size() );
+    for( uint32 key = 0; key < 401; ++key ) {
+        auto range = tree.equal_range( key );
+        std::vector<uint32> expected;
+        for( auto it = range.first; it != range.second; ++it )
+            expected.push_back( it->second );
+        Span<uint32> got = flat.Range( key ), seen = view.Range( key );
+        if( !std::equal( expected.begin(), expected.end(), got.begin(), got.end() )
+         or !std::equal( expected.begin(), expected.end(), seen.begin(), seen.end() ) ) {
+            ::printf( "after Insert()/View(): key %u differs\n", key );
+            return false;
+        }
+    }
+    if( !view.IsView() or ( view.Values().data() != values.data() ) ) {
+        ::printf( "View() copied\n" );
+        return false;
+    }
+
+    // an Insert() into a view makes the table its own and leaves the viewed arrays alone
+    view.Insert( 5000, 1 );
+    if( view.IsView() or ( view.size() != keys.size() + 1 ) or ( keys.size() != flat.size() ) or !view.Has( 5000 ) ) {
+        ::printf( "Insert() into a view went wrong\n" );
+        return false;
+    }
+    return true;
+}
+
+/* times 'lookups' calls of both ways over the table's probes; they must sum the same */
+template<typename K, typename V, typename Tree, typename TreeFn, typename FlatFn>
+bool Time( const char* name, const Table<K, V, Tree>& table, size_t lookups, TreeFn treeFn, FlatFn flatFn )
+{
+    const size_t mask = table.probes.size() - 1;
+    double treeSum = 0.0, flatSum = 0.0;
+
+    double start = GetTimeUSeconds();
+    for( size_t i = 0; i < lookups; ++i )
+        treeSum += treeFn( table.tree, table.probes[ i & mask ] );
+    const double treeTime = GetTimeUSeconds() - start;
+
+    start = GetTimeUSeconds();
+    for( size_t i = 0; i < lookups; ++i )
+        flatSum += flatFn( table.flat, table.probes[ i & mask ] );
+    const double flatTime = GetTimeUSeconds() - start;
+
+    if( treeSum != flatSum ) {
+        ::printf( "%s: sums differ: %f and %f\n", name, treeSum, flatSum );
+        return false;
+    }
+    ::printf( "%-24s %8lu %12.1f %12.1f %8.2fx\n", name, table.flat.size(),
+              treeTime * 1000.0 / lookups, flatTime * 1000.0 / lookups, treeTime / flatTime );
+    return true;
+}
+
+/* the first value of 'key', as map::find() or FlatMap::Find() */
+template<typename Tree>
+const typename Tree::mapped_type* TreeFind( const Tree& tree, typename Tree::key_type key )
+{
+    auto itr = tree.find( key );
+    return ( itr == tree.end() ? nullptr : &itr->second );
+}
+
+std::string MakeName( uint32& seed )
+{
+    std::string name;
+    const size_t length = 6 + Random( seed, 20 );
+    for( size_t i = 0; i < length; ++i )
+        name += (char)( 'a' + Random( seed, 26 ) );
+    return name;
+}
+
+}
+
+int utils_FlatMapBench( int argc, char* argv[] )
+{
+    const size_t lookups = ( 1 < argc ? atoi( argv[1] ) : 2000000 );
+
+    uint32 seed = 4711;
+    MapTable<uint16, TypeRec> types;
+    MapTable<uint16, NameRec> groups, categories, attrTypes;
+    MapTable<uint32, SystemRec> systems;
+    MapTable<uint32, StaticRec> statics;
+    MapTable<uint32, StationRec> stations;
+    MultiTable<uint32, uint32> stationList, whSystems;
+    MultiTable<uint16, AttrRec> typeAttrs;
+    MultiTable<uint16, MatlRec> ramMatls, ramReqs;
+
+    // about the sizes of the crucible tables, added in no particular order
+    for( uint32 i = 0; i < 22000; ++i ) {
+        TypeRec rec = TypeRec();
+        rec.groupID = Random( seed, 1400 );
+        rec.refinable = Random( seed, 2 );
+        rec.mass = Random( seed, 100000 );
+        rec.name = MakeName( seed );
+        const uint16 typeID = Random( seed, 40000 );
+        types.Add( typeID, rec );
+        for( uint32 k = 0, attrs = Random( seed, 40 ); k < attrs; ++k ) {
+            AttrRec attr = { (uint16)Random( seed, 1800 ), Random( seed, 100000 ) / 10.0 };
+            typeAttrs.Add( typeID, attr );
+        }
+        if( Random( seed, 4 ) == 0 )
+            for( uint32 k = 0, matls = 1 + Random( seed, 8 ); k < matls; ++k ) {
+                MatlRec matl = { (uint16)Random( seed, 40000 ), Random( seed, 10000 ) };
+                ramMatls.Add( typeID, matl );
+                ramReqs.Add( typeID, matl );
+            }
+    }
+    for( uint32 i = 0; i < 1400; ++i )
+        groups.Add( i, NameRec{ (uint16)i, (bool)Random( seed, 2 ), MakeName( seed ) } );
+    for( uint32 i = 0; i < 45; ++i )
+        categories.Add( i, NameRec{ (uint16)i, true, MakeName( seed ) } );
+    for( uint32 i = 0; i < 1800; ++i )
+        attrTypes.Add( i, NameRec{ (uint16)i, (bool)Random( seed, 2 ), MakeName( seed ) } );
+    for( uint32 i = 0; i < 7930; ++i ) {
+        SystemRec rec = SystemRec();
+        rec.regionID = 10000000 + Random( seed, 70 );
+        rec.securityRating = Random( seed, 100 ) / 100.0f;
+        rec.name = MakeName( seed );
+        rec.securityClass = "A";
+        systems.Add( 30000000 + i, rec );
+        if( i > 5000 )
+            whSystems.Add( 1 + Random( seed, 9 ), 30000000 + i );
+    }
+    for( uint32 i = 0; i < 500000; ++i ) {
+        StaticRec rec = StaticRec();
+        rec.itemID = 40000000 + Random( seed, 1000000 );
+        rec.systemID = 30000000 + Random( seed, 7930 );
+        rec.typeID = Random( seed, 40000 );
+        rec.x = Random( seed, 1000000 );
+        statics.Add( rec.itemID, rec );
+    }
+    for( uint32 i = 0; i < 5200; ++i ) {
+        StationRec rec = StationRec();
+        rec.systemID = 30000000 + Random( seed, 5000 );
+        rec.regionID = 10000000 + Random( seed, 70 );
+        const uint32 stationID = 60000000 + Random( seed, 20000 );
+        stations.Add( stationID, rec );
+        stationList.Add( rec.systemID, stationID );
+    }
+
+    types.Seal( seed, 2 );
+    groups.Seal( seed, 1 );
+    categories.Seal( seed, 1 );
+    attrTypes.Seal( seed, 1 );
+    systems.Seal( seed, 2 );
+    statics.Seal( seed, 2 );
+    stations.Seal( seed, 4 );
+    stationList.Seal( seed, 2 );
+    whSystems.Seal( seed, 0 );
+    typeAttrs.Seal( seed, 1 );
+    ramMatls.Seal( seed, 2 );
+    ramReqs.Seal( seed, 2 );
+
+    // probes for the uint32 tables, from their own key ranges
+    auto spread = [&seed]( std::vector<uint32>& probes, uint32 base, uint32 range ) {
+        for( size_t i = 0; i < probes.size(); i += 8 )
+            probes[ i ] = base + Random( seed, range );
+    };
+    spread( systems.probes, 30000000, 8000 );
+    spread( statics.probes, 40000000, 1000000 );
+    spread( stations.probes, 60000000, 20000 );
+    spread( stationList.probes, 30000000, 8000 );
+
+    auto sameType = []( const TypeRec& a, const TypeRec& b ) { return ( a.groupID == b.groupID and a.name == b.name ); };
+    auto sameName = []( const NameRec& a, const NameRec& b ) { return ( a.id == b.id and a.name == b.name ); };
+    auto sameSystem = []( const SystemRec& a, const SystemRec& b ) { return ( a.regionID == b.regionID and a.name == b.name ); };
+    auto sameStatic = []( const StaticRec& a, const StaticRec& b ) { return ( ::memcmp( &a, &b, sizeof( a ) ) == 0 ); };
+    auto sameStation = []( const StationRec& a, const StationRec& b ) { return ( ::memcmp( &a, &b, sizeof( a ) ) == 0 ); };
+    auto sameAttr = []( const AttrRec& a, const AttrRec& b ) { return ( a.attributeID == b.attributeID and a.value == b.value ); };
+    auto sameMatl = []( const MatlRec& a, const MatlRec& b ) { return ( a.typeID == b.typeID and a.quantity == b.quantity ); };
+    auto sameID = []( const uint32& a, const uint32& b ) { return ( a == b ); };
+    if( !Verify<uint16, TypeRec>( "types", types, sameType )
+     or !Verify<uint16, NameRec>( "groups", groups, sameName )
+     or !Verify<uint16, NameRec>( "categories", categories, sameName )
+     or !Verify<uint16, NameRec>( "attribute types", attrTypes, sameName )
+     or !Verify<uint32, SystemRec>( "systems", systems, sameSystem )
+     or !Verify<uint32, StaticRec>( "static entities", statics, sameStatic )
+     or !Verify<uint32, StationRec>( "stations", stations, sameStation )
+     or !Verify<uint32, uint32>( "station lists", stationList, sameID )
+     or !Verify<uint32, uint32>( "wh class systems", whSystems, sameID )
+     or !Verify<uint16, AttrRec>( "type attributes", typeAttrs, sameAttr )
+     or !Verify<uint16, MatlRec>( "ram materials", ramMatls, sameMatl )
+     or !Verify<uint16, MatlRec>( "ram requirements", ramReqs, sameMatl )
+     or !VerifyChanges() )
+        return 1;
+    ::printf( "ranges, finds, walks, Insert() and View() match std::multimap\n" );
+
+    ::printf( "%-24s %8s %12s %12s %9s\n", "accessor", "entries", "map ns", "flat ns", "speedup" );
+    bool ok = true;
+    // copies the record out, as GetType() does
+    ok = ok and Time( "GetType", types, lookups,
+        []( const std::map<uint16, TypeRec>& t, uint16 k ) { const TypeRec* p = TreeFind( t, k ); TypeRec r; if( p != nullptr ) r = *p; return (double)r.mass; },
+        []( const FlatMap<uint16, TypeRec>& t, uint16 k ) { const TypeRec* p = t.Find( k ); TypeRec r; if( p != nullptr ) r = *p; return (double)r.mass; } );
+    ok = ok and Time( "FindType", types, lookups,
+        []( const std::map<uint16, TypeRec>& t, uint16 k ) { const TypeRec* p = TreeFind( t, k ); return ( p == nullptr ? 0.0 : p->mass ); },
+        []( const FlatMap<uint16, TypeRec>& t, uint16 k ) { const TypeRec* p = t.Find( k ); return ( p == nullptr ? 0.0 : p->mass ); } );
+    ok = ok and Time( "GetTypeName", types, lookups,
+        []( const std::map<uint16, TypeRec>& t, uint16 k ) { const TypeRec* p = TreeFind( t, k ); return (double)( p == nullptr ? 4 : p->name.size() ); },
+        []( const FlatMap<uint16, TypeRec>& t, uint16 k ) { const TypeRec* p = t.Find( k ); return (double)( p == nullptr ? 4 : p->name.size() ); } );
+    ok = ok and Time( "IsRefinable", types, lookups,
+        []( const std::map<uint16, TypeRec>& t, uint16 k ) { const TypeRec* p = TreeFind( t, k ); return ( p != nullptr and p->refinable ? 1.0 : 0.0 ); },
+        []( const FlatMap<uint16, TypeRec>& t, uint16 k ) { const TypeRec* p = t.Find( k ); return ( p != nullptr and p->refinable ? 1.0 : 0.0 ); } );
+    ok = ok and Time( "GetGroupName", groups, lookups,
+        []( const std::map<uint16, NameRec>& t, uint16 k ) { const NameRec* p = TreeFind( t, k ); return (double)( p == nullptr ? 4 : p->name.size() ); },
+        []( const FlatMap<uint16, NameRec>& t, uint16 k ) { const NameRec* p = t.Find( k ); return (double)( p == nullptr ? 4 : p->name.size() ); } );
+    ok = ok and Time( "GetCategoryName", categories, lookups,
+        []( const std::map<uint16, NameRec>& t, uint16 k ) { const NameRec* p = TreeFind( t, k ); return (double)( p == nullptr ? 4 : p->name.size() ); },
+        []( const FlatMap<uint16, NameRec>& t, uint16 k ) { const NameRec* p = t.Find( k ); return (double)( p == nullptr ? 4 : p->name.size() ); } );
+    ok = ok and Time( "GetAttrName", attrTypes, lookups,
+        []( const std::map<uint16, NameRec>& t, uint16 k ) { const NameRec* p = TreeFind( t, k ); return (double)( p == nullptr ? 4 : p->name.size() ); },
+        []( const FlatMap<uint16, NameRec>& t, uint16 k ) { const NameRec* p = t.Find( k ); return (double)( p == nullptr ? 4 : p->name.size() ); } );
+    ok = ok and Time( "IsStackable", attrTypes, lookups,
+        []( const std::map<uint16, NameRec>& t, uint16 k ) { const NameRec* p = TreeFind( t, k ); return ( p == nullptr or p->flag ? 1.0 : 0.0 ); },
+        []( const FlatMap<uint16, NameRec>& t, uint16 k ) { const NameRec* p = t.Find( k ); return ( p == nullptr or p->flag ? 1.0 : 0.0 ); } );
+    ok = ok and Time( "IsSolarSystem", systems, lookups,
+        []( const std::map<uint32, SystemRec>& t, uint32 k ) { return ( t.find( k ) != t.end() ? 1.0 : 0.0 ); },
+        []( const FlatMap<uint32, SystemRec>& t, uint32 k ) { return ( t.Has( k ) ? 1.0 : 0.0 ); } );
+    ok = ok and Time( "GetSystemName", systems, lookups,
+        []( const std::map<uint32, SystemRec>& t, uint32 k ) { const SystemRec* p = TreeFind( t, k ); return (double)( p == nullptr ? 7 : p->name.size() ); },
+        []( const FlatMap<uint32, SystemRec>& t, uint32 k ) { const SystemRec* p = t.Find( k ); return (double)( p == nullptr ? 7 : p->name.size() ); } );
+    ok = ok and Time( "GetSystemData", systems, lookups,
+        []( const std::map<uint32, SystemRec>& t, uint32 k ) { const SystemRec* p = TreeFind( t, k ); SystemRec r; if( p != nullptr ) r = *p; return (double)r.securityRating; },
+        []( const FlatMap<uint32, SystemRec>& t, uint32 k ) { const SystemRec* p = t.Find( k ); SystemRec r; if( p != nullptr ) r = *p; return (double)r.securityRating; } );
+    ok = ok and Time( "IsStation", stations, lookups,
+        []( const std::map<uint32, StationRec>& t, uint32 k ) { return ( t.find( k ) != t.end() ? 1.0 : 0.0 ); },
+        []( const FlatMap<uint32, StationRec>& t, uint32 k ) { return ( t.Has( k ) ? 1.0 : 0.0 ); } );
+    ok = ok and Time( "GetStationSystem", stations, lookups,
+        []( const std::map<uint32, StationRec>& t, uint32 k ) { const StationRec* p = TreeFind( t, k ); return ( p == nullptr ? 0.0 : p->systemID ); },
+        []( const FlatMap<uint32, StationRec>& t, uint32 k ) { const StationRec* p = t.Find( k ); return ( p == nullptr ? 0.0 : p->systemID ); } );
+    ok = ok and Time( "GetStationRegion", stations, lookups,
+        []( const std::map<uint32, StationRec>& t, uint32 k ) { const StationRec* p = TreeFind( t, k ); return ( p == nullptr ? 0.0 : p->regionID ); },
+        []( const FlatMap<uint32, StationRec>& t, uint32 k ) { const StationRec* p = t.Find( k ); return ( p == nullptr ? 0.0 : p->regionID ); } );
+    ok = ok and Time( "GetStaticInfo", statics, lookups,
+        []( const std::map<uint32, StaticRec>& t, uint32 k ) { const StaticRec* p = TreeFind( t, k ); StaticRec r = StaticRec(); if( p != nullptr ) r = *p; return r.x; },
+        []( const FlatMap<uint32, StaticRec>& t, uint32 k ) { const StaticRec* p = t.Find( k ); StaticRec r = StaticRec(); if( p != nullptr ) r = *p; return r.x; } );
+    ok = ok and Time( "GetStaticType", statics, lookups,
+        []( const std::map<uint32, StaticRec>& t, uint32 k ) { const StaticRec* p = TreeFind( t, k ); return ( p == nullptr ? 0.0 : p->typeID ); },
+        []( const FlatMap<uint32, StaticRec>& t, uint32 k ) { const StaticRec* p = t.Find( k ); return ( p == nullptr ? 0.0 : p->typeID ); } );
+    // the vector copies the old accessors made, against the spans of the new ones
+    ok = ok and Time( "GetDgmTypeAttrs", typeAttrs, lookups,
+        []( const std::multimap<uint16, AttrRec>& t, uint16 k ) {
+            std::vector<AttrRec> v; auto r = t.equal_range( k ); for( auto it = r.first; it != r.second; ++it ) v.push_back( it->second );
+            double sum = 0.0; for( auto& cur : v ) sum += cur.value; return sum; },
+        []( const FlatMap<uint16, AttrRec>& t, uint16 k ) { double sum = 0.0; for( auto& cur : t.Range( k ) ) sum += cur.value; return sum; } );
+    ok = ok and Time( "GetRamMaterials", ramMatls, lookups,
+        []( const std::multimap<uint16, MatlRec>& t, uint16 k ) {
+            std::vector<MatlRec> v; auto r = t.equal_range( k ); for( auto it = r.first; it != r.second; ++it ) v.push_back( it->second );
+            double sum = 0.0; for( auto& cur : v ) sum += cur.quantity; return sum; },
+        []( const FlatMap<uint16, MatlRec>& t, uint16 k ) { double sum = 0.0; for( auto& cur : t.Range( k ) ) sum += cur.quantity; return sum; } );
+    ok = ok and Time( "GetRamRequirements", ramReqs, lookups,
+        []( const std::multimap<uint16, MatlRec>& t, uint16 k ) {
+            std::vector<MatlRec> v; auto r = t.equal_range( k ); for( auto it = r.first; it != r.second; ++it ) v.push_back( it->second );
+            double sum = 0.0; for( auto& cur : v ) sum += cur.typeID; return sum; },
+        []( const FlatMap<uint16, MatlRec>& t, uint16 k ) { double sum = 0.0; for( auto& cur : t.Range( k ) ) sum += cur.typeID; return sum; } );
+    ok = ok and Time( "GetStationList", stationList, lookups,
+        []( const std::multimap<uint32, uint32>& t, uint32 k ) {
+            std::vector<uint32> v; auto r = t.equal_range( k ); for( auto it = r.first; it != r.second; ++it ) v.push_back( it->second );
+            return (double)v.size(); },
+        []( const FlatMap<uint32, uint32>& t, uint32 k ) { return (double)t.Range( k ).size(); } );
+    ok = ok and Time( "GetWHClassSystems", whSystems, lookups / 10,
+        []( const std::multimap<uint32, uint32>& t, uint32 k ) {
+            std::vector<uint32> v; auto r = t.equal_range( k ); for( auto it = r.first; it != r.second; ++it ) v.push_back( it->second );
+            return (double)v[ v.size() / 2 ]; },
+        []( const FlatMap<uint32, uint32>& t, uint32 k ) { Span<uint32> s = t.Range( k ); return (double)s[ s.size() / 2 ]; } );
+
+    return ( ok ? 0 : 1 );
+}
@@ -0,0 +1,159 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     Aknor Jaden
+*/
+
+
+#include "eve-test.h"
+
+#include "utils/SnapshotFile.h"
+
+/*
+ * Writes a SnapshotFile, reads it back thru the map and compares, then checks
+ * that a wrong version or hash, a damaged header and a cut short file are all
+ * refused.  Times writing and opening a file of 'records' 40-byte records.
+ *
+ * usage: eve-test utils/SnapshotFileTest [records]
+ */
+
+namespace {
+
+const char* TEST_PATH = "SnapshotFileTest.snap";
+
+struct Record
+{
+    uint32 id;
+    uint32 typeID;
+    double x, y, z;
+    float radius;
+};
+
+bool Refused( const char* what, uint32 version, uint64_t hash )
+{
+    SnapshotFile file;
+    if( file.Open( TEST_PATH, version, hash ) ) {
+        ::printf( "%s: opened anyway\n", what );
+        return false;
+    }
+    return true;
+}
+
+/* overwrites 'bytes' at 'offset' of the test file, or cuts 'bytes' off its end if 'data' is null */
+void Damage( long offset, const void* data, size_t bytes )
+{
+    std::string contents;
+    FILE* file = fopen( TEST_PATH, "rb" );
+    char buf[ 4096 ];
+    for( size_t read; ( read = fread( buf, 1, sizeof( buf ), file ) ) > 0; )
+        contents.append( buf, read );
+    fclose( file );
+
+    if( data == nullptr )
+        contents.resize( contents.size() - std::min( bytes, contents.size() ) );
+    else
+        contents.replace( offset, bytes, (const char*)data, bytes );
+
+    file = fopen( TEST_PATH, "wb" );
+    fwrite( contents.data(), 1, contents.size(), file );
+    fclose( file );
+}
+
+}
+
+int utils_SnapshotFileTest( int argc, char* argv[] )
+{
+    const size_t records = ( 1 < argc ? atoi( argv[1] ) : 100000 );
+    const uint32 version = 3;
+    const uint64_t hash = SnapshotFile::Hash( std::string( "invTypes:1234" ), SnapshotFile::Hash( std::string( "mapDenormalize:5678" ) ) );
+
+    std::vector<Record> data( records );
+    for( size_t i = 0; i < records; ++i ) {
+        data[ i ] = Record();
+        data[ i ].id = 40000000 + (uint32)i * 3;
+        data[ i ].typeID = (uint32)i % 5000;
+        data[ i ].x = i * 1.5;
+        data[ i ].y = i * -2.25;
+        data[ i ].z = i * 1e9;
+        data[ i ].radius = i * 0.5f;
+    }
+    const std::string name( "a name, not a multiple of 16 long" );
+
+    double start = GetTimeMSeconds();
+    SnapshotFile::Writer writer;
+    writer.Add( 1, name.data(), name.size() );
+    writer.AddArray( 2, data );
+    writer.Add( 3, nullptr, 0 );
+    if( !writer.Write( TEST_PATH, version, hash ) ) {
+        ::printf( "unable to write %s\n", TEST_PATH );
+        return 1;
+    }
+    const double writeTime = GetTimeMSeconds() - start;
+
+    start = GetTimeMSeconds();
+    {
+        SnapshotFile file;
+        if( !file.Open( TEST_PATH, version, hash ) ) {
+            ::printf( "unable to open %s\n", TEST_PATH );
+            return 1;
+        }
+        const double openTime = GetTimeMSeconds() - start;
+
+        size_t bytes( 0 ), count( 0 );
+        const char* pName = (const char*)file.Get( 1, bytes );
+        const Record* pData = file.GetArray<Record>( 2, count );
+        if( ( pName == nullptr ) or ( std::string( pName, bytes ) != name ) ) {
+            ::printf( "section 1 differs\n" );
+            return 1;
+        }
+        if( ( pData == nullptr ) or ( count != records ) or ( (uintptr_t)pData % 16 != 0 )
+            or ( ( records > 0 ) and ( memcmp( pData, data.data(), records * sizeof( Record ) ) != 0 ) ) ) {
+            ::printf( "section 2 differs, or isn't aligned\n" );
+            return 1;
+        }
+        if( ( file.Get( 3, bytes ) == nullptr ) or ( bytes != 0 ) or ( file.Get( 4, bytes ) != nullptr ) ) {
+            ::printf( "empty or missing sections wrong\n" );
+            return 1;
+        }
+
+        ::printf( "%lu records, %lu bytes: written in %.3fms, opened in %.3fms\n", records, file.GetSize(), writeTime, openTime );
+    }
+
+    if( !Refused( "wrong version", version + 1, hash ) or !Refused( "wrong hash", version, hash + 1 ) )
+        return 1;
+
+    // a changed section table, then a file cut short
+    const uint32 junk = 0xDEADBEEF;
+    Damage( 40, &junk, sizeof( junk ) );
+    if( !Refused( "damaged header", version, hash ) )
+        return 1;
+    writer.Write( TEST_PATH, version, hash );
+    Damage( 0, nullptr, 8 );
+    if( !Refused( "cut short", version, hash ) )
+        return 1;
+
+    remove( TEST_PATH );
+    if( !Refused( "missing file", version, hash ) )
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "math/SpatialGrid.h"
+
+/*
+ * Looks up points in a synthetic system of bubbles the way BubbleManager::FindBubble()
+ * does, once with the old linear scan over every bubble of the system and once with
+ * SpatialGrid, and checks both find the same bubble for every point.
+ *
+ * Two layouts are used: bubbles spread over the whole system, and bubbles packed
+ * edge to edge around a few hot spots (gates, belts, a big fight), which puts
+ * many bubbles in the cells a grid lookup visits.
+ *
+ * usage: eve-test utils/SpatialGridBench [bubbles] [lookups]
+ */
+
+namespace {
+
+/* same numbers as BubbleManager.h */
+const double sRadius = 300000.0;
+const double sHysteresis = 5000.0;
+
+struct Bubble
+{
+    GPoint center;
+
+    bool InBubble( const GPoint& pt ) const { return center.distance( pt ) < sRadius; }
+    bool IsOverlap( const GPoint& pt ) const { return center.distance( pt ) < sRadius * 2; }
+};
+
+double Random( uint32& seed )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) / double( 1 << 24 );
+}
+
+GPoint RandomPoint( uint32& seed, double extent )
+{
+    return GPoint( ( Random( seed ) * 2 - 1 ) * extent,
+                   ( Random( seed ) * 2 - 1 ) * extent,
+                   ( Random( seed ) * 2 - 1 ) * extent );
+}
+
+/* places bubbles like MakeBubble() would, rejecting any that overlap an existing one */
+void MakeBubbles( std::vector<Bubble>& bubbles, size_t count, bool packed, uint32 seed )
+{
+    // ~10AU across when spread; 8 hot spots of a few dozen bubbles each when packed
+    const double extent = 7.5e11;
+    GPoint spots[ 8 ];
+    for( size_t i = 0; i < 8; ++i )
+        spots[ i ] = RandomPoint( seed, extent );
+
+    SpatialGrid<size_t> grid( sRadius * 2 );
+    while( bubbles.size() < count ) {
+        Bubble b;
+        if( packed ) {
+            const double reach = sRadius * 2 * std::cbrt( (double)count / 8 ) * 1.5;
+            b.center = spots[ bubbles.size() % 8 ] + RandomPoint( seed, reach );
+        } else
+            b.center = RandomPoint( seed, extent );
+
+        const bool overlap = grid.Visit( b.center, sRadius * 2 + sHysteresis, [&]( size_t cur ) { return bubbles[ cur ].IsOverlap( b.center ); } );
+        if( overlap )
+            continue;
+
+        grid.Insert( b.center, bubbles.size() );
+        bubbles.push_back( b );
+    }
+}
+
+/* half the points inside some bubble, half anywhere in the system */
+void MakeLookups( std::vector<GPoint>& points, const std::vector<Bubble>& bubbles, size_t count, uint32 seed )
+{
+    for( size_t i = 0; i < count; ++i ) {
+        if( i % 2 ) {
+            const Bubble& b = bubbles[ (size_t)( Random( seed ) * bubbles.size() ) ];
+            points.push_back( b.center + RandomPoint( seed, sRadius * 0.57 ) );
+        } else
+            points.push_back( RandomPoint( seed, 7.5e11 ) );
+    }
+}
+
+const Bubble* FindLinear( const std::vector<Bubble>& bubbles, const GPoint& pos )
+{
+    for( const Bubble& cur : bubbles )
+        if( cur.InBubble( pos ) )
+            return &cur;
+    return nullptr;
+}
+
+const Bubble* FindGrid( const SpatialGrid<const Bubble*>& grid, const GPoint& pos )
+{
+    const Bubble* res( nullptr );
+    grid.Visit( pos, sRadius + sHysteresis, [&]( const Bubble* cur ) {
+        if( !cur->InBubble( pos ) )
+            return false;
+        res = cur;
+        return true;
+    } );
+    return res;
+}
+
+bool RunLayout( const char* name, size_t count, size_t lookups, bool packed )
+{
+    std::vector<Bubble> bubbles;
+    MakeBubbles( bubbles, count, packed, 777 );
+
+    SpatialGrid<const Bubble*> grid( sRadius * 2 );
+    for( const Bubble& cur : bubbles )
+        grid.Insert( cur.center, &cur );
+
+    std::vector<GPoint> points;
+    MakeLookups( points, bubbles, lookups, 12345 );
+
+    // verify
+    size_t hits = 0;
+    for( const GPoint& pos : points ) {
+        const Bubble* linear = FindLinear( bubbles, pos );
+        if( linear != FindGrid( grid, pos ) ) {
+            ::printf( "%s: lookup mismatch at %.1f, %.1f, %.1f\n", name, pos.x, pos.y, pos.z );
+            return false;
+        }
+        if( linear != nullptr )
+            ++hits;
+    }
+
+    // time
+    size_t linearHits = 0, gridHits = 0;
+    double start = GetTimeUSeconds();
+    for( const GPoint& pos : points )
+        if( FindLinear( bubbles, pos ) != nullptr )
+            ++linearHits;
+    const double linearTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    start = GetTimeUSeconds();
+    for( const GPoint& pos : points )
+        if( FindGrid( grid, pos ) != nullptr )
+            ++gridHits;
+    const double gridTime = ( GetTimeUSeconds() - start ) / 1e6;
+
+    ::printf( "%-8s %6lu %8lu %8lu %14.0f %14.0f %8.1fx\n", name, bubbles.size(), points.size(), hits,
+              points.size() / linearTime, points.size() / gridTime, linearTime / gridTime );
+
+    // every bubble must come back out of the grid
+    for( const Bubble& cur : bubbles )
+        if( !grid.Erase( cur.center, &cur ) ) {
+            ::printf( "%s: bubble at %.1f, %.1f, %.1f not found for erase\n", name, cur.center.x, cur.center.y, cur.center.z );
+            return false;
+        }
+
+    return ( linearHits == hits ) and ( gridHits == hits ) and grid.empty();
+}
+
+}
+
+int utils_SpatialGridBench( int argc, char* argv[] )
+{
+    const size_t count = ( 1 < argc ? atoi( argv[1] ) : 1000 );
+    const size_t lookups = ( 2 < argc ? atoi( argv[2] ) : 200000 );
+
+    ::printf( "%-8s %6s %8s %8s %14s %14s %9s\n", "layout", "bbls", "lookups", "hits", "linear/s", "grid/s", "speedup" );
+    if( !RunLayout( "spread", count, lookups, false ) )
+        return 1;
+    if( !RunLayout( "packed", count, lookups, true ) )
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "utils/TicList.h"
+
+/*
+ * Runs the entity tic of a busy system the way SystemManager::ProcessTic() used to
+ * (std::map, restarted from begin() and skipped past the last processed itemID
+ * whenever an entity was added or removed) and the way it does with TicList.
+ *
+ * Ships fire missiles that live a few tics and then remove themselves, and
+ * now and then destroy another entity, which is replaced by a new spawn, so
+ * entities come and go from inside Process() the whole time.
+ *
+ * The TicList run checks every tic that each entity there at the start and
+ * still there at the end was processed exactly once, and that nothing is
+ * processed after it was removed.
+ *
+ * Tic times are reported like Profiler does for Profile::system; Profiler
+ * itself lives in eve-server, which eve-test doesn't link.
+ *
+ * usage: eve-test utils/TicListBench [entities] [tics]
+ */
+
+namespace {
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+class System;
+
+struct Entity
+{
+    uint32 id;
+    bool missile;
+    bool alive;
+    uint16 life;            // missiles: tics left
+    uint32 processed;       // Process() calls this tic
+    double pos;
+
+    void Process( System& sys );
+};
+
+class System
+{
+public:
+    System( bool useTicList, uint32 seed ) : mErrors( 0 ), mUseTicList( useTicList ), mChanged( false ), mSeed( seed ), mNextID( 1 ) { }
+
+    uint32 Rand( uint32 limit ) { return Random( mSeed, limit ); }
+
+    Entity* Spawn( bool missile )
+    {
+        mPool.push_back( Entity() );
+        Entity* pEnt = &mPool.back();
+        pEnt->id = mNextID++;
+        pEnt->missile = missile;
+        pEnt->alive = true;
+        pEnt->life = ( missile ? 2 + Rand( 8 ) : 0 );
+        pEnt->processed = 0;
+        pEnt->pos = 0.0;
+
+        mChanged = true;
+        mEntities[ pEnt->id ] = pEnt;
+        if( mUseTicList )
+            mTicList.Add( pEnt->id, pEnt );
+        return pEnt;
+    }
+
+    void Remove( Entity* pEnt )
+    {
+        if( !pEnt->alive )
+            return;
+        pEnt->alive = false;
+
+        mChanged = true;
+        if( mEntities.erase( pEnt->id ) > 0 and mUseTicList )
+            mTicList.Remove( pEnt->id );
+    }
+
+    /* a random entity other than 'pSelf', if any */
+    Entity* Target( Entity* pSelf )
+    {
+        std::map<uint32, Entity*>::iterator itr = mEntities.lower_bound( 1 + Rand( mNextID ) );
+        if( itr == mEntities.end() )
+            itr = mEntities.begin();
+        if( itr == mEntities.end() or itr->second == pSelf )
+            return nullptr;
+        return itr->second;
+    }
+
+    void Tic()
+    {
+        if( mUseTicList ) {
+            mTicList.Tic( [this]( Entity* pEnt ) { pEnt->Process( *this ); } );
+            return;
+        }
+
+        // SystemManager::ProcessTic(), as it was
+        std::map<uint32, Entity*>::iterator itr = mEntities.begin();
+        uint32 mLast( 0 );
+        while( itr != mEntities.end() ) {
+            if( mLast >= itr->first ) {
+                ++itr;
+                continue;
+            }
+
+            mLast = itr->first;
+            itr->second->Process( *this );
+
+            if( mChanged ) {
+                mChanged = false;
+                itr = mEntities.begin();
+                continue;
+            }
+            ++itr;
+        }
+    }
+
+    /* checks the last tic, then resets the counters for the next one */
+    bool Check( const std::set<uint32>& before )
+    {
+        bool ok = ( mErrors == 0 );
+        for( auto& cur : mEntities ) {
+            const bool expected = ( before.count( cur.first ) > 0 );
+            if( cur.second->processed != ( expected ? 1u : 0u ) ) {
+                ::printf( "entity %u processed %u times\n", cur.first, cur.second->processed );
+                ok = false;
+            }
+        }
+        for( Entity& cur : mPool )
+            cur.processed = 0;
+        return ok;
+    }
+
+    void Snapshot( std::set<uint32>& ids ) const
+    {
+        ids.clear();
+        for( auto& cur : mEntities )
+            ids.insert( cur.first );
+    }
+
+    size_t size() const { return mEntities.size(); }
+
+    uint32 mErrors;
+
+protected:
+    bool mUseTicList;
+    bool mChanged;
+    uint32 mSeed;
+    uint32 mNextID;
+    std::deque<Entity> mPool;           // never freed, so a stale call is caught instead of crashing
+    std::map<uint32, Entity*> mEntities;
+    TicList<uint32, Entity*> mTicList;
+};
+
+void Entity::Process( System& sys )
+{
+    if( !alive )
+        ++sys.mErrors;
+    ++processed;
+    pos += 1.5;
+
+    if( missile ) {
+        if( --life == 0 )
+            sys.Remove( this );
+        return;
+    }
+
+    // fire at something
+    if( sys.Rand( 4 ) == 0 )
+        sys.Spawn( true );
+
+    // kill something, something else warps in
+    if( sys.Rand( 20 ) == 0 ) {
+        Entity* pTarget = sys.Target( this );
+        if( pTarget != nullptr and !pTarget->missile ) {
+            sys.Remove( pTarget );
+            sys.Spawn( false );
+        }
+    }
+}
+
+struct Stats
+{
+    double hi, lo, total;
+    size_t count;
+};
+
+Stats Run( bool useTicList, size_t entities, size_t tics, bool& ok )
+{
+    System sys( useTicList, 777 );
+    for( size_t i = 0; i < entities; ++i )
+        sys.Spawn( false );
+
+    Stats res = { 0.0, 1e30, 0.0, 0 };
+    std::set<uint32> before;
+    ok = true;
+    for( size_t t = 0; t < tics; ++t ) {
+        if( useTicList )
+            sys.Snapshot( before );
+
+        const double start = GetTimeUSeconds();
+        sys.Tic();
+        const double elapsed = GetTimeUSeconds() - start;
+
+        res.hi = std::max( res.hi, elapsed );
+        res.lo = std::min( res.lo, elapsed );
+        res.total += elapsed;
+        ++res.count;
+
+        if( useTicList and !sys.Check( before ) ) {
+            ::printf( "tic %lu failed\n", t );
+            ok = false;
+            return res;
+        }
+    }
+
+    ::printf( "%10s %6lu entities at end   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n",
+              ( useTicList ? "TicList" : "legacy" ), sys.size(), res.hi, res.lo, res.total / res.count );
+    return res;
+}
+
+}
+
+int utils_TicListBench( int argc, char* argv[] )
+{
+    const size_t entities = ( 1 < argc ? atoi( argv[1] ) : 2000 );
+    const size_t tics = ( 2 < argc ? atoi( argv[2] ) : 100 );
+
+    ::printf( "%lu entities, %lu tics\n", entities, tics );
+
+    bool ok;
+    const Stats legacy = Run( false, entities, tics, ok );
+    const Stats list = Run( true, entities, tics, ok );
+    if( !ok )
+        return 1;
+
+    ::printf( "speedup (avg) %.1fx\n", legacy.total / list.total );
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "utils/TimeStats.h"
+
+/*
+ * First checks Histogram percentiles against the exact ones of a sorted copy
+ * of the values (within the 1/32 a bucket spans), and that TimeStats merges
+ * what several threads recorded, also after they exited.
+ *
+ * Then times recording from several threads, the way the Profiler kept its
+ * times (a vector per key behind one mutex) and with TimeStats.
+ *
+ * usage: eve-test utils/TimeStatsBench [threads] [records]
+ */
+
+namespace {
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+/* latency-like values: mostly small, a long tail */
+uint64_t MakeValue( uint32& seed )
+{
+    const uint32 scale[] = { 100, 10000, 1000000, 100000000 };
+    const uint32 roll = Random( seed, 100 );
+    return Random( seed, scale[ roll < 70 ? 0 : roll < 95 ? 1 : roll < 99 ? 2 : 3 ] );
+}
+
+bool VerifyHistogram()
+{
+    Histogram hist;
+    std::vector<uint64_t> values;
+    uint32 seed = 31337;
+    for( size_t i = 0; i < 100000; ++i ) {
+        values.push_back( MakeValue( seed ) );
+        hist.Record( values.back() );
+    }
+    std::sort( values.begin(), values.end() );
+
+    bool ok = ( hist.Count() == values.size() and hist.Max() == values.back() );
+    const double pcts[] = { 1.0, 50.0, 90.0, 99.0, 99.9, 100.0 };
+    for( double pct : pcts ) {
+        size_t rank = (size_t)( pct / 100.0 * values.size() + 0.5 );
+        if( rank < 1 )
+            rank = 1;
+        const uint64_t exact = values[ rank - 1 ];
+        const uint64_t got = hist.Percentile( pct );
+        if( got < exact or got > exact + exact / 32 ) {
+            ::printf( "p%.1f: %lu, expected %lu\n", pct, got, exact );
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool VerifyTimeStats()
+{
+    const uint32 key = sTimeStats.GetKey( "TimeStatsBench::Verify" );
+    const size_t threads = 4, records = 10000;
+
+    // half the threads are gone when read, half still alive
+    std::mutex lock;
+    std::condition_variable cond;
+    bool done = false;
+    size_t recorded = 0;
+    std::vector<std::thread> pool;
+    for( size_t t = 0; t < threads; ++t )
+        pool.emplace_back( [&, t]() {
+            for( size_t i = 0; i < records; ++i )
+                sTimeStats.Record( key, (double)( t + 1 ) );
+            std::unique_lock<std::mutex> l( lock );
+            ++recorded;
+            cond.notify_all();
+            if( t % 2 == 0 )
+                return;
+            cond.wait( l, [&]() { return done; } );
+        } );
+
+    {
+        std::unique_lock<std::mutex> l( lock );
+        cond.wait( l, [&]() { return recorded == threads; } );
+    }
+    for( size_t t = 0; t < threads; t += 2 )
+        pool[ t ].join();
+
+    Histogram hist;
+    sTimeStats.Get( key, hist );
+    bool ok = ( hist.Count() == threads * records and hist.Max() == threads * 1000 );
+
+    {
+        std::lock_guard<std::mutex> l( lock );
+        done = true;
+        cond.notify_all();
+    }
+    for( size_t t = 1; t < threads; t += 2 )
+        pool[ t ].join();
+
+    sTimeStats.Get( key, hist );
+    ok = ok and ( hist.Count() == threads * records );
+    if( !ok )
+        ::printf( "merged %lu times, expected %lu\n", hist.Count(), threads * records );
+    return ok;
+}
+
+}
+
+int utils_TimeStatsBench( int argc, char* argv[] )
+{
+    const size_t threads = ( 1 < argc ? atoi( argv[1] ) : 4 );
+    const size_t records = ( 2 < argc ? atoi( argv[2] ) : 1000000 );
+    const size_t keys = 27;
+
+    if( !VerifyHistogram() or !VerifyTimeStats() )
+        return 1;
+    ::printf( "percentiles and merges check out\n" );
+
+    std::vector<uint32> timeKeys;
+    for( size_t k = 0; k < keys; ++k )
+        timeKeys.push_back( sTimeStats.GetKey( "TimeStatsBench::" + std::to_string( k ) ) );
+
+    auto run = [&]( const std::function<void( size_t, double )>& record ) -> double {
+        const double start = GetTimeUSeconds();
+        std::vector<std::thread> pool;
+        for( size_t t = 0; t < threads; ++t )
+            pool.emplace_back( [&, t]() {
+                uint32 seed = 4711 + t;
+                for( size_t i = 0; i < records; ++i )
+                    record( Random( seed, keys ), MakeValue( seed ) / 1000.0 );
+            } );
+        for( auto& cur : pool )
+            cur.join();
+        return GetTimeUSeconds() - start;
+    };
+
+    std::mutex lock;
+    std::vector<std::vector<double>> vectors( keys );
+    const double vectorTime = run( [&]( size_t key, double us ) {
+        std::lock_guard<std::mutex> l( lock );
+        vectors[ key ].push_back( us );
+    } );
+    size_t vectorBytes = 0;
+    for( auto& cur : vectors )
+        vectorBytes += cur.capacity() * sizeof( double );
+
+    const double statsTime = run( [&]( size_t key, double us ) {
+        sTimeStats.Record( timeKeys[ key ], us );
+    } );
+
+    const size_t total = threads * records;
+    ::printf( "%lu threads, %lu records over %lu keys\n", threads, total, keys );
+    ::printf( "%10s %14s %14s %10s\n", "", "ns per record", "memory", "" );
+    ::printf( "%10s %14.1f %13luk\n", "vectors", vectorTime * 1000.0 / total, vectorBytes / 1024 );
+    ::printf( "%10s %14.1f %13luk %9.1fx\n", "timestats", statsTime * 1000.0 / total, keys * sizeof( Histogram ) / 1024, vectorTime / statsTime );
+
+    return 0;
+}
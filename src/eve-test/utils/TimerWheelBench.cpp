@@ -0,0 +1,207 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "utils/TimerWheel.h"
+
+/*
+ * First checks TimerWheel against the expected fire times: timers from 1ms to
+ * days out, the clock moved in steps from 1ms to hours, timers cancelled and
+ * timers rearming themselves from their callbacks.  Every timer must fire at
+ * the first Advance() at or past start + delay + 1, and cancelled ones never.
+ *
+ * Then times a server loop (100Hz) with a set of game timers, the way they
+ * were kept (Timer objects, each Check()ed every loop) and on a TimerWheel.
+ * Like on a real server most of them are disabled or far off (respawns,
+ * jetcans, skill training) and a few cycle every few seconds (locks, modules).
+ *
+ * usage: eve-test utils/TimerWheelBench [timers] [loops]
+ */
+
+namespace {
+
+uint32 Random( uint32& seed, uint32 limit )
+{
+    seed = seed * 1103515245 + 12345;
+    return ( seed >> 8 ) % limit;
+}
+
+bool Verify()
+{
+    struct Entry
+    {
+        uint32 start, delay;
+        bool cancelled, rearm;
+        int fired;
+        TimerWheel::TimerID id;
+    };
+
+    TimerWheel wheel;
+    std::vector<Entry> entries( 20000 );
+    uint32 seed = 31337;
+    uint32 now = 0, last = 0;
+    bool ok = true;
+
+    // 'start' is the wheel's time: now, or the ms a callback arming it runs at
+    std::function<void( size_t, uint32 )> arm = [&]( size_t i, uint32 start ) {
+        Entry& e = entries[ i ];
+        e.start = start;
+        e.fired = 0;
+        const uint32 range = Random( seed, 4 );
+        const uint32 limits[] = { 300, 70000, 20000000, 400000000 };
+        e.delay = Random( seed, limits[ range ] );
+        e.id = wheel.Schedule( e.delay, [&, i]() {
+            Entry& cur = entries[ i ];
+            ++cur.fired;
+            // due in (last, now], and not before start + delay + 1
+            const uint32 due = cur.start + cur.delay + 1;
+            if( cur.cancelled or cur.fired > 1 or ( int32 )( due - last ) <= 0 or ( int32 )( now - due ) < 0 ) {
+                ::printf( "timer %lu: delay %u from %u fired at %u (previous advance %u)\n", i, cur.delay, cur.start, now, last );
+                ok = false;
+            }
+            if( cur.rearm ) {
+                cur.rearm = false;
+                arm( i, due );
+            }
+        } );
+    };
+
+    for( size_t i = 0; i < entries.size(); ++i ) {
+        entries[ i ].cancelled = false;
+        entries[ i ].rearm = ( Random( seed, 4 ) == 0 );
+        arm( i, now );
+    }
+
+    while( ok and wheel.size() > 0 ) {
+        // cancel a few
+        for( int c = 0; c < 3; ++c ) {
+            Entry& e = entries[ Random( seed, (uint32)entries.size() ) ];
+            if( wheel.Cancel( e.id ) )
+                e.cancelled = true;
+        }
+
+        const uint32 steps[] = { 1, 10, 250, 5000, 3600000 };
+        last = now;
+        now += 1 + Random( seed, steps[ Random( seed, 5 ) ] );
+        wheel.Advance( now );
+    }
+
+    for( size_t i = 0; ok and i < entries.size(); ++i )
+        if( !entries[ i ].cancelled and entries[ i ].fired != 1 ) {
+            ::printf( "timer %lu fired %d times\n", i, entries[ i ].fired );
+            ok = false;
+        }
+
+    if( ok )
+        ::printf( "%lu timers fired on time\n", entries.size() );
+    return ok;
+}
+
+struct Kind
+{
+    uint32 period;      // 0: disabled
+    bool repeat;
+};
+
+/* what a timer on a busy server does: mostly nothing */
+Kind MakeKind( uint32& seed )
+{
+    const uint32 roll = Random( seed, 100 );
+    if( roll < 60 )
+        return Kind{ 0, false };                                    // disabled (cloak, invul, jetcan, reload...)
+    if( roll < 90 )
+        return Kind{ 60000 + Random( seed, 3600000 ), false };      // far off (spawns, skill training, save)
+    return Kind{ 1000 + Random( seed, 9000 ), true };               // cycling (locks, modules, npc ai)
+}
+
+}
+
+int utils_TimerWheelBench( int argc, char* argv[] )
+{
+    const size_t count = ( 1 < argc ? atoi( argv[1] ) : 5000 );
+    const size_t loops = ( 2 < argc ? atoi( argv[2] ) : 10000 );
+    const uint32 step = 10;     // ms per server loop
+
+    if( !Verify() )
+        return 1;
+
+    std::vector<Kind> kinds;
+    uint32 seed = 4711;
+    for( size_t i = 0; i < count; ++i )
+        kinds.push_back( MakeKind( seed ) );
+
+    // polled Timers on the real clock.  few of them come due in the time this runs, which is the point
+    size_t polledHits = 0;
+    double polledTime = 0.0;
+    {
+        Timer::SetCurrentTime();
+        std::vector<Timer> timers;
+        for( const Kind& k : kinds )
+            timers.push_back( Timer( k.period ) );
+
+        const double start = GetTimeUSeconds();
+        for( size_t l = 0; l < loops; ++l ) {
+            Timer::SetCurrentTime();
+            for( Timer& t : timers )
+                if( t.Check() )
+                    ++polledHits;
+        }
+        polledTime = GetTimeUSeconds() - start;
+    }
+
+    // the same timers on a wheel, on a simulated clock moving 'step' per loop
+    size_t wheelHits = 0;
+    double wheelTime = 0.0;
+    {
+        TimerWheel wheel;
+        std::function<void( size_t )> arm = [&]( size_t i ) {
+            wheel.Schedule( kinds[ i ].period, [&, i]() {
+                ++wheelHits;
+                if( kinds[ i ].repeat )
+                    arm( i );
+            } );
+        };
+        for( size_t i = 0; i < count; ++i )
+            if( kinds[ i ].period > 0 )
+                arm( i );
+
+        uint32 now = 0;
+        const double start = GetTimeUSeconds();
+        for( size_t l = 0; l < loops; ++l ) {
+            now += step;
+            wheel.Advance( now );
+        }
+        wheelTime = GetTimeUSeconds() - start;
+    }
+
+    ::printf( "%lu timers, %lu loops of %ums (%.0fs simulated on the wheel)\n", count, loops, step, loops * step / 1000.0 );
+    ::printf( "%8s %14s %14s %10s\n", "", "us per loop", "fired", "" );
+    ::printf( "%8s %14.3f %14lu\n", "polled", polledTime / loops, polledHits );
+    ::printf( "%8s %14.3f %14lu %9.1fx\n", "wheel", wheelTime / loops, wheelHits, polledTime / wheelTime );
+    ::printf( "loop cost per simulated second: polled %.0fus, wheel %.0fus\n", polledTime / loops * ( 1000 / step ), wheelTime / loops * ( 1000 / step ) );
+
+    return 0;
+}